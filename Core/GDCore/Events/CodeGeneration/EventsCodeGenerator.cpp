@@ -737,9 +737,8 @@ gd::String EventsCodeGenerator::GenerateObjectsDeclarationCode(
     gd::String objectListDeclaration = "";
     if (!context.ObjectAlreadyDeclared(object)) {
       objectListDeclaration = "std::vector<RuntimeObject*> " +
-                              GetObjectListName(object, context) +
-                              " = runtimeContext->GetObjectsRawPointers(\"" +
-                              ConvertToString(object) + "\");\n";
+                              GetObjectListName(object, context) + " = " +
+                              GenerateAllInstancesGetterCode(object) + ";\n";
       context.SetObjectDeclared(object);
     } else
       objectListDeclaration = declareObjectList(object, context);
@@ -773,6 +772,12 @@ gd::String EventsCodeGenerator::GenerateObjectsDeclarationCode(
   return declarationsCode;
 }
 
+gd::String EventsCodeGenerator::GenerateAllInstancesGetterCode(
+    const gd::String& objectName) {
+  return "runtimeContext->GetObjectsRawPointers(" +
+         ConvertToStringExplicit(objectName) + ")";
+}
+
 /**
  * Generate events list code.
  */
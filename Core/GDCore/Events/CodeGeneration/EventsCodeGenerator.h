@@ -167,6 +167,14 @@ class GD_CORE_API EventsCodeGenerator {
   virtual gd::String GenerateObjectsDeclarationCode(
       EventsCodeGenerationContext& context);
 
+  /**
+   * \brief Generate the code returning all the instances of an object, used
+   * to initialize the list of objects when it is first declared.
+   *
+   * \param objectName The name of the object.
+   */
+  virtual gd::String GenerateAllInstancesGetterCode(const gd::String& objectName);
+
   /**
    * \brief Must convert a plain string ( with line feed, quotes ) to a string
    that can be inserted into code.
@@ -0,0 +1,82 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Events/Parsers/ExpressionNodeArena.h"
+#include <new>
+
+namespace gd {
+
+namespace {
+const std::size_t alignment = 16;
+
+std::size_t AlignSize(std::size_t size) {
+  return (size + alignment - 1) & ~(alignment - 1);
+}
+}  // namespace
+
+ExpressionNodeArena::ExpressionNodeArena(std::size_t blockSize_)
+    : blockSize(AlignSize(blockSize_)), used(0) {}
+
+void* ExpressionNodeArena::Allocate(std::size_t size) {
+  size = AlignSize(size);
+  if (blocks.empty() || used + size > blocks.back().size) {
+    // Allocations larger than a block get a block of their own.
+    Block block;
+    block.size = size > blockSize ? size : blockSize;
+    block.data.reset(new char[block.size + alignment]);
+    blocks.push_back(std::move(block));
+    used = 0;
+  }
+
+  // Blocks are aligned by hand, as new char[] only guarantees the alignment
+  // of the largest fundamental type.
+  char* data = blocks.back().data.get();
+  std::size_t offset =
+      AlignSize(reinterpret_cast<std::size_t>(data)) -
+      reinterpret_cast<std::size_t>(data);
+  void* ptr = data + offset + used;
+  used += size;
+  return ptr;
+}
+
+void ExpressionNodeArena::Clear() {
+  if (blocks.size() > 1) blocks.erase(blocks.begin() + 1, blocks.end());
+  used = 0;
+}
+
+std::size_t ExpressionNodeArena::GetMemoryUsage() const {
+  std::size_t memoryUsage = 0;
+  for (auto& block : blocks) memoryUsage += block.size;
+
+  return memoryUsage;
+}
+
+void* ExpressionNodeAllocation::operator new(std::size_t size,
+                                             ExpressionNodeArena& arena) {
+  char* header = static_cast<char*>(arena.Allocate(headerSize + size));
+  *reinterpret_cast<ExpressionNodeArena**>(header) = &arena;
+  return header + headerSize;
+}
+
+void* ExpressionNodeAllocation::operator new(std::size_t size) {
+  char* header = static_cast<char*>(::operator new(headerSize + size));
+  *reinterpret_cast<ExpressionNodeArena**>(header) = nullptr;
+  return header + headerSize;
+}
+
+void ExpressionNodeAllocation::operator delete(void* ptr) {
+  if (!ptr) return;
+
+  char* header = static_cast<char*>(ptr) - headerSize;
+  if (*reinterpret_cast<ExpressionNodeArena**>(header) == nullptr)
+    ::operator delete(header);
+}
+
+void ExpressionNodeAllocation::operator delete(void* ptr,
+                                               ExpressionNodeArena& arena) {
+  // Only called if a constructor throws: the memory is left to the arena.
+}
+
+}  // namespace gd
@@ -0,0 +1,107 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_EXPRESSIONNODEARENA_H
+#define GDCORE_EXPRESSIONNODEARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace gd {
+
+/**
+ * \brief A monotonic allocator for the nodes and diagnostics of the trees
+ * built by gd::ExpressionParser2.
+ *
+ * Nodes are allocated one after the other in large blocks, so that parsing an
+ * expression does a few allocations instead of one (or more) per node. The
+ * strings stored in the nodes being usually short, they are also stored in
+ * the blocks (as they don't need an allocation of their own).
+ *
+ * Nodes are destroyed as usual (when their std::unique_ptr is destroyed), but
+ * their memory is only released when the arena is cleared or destroyed. An
+ * arena can be cleared and used again to parse another expression, without
+ * allocating again.
+ *
+ * \warning The arena must outlive the nodes allocated in it: destroy the trees
+ * before clearing or destroying the arena.
+ *
+ * \see gd::ExpressionParser2::ParseExpression
+ */
+class GD_CORE_API ExpressionNodeArena {
+ public:
+  ExpressionNodeArena(std::size_t blockSize_ = 16 * 1024);
+  ~ExpressionNodeArena(){};
+
+  /**
+   * \brief Allocate memory in the arena (aligned like the memory returned by
+   * operator new).
+   */
+  void* Allocate(std::size_t size);
+
+  /**
+   * \brief Release all the memory allocated in the arena, keeping the first
+   * block to be used again.
+   */
+  void Clear();
+
+  /**
+   * \brief Return the number of bytes allocated by the arena.
+   */
+  std::size_t GetMemoryUsage() const;
+
+ private:
+  ExpressionNodeArena(const ExpressionNodeArena&) = delete;
+  ExpressionNodeArena& operator=(const ExpressionNodeArena&) = delete;
+
+  struct Block {
+    std::unique_ptr<char[]> data;
+    std::size_t size;
+  };
+
+  std::size_t blockSize;
+  std::vector<Block> blocks;
+  std::size_t used;  ///< The number of bytes used in the last block.
+};
+
+/**
+ * \brief Base class for gd::ExpressionNode and gd::ExpressionParserDiagnostic
+ * so that they can be allocated in a gd::ExpressionNodeArena, while still
+ * being owned by a std::unique_ptr (whatever the way they were allocated).
+ *
+ * \see gd::ExpressionNodeArena
+ */
+struct GD_CORE_API ExpressionNodeAllocation {
+  /**
+   * \brief Allocate a node in the arena.
+   */
+  static void* operator new(std::size_t size, ExpressionNodeArena& arena);
+
+  /**
+   * \brief Allocate a node on the heap (when not parsing with an arena).
+   */
+  static void* operator new(std::size_t size);
+
+  /**
+   * \brief Destroy a node: the memory is released if it was allocated on the
+   * heap, and is left to the arena otherwise.
+   */
+  static void operator delete(void* ptr);
+
+  static void operator delete(void* ptr, ExpressionNodeArena& arena);
+
+ private:
+  /**
+   * \brief Each allocation is preceded by the arena that holds it (or
+   * nullptr for the heap). The header is as large as the alignment of
+   * allocations, so that nodes stay properly aligned.
+   */
+  static const std::size_t headerSize = 16;
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_EXPRESSIONNODEARENA_H
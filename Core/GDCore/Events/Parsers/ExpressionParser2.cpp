@@ -22,7 +22,7 @@ using namespace std;
 
 namespace gd {
 
-gd::String ExpressionParser2::NAMESPACE_SEPARATOR = "::";
+const gd::String ExpressionParser2::NAMESPACE_SEPARATOR = "::";
 
 ExpressionParser2::ExpressionParser2(
     const gd::Platform& platform_,
@@ -30,6 +30,8 @@ ExpressionParser2::ExpressionParser2(
     const gd::ObjectsContainer& objectsContainer_)
     : expression(""),
       currentPosition(0),
+      currentByte(0),
+      arena(nullptr),
       platform(platform_),
       globalObjectsContainer(globalObjectsContainer_),
       objectsContainer(objectsContainer_) {}
@@ -70,7 +72,7 @@ std::unique_ptr<ExpressionParserDiagnostic> ExpressionParser2::ValidateFunction(
     const gd::FunctionCallNode& function, size_t functionStartPosition) {
   if (gd::MetadataProvider::IsBadExpressionMetadata(
           function.expressionMetadata)) {
-    return gd::make_unique<ExpressionParserError>(
+    return MakeNode<ExpressionParserError>(
         "invalid_function_name",
         _("Cannot find an expression with this name: ") +
             function.functionName + "\n" +
@@ -96,7 +98,7 @@ std::unique_ptr<ExpressionParserDiagnostic> ExpressionParser2::ValidateFunction(
                   gd::String::From(maxParametersCount);
 
     if (function.parameters.size() < minParametersCount) {
-      return gd::make_unique<ExpressionParserError>(
+      return MakeNode<ExpressionParserError>(
           "too_few_parameters",
           "You have not entered enough parameters for the expression. " +
               expectedCountMessage,
@@ -105,14 +107,14 @@ std::unique_ptr<ExpressionParserDiagnostic> ExpressionParser2::ValidateFunction(
     }
   }
 
-  return gd::make_unique<ExpressionParserDiagnostic>();
+  return MakeNode<ExpressionParserDiagnostic>();
 }
 
 std::unique_ptr<TextNode> ExpressionParser2::ReadText() {
   size_t textStartPosition = GetCurrentPosition();
   SkipAllWhitespaces();
   if (!CheckIfChar(IsQuote)) {
-    auto text = gd::make_unique<TextNode>("");
+    auto text = MakeNode<TextNode>("");
     text->diagnostic =
         RaiseSyntaxError(_("A text must start with a double quote (\")."));
     text->location = ExpressionParserLocation(textStartPosition, GetCurrentPosition());
@@ -120,10 +122,13 @@ std::unique_ptr<TextNode> ExpressionParser2::ReadText() {
   }
   SkipChar();
 
-  gd::String parsedText = "";
+  // The text is built directly in UTF8, copying the characters as they are
+  // written in the expression (apart from escaped characters).
+  std::string parsedText;
   bool textParsingHasEnded = false;
   bool expectEscapedCharacter = false;
   while (!IsEndReached() && !textParsingHasEnded) {
+    size_t characterByte = currentByte;
     if (GetCurrentChar() == '"') {
       if (expectEscapedCharacter) {
         parsedText += '"';
@@ -131,6 +136,7 @@ std::unique_ptr<TextNode> ExpressionParser2::ReadText() {
       } else {
         textParsingHasEnded = true;
       }
+      NextChar();
     } else if (GetCurrentChar() == '\\') {
       if (expectEscapedCharacter) {
         parsedText += '\\';
@@ -138,18 +144,18 @@ std::unique_ptr<TextNode> ExpressionParser2::ReadText() {
       } else {
         expectEscapedCharacter = true;
       }
+      NextChar();
     } else {
       if (expectEscapedCharacter) {
         parsedText += '\\';
       }
 
-      parsedText += GetCurrentChar();
+      NextChar();
+      parsedText.append(GetRaw(), characterByte, currentByte - characterByte);
     }
-
-    currentPosition++;
   }
 
-  auto text = gd::make_unique<TextNode>(parsedText);
+  auto text = MakeNode<TextNode>(gd::String::FromUTF8(parsedText));
   text->location = ExpressionParserLocation(textStartPosition, GetCurrentPosition());
   if (!textParsingHasEnded) {
     text->diagnostic =
@@ -191,7 +197,7 @@ std::unique_ptr<NumberNode> ExpressionParser2::ReadNumber() {
       break;
     }
 
-    currentPosition++;
+    NextChar();
   }
 
   // parsedNumber can be empty in the only case where we have only seen
@@ -203,7 +209,7 @@ std::unique_ptr<NumberNode> ExpressionParser2::ReadNumber() {
   // Note that parsedNumber can finish by a dot (1., 2., 0.). This is
   // valid in most languages so we allow this.
 
-  auto number = gd::make_unique<NumberNode>(parsedNumber);
+  auto number = MakeNode<NumberNode>(parsedNumber);
   number->location = ExpressionParserLocation(numberStartPosition, GetCurrentPosition());
   if (!numberHasStarted || !digitFound) {
     number->diagnostic = RaiseSyntaxError(
@@ -59,13 +59,52 @@ class GD_CORE_API ExpressionParser2 {
       const gd::String &type,
       const gd::String &expression_,
       const gd::String &objectName = "") {
+    arena = nullptr;
+    return Parse(type, expression_, objectName);
+  }
+
+  /**
+   * Parse the given expression with the specified type, allocating the nodes
+   * of the tree in \a arena_ (see gd::ExpressionNodeArena).
+   *
+   * \warning The tree must be destroyed before the arena is cleared or
+   * destroyed.
+   */
+  std::unique_ptr<ExpressionNode> ParseExpression(
+      const gd::String &type,
+      const gd::String &expression_,
+      ExpressionNodeArena &arena_,
+      const gd::String &objectName = "") {
+    arena = &arena_;
+    auto node = Parse(type, expression_, objectName);
+    arena = nullptr;
+    return node;
+  }
+
+ private:
+  std::unique_ptr<ExpressionNode> Parse(const gd::String &type,
+                                        const gd::String &expression_,
+                                        const gd::String &objectName) {
     expression = expression_;
 
     currentPosition = 0;
+    currentByte = 0;
     return Start(type, objectName);
   }
 
- private:
+  /**
+   * \brief Create a node (or a diagnostic), in the arena if the expression is
+   * parsed with one.
+   */
+  template <class T, class... Args>
+  std::unique_ptr<T> MakeNode(Args &&... args) {
+    if (arena) {
+      return std::unique_ptr<T>(new (*arena) T(std::forward<Args>(args)...));
+    }
+
+    return gd::make_unique<T>(std::forward<Args>(args)...);
+  }
+
   /** \name Grammar
    * Each method is a part of the grammar.
    */
@@ -77,7 +116,7 @@ class GD_CORE_API ExpressionParser2 {
 
     // Check for extra characters at the end of the expression
     if (!IsEndReached()) {
-      auto op = gd::make_unique<OperatorNode>(type, ' ');
+      auto op = MakeNode<OperatorNode>(type, ' ');
       op->leftHandSide = std::move(expression);
       op->rightHandSide = ReadUntilEnd("unknown");
 
@@ -105,7 +144,7 @@ class GD_CORE_API ExpressionParser2 {
     if (IsEndReached()) return leftHandSide;
     if (CheckIfChar(IsExpressionEndingChar)) return leftHandSide;
     if (CheckIfChar(IsExpressionOperator)) {
-      auto op = gd::make_unique<OperatorNode>(type, GetCurrentChar());
+      auto op = MakeNode<OperatorNode>(type, GetCurrentChar());
       op->leftHandSide = std::move(leftHandSide);
       op->diagnostic = ValidateOperator(type, GetCurrentChar());
       SkipChar();
@@ -130,7 +169,7 @@ class GD_CORE_API ExpressionParser2 {
           "properly written.");
     }
 
-    auto op = gd::make_unique<OperatorNode>(type, ' ');
+    auto op = MakeNode<OperatorNode>(type, ' ');
     op->leftHandSide = std::move(leftHandSide);
     op->rightHandSide = Expression(type, objectName);
     op->location =
@@ -151,7 +190,7 @@ class GD_CORE_API ExpressionParser2 {
     // to guarantee the proper operator precedence. (Expression could also
     // be reworked to use a while loop).
     while (CheckIfChar(IsTermOperator)) {
-      auto op = gd::make_unique<OperatorNode>(type, GetCurrentChar());
+      auto op = MakeNode<OperatorNode>(type, GetCurrentChar());
       op->leftHandSide = std::move(factor);
       op->diagnostic = ValidateOperator(type, GetCurrentChar());
       SkipChar();
@@ -185,7 +224,7 @@ class GD_CORE_API ExpressionParser2 {
             expressionStartPosition);
     } else if (CheckIfChar(IsUnaryOperator)) {
       auto unaryOperator =
-          gd::make_unique<UnaryOperatorNode>(type, GetCurrentChar());
+          MakeNode<UnaryOperatorNode>(type, GetCurrentChar());
       unaryOperator->diagnostic = ValidateUnaryOperator(type, GetCurrentChar());
       SkipChar();
       unaryOperator->factor = Factor(type, objectName);
@@ -233,7 +272,7 @@ class GD_CORE_API ExpressionParser2 {
       const gd::String &type, const gd::String &objectName) {
     size_t expressionStartPosition = GetCurrentPosition();
     auto subExpression =
-        gd::make_unique<SubExpressionNode>(type, Expression(type, objectName));
+        MakeNode<SubExpressionNode>(type, Expression(type, objectName));
     subExpression->location =
         ExpressionParserLocation(expressionStartPosition, GetCurrentPosition());
 
@@ -275,7 +314,7 @@ class GD_CORE_API ExpressionParser2 {
       return ObjectFunctionOrBehaviorFunction(
           type, name, nameLocation, dotLocation);
     } else {
-      auto identifier = gd::make_unique<IdentifierNode>(name, type);
+      auto identifier = MakeNode<IdentifierNode>(name, type);
       if (type == "string") {
         identifier->diagnostic =
             RaiseTypeError(_("You must wrap your text inside double quotes "
@@ -302,7 +341,7 @@ class GD_CORE_API ExpressionParser2 {
     const gd::String &name = identifierAndLocation.name;
     const auto &nameLocation = identifierAndLocation.location;
 
-    auto variable = gd::make_unique<VariableNode>(type, name, objectName);
+    auto variable = MakeNode<VariableNode>(type, name, objectName);
     variable->child = VariableAccessorOrVariableBracketAccessor();
 
     variable->location = ExpressionParserLocation(
@@ -319,7 +358,7 @@ class GD_CORE_API ExpressionParser2 {
     if (CheckIfChar(IsOpeningSquareBracket)) {
       SkipChar();
       auto child =
-          gd::make_unique<VariableBracketAccessorNode>(Expression("string"));
+          MakeNode<VariableBracketAccessorNode>(Expression("string"));
 
       if (!CheckIfChar(IsClosingSquareBracket)) {
         child->diagnostic =
@@ -338,7 +377,7 @@ class GD_CORE_API ExpressionParser2 {
 
       auto identifierAndLocation = ReadIdentifierName();
       auto child =
-          gd::make_unique<VariableAccessorNode>(identifierAndLocation.name);
+          MakeNode<VariableAccessorNode>(identifierAndLocation.name);
       child->child = VariableAccessorOrVariableBracketAccessor();
       child->nameLocation = identifierAndLocation.location;
       child->dotLocation = dotLocation;
@@ -369,7 +408,7 @@ class GD_CORE_API ExpressionParser2 {
                                platform, functionFullName);
 
     auto parametersNode = Parameters(metadata.parameters);
-    auto function = gd::make_unique<FunctionCallNode>(
+    auto function = MakeNode<FunctionCallNode>(
         type, std::move(parametersNode.parameters), metadata, functionFullName);
     function->diagnostic = std::move(parametersNode.diagnostic);
     if (!function->diagnostic)
@@ -425,7 +464,7 @@ class GD_CORE_API ExpressionParser2 {
                     platform, objectType, objectFunctionOrBehaviorName);
 
       auto parametersNode = Parameters(metadata.parameters, objectName);
-      auto function = gd::make_unique<FunctionCallNode>(
+      auto function = MakeNode<FunctionCallNode>(
           type,
           objectName,
           std::move(parametersNode.parameters),
@@ -447,7 +486,7 @@ class GD_CORE_API ExpressionParser2 {
       return std::move(function);
     }
 
-    auto node = gd::make_unique<ObjectFunctionNameNode>(
+    auto node = MakeNode<ObjectFunctionNameNode>(
         type, objectName, objectFunctionOrBehaviorName);
     node->diagnostic = RaiseSyntaxError(
         _("An opening parenthesis (for an object expression), or double colon "
@@ -492,7 +531,7 @@ class GD_CORE_API ExpressionParser2 {
 
       auto parametersNode =
           Parameters(metadata.parameters, objectName, behaviorName);
-      auto function = gd::make_unique<FunctionCallNode>(
+      auto function = MakeNode<FunctionCallNode>(
           type,
           objectName,
           behaviorName,
@@ -517,7 +556,7 @@ class GD_CORE_API ExpressionParser2 {
       function->functionNameLocation = functionNameLocation;
       return std::move(function);
     } else {
-      auto node = gd::make_unique<ObjectFunctionNameNode>(
+      auto node = MakeNode<ObjectFunctionNameNode>(
           type, objectName, behaviorName, functionName);
       node->diagnostic = RaiseSyntaxError(
           _("An opening parenthesis was expected here to call a function."));
@@ -576,7 +615,7 @@ class GD_CORE_API ExpressionParser2 {
             size_t parameterStartPosition = GetCurrentPosition();
             parameters.push_back(Expression("unknown"));
             parameters.back()->diagnostic =
-                gd::make_unique<ExpressionParserError>(
+                MakeNode<ExpressionParserError>(
                     "unknown_parameter_type",
                     _("This function is improperly set up. Reach out to the "
                       "extension developer or a GDevelop maintainer to fix "
@@ -588,7 +627,7 @@ class GD_CORE_API ExpressionParser2 {
           size_t parameterStartPosition = GetCurrentPosition();
           parameters.push_back(Expression("unknown"));
           parameters.back()
-              ->diagnostic = gd::make_unique<ExpressionParserError>(
+              ->diagnostic = MakeNode<ExpressionParserError>(
               "extra_parameter",
               _("This parameter was not expected by this expression. Remove it "
                 "or verify that you've entered the proper expression name."),
@@ -623,76 +662,76 @@ class GD_CORE_API ExpressionParser2 {
     if (type == "number") {
       if (operatorChar == '+' || operatorChar == '-' || operatorChar == '/' ||
           operatorChar == '*') {
-        return gd::make_unique<ExpressionParserDiagnostic>();
+        return MakeNode<ExpressionParserDiagnostic>();
       }
 
-      return gd::make_unique<ExpressionParserError>(
+      return MakeNode<ExpressionParserError>(
           "invalid_operator",
           _("You've used an operator that is not supported. Operator should be "
             "either +, -, / or *."),
           GetCurrentPosition());
     } else if (type == "string") {
       if (operatorChar == '+') {
-        return gd::make_unique<ExpressionParserDiagnostic>();
+        return MakeNode<ExpressionParserDiagnostic>();
       }
 
-      return gd::make_unique<ExpressionParserError>(
+      return MakeNode<ExpressionParserError>(
           "invalid_operator",
           _("You've used an operator that is not supported. Only + can be used "
             "to concatenate texts."),
           GetCurrentPosition());
     } else if (gd::ParameterMetadata::IsObject(type)) {
-      return gd::make_unique<ExpressionParserError>(
+      return MakeNode<ExpressionParserError>(
           "invalid_operator",
           _("Operators (+, -, /, *) can't be used with an object name. Remove "
             "the operator."),
           GetCurrentPosition());
     } else if (gd::ParameterMetadata::IsExpression("variable", type)) {
-      return gd::make_unique<ExpressionParserError>(
+      return MakeNode<ExpressionParserError>(
           "invalid_operator",
           _("Operators (+, -, /, *) can't be used in variable names. Remove "
             "the operator from the variable name."),
           GetCurrentPosition());
     }
 
-    return gd::make_unique<ExpressionParserDiagnostic>();
+    return MakeNode<ExpressionParserDiagnostic>();
   }
 
   std::unique_ptr<ExpressionParserDiagnostic> ValidateUnaryOperator(
       const gd::String &type, gd::String::value_type operatorChar) {
     if (type == "number") {
       if (operatorChar == '+' || operatorChar == '-') {
-        return gd::make_unique<ExpressionParserDiagnostic>();
+        return MakeNode<ExpressionParserDiagnostic>();
       }
 
-      return gd::make_unique<ExpressionParserError>(
+      return MakeNode<ExpressionParserError>(
           "invalid_operator",
           _("You've used an \"unary\" operator that is not supported. Operator "
             "should be "
             "either + or -."),
           GetCurrentPosition());
     } else if (type == "string") {
-      return gd::make_unique<ExpressionParserError>(
+      return MakeNode<ExpressionParserError>(
           "invalid_operator",
           _("You've used an operator that is not supported. Only + can be used "
             "to concatenate texts, and must be placed between two texts (or "
             "expressions)."),
           GetCurrentPosition());
     } else if (gd::ParameterMetadata::IsObject(type)) {
-      return gd::make_unique<ExpressionParserError>(
+      return MakeNode<ExpressionParserError>(
           "invalid_operator",
           _("Operators (+, -) can't be used with an object name. Remove the "
             "operator."),
           GetCurrentPosition());
     } else if (gd::ParameterMetadata::IsExpression("variable", type)) {
-      return gd::make_unique<ExpressionParserError>(
+      return MakeNode<ExpressionParserError>(
           "invalid_operator",
           _("Operators (+, -) can't be used in variable names. Remove "
             "the operator from the variable name."),
           GetCurrentPosition());
     }
 
-    return gd::make_unique<ExpressionParserDiagnostic>();
+    return MakeNode<ExpressionParserDiagnostic>();
   }
   ///@}
 
@@ -702,20 +741,20 @@ class GD_CORE_API ExpressionParser2 {
   ///@{
   ExpressionParserLocation SkipChar() {
     size_t startPosition = currentPosition;
-    return ExpressionParserLocation(startPosition, ++currentPosition);
+    NextChar();
+    return ExpressionParserLocation(startPosition, currentPosition);
   }
 
   void SkipAllWhitespaces() {
-    while (currentPosition < expression.size() &&
-           IsWhitespace(expression[currentPosition])) {
-      currentPosition++;
+    while (!IsEndReached() && IsWhitespace(GetCurrentChar())) {
+      NextChar();
     }
   }
 
   void SkipIfChar(
       const std::function<bool(gd::String::value_type)> &predicate) {
     if (CheckIfChar(predicate)) {
-      currentPosition++;
+      NextChar();
     }
   }
 
@@ -724,7 +763,9 @@ class GD_CORE_API ExpressionParser2 {
     // Namespace separator is a special kind of delimiter as it is 2 characters
     // long
     if (IsNamespaceSeparator()) {
-      currentPosition += NAMESPACE_SEPARATOR.size();
+      // The separator is ASCII: as many characters as bytes.
+      currentPosition += NAMESPACE_SEPARATOR.Raw().size();
+      currentByte += NAMESPACE_SEPARATOR.Raw().size();
     }
 
     return ExpressionParserLocation(startPosition, currentPosition);
@@ -732,15 +773,15 @@ class GD_CORE_API ExpressionParser2 {
 
   bool CheckIfChar(
       const std::function<bool(gd::String::value_type)> &predicate) {
-    if (currentPosition >= expression.size()) return false;
-    gd::String::value_type character = expression[currentPosition];
+    if (IsEndReached()) return false;
+    gd::String::value_type character = GetCurrentChar();
 
     return predicate(character);
   }
 
   bool IsIdentifierAllowedChar() {
-    if (currentPosition >= expression.size()) return false;
-    gd::String::value_type character = expression[currentPosition];
+    if (IsEndReached()) return false;
+    gd::String::value_type character = GetCurrentChar();
 
     // Quickly compare if the character is a number or ASCII character.
     if ((character >= '0' && character <= '9') ||
@@ -830,12 +871,12 @@ class GD_CORE_API ExpressionParser2 {
   bool IsNamespaceSeparator() {
     // Namespace separator is a special kind of delimiter as it is 2 characters
     // long
-    return (currentPosition + NAMESPACE_SEPARATOR.size() <= expression.size() &&
-            expression.substr(currentPosition, NAMESPACE_SEPARATOR.size()) ==
-                NAMESPACE_SEPARATOR);
+    return GetRaw().compare(currentByte,
+                            NAMESPACE_SEPARATOR.Raw().size(),
+                            NAMESPACE_SEPARATOR.Raw()) == 0;
   }
 
-  bool IsEndReached() { return currentPosition >= expression.size(); }
+  bool IsEndReached() { return currentByte >= GetRaw().size(); }
 
   // A temporary node used when reading an identifier
   struct IdentifierAndLocation {
@@ -844,36 +885,30 @@ class GD_CORE_API ExpressionParser2 {
   };
 
   IdentifierAndLocation ReadIdentifierName() {
-    gd::String name;
     size_t startPosition = currentPosition;
-    while (currentPosition < expression.size() &&
+    size_t startByte = currentByte;
+    // Trailing whitespace is not part of the name (we allow them for
+    // compatibility inside the name, but after the last character that is not
+    // whitespace, they should be ignored again).
+    size_t endPosition = currentPosition;
+    size_t endByte = currentByte;
+    while (!IsEndReached() &&
            (IsIdentifierAllowedChar()
             // Allow whitespace in identifier name for compatibility
-            ||
-            expression[currentPosition] == ' ')) {
-      name += expression[currentPosition];
-      currentPosition++;
-    }
-
-    // Trim whitespace at the end (we allow them for compatibility inside
-    // the name, but after the last character that is not whitespace, they
-    // should be ignore again).
-    if (!name.empty() && IsWhitespace(name[name.size() - 1])) {
-      size_t lastCharacterPos = name.size() - 1;
-      while (lastCharacterPos < name.size() &&
-             IsWhitespace(name[lastCharacterPos])) {
-        lastCharacterPos--;
-      }
-      if ((lastCharacterPos + 1) < name.size()) {
-        name.erase(lastCharacterPos + 1);
+            || GetCurrentChar() == ' ')) {
+      bool isWhitespace = IsWhitespace(GetCurrentChar());
+      NextChar();
+      if (!isWhitespace) {
+        endPosition = currentPosition;
+        endByte = currentByte;
       }
     }
 
     IdentifierAndLocation identifierAndLocation{
-        name,
+        GetText(startByte, endByte),
         // The location is ignoring the trailing whitespace (only whitespace
         // inside the identifier are allowed for compatibility).
-        ExpressionParserLocation(startPosition, startPosition + name.size())};
+        ExpressionParserLocation(startPosition, endPosition)};
     return identifierAndLocation;
   }
 
@@ -883,14 +918,13 @@ class GD_CORE_API ExpressionParser2 {
 
   std::unique_ptr<EmptyNode> ReadUntilWhitespace(gd::String type) {
     size_t startPosition = GetCurrentPosition();
-    gd::String text;
-    while (currentPosition < expression.size() &&
-           !IsWhitespace(expression[currentPosition])) {
-      text += expression[currentPosition];
-      currentPosition++;
+    size_t startByte = currentByte;
+    while (!IsEndReached() && !IsWhitespace(GetCurrentChar())) {
+      NextChar();
     }
 
-    auto node = gd::make_unique<EmptyNode>(type, text);
+    auto node =
+        MakeNode<EmptyNode>(type, GetText(startByte, currentByte));
     node->location =
         ExpressionParserLocation(startPosition, GetCurrentPosition());
     return node;
@@ -898,13 +932,13 @@ class GD_CORE_API ExpressionParser2 {
 
   std::unique_ptr<EmptyNode> ReadUntilEnd(gd::String type) {
     size_t startPosition = GetCurrentPosition();
-    gd::String text;
-    while (currentPosition < expression.size()) {
-      text += expression[currentPosition];
-      currentPosition++;
+    size_t startByte = currentByte;
+    while (!IsEndReached()) {
+      NextChar();
     }
 
-    auto node = gd::make_unique<EmptyNode>(type, text);
+    auto node =
+        MakeNode<EmptyNode>(type, GetText(startByte, currentByte));
     node->location =
         ExpressionParserLocation(startPosition, GetCurrentPosition());
     return node;
@@ -913,13 +947,60 @@ class GD_CORE_API ExpressionParser2 {
   size_t GetCurrentPosition() { return currentPosition; }
 
   gd::String::value_type GetCurrentChar() {
-    if (currentPosition < expression.size()) {
-      return expression[currentPosition];
+    if (!IsEndReached()) {
+      // Most expressions are ASCII: avoid decoding these characters.
+      unsigned char byte = GetRaw()[currentByte];
+      if (byte < 0x80) return byte;
+
+      // Invalid or truncated sequences are read as a single byte.
+      if (GetSequenceLength() == 1) return byte;
+
+      return ::utf8::unchecked::peek_next(GetRaw().begin() + currentByte);
     }
 
     return '\n';  // Should not arise, unless GetCurrentChar was called when
                   // IsEndReached() is true (which is a logical error).
   }
+
+  /**
+   * \brief Move to the next character, updating both the position (in
+   * characters) and the offset in the UTF8 expression (in bytes).
+   */
+  void NextChar() {
+    if (IsEndReached()) return;
+
+    unsigned char byte = GetRaw()[currentByte];
+    if (byte < 0x80)
+      currentByte++;
+    else
+      currentByte += GetSequenceLength();
+
+    currentPosition++;
+  }
+
+  /**
+   * \brief Return the length (in bytes) of the UTF8 sequence starting at the
+   * current offset. An invalid lead byte, or a sequence truncated by the end of
+   * the expression, is considered as a sequence of one byte so that the parser
+   * always moves forward.
+   */
+  std::size_t GetSequenceLength() const {
+    std::size_t length =
+        ::utf8::internal::sequence_length(GetRaw().begin() + currentByte);
+    if (length == 0 || currentByte + length > GetRaw().size()) return 1;
+
+    return length;
+  }
+
+  /**
+   * \brief Return the text between two offsets (in bytes) of the expression.
+   */
+  gd::String GetText(size_t startByte, size_t endByte) const {
+    return gd::String::FromUTF8(
+        GetRaw().substr(startByte, endByte - startByte));
+  }
+
+  const std::string &GetRaw() const { return expression.Raw(); }
   ///@}
 
   /** \name Raising errors
@@ -928,13 +1009,13 @@ class GD_CORE_API ExpressionParser2 {
   ///@{
   std::unique_ptr<ExpressionParserError> RaiseSyntaxError(
       const gd::String &message) {
-    return std::move(gd::make_unique<ExpressionParserError>(
+    return std::move(MakeNode<ExpressionParserError>(
         "syntax_error", message, GetCurrentPosition()));
   }
 
   std::unique_ptr<ExpressionParserError> RaiseTypeError(
       const gd::String &message, size_t beginningPosition) {
-    return std::move(gd::make_unique<ExpressionParserError>(
+    return std::move(MakeNode<ExpressionParserError>(
         "type_error", message, beginningPosition, GetCurrentPosition()));
   }
 
@@ -966,13 +1047,18 @@ class GD_CORE_API ExpressionParser2 {
   }
 
   gd::String expression;
-  std::size_t currentPosition;
+  std::size_t currentPosition;  ///< The position in the expression, in
+                                ///< characters (used for locations).
+  std::size_t currentByte;  ///< The offset of currentPosition in the UTF8
+                            ///< expression, in bytes.
+  ExpressionNodeArena *arena;  ///< The arena where nodes are allocated, if
+                               ///< any.
 
   const gd::Platform &platform;
   const gd::ObjectsContainer &globalObjectsContainer;
   const gd::ObjectsContainer &objectsContainer;
 
-  static gd::String NAMESPACE_SEPARATOR;
+  static const gd::String NAMESPACE_SEPARATOR;
 };
 
 }  // namespace gd
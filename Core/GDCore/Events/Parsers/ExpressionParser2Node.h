@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <vector>
+#include "ExpressionNodeArena.h"
 #include "ExpressionParser2NodeWorker.h"
 #include "GDCore/String.h"
 namespace gd {
@@ -41,7 +42,7 @@ struct ExpressionParserLocation {
 /**
  * \brief A diagnostic that can be attached to a gd::ExpressionNode.
  */
-struct ExpressionParserDiagnostic {
+struct ExpressionParserDiagnostic : public ExpressionNodeAllocation {
   virtual bool IsError() { return false; }
   virtual const gd::String &GetMessage() { return noMessage; }
   virtual size_t GetStartPosition() { return 0; }
@@ -82,8 +83,12 @@ struct ExpressionParserError : public ExpressionParserDiagnostic {
 /**
  * \brief The base node, from which all nodes in the tree of
  * an expression inherits from.
+ *
+ * Nodes can be allocated in a gd::ExpressionNodeArena (see
+ * gd::ExpressionParser2::ParseExpression), which is transparent for the
+ * code using them.
  */
-struct ExpressionNode {
+struct ExpressionNode : public ExpressionNodeAllocation {
   virtual ~ExpressionNode(){};
   virtual void Visit(ExpressionParser2NodeWorker &worker){};
 
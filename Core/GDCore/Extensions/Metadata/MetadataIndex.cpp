@@ -0,0 +1,94 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Extensions/Metadata/MetadataIndex.h"
+#include <map>
+#include "GDCore/Extensions/Metadata/BehaviorMetadata.h"
+#include "GDCore/Extensions/Metadata/EffectMetadata.h"
+#include "GDCore/Extensions/Metadata/ExpressionMetadata.h"
+#include "GDCore/Extensions/Metadata/InstructionMetadata.h"
+#include "GDCore/Extensions/Metadata/ObjectMetadata.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Extensions/PlatformExtension.h"
+
+namespace gd {
+
+namespace {
+/**
+ * \brief Add the metadata to the table, unless an extension already declared
+ * something with the same name.
+ */
+template <class T>
+void AddToTable(MetadataIndex::Table<T>& table,
+                const gd::PlatformExtension& extension,
+                const std::map<gd::String, T>& metadata) {
+  for (auto& it : metadata)
+    table.emplace(it.first, ExtensionAndMetadata<T>(extension, it.second));
+}
+}  // namespace
+
+MetadataIndex::MetadataIndex(const gd::Platform& platform) {
+  for (auto& extension : platform.GetAllPlatformExtensions()) {
+    for (const gd::String& behaviorType : extension->GetBehaviorsTypes())
+      behaviors.emplace(behaviorType,
+                        ExtensionAndMetadata<BehaviorMetadata>(
+                            *extension,
+                            extension->GetBehaviorMetadata(behaviorType)));
+    for (const gd::String& effectType : extension->GetExtensionEffectTypes())
+      effects.emplace(effectType,
+                      ExtensionAndMetadata<EffectMetadata>(
+                          *extension, extension->GetEffectMetadata(effectType)));
+
+    AddToTable(actions, *extension, extension->GetAllActions());
+    AddToTable(conditions, *extension, extension->GetAllConditions());
+    AddToTable(expressions, *extension, extension->GetAllExpressions());
+    AddToTable(strExpressions, *extension, extension->GetAllStrExpressions());
+
+    // Free instructions are searched before the object ones, which are
+    // searched before the behavior ones.
+    AddToTable(allActions, *extension, extension->GetAllActions());
+    AddToTable(allConditions, *extension, extension->GetAllConditions());
+
+    for (const gd::String& objectType :
+         extension->GetExtensionObjectsTypes()) {
+      objects.emplace(objectType,
+                      ExtensionAndMetadata<ObjectMetadata>(
+                          *extension, extension->GetObjectMetadata(objectType)));
+
+      auto& objectActions = extension->GetAllActionsForObject(objectType);
+      auto& objectConditions =
+          extension->GetAllConditionsForObject(objectType);
+      AddToTable(objectsActions[objectType], *extension, objectActions);
+      AddToTable(objectsConditions[objectType], *extension, objectConditions);
+      AddToTable(allActions, *extension, objectActions);
+      AddToTable(allConditions, *extension, objectConditions);
+      AddToTable(objectsExpressions[objectType],
+                 *extension,
+                 extension->GetAllExpressionsForObject(objectType));
+      AddToTable(objectsStrExpressions[objectType],
+                 *extension,
+                 extension->GetAllStrExpressionsForObject(objectType));
+    }
+
+    for (const gd::String& behaviorType : extension->GetBehaviorsTypes()) {
+      auto& behaviorActions = extension->GetAllActionsForBehavior(behaviorType);
+      auto& behaviorConditions =
+          extension->GetAllConditionsForBehavior(behaviorType);
+      AddToTable(behaviorsActions[behaviorType], *extension, behaviorActions);
+      AddToTable(
+          behaviorsConditions[behaviorType], *extension, behaviorConditions);
+      AddToTable(allActions, *extension, behaviorActions);
+      AddToTable(allConditions, *extension, behaviorConditions);
+      AddToTable(behaviorsExpressions[behaviorType],
+                 *extension,
+                 extension->GetAllExpressionsForBehavior(behaviorType));
+      AddToTable(behaviorsStrExpressions[behaviorType],
+                 *extension,
+                 extension->GetAllStrExpressionsForBehavior(behaviorType));
+    }
+  }
+}
+
+}  // namespace gd
@@ -0,0 +1,109 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_METADATAINDEX_H
+#define GDCORE_METADATAINDEX_H
+#include <unordered_map>
+#include "GDCore/Extensions/Metadata/MetadataProvider.h"
+#include "GDCore/String.h"
+namespace gd {
+class BehaviorMetadata;
+class ObjectMetadata;
+class EffectMetadata;
+class ExpressionMetadata;
+class InstructionMetadata;
+class Platform;
+}  // namespace gd
+
+namespace gd {
+
+/**
+ * \brief Tables giving the metadata (and the extension) of the objects,
+ * behaviors, effects, instructions and expressions of all the extensions of a
+ * platform, so that they can be found without going through every
+ * extension.
+ *
+ * When several extensions declare the same object, behavior, instruction or
+ * expression, the tables contain the first one, in the order of the
+ * extensions of the platform (like when searching the extensions one by one).
+ *
+ * The index is built by gd::Platform the first time it's needed, and rebuilt
+ * when extensions are added or removed. It's used by gd::MetadataProvider and
+ * should not be needed elsewhere.
+ *
+ * \see gd::Platform::GetMetadataIndex
+ * \see gd::MetadataProvider
+ */
+class GD_CORE_API MetadataIndex {
+ public:
+  template <class T>
+  using Table = std::unordered_map<gd::String, ExtensionAndMetadata<T>>;
+
+  /**
+   * \brief Tables of instructions or expressions, for each object (or
+   * behavior) type.
+   */
+  template <class T>
+  using TablesByType = std::unordered_map<gd::String, Table<T>>;
+
+  /**
+   * \brief Build the index of the extensions of the platform.
+   */
+  MetadataIndex(const gd::Platform& platform);
+  virtual ~MetadataIndex(){};
+
+  /**
+   * \brief Return the element of the table having the specified name, or
+   * nullptr if not found.
+   */
+  template <class T>
+  static const ExtensionAndMetadata<T>* Find(const Table<T>& table,
+                                             const gd::String& name) {
+    auto it = table.find(name);
+    return it != table.end() ? &it->second : nullptr;
+  }
+
+  /**
+   * \brief Return the element having the specified name in the table of the
+   * specified type, or nullptr if not found.
+   */
+  template <class T>
+  static const ExtensionAndMetadata<T>* Find(const TablesByType<T>& tables,
+                                             const gd::String& type,
+                                             const gd::String& name) {
+    auto it = tables.find(type);
+    return it != tables.end() ? Find(it->second, name) : nullptr;
+  }
+
+  Table<BehaviorMetadata> behaviors;
+  Table<ObjectMetadata> objects;
+  Table<EffectMetadata> effects;
+
+  Table<InstructionMetadata> actions;  ///< Free actions only.
+  Table<InstructionMetadata> conditions;  ///< Free conditions only.
+  TablesByType<InstructionMetadata> objectsActions;
+  TablesByType<InstructionMetadata> objectsConditions;
+  TablesByType<InstructionMetadata> behaviorsActions;
+  TablesByType<InstructionMetadata> behaviorsConditions;
+  Table<InstructionMetadata> allActions;  ///< Free, object and behavior
+                                          ///< actions.
+  Table<InstructionMetadata> allConditions;  ///< Free, object and behavior
+                                             ///< conditions.
+
+  Table<ExpressionMetadata> expressions;
+  Table<ExpressionMetadata> strExpressions;
+  TablesByType<ExpressionMetadata> objectsExpressions;
+  TablesByType<ExpressionMetadata> objectsStrExpressions;
+  TablesByType<ExpressionMetadata> behaviorsExpressions;
+  TablesByType<ExpressionMetadata> behaviorsStrExpressions;
+
+ private:
+  MetadataIndex(const MetadataIndex&) = delete;
+  MetadataIndex& operator=(const MetadataIndex&) = delete;
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_METADATAINDEX_H
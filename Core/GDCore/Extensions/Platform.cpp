@@ -4,6 +4,7 @@
  * reserved. This project is released under the MIT License.
  */
 #include "Platform.h"
+#include "GDCore/Extensions/Metadata/MetadataIndex.h"
 #include "GDCore/Extensions/PlatformExtension.h"
 #include "GDCore/Project/Object.h"
 #include "GDCore/String.h"
@@ -14,9 +15,10 @@ using namespace std;
 
 namespace gd {
 
-Platform::Platform(): enableExtensionLoadingLogs(true) {}
+Platform::Platform()
+    : metadataIndex(nullptr), enableExtensionLoadingLogs(true) {}
 
-Platform::~Platform() {}
+Platform::~Platform() { InvalidateMetadataIndex(); }
 
 bool Platform::AddExtension(std::shared_ptr<gd::PlatformExtension> extension) {
   if (!extension) return false;
@@ -29,6 +31,7 @@ bool Platform::AddExtension(std::shared_ptr<gd::PlatformExtension> extension) {
   if (enableExtensionLoadingLogs) std::cout << std::endl;
 
   extensionsLoaded.push_back(extension);
+  InvalidateMetadataIndex();
 
   // Load all creation/destruction functions for objects provided by the
   // extension
@@ -61,6 +64,26 @@ void Platform::RemoveExtension(const gd::String& name) {
                   return extension->GetName() == name;
                 }),
       extensionsLoaded.end());
+  InvalidateMetadataIndex();
+}
+
+const gd::MetadataIndex& Platform::GetMetadataIndex() const {
+  gd::MetadataIndex* index = metadataIndex.load(std::memory_order_acquire);
+  if (index) return *index;
+
+  std::lock_guard<std::mutex> lock(metadataIndexMutex);
+  index = metadataIndex.load(std::memory_order_relaxed);
+  if (!index) {
+    index = new gd::MetadataIndex(*this);
+    metadataIndex.store(index, std::memory_order_release);
+  }
+
+  return *index;
+}
+
+void Platform::InvalidateMetadataIndex() {
+  std::lock_guard<std::mutex> lock(metadataIndexMutex);
+  delete metadataIndex.exchange(nullptr);
 }
 
 bool Platform::IsExtensionLoaded(const gd::String& name) const {
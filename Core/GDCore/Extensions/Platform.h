@@ -6,8 +6,10 @@
 
 #ifndef GDCORE_PLATFORM_H
 #define GDCORE_PLATFORM_H
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include "GDCore/String.h"
 
@@ -23,6 +25,7 @@ class BehaviorsSharedData;
 class PlatformExtension;
 class LayoutEditorCanvas;
 class ProjectExporter;
+class MetadataIndex;
 }  // namespace gd
 
 typedef std::function<std::unique_ptr<gd::Object>(gd::String name)>
@@ -123,6 +126,26 @@ class GD_CORE_API Platform {
    * anymore.
    */
   virtual void RemoveExtension(const gd::String& name);
+
+  /**
+   * \brief Get the index of the metadata of the extensions, used by
+   * gd::MetadataProvider to find metadata without going through all the
+   * extensions.
+   *
+   * The index is built the first time it's needed (this can be done by
+   * several threads at the same time), and is invalidated when an extension
+   * is added or removed.
+   */
+  const gd::MetadataIndex& GetMetadataIndex() const;
+
+  /**
+   * \brief Invalidate the index of the metadata of the extensions.
+   *
+   * \note This is done automatically when an extension is added or removed,
+   * but must be called if an extension already added to the platform is
+   * modified.
+   */
+  void InvalidateMetadataIndex();
   ///@}
 
   /** \name Factory method
@@ -176,8 +199,16 @@ class GD_CORE_API Platform {
 #endif
 
  private:
+  Platform(const Platform&) = delete;
+  Platform& operator=(const Platform&) = delete;
+
   std::vector<std::shared_ptr<PlatformExtension>>
       extensionsLoaded;  ///< Extensions of the platform
+  mutable std::atomic<gd::MetadataIndex*> metadataIndex;  ///< Owned index of
+                                                         ///< the metadata, or
+                                                         ///< nullptr if not
+                                                         ///< built yet.
+  mutable std::mutex metadataIndexMutex;  ///< Protect the build of the index.
   std::map<gd::String, CreateFunPtr>
       creationFunctionTable;  ///< Creation functions for objects
   bool enableExtensionLoadingLogs;
@@ -6,6 +6,7 @@
 
 #ifndef GDCORE_ABSTRACTFILESYSTEM
 #define GDCORE_ABSTRACTFILESYSTEM
+#include <cstdint>
 #include <vector>
 #include "GDCore/String.h"
 
@@ -123,6 +124,36 @@ class GD_CORE_API AbstractFileSystem {
   virtual std::vector<gd::String> ReadDir(const gd::String& path,
                                           const gd::String& extension = "") = 0;
 
+  /**
+   * \brief Get the size (in bytes) and the time of the last modification (in
+   * milliseconds) of a file.
+   *
+   * \return true if the operation succeeded. The default implementation returns
+   * false, meaning that the file system can't tell when files are modified.
+   */
+  virtual bool GetFileStats(const gd::String& file,
+                            std::uint64_t& size,
+                            std::int64_t& modificationTime) {
+    return false;
+  }
+
+  /**
+   * \brief Compute a hash of the content of a file.
+   *
+   * \return The hash of the file, or an empty string if the file can't be read
+   * (or if the file system does not support hashing files, which is the
+   * default).
+   */
+  virtual gd::String GetFileHash(const gd::String& file) { return ""; }
+
+  /**
+   * \brief Remove a file.
+   *
+   * \return true if the operation succeeded. The default implementation returns
+   * false, meaning that the file system can't remove files.
+   */
+  virtual bool RemoveFile(const gd::String& file) { return false; }
+
  protected:
   AbstractFileSystem(){};
 };
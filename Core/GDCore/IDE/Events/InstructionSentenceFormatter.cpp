@@ -48,7 +48,8 @@ InstructionSentenceFormatter::GetAsFormattedText(
   std::vector<std::pair<gd::String, gd::TextFormatting> > formattedStr;
 
   gd::String sentence = metadata.GetSentence();
-  std::replace(sentence.Raw().begin(), sentence.Raw().end(), '\n', ' ');
+  std::replace(
+      sentence.RawMutable().begin(), sentence.RawMutable().end(), '\n', ' ');
 
   size_t loopCount = 0;
   bool parse = true;
@@ -88,8 +89,8 @@ InstructionSentenceFormatter::GetAsFormattedText(
       format.userData = firstParamIndex;
 
       gd::String text = instr.GetParameter(firstParamIndex).GetPlainString();
-      std::replace(text.Raw().begin(),
-                   text.Raw().end(),
+      std::replace(text.RawMutable().begin(),
+                   text.RawMutable().end(),
                    '\n',
                    ' ');  // Using the raw std::string inside gd::String (no
                           // problems because it's only ANSI characters)
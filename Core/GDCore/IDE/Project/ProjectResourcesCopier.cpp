@@ -5,16 +5,80 @@
  */
 #include "ProjectResourcesCopier.h"
 #include <map>
+#include <set>
 #include "GDCore/CommonTools.h"
 #include "GDCore/IDE/AbstractFileSystem.h"
 #include "GDCore/IDE/Project/ResourcesAbsolutePathChecker.h"
 #include "GDCore/IDE/Project/ResourcesMergingHelper.h"
 #include "GDCore/Project/Project.h"
+#include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/Tools/Localization.h"
 #include "GDCore/Tools/Log.h"
 
 using namespace std;
 
+namespace {
+
+/**
+ * \brief Copy \a file to \a destination, unless the destination was
+ * made from the same file and the file is unchanged since.
+ *
+ * \param previousFileElement The description of the previous copy made to
+ * \a destination, or nullptr if there is none.
+ * \param manifest The manifest where the copy is described, if the file system
+ * can tell the size and modification time of the file.
+ *
+ * \return true if the destination is up-to-date.
+ */
+bool CopyFileIfChanged(gd::AbstractFileSystem& fs,
+                       const gd::String& file,
+                       const gd::String& destination,
+                       const gd::SerializerElement* previousFileElement,
+                       gd::SerializerElement& manifest) {
+  std::uint64_t size = 0;
+  std::int64_t modificationTime = 0;
+  if (!fs.GetFileStats(file, size, modificationTime))
+    return fs.CopyFile(file, destination);
+
+  // Sizes and times are stored as strings, as numbers of the manifest would
+  // be written with a limited precision.
+  gd::String sizeString = gd::String::From(size);
+  gd::String modificationTimeString = gd::String::From(modificationTime);
+
+  bool upToDate = false;
+  gd::String hash;
+  if (previousFileElement &&
+      previousFileElement->GetStringAttribute("source") == file &&
+      previousFileElement->GetStringAttribute("size") == sizeString &&
+      fs.FileExists(destination)) {
+    if (previousFileElement->GetStringAttribute("modificationTime") ==
+        modificationTimeString) {
+      upToDate = true;
+      hash = previousFileElement->GetStringAttribute("hash");
+    } else {
+      // The file was saved again, maybe without changes: compare its content
+      // with the content of the copy.
+      hash = fs.GetFileHash(file);
+      gd::String previousHash = previousFileElement->GetStringAttribute("hash");
+      if (previousHash.empty()) previousHash = fs.GetFileHash(destination);
+      upToDate = !hash.empty() && hash == previousHash;
+    }
+  }
+
+  if (!upToDate && !fs.CopyFile(file, destination)) return false;
+
+  gd::SerializerElement& fileElement = manifest.AddChild("file");
+  fileElement.SetAttribute("destination", destination);
+  fileElement.SetAttribute("source", file);
+  fileElement.SetAttribute("size", sizeString);
+  fileElement.SetAttribute("modificationTime", modificationTimeString);
+  fileElement.SetAttribute("hash", hash);
+  return true;
+}
+
+}  // namespace
+
 namespace gd {
 
 bool ProjectResourcesCopier::CopyAllResourcesTo(
@@ -23,7 +87,8 @@ bool ProjectResourcesCopier::CopyAllResourcesTo(
     gd::String destinationDirectory,
     bool updateOriginalProject,
     bool preserveAbsoluteFilenames,
-    bool preserveDirectoryStructure) {
+    bool preserveDirectoryStructure,
+    bool incrementalCopy) {
   // Check if there are some resources with absolute filenames
   gd::ResourcesAbsolutePathChecker absolutePathChecker(fs);
   originalProject.ExposeResources(absolutePathChecker);
@@ -47,6 +112,25 @@ bool ProjectResourcesCopier::CopyAllResourcesTo(
     project->ExposeResources(resourcesMergingHelper);
   }
 
+  // Read the files copied by a previous incremental copy
+  gd::String manifestFilename =
+      destinationDirectory + "/" + "resourcesManifest.json";
+  gd::SerializerElement previousManifest;
+  if (incrementalCopy && fs.FileExists(manifestFilename))
+    previousManifest = gd::Serializer::FromJSON(fs.ReadFile(manifestFilename));
+  previousManifest.ConsiderAsArrayOf("file");
+
+  std::map<gd::String, const gd::SerializerElement*> previousFileElements;
+  for (std::size_t i = 0; i < previousManifest.GetChildrenCount(); ++i) {
+    const gd::SerializerElement& fileElement = previousManifest.GetChild(i);
+    previousFileElements[fileElement.GetStringAttribute("destination")] =
+        &fileElement;
+  }
+
+  gd::SerializerElement manifest;
+  manifest.ConsiderAsArrayOf("file");
+  std::set<gd::String> destinationFiles;
+
   // Copy resources
   map<gd::String, gd::String>& resourcesNewFilename =
       resourcesMergingHelper.GetAllResourcesOldAndNewFilename();
@@ -65,7 +149,23 @@ bool ProjectResourcesCopier::CopyAllResourcesTo(
       if (!fs.DirExists(dir)) fs.MkDir(dir);
 
       // We can now copy the file
-      if (!fs.CopyFile(it->first, destinationFile)) {
+      destinationFiles.insert(destinationFile);
+      bool copied = false;
+      if (incrementalCopy) {
+        auto previousFileElement = previousFileElements.find(destinationFile);
+        copied = CopyFileIfChanged(
+            fs,
+            it->first,
+            destinationFile,
+            previousFileElement != previousFileElements.end()
+                ? previousFileElement->second
+                : nullptr,
+            manifest);
+      } else {
+        copied = fs.CopyFile(it->first, destinationFile);
+      }
+
+      if (!copied) {
         gd::LogWarning(_("Unable to copy \"") + it->first + _("\" to \"") +
                        destinationFile + _("\"."));
       }
@@ -74,6 +174,18 @@ bool ProjectResourcesCopier::CopyAllResourcesTo(
     ++i;
   }
 
+  if (incrementalCopy) {
+    // Remove the copies of the resources that are not used anymore.
+    for (const auto& previousFileElement : previousFileElements) {
+      const gd::String& previousFile = previousFileElement.first;
+      if (destinationFiles.find(previousFile) == destinationFiles.end() &&
+          fs.FileExists(previousFile))
+        fs.RemoveFile(previousFile);
+    }
+
+    fs.WriteToFile(manifestFilename, gd::Serializer::ToJSON(manifest));
+  }
+
   return true;
 }
 
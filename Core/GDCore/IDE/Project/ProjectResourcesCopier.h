@@ -39,6 +39,13 @@ class GD_CORE_API ProjectResourcesCopier {
    * of the resources will be preserved when copying. Otherwise, everything will
    * be send in the destinationDirectory.
    *
+   * \param incrementalCopy If set to true, the size, modification time and
+   * hash of the copied files are kept in a manifest in the destination
+   * directory, and files that are unchanged since the previous copy are not
+   * copied again. The copies of the resources not used anymore are removed:
+   * only use this for directories that are not modified by anything else than
+   * the copier (like a preview).
+   *
    * \return true if no error happened
    */
   static bool CopyAllResourcesTo(gd::Project& project,
@@ -46,7 +53,8 @@ class GD_CORE_API ProjectResourcesCopier {
                                  gd::String destinationDirectory,
                                  bool updateOriginalProject,
                                  bool preserveAbsoluteFilenames = true,
-                                 bool preserveDirectoryStructure = true);
+                                 bool preserveDirectoryStructure = true,
+                                 bool incrementalCopy = false);
 };
 
 }  // namespace gd
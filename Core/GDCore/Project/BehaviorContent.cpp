@@ -4,9 +4,20 @@
  * reserved. This project is released under the MIT License.
  */
 #include "GDCore/Project/BehaviorContent.h"
+#include "GDCore/Project/ObjectTypesCache.h"
 
 namespace gd {
 
 BehaviorContent::~BehaviorContent(){};
 
+void BehaviorContent::SetName(const gd::String& name_) {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
+  name = name_;
+}
+
+void BehaviorContent::SetTypeName(const gd::String& type_) {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
+  type = type_;
+}
+
 }  // namespace gd
@@ -44,7 +44,7 @@ class GD_CORE_API BehaviorContent {
   /**
    * \brief Change the name identifying the behavior
    */
-  virtual void SetName(const gd::String& name_) { name = name_; }
+  virtual void SetName(const gd::String& name_);
 
   /**
    * \brief Get the type of the behavior.
@@ -54,7 +54,7 @@ class GD_CORE_API BehaviorContent {
   /**
    * \brief Change the type of the behavior
    */
-  virtual void SetTypeName(const gd::String& type_) { type = type_; }
+  virtual void SetTypeName(const gd::String& type_);
 
 #if defined(GD_IDE_ONLY)
   /**
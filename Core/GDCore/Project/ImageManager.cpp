@@ -36,33 +36,56 @@ std::shared_ptr<SFMLTextureWrapper> ImageManager::GetSFMLTexture(
       !alreadyLoadedImages.find(name)->second.expired())
     return alreadyLoadedImages.find(name)->second.lock();
 
+  // Load only an image when necessary
+  std::shared_ptr<SFMLTextureWrapper> texture = DecodeImage(name);
+  if (!texture) return badTexture;
+
+  return LoadDecodedImage(name, texture);
+}
+
+std::shared_ptr<SFMLTextureWrapper> ImageManager::DecodeImage(
+    const gd::String& name) const {
+  if (!resourcesManager) {
+    std::cout << "ImageManager has no ResourcesManager associated with.";
+    return nullptr;
+  }
+
   std::cout << "ImageManager: Loading " << name << ".";
 
-  // Load only an image when necessary
   try {
     ImageResource& image =
         dynamic_cast<ImageResource&>(resourcesManager->GetResource(name));
 
     auto texture = std::make_shared<SFMLTextureWrapper>();
     ResourcesLoader::Get()->LoadSFMLImage(image.GetFile(), texture->image);
-    texture->texture.loadFromImage(texture->image);
-    texture->texture.setSmooth(image.smooth);
-
-    alreadyLoadedImages[name] = texture;
-#if defined(GD_IDE_ONLY)
-    if (preventUnloading)
-      unloadingPreventer.push_back(
-          texture);  // If unload prevention is activated, add the image to the
-                     // list dedicated to prevent images from being unloaded.
-#endif
-
+    texture->texture.setSmooth(image.smooth);  // Applied when the texture is
+                                               // created.
     return texture;
   } catch (...) {
   }
 
   std::cout << " Resource not found." << std::endl;
 
-  return badTexture;
+  return nullptr;
+}
+
+std::shared_ptr<SFMLTextureWrapper> ImageManager::LoadDecodedImage(
+    const gd::String& name, std::shared_ptr<SFMLTextureWrapper> texture) const {
+  if (alreadyLoadedImages.find(name) != alreadyLoadedImages.end() &&
+      !alreadyLoadedImages.find(name)->second.expired())
+    return alreadyLoadedImages.find(name)->second.lock();
+
+  texture->texture.loadFromImage(texture->image);
+
+  alreadyLoadedImages[name] = texture;
+#if defined(GD_IDE_ONLY)
+  if (preventUnloading)
+    unloadingPreventer.push_back(
+        texture);  // If unload prevention is activated, add the image to the
+                   // list dedicated to prevent images from being unloaded.
+#endif
+
+  return texture;
 }
 
 bool ImageManager::HasLoadedSFMLTexture(const gd::String& name) const {
@@ -63,6 +63,30 @@ class GD_CORE_API ImageManager {
   std::shared_ptr<SFMLTextureWrapper> GetSFMLTexture(
       const gd::String& name) const;
 
+  /**
+   * \brief Load the image called \a name in a new SFMLTextureWrapper, without
+   * creating its texture.
+   *
+   * Can be called from a thread other than the one using the ImageManager (for
+   * example to load the images of a scene in the background), as long as the
+   * resources are not modified meanwhile.
+   *
+   * \return The SFMLTextureWrapper holding the image, to be given to
+   * LoadDecodedImage, or nullptr if there is no image called \a name.
+   */
+  std::shared_ptr<SFMLTextureWrapper> DecodeImage(const gd::String& name) const;
+
+  /**
+   * \brief Create the texture of an image returned by DecodeImage, and make it
+   * available through GetSFMLTexture.
+   *
+   * \return The texture of the image, which is the one already loaded if the
+   * image was loaded since it was decoded.
+   */
+  std::shared_ptr<SFMLTextureWrapper> LoadDecodedImage(
+      const gd::String& name,
+      std::shared_ptr<SFMLTextureWrapper> texture) const;
+
   /**
    * \brief Set the gd::ResourcesManager used by the ImageManager.
    */
@@ -19,6 +19,7 @@
 #include "GDCore/Project/Object.h"
 #include "GDCore/Project/ObjectGroup.h"
 #include "GDCore/Project/ObjectGroupsContainer.h"
+#include "GDCore/Project/ObjectTypesCache.h"
 #include "GDCore/Project/Project.h"
 #include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/String.h"
@@ -408,6 +409,8 @@ void Layout::Init(const Layout& other) {
 
   profiler = other.profiler;
 #endif
+
+  gd::ObjectTypesCache::NotifyObjectsChanged();
 }
 
 std::vector<gd::String> GetHiddenLayers(const Layout& layout) {
@@ -426,92 +429,15 @@ gd::String GD_CORE_API GetTypeOfObject(const gd::ObjectsContainer& project,
                                        const gd::ObjectsContainer& layout,
                                        gd::String name,
                                        bool searchInGroups) {
-  gd::String type;
-
-  // Search in objects
-  if (layout.HasObjectNamed(name))
-    type = layout.GetObject(name).GetType();
-  else if (project.HasObjectNamed(name))
-    type = project.GetObject(name).GetType();
-
-  // Search in groups
-  if (searchInGroups) {
-    for (std::size_t i = 0; i < layout.GetObjectGroups().size(); ++i) {
-      if (layout.GetObjectGroups()[i].GetName() == name) {
-        // A group has the name searched
-        // Verifying now that all objects have the same type.
-
-        vector<gd::String> groupsObjects =
-            layout.GetObjectGroups()[i].GetAllObjectsNames();
-        gd::String previousType =
-            groupsObjects.empty()
-                ? ""
-                : GetTypeOfObject(project, layout, groupsObjects[0], false);
-
-        for (std::size_t j = 0; j < groupsObjects.size(); ++j) {
-          if (GetTypeOfObject(project, layout, groupsObjects[j], false) !=
-              previousType)
-            return "";  // The group has more than one type.
-        }
-
-        if (!type.empty() && previousType != type)
-          return "";  // The group has objects of different type, so the group
-                      // has not any type.
-
-        type = previousType;
-      }
-    }
-    for (std::size_t i = 0; i < project.GetObjectGroups().size(); ++i) {
-      if (project.GetObjectGroups()[i].GetName() == name) {
-        // A group has the name searched
-        // Verifying now that all objects have the same type.
-
-        vector<gd::String> groupsObjects =
-            project.GetObjectGroups()[i].GetAllObjectsNames();
-        gd::String previousType =
-            groupsObjects.empty()
-                ? ""
-                : GetTypeOfObject(project, layout, groupsObjects[0], false);
-
-        for (std::size_t j = 0; j < groupsObjects.size(); ++j) {
-          if (GetTypeOfObject(project, layout, groupsObjects[j], false) !=
-              previousType)
-            return "";  // The group has more than one type.
-        }
-
-        if (!type.empty() && previousType != type)
-          return "";  // The group has objects of different type, so the group
-                      // has not any type.
-
-        type = previousType;
-      }
-    }
-  }
-
-  return type;
+  return layout.GetTypesCache().GetTypeOfObject(
+      project, layout, name, searchInGroups);
 }
 
 gd::String GD_CORE_API GetTypeOfBehavior(const gd::ObjectsContainer& project,
                                          const gd::ObjectsContainer& layout,
                                          gd::String name,
                                          bool searchInGroups) {
-  for (std::size_t i = 0; i < layout.GetObjectsCount(); ++i) {
-    vector<gd::String> behaviors = layout.GetObject(i).GetAllBehaviorNames();
-    for (std::size_t j = 0; j < behaviors.size(); ++j) {
-      if (layout.GetObject(i).GetBehavior(behaviors[j]).GetName() == name)
-        return layout.GetObject(i).GetBehavior(behaviors[j]).GetTypeName();
-    }
-  }
-
-  for (std::size_t i = 0; i < project.GetObjectsCount(); ++i) {
-    vector<gd::String> behaviors = project.GetObject(i).GetAllBehaviorNames();
-    for (std::size_t j = 0; j < behaviors.size(); ++j) {
-      if (project.GetObject(i).GetBehavior(behaviors[j]).GetName() == name)
-        return project.GetObject(i).GetBehavior(behaviors[j]).GetTypeName();
-    }
-  }
-
-  return "";
+  return layout.GetTypesCache().GetTypeOfBehavior(project, layout, name);
 }
 
 vector<gd::String> GD_CORE_API
@@ -7,6 +7,7 @@
 #include "GDCore/Extensions/Platform.h"
 #include "GDCore/Project/Behavior.h"
 #include "GDCore/Project/Layout.h"
+#include "GDCore/Project/ObjectTypesCache.h"
 #include "GDCore/Project/Project.h"
 #include "GDCore/Serialization/SerializerElement.h"
 #if defined(GD_IDE_ONLY)
@@ -20,6 +21,7 @@ Object::~Object() {}
 Object::Object(const gd::String& name_) : name(name_) {}
 
 void Object::Init(const gd::Object& object) {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
   name = object.name;
   type = object.type;
   objectVariables = object.objectVariables;
@@ -31,6 +33,16 @@ void Object::Init(const gd::Object& object) {
   }
 }
 
+void Object::SetName(const gd::String& name_) {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
+  name = name_;
+}
+
+void Object::SetType(const gd::String& type_) {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
+  type = type_;
+}
+
 std::vector<gd::String> Object::GetAllBehaviorNames() const {
   std::vector<gd::String> allNameIdentifiers;
 
@@ -39,13 +51,17 @@ std::vector<gd::String> Object::GetAllBehaviorNames() const {
   return allNameIdentifiers;
 }
 
-void Object::RemoveBehavior(const gd::String& name) { behaviors.erase(name); }
+void Object::RemoveBehavior(const gd::String& name) {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
+  behaviors.erase(name);
+}
 
 bool Object::RenameBehavior(const gd::String& name, const gd::String& newName) {
   if (behaviors.find(name) == behaviors.end() ||
       behaviors.find(newName) != behaviors.end())
     return false;
 
+  gd::ObjectTypesCache::NotifyObjectsChanged();
   std::unique_ptr<BehaviorContent> aut =
       std::move(behaviors.find(name)->second);
   behaviors.erase(name);
@@ -69,6 +85,7 @@ bool Object::HasBehaviorNamed(const gd::String& name) const {
 
 gd::BehaviorContent& Object::AddBehavior(
     const gd::BehaviorContent& behaviorContent) {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
   const gd::String& behaviorName = behaviorContent.GetName();
   auto newBehaviorContent =
       gd::make_unique<gd::BehaviorContent>(behaviorContent);
@@ -88,6 +105,7 @@ gd::BehaviorContent* Object::AddNewBehavior(gd::Project& project,
   gd::Behavior* behavior = project.GetCurrentPlatform().GetBehavior(type);
 
   if (behavior) {
+    gd::ObjectTypesCache::NotifyObjectsChanged();
     auto behaviorContent = gd::make_unique<gd::BehaviorContent>(name, type);
     behavior->InitializeContent(behaviorContent->GetContent());
     behaviors[name] = std::move(behaviorContent);
@@ -108,6 +126,7 @@ Object::GetInitialInstanceProperties(const gd::InitialInstance& instance,
 
 void Object::UnserializeFrom(gd::Project& project,
                              const SerializerElement& element) {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
   type = element.GetStringAttribute("type");
   name = element.GetStringAttribute("name", name, "nom");
   tags = element.GetStringAttribute("tags");
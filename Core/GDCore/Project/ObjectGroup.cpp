@@ -7,6 +7,7 @@
 #include "ObjectGroup.h"
 #include <algorithm>
 #include <vector>
+#include "GDCore/Project/ObjectTypesCache.h"
 #include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/String.h"
 
@@ -19,11 +20,18 @@ bool ObjectGroup::Find(const gd::String& name) const {
          memberObjects.end();
 }
 
+void ObjectGroup::SetName(const gd::String& name_) {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
+  name = name_;
+}
+
 void ObjectGroup::AddObject(const gd::String& name) {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
   if (!Find(name)) memberObjects.push_back(name);
 }
 
 void ObjectGroup::RemoveObject(const gd::String& name) {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
   memberObjects.erase(
       std::remove(memberObjects.begin(), memberObjects.end(), name),
       memberObjects.end());
@@ -31,6 +39,7 @@ void ObjectGroup::RemoveObject(const gd::String& name) {
 
 void ObjectGroup::RenameObject(const gd::String& oldName,
                                const gd::String& newName) {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
   for (auto& object : memberObjects) {
     if (object == oldName) object = newName;
   }
@@ -54,7 +54,7 @@ class GD_CORE_API ObjectGroup {
 
   /** \brief Change group name
    */
-  inline void SetName(const gd::String& name_) { name = name_; };
+  void SetName(const gd::String& name_);
 
   /**
    * \brief Get a vector with objects names.
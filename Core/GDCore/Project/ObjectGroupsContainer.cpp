@@ -6,6 +6,7 @@
 
 #include "GDCore/Project/ObjectGroupsContainer.h"
 #include "GDCore/Project/ObjectGroup.h"
+#include "GDCore/Project/ObjectTypesCache.h"
 #include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/String.h"
 
@@ -55,6 +56,7 @@ const ObjectGroup& ObjectGroupsContainer::Get(const gd::String& name) const {
 
 ObjectGroup& ObjectGroupsContainer::Insert(const gd::ObjectGroup& group,
                                            std::size_t position) {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
   if (position < objectGroups.size()) {
     objectGroups.insert(objectGroups.begin() + position, group);
     return objectGroups[position];
@@ -66,6 +68,7 @@ ObjectGroup& ObjectGroupsContainer::Insert(const gd::ObjectGroup& group,
 
 #if defined(GD_IDE_ONLY)
 void ObjectGroupsContainer::Remove(const gd::String& name) {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
   objectGroups.erase(std::remove_if(objectGroups.begin(),
                                     objectGroups.end(),
                                     [&name](const ObjectGroup& group) {
@@ -113,6 +116,11 @@ void ObjectGroupsContainer::Move(std::size_t oldIndex, std::size_t newIndex) {
 }
 #endif
 
+void ObjectGroupsContainer::Clear() {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
+  objectGroups.clear();
+}
+
 void ObjectGroupsContainer::SerializeTo(SerializerElement& element) const {
   element.ConsiderAsArrayOf("group");
   for (auto& group : objectGroups) {
@@ -122,6 +130,7 @@ void ObjectGroupsContainer::SerializeTo(SerializerElement& element) const {
 }
 
 void ObjectGroupsContainer::UnserializeFrom(const SerializerElement& element) {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
   objectGroups.clear();
   element.ConsiderAsArrayOf("group", "Groupe");
   for (std::size_t i = 0; i < element.GetChildrenCount(); ++i) {
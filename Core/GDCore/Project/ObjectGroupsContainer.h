@@ -112,7 +112,7 @@ class GD_CORE_API ObjectGroupsContainer {
   /**
    * \brief Clear all groups of the container.
    */
-  inline void Clear() { objectGroups.clear(); }
+  void Clear();
   ///@}
 
   /** \name Saving and loading
@@ -0,0 +1,116 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCore/Project/ObjectTypesCache.h"
+#include "GDCore/Project/BehaviorContent.h"
+#include "GDCore/Project/Object.h"
+#include "GDCore/Project/ObjectGroup.h"
+#include "GDCore/Project/ObjectGroupsContainer.h"
+#include "GDCore/Project/ObjectsContainer.h"
+
+namespace gd {
+
+namespace {
+const gd::String noType;
+}
+
+std::atomic<std::size_t> ObjectTypesCache::revision(0);
+
+ObjectTypesCache::ObjectTypesCache()
+    : cachedGlobalObjects(nullptr), cachedRevision(0) {}
+
+void ObjectTypesCache::NotifyObjectsChanged() { ++revision; }
+
+gd::String ObjectTypesCache::GetTypeOfObject(
+    const gd::ObjectsContainer& globalObjects,
+    const gd::ObjectsContainer& objects,
+    const gd::String& name,
+    bool searchInGroups) {
+  std::lock_guard<std::mutex> lock(mutex);
+  Update(globalObjects, objects);
+  if (!searchInGroups) return FindObjectType(name);
+
+  auto it = objectOrGroupTypes.find(name);
+  if (it != objectOrGroupTypes.end()) return it->second;
+
+  gd::String type = ComputeTypeOfObjectOrGroup(globalObjects, objects, name);
+  objectOrGroupTypes[name] = type;
+  return type;
+}
+
+gd::String ObjectTypesCache::GetTypeOfBehavior(
+    const gd::ObjectsContainer& globalObjects,
+    const gd::ObjectsContainer& objects,
+    const gd::String& name) {
+  std::lock_guard<std::mutex> lock(mutex);
+  Update(globalObjects, objects);
+
+  auto it = behaviorTypes.find(name);
+  return it != behaviorTypes.end() ? it->second : noType;
+}
+
+void ObjectTypesCache::Update(const gd::ObjectsContainer& globalObjects,
+                              const gd::ObjectsContainer& objects) {
+  std::size_t currentRevision = revision;
+  if (cachedGlobalObjects == &globalObjects &&
+      cachedRevision == currentRevision)
+    return;
+
+  cachedGlobalObjects = &globalObjects;
+  cachedRevision = currentRevision;
+  objectTypes.clear();
+  objectOrGroupTypes.clear();
+  behaviorTypes.clear();
+
+  // The objects of the container are searched before the global ones, so
+  // that they hide global objects (or behaviors) with the same name.
+  for (const gd::ObjectsContainer* container : {&objects, &globalObjects}) {
+    for (auto& object : container->GetObjects()) {
+      objectTypes.emplace(object->GetName(), object->GetType());
+      for (auto& it : object->GetAllBehaviorContents())
+        behaviorTypes.emplace(it.second->GetName(), it.second->GetTypeName());
+    }
+  }
+}
+
+gd::String ObjectTypesCache::ComputeTypeOfObjectOrGroup(
+    const gd::ObjectsContainer& globalObjects,
+    const gd::ObjectsContainer& objects,
+    const gd::String& name) const {
+  gd::String type = FindObjectType(name);
+  for (const gd::ObjectsContainer* container : {&objects, &globalObjects}) {
+    const gd::ObjectGroupsContainer& groups = container->GetObjectGroups();
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+      if (groups[i].GetName() != name) continue;
+
+      // A group has the name searched: all its objects must have the same
+      // type for the group to have a type.
+      const std::vector<gd::String>& groupObjects =
+          groups[i].GetAllObjectsNames();
+      const gd::String& groupType =
+          groupObjects.empty() ? noType : FindObjectType(groupObjects[0]);
+      for (auto& objectName : groupObjects) {
+        if (FindObjectType(objectName) != groupType)
+          return "";  // The group has more than one type.
+      }
+
+      if (!type.empty() && groupType != type)
+        return "";  // The group has objects of a different type than the
+                    // object (or other group) with the same name.
+
+      type = groupType;
+    }
+  }
+
+  return type;
+}
+
+const gd::String& ObjectTypesCache::FindObjectType(
+    const gd::String& name) const {
+  auto it = objectTypes.find(name);
+  return it != objectTypes.end() ? it->second : noType;
+}
+
+}  // namespace gd
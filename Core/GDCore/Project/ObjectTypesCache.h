@@ -0,0 +1,101 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCORE_OBJECTTYPESCACHE_H
+#define GDCORE_OBJECTTYPESCACHE_H
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include "GDCore/String.h"
+namespace gd {
+class ObjectsContainer;
+}
+
+namespace gd {
+
+/**
+ * \brief Remember the types of the objects, groups and behaviors of a pair of
+ * objects containers (usually the project and a layout), so that
+ * gd::GetTypeOfObject and gd::GetTypeOfBehavior don't have to go through all
+ * the objects and groups for each call.
+ *
+ * Each gd::ObjectsContainer owns the cache used for the lookups where it is the
+ * (layout) container, see gd::ObjectsContainer::GetTypesCache.
+ *
+ * Objects, groups, behaviors and their containers call NotifyObjectsChanged
+ * when they are modified: all the caches are then invalidated and rebuilt
+ * on their next lookup.
+ *
+ * \see gd::GetTypeOfObject
+ * \see gd::GetTypeOfBehavior
+ */
+class GD_CORE_API ObjectTypesCache {
+ public:
+  ObjectTypesCache();
+  virtual ~ObjectTypesCache(){};
+
+  /**
+   * \brief Return the type of the object or group called \a name, or an empty
+   * string if not found (or if the objects of the group have different types).
+   *
+   * \see gd::GetTypeOfObject
+   */
+  gd::String GetTypeOfObject(const gd::ObjectsContainer& globalObjects,
+                             const gd::ObjectsContainer& objects,
+                             const gd::String& name,
+                             bool searchInGroups);
+
+  /**
+   * \brief Return the type of the behavior called \a name, or an empty string
+   * if no object has such a behavior.
+   *
+   * \see gd::GetTypeOfBehavior
+   */
+  gd::String GetTypeOfBehavior(const gd::ObjectsContainer& globalObjects,
+                               const gd::ObjectsContainer& objects,
+                               const gd::String& name);
+
+  /**
+   * \brief Invalidate all the caches. To be called when objects, groups or
+   * behaviors are added, removed, renamed or have their type changed.
+   */
+  static void NotifyObjectsChanged();
+
+ private:
+  /**
+   * \brief Rebuild the tables if objects were changed since they were built,
+   * or if they were built for other containers.
+   */
+  void Update(const gd::ObjectsContainer& globalObjects,
+              const gd::ObjectsContainer& objects);
+
+  gd::String ComputeTypeOfObjectOrGroup(
+      const gd::ObjectsContainer& globalObjects,
+      const gd::ObjectsContainer& objects,
+      const gd::String& name) const;
+
+  const gd::String& FindObjectType(const gd::String& name) const;
+
+  const gd::ObjectsContainer* cachedGlobalObjects;  ///< The global objects
+                                                    ///< the tables were built
+                                                    ///< with.
+  std::size_t cachedRevision;  ///< The revision the tables were built at.
+  std::unordered_map<gd::String, gd::String> objectTypes;
+  std::unordered_map<gd::String, gd::String>
+      objectOrGroupTypes;  ///< Filled on demand, as computing the type of a
+                           ///< group requires to check all its objects.
+  std::unordered_map<gd::String, gd::String> behaviorTypes;
+  std::mutex mutex;
+
+  static std::atomic<std::size_t> revision;  ///< Incremented at each change
+                                             ///< of objects or groups.
+
+  ObjectTypesCache(const ObjectTypesCache&) = delete;
+  ObjectTypesCache& operator=(const ObjectTypesCache&) = delete;
+};
+
+}  // namespace gd
+
+#endif  // GDCORE_OBJECTTYPESCACHE_H
@@ -7,14 +7,18 @@
 #include <algorithm>
 #include "GDCore/Extensions/Platform.h"
 #include "GDCore/Project/Object.h"
+#include "GDCore/Project/ObjectTypesCache.h"
 #include "GDCore/Project/Project.h"
 #include "GDCore/Serialization/SerializerElement.h"
 
 namespace gd {
 
-ObjectsContainer::ObjectsContainer() {}
+ObjectsContainer::ObjectsContainer()
+    : typesCache(new gd::ObjectTypesCache) {}
 
-ObjectsContainer::~ObjectsContainer() {}
+ObjectsContainer::~ObjectsContainer() {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
+}
 
 #if defined(GD_IDE_ONLY)
 void ObjectsContainer::SerializeObjectsTo(SerializerElement& element) const {
@@ -27,6 +31,7 @@ void ObjectsContainer::SerializeObjectsTo(SerializerElement& element) const {
 
 void ObjectsContainer::UnserializeObjectsFrom(
     gd::Project& project, const SerializerElement& element) {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
   initialObjects.clear();
   element.ConsiderAsArrayOf("object", "Objet");
   for (std::size_t i = 0; i < element.GetChildrenCount(); ++i) {
@@ -66,6 +71,10 @@ gd::Object& ObjectsContainer::GetObject(std::size_t index) {
 const gd::Object& ObjectsContainer::GetObject(std::size_t index) const {
   return *initialObjects[index];
 }
+std::vector<std::unique_ptr<gd::Object> >& ObjectsContainer::GetObjects() {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
+  return initialObjects;
+}
 std::size_t ObjectsContainer::GetObjectPosition(const gd::String& name) const {
   for (std::size_t i = 0; i < initialObjects.size(); ++i) {
     if (initialObjects[i]->GetName() == name) return i;
@@ -80,6 +89,7 @@ gd::Object& ObjectsContainer::InsertNewObject(gd::Project& project,
                                               const gd::String& objectType,
                                               const gd::String& name,
                                               std::size_t position) {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
   gd::Object& newlyCreatedObject = *(*(initialObjects.insert(
       position < initialObjects.size() ? initialObjects.begin() + position
                                        : initialObjects.end(),
@@ -91,6 +101,7 @@ gd::Object& ObjectsContainer::InsertNewObject(gd::Project& project,
 
 gd::Object& ObjectsContainer::InsertObject(const gd::Object& object,
                                            std::size_t position) {
+  gd::ObjectTypesCache::NotifyObjectsChanged();
   gd::Object& newlyCreatedObject = *(*(initialObjects.insert(
       position < initialObjects.size() ? initialObjects.begin() + position
                                        : initialObjects.end(),
@@ -105,6 +116,7 @@ void ObjectsContainer::SwapObjects(std::size_t firstObjectIndex,
       secondObjectIndex >= initialObjects.size())
     return;
 
+  gd::ObjectTypesCache::NotifyObjectsChanged();
   std::iter_swap(initialObjects.begin() + firstObjectIndex,
                  initialObjects.begin() + secondObjectIndex);
 }
@@ -113,6 +125,7 @@ void ObjectsContainer::MoveObject(std::size_t oldIndex, std::size_t newIndex) {
   if (oldIndex >= initialObjects.size() || newIndex >= initialObjects.size())
     return;
 
+  gd::ObjectTypesCache::NotifyObjectsChanged();
   std::unique_ptr<gd::Object> object = std::move(initialObjects[oldIndex]);
   initialObjects.erase(initialObjects.begin() + oldIndex);
   initialObjects.insert(initialObjects.begin() + newIndex, std::move(object));
@@ -125,6 +138,7 @@ void ObjectsContainer::RemoveObject(const gd::String& name) {
               bind2nd(ObjectHasName(), name));
   if (objectIt == initialObjects.end()) return;
 
+  gd::ObjectTypesCache::NotifyObjectsChanged();
   initialObjects.erase(objectIt);
 }
 
@@ -138,6 +152,7 @@ void ObjectsContainer::MoveObjectToAnotherContainer(
               bind2nd(ObjectHasName(), name));
   if (objectIt == initialObjects.end()) return;
 
+  gd::ObjectTypesCache::NotifyObjectsChanged();
   std::unique_ptr<gd::Object> object = std::move(*objectIt);
   initialObjects.erase(objectIt);
 
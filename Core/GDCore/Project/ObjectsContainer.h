@@ -11,6 +11,7 @@
 #include "GDCore/Project/ObjectGroupsContainer.h"
 namespace gd {
 class Object;
+class ObjectTypesCache;
 class Project;
 class SerializerElement;
 }
@@ -142,10 +143,10 @@ class GD_CORE_API ObjectsContainer {
 
   /**
    * Provide a raw access to the vector containing the objects
+   * \note As the vector can be modified, this invalidates the types cache
+   * (see GetTypesCache).
    */
-  std::vector<std::unique_ptr<gd::Object> >& GetObjects() {
-    return initialObjects;
-  }
+  std::vector<std::unique_ptr<gd::Object> >& GetObjects();
 
   /**
    * Provide a raw access to the vector containing the objects
@@ -186,6 +187,13 @@ class GD_CORE_API ObjectsContainer {
    * \brief Return a const reference to the project's objects groups.
    */
   const ObjectGroupsContainer& GetObjectGroups() const { return objectGroups; }
+
+  /**
+   * \brief Return the cache of the types of objects, groups and behaviors
+   * used by gd::GetTypeOfObject and gd::GetTypeOfBehavior when this container
+   * is the layout.
+   */
+  gd::ObjectTypesCache& GetTypesCache() const { return *typesCache; }
 #endif
 
   ///@}
@@ -194,6 +202,9 @@ class GD_CORE_API ObjectsContainer {
   std::vector<std::unique_ptr<gd::Object> >
       initialObjects;  ///< Objects contained.
   gd::ObjectGroupsContainer objectGroups;
+
+ private:
+  std::unique_ptr<gd::ObjectTypesCache> typesCache;
 };
 
 }  // namespace gd
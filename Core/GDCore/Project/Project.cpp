@@ -29,6 +29,7 @@
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Object.h"
 #include "GDCore/Project/ObjectGroupsContainer.h"
+#include "GDCore/Project/ObjectTypesCache.h"
 #include "GDCore/Project/ResourcesManager.h"
 #include "GDCore/Project/SourceFile.h"
 #include "GDCore/Serialization/Serializer.h"
@@ -1111,6 +1112,7 @@ void Project::Init(const gd::Project& game) {
   imageManager->SetResourcesManager(&resourcesManager);
 
   initialObjects = gd::Clone(game.initialObjects);
+  gd::ObjectTypesCache::NotifyObjectsChanged();
 
   scenes = gd::Clone(game.scenes);
 
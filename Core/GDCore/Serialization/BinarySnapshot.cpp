@@ -0,0 +1,505 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#include "GDCore/Serialization/BinarySnapshot.h"
+#include <cmath>
+#include <cstring>
+#include <ostream>
+#include <utility>
+
+namespace gd {
+
+namespace {
+const char magic[] = {'G', 'D', 'S', 'N'};
+const char formatVersion = 1;
+
+/**
+ * The types of the values, stored before each value.
+ */
+enum ValueType {
+  TYPE_NULL = 0,
+  TYPE_FALSE = 1,
+  TYPE_TRUE = 2,
+  TYPE_INT = 3,               ///< An int (OnInt), as a varint.
+  TYPE_INTEGRAL_NUMBER = 4,  ///< A double having an integral value, as a
+                             ///< varint.
+  TYPE_NUMBER = 5,           ///< A double, as 8 bytes.
+  TYPE_STRING = 6,
+  TYPE_OBJECT = 7,
+  TYPE_ARRAY = 8
+};
+
+/**
+ * Size of the header of an object or array: the size of its content and the
+ * number of children.
+ */
+const std::size_t containerHeaderSize = 8;
+
+void AppendVarint(std::string& str, std::uint64_t value) {
+  while (value >= 0x80) {
+    str.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  str.push_back(static_cast<char>(value));
+}
+
+std::uint64_t ZigZagEncode(std::int64_t value) {
+  return (static_cast<std::uint64_t>(value) << 1) ^
+         static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t ZigZagDecode(std::uint64_t value) {
+  return static_cast<std::int64_t>(value >> 1) ^
+         -static_cast<std::int64_t>(value & 1);
+}
+
+void StoreUInt32(char* destination, std::uint32_t value) {
+  for (int i = 0; i < 4; ++i)
+    destination[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+}  // namespace
+
+BinarySnapshotWriter::BinarySnapshotWriter() {}
+
+void BinarySnapshotWriter::WriteStringIndex(const char* str,
+                                            std::size_t length) {
+  std::pair<std::unordered_map<std::string, std::uint32_t>::iterator, bool>
+      insertion = stringsIndices.insert(
+          std::make_pair(std::string(str, length), strings.size()));
+  if (insertion.second) strings.push_back(&insertion.first->first);
+
+  AppendVarint(values, insertion.first->second);
+}
+
+void BinarySnapshotWriter::BeginContainer(char type) {
+  if (!childrenCounts.empty()) childrenCounts.back()++;
+
+  values.push_back(type);
+  containersStarts.push_back(values.size());
+  childrenCounts.push_back(0);
+  values.append(containerHeaderSize, '\0');
+}
+
+void BinarySnapshotWriter::EndContainer() {
+  // The size and the number of children are only known now.
+  std::size_t start = containersStarts.back();
+  std::size_t contentSize = values.size() - start - containerHeaderSize;
+  StoreUInt32(&values[start], contentSize);
+  StoreUInt32(&values[start + 4], childrenCounts.back());
+
+  containersStarts.pop_back();
+  childrenCounts.pop_back();
+}
+
+bool BinarySnapshotWriter::OnBeginObject() {
+  BeginContainer(TYPE_OBJECT);
+  return true;
+}
+
+bool BinarySnapshotWriter::OnKey(const char* key, std::size_t length) {
+  WriteStringIndex(key, length);
+  return true;
+}
+
+bool BinarySnapshotWriter::OnEndObject() {
+  EndContainer();
+  return values.size() <= 0xFFFFFFFF;
+}
+
+bool BinarySnapshotWriter::OnBeginArray() {
+  BeginContainer(TYPE_ARRAY);
+  return true;
+}
+
+bool BinarySnapshotWriter::OnEndArray() {
+  EndContainer();
+  return values.size() <= 0xFFFFFFFF;
+}
+
+bool BinarySnapshotWriter::OnString(const char* value, std::size_t length) {
+  if (!childrenCounts.empty()) childrenCounts.back()++;
+
+  values.push_back(TYPE_STRING);
+  WriteStringIndex(value, length);
+  return true;
+}
+
+bool BinarySnapshotWriter::OnNumber(double value) {
+  if (!childrenCounts.empty()) childrenCounts.back()++;
+
+  // Most numbers are integers, which are stored as varints (-0 is kept as a
+  // double to be restored exactly).
+  if (value > -9007199254740992.0 && value < 9007199254740992.0 &&
+      value == std::floor(value) && !(value == 0 && std::signbit(value))) {
+    values.push_back(TYPE_INTEGRAL_NUMBER);
+    AppendVarint(values, ZigZagEncode(static_cast<std::int64_t>(value)));
+    return true;
+  }
+
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  values.push_back(TYPE_NUMBER);
+  for (int i = 0; i < 8; ++i)
+    values.push_back(static_cast<char>((bits >> (8 * i)) & 0xFF));
+  return true;
+}
+
+bool BinarySnapshotWriter::OnInt(int value) {
+  if (!childrenCounts.empty()) childrenCounts.back()++;
+
+  values.push_back(TYPE_INT);
+  AppendVarint(values, ZigZagEncode(value));
+  return true;
+}
+
+bool BinarySnapshotWriter::OnBool(bool value) {
+  if (!childrenCounts.empty()) childrenCounts.back()++;
+
+  values.push_back(value ? TYPE_TRUE : TYPE_FALSE);
+  return true;
+}
+
+bool BinarySnapshotWriter::OnNull() {
+  if (!childrenCounts.empty()) childrenCounts.back()++;
+
+  values.push_back(TYPE_NULL);
+  return true;
+}
+
+std::string BinarySnapshotWriter::WriteHeader() const {
+  std::string header(magic, sizeof(magic));
+  header.push_back(formatVersion);
+
+  AppendVarint(header, strings.size());
+  for (std::size_t i = 0; i < strings.size(); ++i) {
+    AppendVarint(header, strings[i]->size());
+    header.append(*strings[i]);
+  }
+
+  return header;
+}
+
+void BinarySnapshotWriter::Write(std::ostream& stream) const {
+  std::string header = WriteHeader();
+  stream.write(header.data(), header.size());
+  stream.write(values.data(), values.size());
+}
+
+void BinarySnapshotWriter::Write(std::string& snapshot) const {
+  snapshot = WriteHeader();
+  snapshot.append(values);
+}
+
+BinarySnapshot::BinarySnapshot(const char* data_, std::size_t size_)
+    : data(data_), size(size_), valid(false), rootPosition(0) {
+  if (size < sizeof(magic) + 1 ||
+      std::memcmp(data, magic, sizeof(magic)) != 0 ||
+      data[sizeof(magic)] != formatVersion)
+    return;
+
+  std::size_t position = sizeof(magic) + 1;
+  std::uint64_t stringsCount;
+  if (!ReadVarint(position, stringsCount)) return;
+  if (stringsCount > size - position) return;  // Each string takes 1 byte.
+
+  stringsPositions.reserve(stringsCount);
+  stringsLengths.reserve(stringsCount);
+  for (std::uint64_t i = 0; i < stringsCount; ++i) {
+    std::uint64_t length;
+    if (!ReadVarint(position, length) || length > size - position) return;
+
+    stringsPositions.push_back(position);
+    stringsLengths.push_back(length);
+    position += length;
+  }
+
+  rootPosition = position;
+  valid = rootPosition < size;
+}
+
+BinarySnapshotElement BinarySnapshot::GetRoot() const {
+  if (!valid) return BinarySnapshotElement();
+
+  return BinarySnapshotElement(
+      this, rootPosition, BinarySnapshotElement::noNameIndex);
+}
+
+bool BinarySnapshot::ReadVarint(std::size_t& position,
+                                std::uint64_t& value) const {
+  value = 0;
+  for (unsigned int shift = 0; shift < 64; shift += 7) {
+    if (position >= size) return false;
+
+    unsigned char byte = static_cast<unsigned char>(data[position++]);
+    value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) return true;
+  }
+
+  return false;
+}
+
+bool BinarySnapshot::ReadUInt32(std::size_t& position,
+                                std::uint32_t& value) const {
+  if (size - position < 4) return false;
+
+  value = 0;
+  for (int i = 0; i < 4; ++i)
+    value |= static_cast<std::uint32_t>(
+                 static_cast<unsigned char>(data[position + i]))
+             << (8 * i);
+  position += 4;
+  return true;
+}
+
+bool BinarySnapshot::ReadStringIndex(std::size_t& position,
+                                     std::uint32_t& index) const {
+  std::uint64_t value;
+  if (!ReadVarint(position, value) || value >= stringsPositions.size())
+    return false;
+
+  index = value;
+  return true;
+}
+
+gd::String BinarySnapshot::GetString(std::uint32_t index) const {
+  gd::String str;
+  str.RawMutable().assign(data + stringsPositions[index], stringsLengths[index]);
+  if (!::utf8::is_valid(str.Raw().begin(), str.Raw().end()))
+    str.ReplaceInvalid();
+
+  return str;
+}
+
+std::size_t BinarySnapshot::SkipValue(std::size_t position) const {
+  if (position >= size) return 0;
+
+  std::uint64_t varint;
+  std::uint32_t index;
+  switch (data[position++]) {
+    case TYPE_NULL:
+    case TYPE_FALSE:
+    case TYPE_TRUE:
+      return position;
+    case TYPE_INT:
+    case TYPE_INTEGRAL_NUMBER:
+      return ReadVarint(position, varint) ? position : 0;
+    case TYPE_NUMBER:
+      return size - position >= 8 ? position + 8 : 0;
+    case TYPE_STRING:
+      return ReadStringIndex(position, index) ? position : 0;
+    case TYPE_OBJECT:
+    case TYPE_ARRAY: {
+      std::uint32_t contentSize, childrenCount;
+      if (!ReadUInt32(position, contentSize) ||
+          !ReadUInt32(position, childrenCount) ||
+          contentSize > size - position)
+        return 0;
+
+      return position + contentSize;
+    }
+    default:
+      return 0;
+  }
+}
+
+gd::String BinarySnapshotElement::GetName() const {
+  if (!snapshot || nameIndex == noNameIndex) return "";
+
+  return snapshot->GetString(nameIndex);
+}
+
+char BinarySnapshotElement::GetContainerType() const {
+  if (!snapshot) return 0;
+
+  char type = snapshot->data[position];
+  return type == TYPE_OBJECT || type == TYPE_ARRAY ? type : 0;
+}
+
+bool BinarySnapshotElement::IsValueUndefined() const {
+  return !snapshot || GetContainerType() != 0;
+}
+
+bool BinarySnapshotElement::ConsideredAsArray() const {
+  return GetContainerType() == TYPE_ARRAY;
+}
+
+SerializerValue BinarySnapshotElement::GetValue() const {
+  if (!snapshot) return SerializerValue();
+
+  std::size_t valuePosition = position + 1;
+  std::uint64_t varint;
+  std::uint32_t index;
+  switch (snapshot->data[position]) {
+    case TYPE_NULL:
+      // null was always unserialized as the number 0 (see gd::Serializer).
+      return SerializerValue(0.0);
+    case TYPE_FALSE:
+      return SerializerValue(false);
+    case TYPE_TRUE:
+      return SerializerValue(true);
+    case TYPE_INT:
+      if (!snapshot->ReadVarint(valuePosition, varint)) break;
+      return SerializerValue(static_cast<int>(ZigZagDecode(varint)));
+    case TYPE_INTEGRAL_NUMBER:
+      if (!snapshot->ReadVarint(valuePosition, varint)) break;
+      return SerializerValue(static_cast<double>(ZigZagDecode(varint)));
+    case TYPE_NUMBER: {
+      if (snapshot->size - valuePosition < 8) break;
+
+      std::uint64_t bits = 0;
+      for (int i = 0; i < 8; ++i)
+        bits |= static_cast<std::uint64_t>(static_cast<unsigned char>(
+                    snapshot->data[valuePosition + i]))
+                << (8 * i);
+      double value;
+      std::memcpy(&value, &bits, sizeof(value));
+      return SerializerValue(value);
+    }
+    case TYPE_STRING:
+      if (!snapshot->ReadStringIndex(valuePosition, index)) break;
+      return SerializerValue(snapshot->GetString(index));
+  }
+
+  return SerializerValue();
+}
+
+std::size_t BinarySnapshotElement::GetAllChildrenCount() const {
+  if (GetContainerType() == 0) return 0;
+
+  std::size_t countPosition = position + 5;
+  std::uint32_t childrenCount;
+  return snapshot->ReadUInt32(countPosition, childrenCount) ? childrenCount
+                                                            : 0;
+}
+
+BinarySnapshotElement BinarySnapshotElement::GetChildAt(
+    std::size_t childPosition) const {
+  char type = GetContainerType();
+  if (type == 0) return BinarySnapshotElement();
+
+  std::size_t end = snapshot->SkipValue(position);
+  if (end == 0) return BinarySnapshotElement();
+
+  std::size_t current = position + 1 + containerHeaderSize;
+  for (std::size_t i = 0; current < end; ++i) {
+    std::uint32_t childNameIndex = noNameIndex;
+    if (type == TYPE_OBJECT &&
+        !snapshot->ReadStringIndex(current, childNameIndex))
+      return BinarySnapshotElement();
+    if (current >= end) return BinarySnapshotElement();
+
+    if (i == childPosition)
+      return BinarySnapshotElement(snapshot, current, childNameIndex);
+
+    current = snapshot->SkipValue(current);
+    if (current == 0) return BinarySnapshotElement();
+  }
+
+  return BinarySnapshotElement();
+}
+
+BinarySnapshotElement BinarySnapshotElement::GetChild(
+    const gd::String& name, std::size_t index) const {
+  char type = GetContainerType();
+  if (type == TYPE_ARRAY) return GetChildAt(index);
+  if (type != TYPE_OBJECT) return BinarySnapshotElement();
+
+  std::size_t end = snapshot->SkipValue(position);
+  if (end == 0) return BinarySnapshotElement();
+
+  const std::string& rawName = name.Raw();
+  std::size_t current = position + 1 + containerHeaderSize;
+  while (current < end) {
+    std::uint32_t childNameIndex;
+    if (!snapshot->ReadStringIndex(current, childNameIndex) || current >= end)
+      return BinarySnapshotElement();
+
+    if (snapshot->stringsLengths[childNameIndex] == rawName.size() &&
+        std::memcmp(snapshot->data + snapshot->stringsPositions[childNameIndex],
+                    rawName.data(),
+                    rawName.size()) == 0) {
+      if (index == 0)
+        return BinarySnapshotElement(snapshot, current, childNameIndex);
+      else
+        index--;
+    }
+
+    current = snapshot->SkipValue(current);
+    if (current == 0) return BinarySnapshotElement();
+  }
+
+  return BinarySnapshotElement();
+}
+
+bool BinarySnapshotElement::Visit(JSONVisitor& visitor) const {
+  if (!snapshot) return false;
+
+  const char* data = snapshot->data;
+  std::size_t end = snapshot->SkipValue(position);
+  if (end == 0) return false;
+
+  // The decoding is done without recursion, the objects and arrays being
+  // decoded are stored in containers (with the position of their end).
+  std::vector<std::pair<std::size_t, bool> > containers;
+  std::size_t current = position;
+  do {
+    if (!containers.empty() && containers.back().second) {
+      std::uint32_t keyIndex;
+      if (!snapshot->ReadStringIndex(current, keyIndex) ||
+          !visitor.OnKey(data + snapshot->stringsPositions[keyIndex],
+                         snapshot->stringsLengths[keyIndex]))
+        return false;
+    }
+    if (current >= end) return false;
+
+    BinarySnapshotElement value(snapshot, current, noNameIndex);
+    char type = data[current];
+    if (type == TYPE_OBJECT || type == TYPE_ARRAY) {
+      std::size_t valueEnd = snapshot->SkipValue(current);
+      if (valueEnd == 0 || valueEnd > end) return false;
+
+      current += 1 + containerHeaderSize;
+      containers.push_back(std::make_pair(valueEnd, type == TYPE_OBJECT));
+      if (!(type == TYPE_OBJECT ? visitor.OnBeginObject()
+                                : visitor.OnBeginArray()))
+        return false;
+    } else {
+      current = snapshot->SkipValue(current);
+      if (current == 0) return false;
+
+      bool visited = false;
+      if (type == TYPE_STRING) {
+        std::size_t indexPosition = value.position + 1;
+        std::uint32_t index;
+        snapshot->ReadStringIndex(indexPosition, index);
+        visited = visitor.OnString(data + snapshot->stringsPositions[index],
+                                   snapshot->stringsLengths[index]);
+      } else if (type == TYPE_NULL) {
+        visited = visitor.OnNull();
+      } else if (type == TYPE_FALSE || type == TYPE_TRUE) {
+        visited = visitor.OnBool(type == TYPE_TRUE);
+      } else if (type == TYPE_INT) {
+        visited = visitor.OnInt(value.GetValue().GetInt());
+      } else {
+        visited = visitor.OnNumber(value.GetValue().GetDouble());
+      }
+      if (!visited) return false;
+    }
+
+    while (!containers.empty() && current == containers.back().first) {
+      if (!(containers.back().second ? visitor.OnEndObject()
+                                     : visitor.OnEndArray()))
+        return false;
+      containers.pop_back();
+    }
+    if (!containers.empty() && current > containers.back().first)
+      return false;
+  } while (!containers.empty());
+
+  return true;
+}
+
+}  // namespace gd
@@ -0,0 +1,269 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#ifndef GDCORE_BINARYSNAPSHOT_H
+#define GDCORE_BINARYSNAPSHOT_H
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "GDCore/Serialization/JSONReader.h"
+#include "GDCore/Serialization/SerializerValue.h"
+#include "GDCore/String.h"
+
+namespace gd {
+class BinarySnapshot;
+}
+
+namespace gd {
+
+/**
+ * \brief Write a binary snapshot: a compact binary encoding of a JSON document
+ * (usually the serialization of a gd::SerializerElement, see
+ * gd::Serializer::ToBinary).
+ *
+ * The snapshot is made of:
+ * - A header ("GDSN" and the version of the format).
+ * - A table of all the strings (keys and string values) used in the
+ * document, each string being stored once, prefixed by its length.
+ * - The root value. Each value starts with its type (one byte) followed by:
+ *   - for a string, its index in the strings table,
+ *   - for a number, its value as a (zigzag encoded) varint if it's an integer,
+ *   or the 8 bytes of the double otherwise,
+ *   - for an object or an array, the size in bytes of its content and the
+ *   number of children (both on 4 bytes, so that the object or array can be
+ *   skipped without being decoded), followed by the children (each one
+ *   preceded by the index of its key for objects).
+ *
+ * Lengths and indices are stored as varints. Numbers are stored in little
+ * endian whatever the platform.
+ *
+ * The writer is a gd::JSONVisitor: the document is sent to it (for example
+ * with gd::Serializer::VisitAsJSON) then written with Write.
+ *
+ * \see gd::BinarySnapshot
+ */
+class GD_CORE_API BinarySnapshotWriter : public JSONVisitor {
+ public:
+  BinarySnapshotWriter();
+  virtual ~BinarySnapshotWriter(){};
+
+  /**
+   * \brief Write the snapshot of the document that was sent to the writer.
+   */
+  void Write(std::ostream& stream) const;
+
+  /**
+   * \brief Write the snapshot of the document that was sent to the writer in
+   * a string.
+   */
+  void Write(std::string& snapshot) const;
+
+  /** \name gd::JSONVisitor implementation
+   */
+  ///@{
+  virtual bool OnBeginObject() override;
+  virtual bool OnKey(const char* key, std::size_t length) override;
+  virtual bool OnEndObject() override;
+  virtual bool OnBeginArray() override;
+  virtual bool OnEndArray() override;
+  virtual bool OnString(const char* value, std::size_t length) override;
+  virtual bool OnNumber(double value) override;
+  virtual bool OnBool(bool value) override;
+  virtual bool OnNull() override;
+  virtual bool OnInt(int value) override;
+  ///@}
+
+ private:
+  BinarySnapshotWriter(const BinarySnapshotWriter&) = delete;
+  BinarySnapshotWriter& operator=(const BinarySnapshotWriter&) = delete;
+
+  void BeginContainer(char type);
+  void EndContainer();
+  void WriteStringIndex(const char* str, std::size_t length);
+  std::string WriteHeader() const;
+
+  std::string values;  ///< The encoded root value.
+  std::vector<std::size_t> containersStarts;  ///< For each object or array
+                                              ///< being written, the position
+                                              ///< of its size in values.
+  std::vector<std::uint32_t> childrenCounts;  ///< For each object or array
+                                              ///< being written, the number
+                                              ///< of children written.
+  std::vector<const std::string*> strings;  ///< The strings table.
+  std::unordered_map<std::string, std::uint32_t> stringsIndices;
+};
+
+/**
+ * \brief An element of a gd::BinarySnapshot, decoded only when its value or
+ * children are accessed.
+ *
+ * This is a lightweight handle (the snapshot and the position of the element
+ * in it), to be passed by value. Getting a child that does not exist gives a
+ * "null" element.
+ *
+ * \note Getting a child means going through the previous children (without
+ * decoding them), so iterating on the children of an element with GetChildAt
+ * is quadratic: this is meant to find an element (for example a layout) and
+ * decode it (see gd::Serializer::FromBinary).
+ *
+ * \see gd::BinarySnapshot
+ */
+class GD_CORE_API BinarySnapshotElement {
+ public:
+  /**
+   * \brief Create a null element.
+   */
+  BinarySnapshotElement()
+      : snapshot(nullptr), position(0), nameIndex(noNameIndex){};
+
+  /**
+   * \brief Return false if the element is a null element (for example, a
+   * child that does not exist).
+   */
+  bool IsValid() const { return snapshot != nullptr; }
+
+  /**
+   * \brief Return the name of the element in its parent (empty for the root
+   * and for the elements of an array).
+   */
+  gd::String GetName() const;
+
+  /**
+   * \brief Return true if the element has no value (it's an object, an array
+   * or a null element).
+   */
+  bool IsValueUndefined() const;
+
+  /**
+   * \brief Return true if the element is an array.
+   */
+  bool ConsideredAsArray() const;
+
+  /**
+   * \brief Get the value of the element, as a generic gd::SerializerValue.
+   */
+  SerializerValue GetValue() const;
+
+  bool GetBoolValue() const { return GetValue().GetBool(); }
+  gd::String GetStringValue() const { return GetValue().GetString(); }
+  int GetIntValue() const { return GetValue().GetInt(); }
+  double GetDoubleValue() const { return GetValue().GetDouble(); }
+
+  /**
+   * \brief Return the number of children of the object or array.
+   */
+  std::size_t GetAllChildrenCount() const;
+
+  /**
+   * \brief Return the child at the specified position.
+   */
+  BinarySnapshotElement GetChildAt(std::size_t position) const;
+
+  /**
+   * \brief Return the first child having the specified name. For an array,
+   * return the element at \a index.
+   */
+  BinarySnapshotElement GetChild(const gd::String& name,
+                                 std::size_t index = 0) const;
+
+  /**
+   * \brief Send the content of the element to a visitor, like a gd::JSONReader
+   * would do when reading its JSON serialization (so that it can be decoded
+   * into a gd::SerializerElement or a gd::FlatSerializerTree).
+   *
+   * \return false if the visitor stopped the visit or if the snapshot is
+   * corrupted.
+   */
+  bool Visit(JSONVisitor& visitor) const;
+
+ private:
+  friend class BinarySnapshot;
+  BinarySnapshotElement(const BinarySnapshot* snapshot_,
+                        std::size_t position_,
+                        std::uint32_t nameIndex_)
+      : snapshot(snapshot_), position(position_), nameIndex(nameIndex_){};
+
+  /**
+   * \brief Return the type of the element if it's an object or an array, 0
+   * otherwise.
+   */
+  char GetContainerType() const;
+
+  static const std::uint32_t noNameIndex = 0xFFFFFFFF;
+
+  const BinarySnapshot* snapshot;
+  std::size_t position;     ///< The position of the type of the element.
+  std::uint32_t nameIndex;  ///< The index of the name in the strings table.
+};
+
+/**
+ * \brief Read a binary snapshot written by gd::BinarySnapshotWriter.
+ *
+ * The snapshot is not copied, and only the strings table is read when the
+ * snapshot is opened: the data can be a memory-mapped file, and elements are
+ * decoded only when accessed, so that a single element (for example a layout
+ * or an external layout) can be decoded without going through the rest of the
+ * project.
+ *
+ * The snapshot is checked while being read: corrupted or truncated data gives
+ * null elements or a failed visit, never reads outside of the data.
+ *
+ * \see gd::BinarySnapshotElement
+ * \see gd::Serializer::FromBinary
+ */
+class GD_CORE_API BinarySnapshot {
+ public:
+  /**
+   * \brief Open a snapshot.
+   *
+   * \warning The data is not copied and must stay alive as long as the
+   * snapshot and its elements are used.
+   */
+  BinarySnapshot(const char* data, std::size_t size);
+  virtual ~BinarySnapshot(){};
+
+  /**
+   * \brief Return true if the data is a snapshot that can be read.
+   */
+  bool IsValid() const { return valid; }
+
+  /**
+   * \brief Return the root element (a null element if the snapshot is not
+   * valid).
+   */
+  BinarySnapshotElement GetRoot() const;
+
+ private:
+  friend class BinarySnapshotElement;
+  BinarySnapshot(const BinarySnapshot&) = delete;
+  BinarySnapshot& operator=(const BinarySnapshot&) = delete;
+
+  bool ReadVarint(std::size_t& position, std::uint64_t& value) const;
+  bool ReadUInt32(std::size_t& position, std::uint32_t& value) const;
+  bool ReadStringIndex(std::size_t& position, std::uint32_t& index) const;
+  gd::String GetString(std::uint32_t index) const;
+
+  /**
+   * \brief Return the position just after the value starting at \a position,
+   * or 0 if the value is corrupted.
+   */
+  std::size_t SkipValue(std::size_t position) const;
+
+  const char* data;
+  std::size_t size;
+  bool valid;
+  std::vector<std::size_t> stringsPositions;  ///< The position of the
+                                              ///< characters of each string.
+  std::vector<std::size_t> stringsLengths;
+  std::size_t rootPosition;
+};
+
+}  // namespace gd
+
+#endif
@@ -0,0 +1,470 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#include "GDCore/Serialization/FlatSerializerTree.h"
+#include <cstring>
+#include "GDCore/Serialization/SerializerElement.h"
+
+namespace gd {
+
+FlatSerializerTree::FlatSerializerTree() { Clear(); }
+
+void FlatSerializerTree::Clear() {
+  // Swap with empty containers so that the memory is really freed.
+  std::vector<Node>().swap(nodes);
+  std::vector<Node>().swap(pendingNodes);
+  std::string().swap(strings);
+  std::vector<Range>().swap(names);
+  std::string().swap(namesCharacters);
+  std::vector<std::uint32_t>(64, 0).swap(namesTable);
+  rootIndex = noNodeIndex;
+
+  InternName("", 0);  // The name of array elements is always 0.
+}
+
+FlatSerializerElement FlatSerializerTree::GetRoot() const {
+  if (rootIndex == noNodeIndex) return FlatSerializerElement();
+
+  return FlatSerializerElement(this, rootIndex);
+}
+
+std::size_t FlatSerializerTree::GetMemoryUsage() const {
+  return nodes.capacity() * sizeof(Node) +
+         pendingNodes.capacity() * sizeof(Node) + strings.capacity() +
+         names.capacity() * sizeof(Range) + namesCharacters.capacity() +
+         namesTable.capacity() * sizeof(std::uint32_t);
+}
+
+std::uint32_t FlatSerializerTree::HashName(const char* name,
+                                           std::size_t length) {
+  // FNV-1a
+  std::uint32_t hash = 2166136261u;
+  for (std::size_t i = 0; i < length; ++i) {
+    hash ^= static_cast<unsigned char>(name[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+std::size_t FlatSerializerTree::FindNameSlot(const char* name,
+                                             std::size_t length,
+                                             std::uint32_t hash) const {
+  std::size_t mask = namesTable.size() - 1;
+  for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+    std::uint32_t entry = namesTable[slot];
+    if (entry == 0) return slot;
+
+    const Range& existingName = names[entry - 1];
+    if (existingName.count == length &&
+        std::memcmp(namesCharacters.data() + existingName.begin,
+                    name,
+                    length) == 0)
+      return slot;
+  }
+}
+
+std::uint32_t FlatSerializerTree::InternName(const char* name,
+                                             std::size_t length) {
+  std::uint32_t hash = HashName(name, length);
+  std::size_t slot = FindNameSlot(name, length, hash);
+  if (namesTable[slot] != 0) return namesTable[slot] - 1;
+
+  Range newName;
+  newName.begin = namesCharacters.size();
+  newName.count = length;
+  namesCharacters.append(name, length);
+  names.push_back(newName);
+  std::uint32_t nameId = names.size() - 1;
+
+  if (names.size() * 2 <= namesTable.size()) {
+    namesTable[slot] = nameId + 1;
+    return nameId;
+  }
+
+  // Keep the table at most half full.
+  std::vector<std::uint32_t> newNamesTable(namesTable.size() * 2, 0);
+  namesTable.swap(newNamesTable);
+  for (std::uint32_t id = 0; id < names.size(); ++id) {
+    const char* characters = namesCharacters.data() + names[id].begin;
+    namesTable[FindNameSlot(characters,
+                            names[id].count,
+                            HashName(characters, names[id].count))] = id + 1;
+  }
+
+  return nameId;
+}
+
+std::uint32_t FlatSerializerTree::FindNameId(const gd::String& name) const {
+  const std::string& characters = name.Raw();
+  std::size_t slot =
+      FindNameSlot(characters.data(),
+                   characters.size(),
+                   HashName(characters.data(), characters.size()));
+
+  return namesTable[slot] == 0 ? noNameId : namesTable[slot] - 1;
+}
+
+FlatSerializerTree::JSONBuilder::JSONBuilder(FlatSerializerTree& tree_)
+    : tree(tree_), currentNameId(0) {
+  tree.Clear();
+}
+
+void FlatSerializerTree::JSONBuilder::AddNode(std::uint32_t type,
+                                              double numberValue) {
+  Node node;
+  node.type = type;
+  node.numberValue = numberValue;
+  if (containersStarts.empty()) {
+    // The root element.
+    node.nameId = 0;
+    tree.nodes.push_back(node);
+    tree.rootIndex = tree.nodes.size() - 1;
+    return;
+  }
+
+  const Node& parent = tree.pendingNodes[containersStarts.back() - 1];
+  node.nameId = parent.type == ARRAY ? 0 : currentNameId;
+  tree.pendingNodes.push_back(node);
+}
+
+void FlatSerializerTree::JSONBuilder::AddStringNode(const char* value,
+                                                    std::size_t length) {
+  Range range;
+  range.begin = tree.strings.size();
+  if (::utf8::is_valid(value, value + length)) {
+    tree.strings.append(value, length);
+  } else {
+    gd::String validString;
+    validString.RawMutable().assign(value, length);
+    validString.ReplaceInvalid();
+    tree.strings.append(validString.Raw());
+  }
+  range.count = tree.strings.size() - range.begin;
+
+  AddNode(STRING, 0);
+  Node& node = containersStarts.empty() ? tree.nodes.back()
+                                        : tree.pendingNodes.back();
+  node.range = range;
+}
+
+void FlatSerializerTree::JSONBuilder::EndContainer() {
+  // All the children of the container are now known: move them in the
+  // elements, next to each other.
+  std::uint32_t start = containersStarts.back();
+  containersStarts.pop_back();
+
+  Range children;
+  children.begin = tree.nodes.size();
+  children.count = tree.pendingNodes.size() - start;
+  tree.nodes.insert(tree.nodes.end(),
+                    tree.pendingNodes.begin() + start,
+                    tree.pendingNodes.end());
+  tree.pendingNodes.resize(start);
+  tree.pendingNodes.back().range = children;
+
+  if (containersStarts.empty()) {
+    // The root element is done.
+    tree.nodes.push_back(tree.pendingNodes.back());
+    std::vector<Node>().swap(tree.pendingNodes);
+    tree.rootIndex = tree.nodes.size() - 1;
+  }
+}
+
+bool FlatSerializerTree::JSONBuilder::OnBeginObject() {
+  if (containersStarts.empty()) {
+    Node root;
+    root.nameId = 0;
+    root.type = OBJECT;
+    tree.pendingNodes.push_back(root);
+  } else {
+    AddNode(OBJECT, 0);
+  }
+  containersStarts.push_back(tree.pendingNodes.size());
+  return true;
+}
+
+bool FlatSerializerTree::JSONBuilder::OnKey(const char* key,
+                                            std::size_t length) {
+  if (::utf8::is_valid(key, key + length)) {
+    currentNameId = tree.InternName(key, length);
+  } else {
+    gd::String validKey;
+    validKey.RawMutable().assign(key, length);
+    validKey.ReplaceInvalid();
+    currentNameId =
+        tree.InternName(validKey.Raw().data(), validKey.Raw().size());
+  }
+  return true;
+}
+
+bool FlatSerializerTree::JSONBuilder::OnEndObject() {
+  EndContainer();
+  return true;
+}
+
+bool FlatSerializerTree::JSONBuilder::OnBeginArray() {
+  if (containersStarts.empty()) {
+    Node root;
+    root.nameId = 0;
+    root.type = ARRAY;
+    tree.pendingNodes.push_back(root);
+  } else {
+    AddNode(ARRAY, 0);
+  }
+  containersStarts.push_back(tree.pendingNodes.size());
+  return true;
+}
+
+bool FlatSerializerTree::JSONBuilder::OnEndArray() {
+  EndContainer();
+  return true;
+}
+
+bool FlatSerializerTree::JSONBuilder::OnString(const char* value,
+                                               std::size_t length) {
+  AddStringNode(value, length);
+  return true;
+}
+
+bool FlatSerializerTree::JSONBuilder::OnNumber(double value) {
+  AddNode(NUMBER, value);
+  return true;
+}
+
+bool FlatSerializerTree::JSONBuilder::OnBool(bool value) {
+  AddNode(BOOLEAN, value ? 1 : 0);
+  return true;
+}
+
+bool FlatSerializerTree::JSONBuilder::OnNull() {
+  // null was always unserialized as the number 0 (see gd::Serializer).
+  AddNode(NUMBER, 0);
+  return true;
+}
+
+gd::String FlatSerializerElement::GetName() const {
+  if (!tree) return "";
+
+  const FlatSerializerTree::Range& name =
+      tree->names[tree->nodes[index].nameId];
+  gd::String str;
+  str.RawMutable().assign(tree->namesCharacters.data() + name.begin, name.count);
+  return str;
+}
+
+bool FlatSerializerElement::IsValueUndefined() const {
+  if (!tree) return true;
+
+  std::uint32_t type = tree->nodes[index].type;
+  return type == FlatSerializerTree::OBJECT ||
+         type == FlatSerializerTree::ARRAY;
+}
+
+SerializerValue FlatSerializerElement::GetValue() const {
+  if (!tree) return SerializerValue();
+
+  const FlatSerializerTree::Node& node = tree->nodes[index];
+  if (node.type == FlatSerializerTree::STRING) {
+    return SerializerValue(GetStringValue());
+  } else if (node.type == FlatSerializerTree::NUMBER) {
+    return SerializerValue(node.numberValue);
+  } else if (node.type == FlatSerializerTree::BOOLEAN) {
+    return SerializerValue(node.numberValue != 0);
+  }
+
+  return SerializerValue();
+}
+
+bool FlatSerializerElement::GetBoolValue() const {
+  if (!tree) return SerializerValue().GetBool();
+
+  const FlatSerializerTree::Node& node = tree->nodes[index];
+  if (node.type == FlatSerializerTree::NUMBER ||
+      node.type == FlatSerializerTree::BOOLEAN)
+    return node.numberValue != 0;
+  else if (node.type == FlatSerializerTree::STRING)
+    return node.range.count != 5 ||
+           std::memcmp(tree->strings.data() + node.range.begin, "false", 5) !=
+               0;
+
+  return SerializerValue().GetBool();
+}
+
+gd::String FlatSerializerElement::GetStringValue() const {
+  if (tree && tree->nodes[index].type == FlatSerializerTree::STRING) {
+    const FlatSerializerTree::Range& range = tree->nodes[index].range;
+    gd::String str;
+    str.RawMutable().assign(tree->strings.data() + range.begin, range.count);
+    return str;
+  }
+
+  return GetValue().GetString();
+}
+
+int FlatSerializerElement::GetIntValue() const {
+  if (tree && (tree->nodes[index].type == FlatSerializerTree::NUMBER ||
+               tree->nodes[index].type == FlatSerializerTree::BOOLEAN))
+    return tree->nodes[index].numberValue;
+
+  return GetValue().GetInt();
+}
+
+double FlatSerializerElement::GetDoubleValue() const {
+  if (tree && (tree->nodes[index].type == FlatSerializerTree::NUMBER ||
+               tree->nodes[index].type == FlatSerializerTree::BOOLEAN))
+    return tree->nodes[index].numberValue;
+
+  return GetValue().GetDouble();
+}
+
+FlatSerializerElement FlatSerializerElement::FindAttribute(
+    const gd::String& name, const gd::String& deprecatedName) const {
+  if (!tree) return FlatSerializerElement();
+
+  FlatSerializerElement child = GetChild(name, 0, deprecatedName);
+  return child.IsValueUndefined() ? FlatSerializerElement() : child;
+}
+
+bool FlatSerializerElement::GetBoolAttribute(
+    const gd::String& name,
+    bool defaultValue,
+    const gd::String& deprecatedName) const {
+  FlatSerializerElement attribute = FindAttribute(name, deprecatedName);
+  return attribute.IsValid() ? attribute.GetBoolValue() : defaultValue;
+}
+
+gd::String FlatSerializerElement::GetStringAttribute(
+    const gd::String& name,
+    const gd::String& defaultValue,
+    const gd::String& deprecatedName) const {
+  FlatSerializerElement attribute = FindAttribute(name, deprecatedName);
+  return attribute.IsValid() ? attribute.GetStringValue() : defaultValue;
+}
+
+int FlatSerializerElement::GetIntAttribute(
+    const gd::String& name,
+    int defaultValue,
+    const gd::String& deprecatedName) const {
+  FlatSerializerElement attribute = FindAttribute(name, deprecatedName);
+  return attribute.IsValid() ? attribute.GetIntValue() : defaultValue;
+}
+
+double FlatSerializerElement::GetDoubleAttribute(
+    const gd::String& name,
+    double defaultValue,
+    const gd::String& deprecatedName) const {
+  FlatSerializerElement attribute = FindAttribute(name, deprecatedName);
+  return attribute.IsValid() ? attribute.GetDoubleValue() : defaultValue;
+}
+
+bool FlatSerializerElement::ConsideredAsArray() const {
+  return tree && tree->nodes[index].type == FlatSerializerTree::ARRAY;
+}
+
+std::size_t FlatSerializerElement::GetAllChildrenCount() const {
+  if (IsValueUndefined() && tree) return tree->nodes[index].range.count;
+
+  return 0;
+}
+
+FlatSerializerElement FlatSerializerElement::GetChildAt(
+    std::size_t position) const {
+  if (position >= GetAllChildrenCount()) return FlatSerializerElement();
+
+  return FlatSerializerElement(tree,
+                               tree->nodes[index].range.begin + position);
+}
+
+FlatSerializerElement FlatSerializerElement::FindChild(
+    std::uint32_t nameId,
+    std::uint32_t deprecatedNameId,
+    std::size_t position) const {
+  const FlatSerializerTree::Range& children = tree->nodes[index].range;
+  const FlatSerializerTree::Node* childrenNodes =
+      tree->nodes.data() + children.begin;
+  for (std::uint32_t i = 0; i < children.count; ++i) {
+    if (childrenNodes[i].nameId == nameId ||
+        childrenNodes[i].nameId == deprecatedNameId) {
+      if (position == 0)
+        return FlatSerializerElement(tree, children.begin + i);
+      else
+        position--;
+    }
+  }
+
+  return FlatSerializerElement();
+}
+
+FlatSerializerElement FlatSerializerElement::GetChild(
+    const gd::String& name,
+    std::size_t index,
+    const gd::String& deprecatedName) const {
+  if (!tree || !IsValueUndefined()) return FlatSerializerElement();
+  if (ConsideredAsArray()) return GetChildAt(index);
+
+  std::uint32_t deprecatedNameId =
+      deprecatedName.empty() ? FlatSerializerTree::noNameId
+                             : tree->FindNameId(deprecatedName);
+  return FindChild(tree->FindNameId(name), deprecatedNameId, index);
+}
+
+FlatSerializerElement FlatSerializerElement::GetChild(std::size_t index) const {
+  if (!ConsideredAsArray()) return FlatSerializerElement();
+
+  return GetChildAt(index);
+}
+
+std::size_t FlatSerializerElement::GetChildrenCount(
+    const gd::String& name, const gd::String& deprecatedName) const {
+  if (ConsideredAsArray()) return GetAllChildrenCount();
+  if (!tree || !IsValueUndefined() || name.empty()) return 0;
+
+  std::uint32_t nameId = tree->FindNameId(name);
+  std::uint32_t deprecatedNameId =
+      deprecatedName.empty() ? FlatSerializerTree::noNameId
+                             : tree->FindNameId(deprecatedName);
+
+  std::size_t count = 0;
+  const FlatSerializerTree::Range& children = tree->nodes[index].range;
+  for (std::uint32_t i = 0; i < children.count; ++i) {
+    std::uint32_t childNameId = tree->nodes[children.begin + i].nameId;
+    if (childNameId == nameId || childNameId == deprecatedNameId) count++;
+  }
+
+  return count;
+}
+
+bool FlatSerializerElement::HasChild(const gd::String& name,
+                                     const gd::String& deprecatedName) const {
+  if (!tree || !IsValueUndefined() || ConsideredAsArray()) return false;
+
+  return GetChild(name, 0, deprecatedName).IsValid();
+}
+
+void FlatSerializerElement::ToSerializerElement(
+    SerializerElement& element) const {
+  if (!tree) return;
+
+  const FlatSerializerTree::Node& node = tree->nodes[index];
+  if (node.type == FlatSerializerTree::STRING)
+    element.SetValue(GetStringValue());
+  else if (node.type == FlatSerializerTree::NUMBER)
+    element.SetValue(node.numberValue);
+  else if (node.type == FlatSerializerTree::BOOLEAN)
+    element.SetValue(node.numberValue != 0);
+  else if (node.type == FlatSerializerTree::ARRAY) {
+    element.ConsiderAsArray();
+    for (std::uint32_t i = 0; i < node.range.count; ++i)
+      GetChildAt(i).ToSerializerElement(element.AddChild(""));
+  } else {
+    for (std::uint32_t i = 0; i < node.range.count; ++i) {
+      FlatSerializerElement child = GetChildAt(i);
+      child.ToSerializerElement(element.AddChild(child.GetName()));
+    }
+  }
+}
+
+}  // namespace gd
@@ -0,0 +1,325 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#ifndef GDCORE_FLATSERIALIZERTREE_H
+#define GDCORE_FLATSERIALIZERTREE_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GDCore/Serialization/JSONReader.h"
+#include "GDCore/Serialization/SerializerValue.h"
+#include "GDCore/String.h"
+
+namespace gd {
+class FlatSerializerTree;
+class SerializerElement;
+}
+
+namespace gd {
+
+/**
+ * \brief A read-only element of a gd::FlatSerializerTree.
+ *
+ * This is a lightweight handle (the tree and the index of the element in it),
+ * to be passed by value. Its methods are the same as the getters of
+ * gd::SerializerElement, so that code reading a gd::SerializerElement can read
+ * a flat tree in the same way, and an element can be converted to a
+ * gd::SerializerElement when the full (mutable) API is needed.
+ *
+ * Getting a child of an element whose name is not in the tree is a "null"
+ * element: it has no value and no children.
+ *
+ * \warning An element is only valid as long as its tree is alive and not
+ * modified.
+ *
+ * \see gd::FlatSerializerTree
+ */
+class GD_CORE_API FlatSerializerElement {
+ public:
+  /**
+   * \brief Create a null element.
+   */
+  FlatSerializerElement() : tree(nullptr), index(0){};
+
+  /**
+   * \brief Return false if the element is a null element (for example, a
+   * child that does not exist).
+   */
+  bool IsValid() const { return tree != nullptr; }
+
+  /**
+   * \brief Return the name of the element in its parent (empty for the root
+   * and for the elements of an array).
+   */
+  gd::String GetName() const;
+
+  /** \name Value
+   */
+  ///@{
+  /**
+   * \brief Return true if the element has no value (it's an object, an array
+   * or a null element).
+   */
+  bool IsValueUndefined() const;
+
+  /**
+   * \brief Get the value of the element, as a generic gd::SerializerValue.
+   */
+  SerializerValue GetValue() const;
+
+  bool GetBoolValue() const;
+  gd::String GetStringValue() const;
+  int GetIntValue() const;
+  double GetDoubleValue() const;
+  ///@}
+
+  /** \name Attributes
+   * Same as gd::SerializerElement attributes getters (which also search in
+   * children elements).
+   */
+  ///@{
+  bool GetBoolAttribute(const gd::String &name,
+                        bool defaultValue = false,
+                        const gd::String &deprecatedName = "") const;
+  gd::String GetStringAttribute(const gd::String &name,
+                                const gd::String &defaultValue = "",
+                                const gd::String &deprecatedName = "") const;
+  int GetIntAttribute(const gd::String &name,
+                      int defaultValue = 0,
+                      const gd::String &deprecatedName = "") const;
+  double GetDoubleAttribute(const gd::String &name,
+                            double defaultValue = 0.0,
+                            const gd::String &deprecatedName = "") const;
+  ///@}
+
+  /** \name Children
+   */
+  ///@{
+  /**
+   * \brief Return true if the element is an array.
+   */
+  bool ConsideredAsArray() const;
+
+  /**
+   * \brief Get a child of the element using its name.
+   *
+   * Elements of an array having no name, all of them are matching \a name
+   * when the element is an array (like for a gd::SerializerElement unserialized
+   * from JSON).
+   *
+   * \param name The name of the child.
+   * \param index The index of the child, in case of an array.
+   * \param deprecatedName An alternative name for the child.
+   */
+  FlatSerializerElement GetChild(const gd::String &name,
+                                 std::size_t index = 0,
+                                 const gd::String &deprecatedName = "") const;
+
+  /**
+   * \brief Get a child of the element using its index (when the element is an
+   * array).
+   */
+  FlatSerializerElement GetChild(std::size_t index) const;
+
+  /**
+   * \brief Get the number of children having a specific name.
+   *
+   * If no children name is specified, return the number of children of the
+   * array.
+   */
+  std::size_t GetChildrenCount(const gd::String &name = "",
+                               const gd::String &deprecatedName = "") const;
+
+  /**
+   * \brief Return true if the specified child exists.
+   */
+  bool HasChild(const gd::String &name,
+                const gd::String &deprecatedName = "") const;
+
+  /**
+   * \brief Return the number of children, whatever their names.
+   */
+  std::size_t GetAllChildrenCount() const;
+
+  /**
+   * \brief Return the child at the specified position, whatever its name (see
+   * GetAllChildrenCount).
+   */
+  FlatSerializerElement GetChildAt(std::size_t position) const;
+  ///@}
+
+  /**
+   * \brief Copy the element and all its children into a gd::SerializerElement
+   * (giving the same result as gd::Serializer::FromJSON).
+   */
+  void ToSerializerElement(SerializerElement &element) const;
+
+ private:
+  friend class FlatSerializerTree;
+  FlatSerializerElement(const FlatSerializerTree *tree_, std::uint32_t index_)
+      : tree(tree_), index(index_){};
+
+  /**
+   * \brief Return the first child having one of the specified names (given as
+   * names identifiers), skipping \a position matching children.
+   */
+  FlatSerializerElement FindChild(std::uint32_t nameId,
+                                  std::uint32_t deprecatedNameId,
+                                  std::size_t position) const;
+
+  /**
+   * \brief Return the child having the specified name or deprecated name, if
+   * it has a value.
+   */
+  FlatSerializerElement FindAttribute(const gd::String &name,
+                                      const gd::String &deprecatedName) const;
+
+  const FlatSerializerTree *tree;
+  std::uint32_t index;
+};
+
+/**
+ * \brief A read-only tree of elements with the same structure as a
+ * gd::SerializerElement, stored in a few contiguous arrays.
+ *
+ * gd::SerializerElement allocates every element, name and value separately
+ * (and children are reference counted), which makes large projects slow to
+ * load and free and uses a lot of memory. In a flat tree:
+ * - Elements are stored in a single array. The children of an element are
+ * stored next to each other, so that they can be iterated without following
+ * pointers.
+ * - Names are interned: each name is stored once and elements refer to it by
+ * an integer, so that searching a child compares integers rather than
+ * strings.
+ * - Strings are stored one after the other in a single buffer.
+ *
+ * The tree is freed in one go when destroyed (or cleared).
+ *
+ * \note Sizes are stored on 32 bits: the tree is limited to 4 GB of strings
+ * and 4 billions elements.
+ *
+ * \see gd::Serializer::FromJSON
+ * \see gd::FlatSerializerElement
+ */
+class GD_CORE_API FlatSerializerTree {
+ public:
+  /**
+   * \brief Build a tree from the content of a JSON document (see
+   * gd::JSONReader).
+   *
+   * \note The tree is cleared when the builder is created.
+   */
+  class GD_CORE_API JSONBuilder : public JSONVisitor {
+   public:
+    JSONBuilder(FlatSerializerTree &tree_);
+    virtual ~JSONBuilder(){};
+
+    virtual bool OnBeginObject() override;
+    virtual bool OnKey(const char *key, std::size_t length) override;
+    virtual bool OnEndObject() override;
+    virtual bool OnBeginArray() override;
+    virtual bool OnEndArray() override;
+    virtual bool OnString(const char *value, std::size_t length) override;
+    virtual bool OnNumber(double value) override;
+    virtual bool OnBool(bool value) override;
+    virtual bool OnNull() override;
+
+   private:
+    /**
+     * \brief Add a node for a new element, named according to its parent.
+     */
+    void AddNode(std::uint32_t type, double numberValue);
+    void AddStringNode(const char *value, std::size_t length);
+    void EndContainer();
+
+    FlatSerializerTree &tree;
+    std::vector<std::uint32_t> containersStarts;  ///< For each object or array
+                                                  ///< being read, the position
+                                                  ///< in pendingNodes of its
+                                                  ///< first child.
+    std::uint32_t currentNameId;  ///< The name of the next element, if in an
+                                  ///< object.
+  };
+
+  FlatSerializerTree();
+  virtual ~FlatSerializerTree(){};
+
+  /**
+   * \brief Return the root element (a null element if the tree is empty).
+   */
+  FlatSerializerElement GetRoot() const;
+
+  /**
+   * \brief Remove all the elements, freeing the memory.
+   */
+  void Clear();
+
+  /**
+   * \brief Return the number of bytes allocated by the tree.
+   */
+  std::size_t GetMemoryUsage() const;
+
+ private:
+  friend class FlatSerializerElement;
+  FlatSerializerTree(const FlatSerializerTree &) = delete;
+  FlatSerializerTree &operator=(const FlatSerializerTree &) = delete;
+
+  enum NodeType { OBJECT, ARRAY, STRING, NUMBER, BOOLEAN };
+
+  struct Range {
+    std::uint32_t begin;
+    std::uint32_t count;
+  };
+
+  struct Node {
+    std::uint32_t nameId;
+    std::uint32_t type;  ///< A NodeType.
+    union {
+      double numberValue;  ///< For NUMBER and BOOLEAN.
+      Range range;  ///< The children in nodes for OBJECT and ARRAY, the
+                    ///< characters in strings for STRING.
+    };
+  };
+
+  /**
+   * \brief Return the identifier of a name, adding it to the names if needed.
+   */
+  std::uint32_t InternName(const char *name, std::size_t length);
+
+  /**
+   * \brief Return the identifier of a name, or noNameId if the name is not
+   * used in the tree.
+   */
+  std::uint32_t FindNameId(const gd::String &name) const;
+
+  std::size_t FindNameSlot(const char *name,
+                           std::size_t length,
+                           std::uint32_t hash) const;
+
+  static std::uint32_t HashName(const char *name, std::size_t length);
+
+  std::vector<Node> nodes;  ///< All the elements, the children of an element
+                            ///< being stored contiguously.
+  std::vector<Node> pendingNodes;  ///< Elements being built, whose siblings
+                                   ///< are not all known yet.
+  std::uint32_t rootIndex;
+  std::string strings;  ///< The characters of all the string values.
+
+  std::vector<Range> names;      ///< The characters of each name in
+                                 ///< namesCharacters.
+  std::string namesCharacters;
+  std::vector<std::uint32_t> namesTable;  ///< Hash table (open addressing) of
+                                          ///< names identifiers + 1 (0 for an
+                                          ///< empty slot).
+
+  static const std::uint32_t noNameId = 0xFFFFFFFF;
+  static const std::uint32_t noNodeIndex = 0xFFFFFFFF;
+};
+
+}  // namespace gd
+
+#endif
@@ -0,0 +1,370 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#include "GDCore/Serialization/JSONReader.h"
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <locale>
+#include <sstream>
+
+namespace gd {
+
+namespace {
+bool IsBlank(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+/**
+ * Return true if the character ends a number, true, false or null.
+ */
+bool IsLiteralEnd(char c) {
+  return IsBlank(c) || c == ',' || c == '}' || c == ']' || c == ':' ||
+         c == '"' || c == '{' || c == '[';
+}
+
+/**
+ * Parse a number. Numbers with at most 15 significant digits and a small
+ * exponent, which are the only ones found in projects in practice, are
+ * converted exactly without going through a stream (the mantissa and the power
+ * of ten being both exactly represented by a double, the result of the single
+ * multiplication or division is correctly rounded).
+ */
+bool ParseNumber(const char* begin, const char* end, double& value) {
+  static const double powersOfTen[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  static const int maxExponent = 22;
+  static const int maxSignificantDigits = 15;
+
+  const char* it = begin;
+  bool negative = false;
+  if (it != end && (*it == '-' || *it == '+')) {
+    negative = *it == '-';
+    ++it;
+  }
+
+  std::uint64_t mantissa = 0;
+  int exponent = 0;
+  int significantDigitsCount = 0;
+  bool hasDigits = false;
+  bool fractional = false;
+  for (; it != end; ++it) {
+    if (*it == '.' && !fractional) {
+      fractional = true;
+      continue;
+    }
+    if (*it < '0' || *it > '9') break;
+
+    hasDigits = true;
+    if (mantissa != 0 || *it != '0') significantDigitsCount++;
+    if (significantDigitsCount <= maxSignificantDigits) {
+      mantissa = mantissa * 10 + (*it - '0');
+      if (fractional) exponent--;
+    }
+  }
+
+  if (hasDigits && it != end && (*it == 'e' || *it == 'E')) {
+    ++it;
+    bool negativeExponent = false;
+    if (it != end && (*it == '-' || *it == '+')) {
+      negativeExponent = *it == '-';
+      ++it;
+    }
+    int exponentValue = 0;
+    bool hasExponentDigits = false;
+    for (; it != end && *it >= '0' && *it <= '9'; ++it) {
+      hasExponentDigits = true;
+      if (exponentValue < 10000)
+        exponentValue = exponentValue * 10 + (*it - '0');
+    }
+    if (!hasExponentDigits) hasDigits = false;
+    exponent += negativeExponent ? -exponentValue : exponentValue;
+  }
+
+  if (hasDigits && it == end &&
+      significantDigitsCount <= maxSignificantDigits &&
+      exponent >= -maxExponent && exponent <= maxExponent) {
+    value = exponent < 0
+                ? static_cast<double>(mantissa) / powersOfTen[-exponent]
+                : static_cast<double>(mantissa) * powersOfTen[exponent];
+    if (negative) value = -value;
+    return true;
+  }
+
+  // Fallback to the standard library for other numbers.
+  std::istringstream stream(std::string(begin, end));
+  stream.imbue(std::locale::classic());
+  stream >> value;
+  return !stream.fail();
+}
+}  // namespace
+
+JSONReader::JSONReader(const char* data, std::size_t size)
+    : current(data),
+      end(data + size),
+      bufferPosition(0),
+      bufferBegin(data),
+      stream(nullptr),
+      errorPosition(0) {}
+
+JSONReader::JSONReader(std::istream& stream_, std::size_t bufferSize)
+    : current(nullptr),
+      end(nullptr),
+      bufferPosition(0),
+      bufferBegin(nullptr),
+      stream(&stream_),
+      streamBuffer(bufferSize > 0 ? bufferSize : 1),
+      errorPosition(0) {}
+
+bool JSONReader::Refill() {
+  if (!stream) return false;
+
+  bufferPosition += end - bufferBegin;
+  stream->read(streamBuffer.data(), streamBuffer.size());
+  std::size_t readCount = static_cast<std::size_t>(stream->gcount());
+
+  bufferBegin = current = streamBuffer.data();
+  end = current + readCount;
+  return readCount > 0;
+}
+
+bool JSONReader::SetError(const gd::String& message) {
+  error = message;
+  errorPosition = bufferPosition + (current - bufferBegin);
+  return false;
+}
+
+int JSONReader::SkipBlanks() {
+  while (true) {
+    for (; current != end; ++current) {
+      if (!IsBlank(*current)) return static_cast<unsigned char>(*current);
+    }
+    if (!Refill()) return -1;
+  }
+}
+
+bool JSONReader::ReadCodeUnit(unsigned int& codeUnit) {
+  codeUnit = 0;
+  for (int i = 0; i < 4; ++i) {
+    int c = NextChar();
+    if (c >= '0' && c <= '9')
+      codeUnit = codeUnit * 16 + (c - '0');
+    else if (c >= 'a' && c <= 'f')
+      codeUnit = codeUnit * 16 + (c - 'a' + 10);
+    else if (c >= 'A' && c <= 'F')
+      codeUnit = codeUnit * 16 + (c - 'A' + 10);
+    else
+      return SetError("Invalid unicode escape sequence in string");
+  }
+
+  return true;
+}
+
+bool JSONReader::ReadString(const char*& begin, std::size_t& length) {
+  ++current;  // Opening quote
+
+  // Most strings have no escaped characters and can be used directly from the
+  // buffer.
+  const char* closingQuote =
+      static_cast<const char*>(std::memchr(current, '"', end - current));
+  if (closingQuote && !std::memchr(current, '\\', closingQuote - current)) {
+    begin = current;
+    length = closingQuote - current;
+    current = closingQuote + 1;
+    return true;
+  }
+
+  scratch.clear();
+  while (true) {
+    const char* chunkBegin = current;
+    while (current != end && *current != '"' && *current != '\\') ++current;
+    scratch.append(chunkBegin, current);
+    if (current == end) {
+      if (!Refill()) return SetError("String not properly ended");
+      continue;
+    }
+
+    if (*current++ == '"') break;
+
+    int c = NextChar();
+    switch (c) {
+      case 'b':
+        scratch.push_back('\b');
+        break;
+      case 'f':
+        scratch.push_back('\f');
+        break;
+      case 'n':
+        scratch.push_back('\n');
+        break;
+      case 'r':
+        scratch.push_back('\r');
+        break;
+      case 't':
+        scratch.push_back('\t');
+        break;
+      case '"':
+      case '\\':
+      case '/':
+        scratch.push_back(c);
+        break;
+      case 'u': {
+        unsigned int codePoint;
+        if (!ReadCodeUnit(codePoint)) return false;
+        if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+          // High surrogate, must be followed by a low surrogate.
+          unsigned int lowSurrogate;
+          if (NextChar() != '\\' || NextChar() != 'u' ||
+              !ReadCodeUnit(lowSurrogate) || lowSurrogate < 0xDC00 ||
+              lowSurrogate > 0xDFFF)
+            return SetError("Invalid unicode surrogate pair in string");
+
+          codePoint =
+              0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+        } else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+          codePoint = 0xFFFD;  // Unpaired low surrogate
+        }
+        ::utf8::unchecked::append(codePoint, std::back_inserter(scratch));
+      } break;
+      case -1:
+        return SetError("String not properly ended");
+      default:
+        // Unknown escape sequences are kept as is.
+        scratch.push_back('\\');
+        scratch.push_back(c);
+        break;
+    }
+  }
+
+  begin = scratch.data();
+  length = scratch.size();
+  return true;
+}
+
+bool JSONReader::ReadKey(JSONVisitor& visitor) {
+  if (SkipBlanks() != '"') return SetError("Expected a key in object");
+
+  const char* key;
+  std::size_t length;
+  if (!ReadString(key, length)) return false;
+  if (!visitor.OnKey(key, length)) return false;
+
+  if (SkipBlanks() != ':') return SetError("Expected a colon after key");
+  ++current;
+  return true;
+}
+
+bool JSONReader::ReadLiteral(JSONVisitor& visitor) {
+  const char* literalBegin = current;
+  while (current != end && !IsLiteralEnd(*current)) ++current;
+  const char* literalEnd = current;
+
+  if (current == end && stream) {
+    // The literal may continue in the next bytes of the stream.
+    scratch.assign(literalBegin, literalEnd);
+    while (Refill()) {
+      const char* chunkBegin = current;
+      while (current != end && !IsLiteralEnd(*current)) ++current;
+      scratch.append(chunkBegin, current);
+      if (current != end) break;
+    }
+    literalBegin = scratch.data();
+    literalEnd = scratch.data() + scratch.size();
+  }
+
+  std::size_t length = literalEnd - literalBegin;
+  if (length == 4 && std::memcmp(literalBegin, "true", 4) == 0)
+    return visitor.OnBool(true);
+  else if (length == 5 && std::memcmp(literalBegin, "false", 5) == 0)
+    return visitor.OnBool(false);
+  else if (length == 4 && std::memcmp(literalBegin, "null", 4) == 0)
+    return visitor.OnNull();
+
+  double value;
+  if (length == 0 || !ParseNumber(literalBegin, literalEnd, value))
+    return SetError("Invalid value");
+
+  return visitor.OnNumber(value);
+}
+
+bool JSONReader::Read(JSONVisitor& visitor) {
+  containers.clear();
+  error.clear();
+  errorPosition = 0;
+
+  // The reading is done without recursion, the objects and arrays being read
+  // are stored in containers.
+  bool expectValue = true;
+  while (true) {
+    if (expectValue) {
+      int c = SkipBlanks();
+      if (c == '{') {
+        ++current;
+        if (!visitor.OnBeginObject()) return false;
+        if (SkipBlanks() == '}') {
+          ++current;
+          if (!visitor.OnEndObject()) return false;
+          expectValue = false;
+        } else {
+          containers.push_back('{');
+          if (!ReadKey(visitor)) return false;
+        }
+      } else if (c == '[') {
+        ++current;
+        if (!visitor.OnBeginArray()) return false;
+        if (SkipBlanks() == ']') {
+          ++current;
+          if (!visitor.OnEndArray()) return false;
+          expectValue = false;
+        } else {
+          containers.push_back('[');
+        }
+      } else if (c == '"') {
+        const char* str;
+        std::size_t length;
+        if (!ReadString(str, length)) return false;
+        if (!visitor.OnString(str, length)) return false;
+        expectValue = false;
+      } else if (c == -1) {
+        return SetError("Unexpected end of document");
+      } else if (c == '}' || c == ']' || c == ',' || c == ':') {
+        return SetError("Expected a value");
+      } else {
+        if (!ReadLiteral(visitor)) return false;
+        expectValue = false;
+      }
+    } else {
+      if (containers.empty()) return true;
+
+      int c = SkipBlanks();
+      char container = containers.back();
+      if (c == ',') {
+        ++current;
+        // Trailing commas are accepted: the end of the container is then read
+        // at the next iteration.
+        int next = SkipBlanks();
+        if (next != (container == '{' ? '}' : ']')) {
+          expectValue = true;
+          if (container == '{' && !ReadKey(visitor)) return false;
+        }
+      } else if (c == '}' && container == '{') {
+        ++current;
+        containers.pop_back();
+        if (!visitor.OnEndObject()) return false;
+      } else if (c == ']' && container == '[') {
+        ++current;
+        containers.pop_back();
+        if (!visitor.OnEndArray()) return false;
+      } else if (c == -1) {
+        return SetError("Unexpected end of document");
+      } else {
+        return SetError(container == '{' ? "Object not properly formed"
+                                         : "Array not properly formed");
+      }
+    }
+  }
+}
+
+}  // namespace gd
@@ -0,0 +1,173 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#ifndef GDCORE_JSONREADER_H
+#define GDCORE_JSONREADER_H
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "GDCore/String.h"
+
+namespace gd {
+
+/**
+ * \brief Interface to be implemented to receive the content of a JSON
+ * document, as it is read by gd::JSONReader (or as a gd::SerializerElement is
+ * visited by gd::Serializer::VisitAsJSON).
+ *
+ * Strings are UTF8 encoded and already unescaped. They are given as a pointer
+ * and a length and are only valid during the call: they must be copied if they
+ * must be kept.
+ *
+ * Each method returns false to stop the reading.
+ *
+ * \see gd::JSONReader
+ * \see gd::JSONWriter
+ */
+class GD_CORE_API JSONVisitor {
+ public:
+  virtual ~JSONVisitor(){};
+
+  virtual bool OnBeginObject() = 0;
+  virtual bool OnKey(const char* key, std::size_t length) = 0;
+  virtual bool OnEndObject() = 0;
+  virtual bool OnBeginArray() = 0;
+  virtual bool OnEndArray() = 0;
+  virtual bool OnString(const char* value, std::size_t length) = 0;
+  virtual bool OnNumber(double value) = 0;
+  virtual bool OnBool(bool value) = 0;
+  virtual bool OnNull() = 0;
+
+  /**
+   * \brief Called for integers when a gd::SerializerElement is visited (JSON
+   * documents only contain numbers, see OnNumber).
+   */
+  virtual bool OnInt(int value) { return OnNumber(value); };
+};
+
+/**
+ * \brief Streaming (SAX-style) JSON reader.
+ *
+ * The document is read from a buffer or a std::istream and its content is sent
+ * to a gd::JSONVisitor, without building any intermediate representation.
+ * Strings without escaped characters are given to the visitor directly from
+ * the buffer, without copying them.
+ *
+ * The reader is a bit more permissive than the JSON specification (trailing
+ * commas and control characters in strings are accepted), like the parser
+ * previously used by gd::Serializer.
+ *
+ * \see gd::Serializer::FromJSON
+ */
+class GD_CORE_API JSONReader {
+ public:
+  /**
+   * \brief Create a reader for the document stored in \a data.
+   * \note The buffer is not copied and must be kept alive while reading.
+   */
+  JSONReader(const char* data, std::size_t size);
+
+  /**
+   * \brief Create a reader for the document read from \a stream, using a
+   * buffer of \a bufferSize bytes.
+   */
+  JSONReader(std::istream& stream, std::size_t bufferSize = 64 * 1024);
+
+  virtual ~JSONReader(){};
+
+  /**
+   * \brief Read a value (usually the object at the root of the document) and
+   * send its content to the visitor.
+   *
+   * Anything after the value is ignored.
+   *
+   * \return true if the value was entirely read, false if the document is
+   * invalid or if the visitor stopped the reading.
+   */
+  bool Read(JSONVisitor& visitor);
+
+  /**
+   * \brief Return a description of the error that stopped the reading, if any.
+   */
+  const gd::String& GetError() const { return error; }
+
+  /**
+   * \brief Return the position, in bytes, at which the reading was stopped by
+   * an error.
+   */
+  std::size_t GetErrorPosition() const { return errorPosition; }
+
+ private:
+  JSONReader(const JSONReader&) = delete;
+  JSONReader& operator=(const JSONReader&) = delete;
+
+  /**
+   * \brief Fill the buffer with the next bytes of the stream, if any.
+   * \return false if there is nothing more to read.
+   */
+  bool Refill();
+
+  /**
+   * \brief Skip the blank characters and return the next character, without
+   * consuming it, or -1 at the end of the document.
+   */
+  int SkipBlanks();
+
+  /**
+   * \brief Consume and return the next character, or -1 at the end of the
+   * document.
+   */
+  int NextChar() {
+    if (current == end && !Refill()) return -1;
+    return static_cast<unsigned char>(*current++);
+  }
+
+  /**
+   * \brief Read a string (the opening quote being the next character) and
+   * store its content in \a begin and \a length.
+   */
+  bool ReadString(const char*& begin, std::size_t& length);
+
+  /**
+   * \brief Read the 4 hexadecimal digits of an escaped unicode character
+   * (after "\\u").
+   */
+  bool ReadCodeUnit(unsigned int& codeUnit);
+
+  /**
+   * \brief Read a number, true, false or null and send it to the visitor.
+   */
+  bool ReadLiteral(JSONVisitor& visitor);
+
+  /**
+   * \brief Read a key and the colon following it and send it to the visitor.
+   */
+  bool ReadKey(JSONVisitor& visitor);
+
+  bool SetError(const gd::String& message);
+
+  const char* current;  ///< The next character to be read.
+  const char* end;      ///< The end of the bytes available in the buffer.
+  std::size_t bufferPosition;  ///< The position in the document of the start
+                               ///< of the buffer.
+  const char* bufferBegin;
+
+  std::istream* stream;  ///< The stream to read from, if any.
+  std::vector<char> streamBuffer;
+
+  std::string scratch;  ///< Used for strings having escaped characters or
+                        ///< split between two reads of the stream.
+  std::vector<char> containers;  ///< The objects ('{') and arrays ('[') being
+                                 ///< read.
+
+  gd::String error;
+  std::size_t errorPosition;
+};
+
+}  // namespace gd
+
+#endif
@@ -0,0 +1,204 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#include "GDCore/Serialization/JSONWriter.h"
+#include <cmath>
+#include <ostream>
+#include <string>
+
+namespace gd {
+
+namespace {
+/**
+ * Return the escape sequence to be used for a character in a JSON string, or
+ * NULL if the character can be written as is.
+ */
+const char* GetEscapeSequence(char c) {
+  static const char* controlCharacters[] = {
+      NULL,      "\\u0001", "\\u0002", "\\u0003", "\\u0004", "\\u0005",
+      "\\u0006", "\\u0007", "\\b",     "\\t",     "\\n",     "\\u000B",
+      "\\f",     "\\r",     "\\u000E", "\\u000F", "\\u0010", "\\u0011",
+      "\\u0012", "\\u0013", "\\u0014", "\\u0015", "\\u0016", "\\u0017",
+      "\\u0018", "\\u0019", "\\u001A", "\\u001B", "\\u001C", "\\u001D",
+      "\\u001E", "\\u001F"};
+
+  if (c == '"') return "\\\"";
+  if (c == '\\') return "\\\\";
+  if (c >= 0 && c <= 0x1F) return controlCharacters[static_cast<int>(c)];
+  return NULL;
+}
+
+/**
+ * Write the digits of an integer just before \a bufferEnd, and return a
+ * pointer to the first character.
+ */
+char* FormatInteger(long long value, char* bufferEnd) {
+  bool negative = value < 0;
+  unsigned long long absoluteValue =
+      negative ? 0ULL - static_cast<unsigned long long>(value)
+               : static_cast<unsigned long long>(value);
+
+  char* it = bufferEnd;
+  do {
+    *--it = static_cast<char>('0' + absoluteValue % 10);
+    absoluteValue /= 10;
+  } while (absoluteValue != 0);
+  if (negative) *--it = '-';
+
+  return it;
+}
+}  // namespace
+
+JSONWriter::JSONWriter(std::ostream& stream_)
+    : stream(stream_), needsComma(false) {}
+
+void JSONWriter::Write(char c) { stream.put(c); }
+
+void JSONWriter::Write(const char* str, std::size_t length) {
+  stream.write(str, length);
+}
+
+void JSONWriter::WriteQuoted(const char* str, std::size_t length) {
+  Write('"');
+  const char* chunkBegin = str;
+  const char* strEnd = str + length;
+  for (const char* it = str; it != strEnd; ++it) {
+    const char* escapeSequence = GetEscapeSequence(*it);
+    if (!escapeSequence) continue;
+
+    Write(chunkBegin, it - chunkBegin);
+    Write(escapeSequence, std::char_traits<char>::length(escapeSequence));
+    chunkBegin = it + 1;
+  }
+  Write(chunkBegin, strEnd - chunkBegin);
+  Write('"');
+}
+
+void JSONWriter::BeginObject() {
+  BeginValue();
+  Write('{');
+  needsComma = false;
+}
+
+void JSONWriter::WriteKey(const char* key, std::size_t length) {
+  BeginValue();
+  WriteQuoted(key, length);
+  Write(": ", 2);
+  needsComma = false;
+}
+
+void JSONWriter::EndObject() {
+  Write('}');
+  needsComma = true;
+}
+
+void JSONWriter::BeginArray() {
+  BeginValue();
+  Write('[');
+  needsComma = false;
+}
+
+void JSONWriter::EndArray() {
+  Write(']');
+  needsComma = true;
+}
+
+void JSONWriter::WriteString(const char* value, std::size_t length) {
+  BeginValue();
+  WriteQuoted(value, length);
+}
+
+void JSONWriter::WriteNumber(double value) {
+  BeginValue();
+
+  // Integers (the most common numbers) are written without the stream
+  // formatting, which would give the same result: stream default precision
+  // being 6 digits, integers up to 999999 are written with all their digits.
+  if (value > -1e6 && value < 1e6 && value == std::floor(value) &&
+      !(value == 0 && std::signbit(value))) {
+    char buffer[16];
+    char* bufferEnd = buffer + sizeof(buffer);
+    char* begin = FormatInteger(static_cast<long long>(value), bufferEnd);
+    Write(begin, bufferEnd - begin);
+    return;
+  }
+
+  stream << value;
+}
+
+void JSONWriter::WriteInt(int value) {
+  BeginValue();
+
+  char buffer[16];
+  char* bufferEnd = buffer + sizeof(buffer);
+  char* begin = FormatInteger(value, bufferEnd);
+  Write(begin, bufferEnd - begin);
+}
+
+void JSONWriter::WriteBool(bool value) {
+  BeginValue();
+  if (value)
+    Write("true", 4);
+  else
+    Write("false", 5);
+}
+
+void JSONWriter::WriteNull() {
+  BeginValue();
+  Write("null", 4);
+}
+
+bool JSONWriter::OnBeginObject() {
+  BeginObject();
+  return stream.good();
+}
+
+bool JSONWriter::OnKey(const char* key, std::size_t length) {
+  WriteKey(key, length);
+  return stream.good();
+}
+
+bool JSONWriter::OnEndObject() {
+  EndObject();
+  return stream.good();
+}
+
+bool JSONWriter::OnBeginArray() {
+  BeginArray();
+  return stream.good();
+}
+
+bool JSONWriter::OnEndArray() {
+  EndArray();
+  return stream.good();
+}
+
+bool JSONWriter::OnString(const char* value, std::size_t length) {
+  WriteString(value, length);
+  return stream.good();
+}
+
+bool JSONWriter::OnNumber(double value) {
+  WriteNumber(value);
+  return stream.good();
+}
+
+bool JSONWriter::OnBool(bool value) {
+  WriteBool(value);
+  return stream.good();
+}
+
+bool JSONWriter::OnNull() {
+  WriteNull();
+  return stream.good();
+}
+
+bool JSONWriter::OnInt(int value) {
+  WriteInt(value);
+  return stream.good();
+}
+
+}  // namespace gd
@@ -0,0 +1,86 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+
+#ifndef GDCORE_JSONWRITER_H
+#define GDCORE_JSONWRITER_H
+#include <cstddef>
+#include <iosfwd>
+#include "GDCore/Serialization/JSONReader.h"
+#include "GDCore/String.h"
+
+namespace gd {
+
+/**
+ * \brief Streaming JSON writer.
+ *
+ * The document is directly written to a std::ostream, so that large documents
+ * are never entirely stored in memory. Commas are automatically inserted
+ * between values.
+ *
+ * The output is the same as the one of gd::Serializer::ToJSON (which uses this
+ * writer).
+ *
+ * The writer is also a gd::JSONVisitor, so that it can receive the content
+ * of a document read by a gd::JSONReader or of a gd::SerializerElement (see
+ * gd::Serializer::VisitAsJSON).
+ */
+class GD_CORE_API JSONWriter : public JSONVisitor {
+ public:
+  JSONWriter(std::ostream& stream);
+  virtual ~JSONWriter(){};
+
+  void BeginObject();
+  void WriteKey(const char* key, std::size_t length);
+  void WriteKey(const gd::String& key) {
+    WriteKey(key.Raw().data(), key.Raw().size());
+  }
+  void EndObject();
+  void BeginArray();
+  void EndArray();
+  void WriteString(const char* value, std::size_t length);
+  void WriteString(const gd::String& value) {
+    WriteString(value.Raw().data(), value.Raw().size());
+  }
+  void WriteNumber(double value);
+  void WriteInt(int value);
+  void WriteBool(bool value);
+  void WriteNull();
+
+  /** \name gd::JSONVisitor implementation
+   */
+  ///@{
+  virtual bool OnBeginObject() override;
+  virtual bool OnKey(const char* key, std::size_t length) override;
+  virtual bool OnEndObject() override;
+  virtual bool OnBeginArray() override;
+  virtual bool OnEndArray() override;
+  virtual bool OnString(const char* value, std::size_t length) override;
+  virtual bool OnNumber(double value) override;
+  virtual bool OnBool(bool value) override;
+  virtual bool OnNull() override;
+  virtual bool OnInt(int value) override;
+  ///@}
+
+ private:
+  JSONWriter(const JSONWriter&) = delete;
+  JSONWriter& operator=(const JSONWriter&) = delete;
+
+  void BeginValue() {
+    if (needsComma) Write(',');
+    needsComma = true;
+  }
+  void Write(char c);
+  void Write(const char* str, std::size_t length);
+  void WriteQuoted(const char* str, std::size_t length);
+
+  std::ostream& stream;
+  bool needsComma;  ///< true if a value was just written in the current
+                    ///< object or array.
+};
+
+}  // namespace gd
+
+#endif
@@ -5,12 +5,16 @@
  */
 
 #include "GDCore/Serialization/Serializer.h"
-#include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 #include "GDCore/CommonTools.h"
+#include "GDCore/Serialization/BinarySnapshot.h"
+#include "GDCore/Serialization/FlatSerializerTree.h"
+#include "GDCore/Serialization/JSONReader.h"
+#include "GDCore/Serialization/JSONWriter.h"
 #include "GDCore/Serialization/SerializerElement.h"
 #if !defined(EMSCRIPTEN)
 #include "GDCore/TinyXml/tinyxml.h"
@@ -104,400 +108,272 @@ gd::String Serializer::ToEscapedXMLString(const gd::String& str) {
 }
 
 namespace {
+bool VisitValueAsJSON(const SerializerValue& value, JSONVisitor& visitor) {
+  if (value.IsBoolean())
+    return visitor.OnBool(value.GetBool());
+  else if (value.IsInt())
+    return visitor.OnInt(value.GetInt());
+  else if (value.IsDouble())
+    return visitor.OnNumber(value.GetDouble());
+
+  gd::String str = value.GetString();
+  return visitor.OnString(str.Raw().data(), str.Raw().size());
+}
 
 /**
- * Adapted from public domain library "jsoncpp"
- * (http://sourceforge.net/projects/jsoncpp/).
+ * \brief Build a gd::SerializerElement from the content of a JSON document.
  */
-static inline bool isControlCharacter(char ch) { return ch > 0 && ch <= 0x1F; }
+class SerializerElementBuilder : public JSONVisitor {
+ public:
+  SerializerElementBuilder(SerializerElement& root_) : root(root_){};
+  virtual ~SerializerElementBuilder(){};
+
+  virtual bool OnBeginObject() override {
+    elements.push_back(&AddElement());
+    return true;
+  }
+  virtual bool OnKey(const char* key, std::size_t length) override {
+    AssignString(currentKey, key, length);
+    return true;
+  }
+  virtual bool OnEndObject() override {
+    elements.pop_back();
+    return true;
+  }
+  virtual bool OnBeginArray() override {
+    SerializerElement& element = AddElement();
+    element.ConsiderAsArray();
+    elements.push_back(&element);
+    return true;
+  }
+  virtual bool OnEndArray() override {
+    elements.pop_back();
+    return true;
+  }
+  virtual bool OnString(const char* value, std::size_t length) override {
+    gd::String str;
+    AssignString(str, value, length);
+    AddElement().SetValue(str);
+    return true;
+  }
+  virtual bool OnNumber(double value) override {
+    AddElement().SetValue(value);
+    return true;
+  }
+  virtual bool OnBool(bool value) override {
+    AddElement().SetValue(value);
+    return true;
+  }
+  virtual bool OnNull() override {
+    // null was always unserialized as the number 0.
+    AddElement().SetValue(0.0);
+    return true;
+  }
 
-/**
- * Adapted from public domain library "jsoncpp"
- * (http://sourceforge.net/projects/jsoncpp/).
- */
-static bool containsControlCharacter(const char* str) {
-  while (*str) {
-    if (isControlCharacter(*(str++))) return true;
+ private:
+  /**
+   * \brief Return the element to be filled with the next value.
+   */
+  SerializerElement& AddElement() {
+    if (elements.empty()) return root;
+
+    SerializerElement& parent = *elements.back();
+    return parent.ConsideredAsArray() ? parent.AddChild("")
+                                      : parent.AddChild(currentKey);
   }
-  return false;
-}
 
-/**
- * Tool function converting a string to a quoted string that can be inserted
- * into a JSON file. Adapted from public domain library "jsoncpp"
- * (http://sourceforge.net/projects/jsoncpp/).
- */
-gd::String StringToQuotedJSONString(const char* value) {
-  if (value == NULL) return "";
-  // Not sure how to handle unicode...
-  if (strpbrk(value, "\"\\\b\f\n\r\t") == NULL &&
-      !containsControlCharacter(value))
-    return gd::String("\"") + value + "\"";
-  // We have to walk value and escape any special characters.
-  // Appending to std::string is not efficient, but this should be rare.
-  // (Note: forward slashes are *not* rare, but I am not escaping them.)
-  std::string::size_type maxsize =
-      strlen(value) * 2 + 3;  // allescaped+quotes+NULL
-  std::string result;
-  result.reserve(maxsize);  // to avoid lots of mallocs
-  result += "\"";
-  for (const char* c = value; *c != 0; ++c) {
-    switch (*c) {
-      case '\"':
-        result += "\\\"";
-        break;
-      case '\\':
-        result += "\\\\";
-        break;
-      case '\b':
-        result += "\\b";
-        break;
-      case '\f':
-        result += "\\f";
-        break;
-      case '\n':
-        result += "\\n";
-        break;
-      case '\r':
-        result += "\\r";
-        break;
-      case '\t':
-        result += "\\t";
-        break;
-      // case '/':
-      // Even though \/ is considered a legal escape in JSON, a bare
-      // slash is also legal, so I see no reason to escape it.
-      // (I hope I am not misunderstanding something.
-      // blep notes: actually escaping \/ may be useful in javascript to avoid
-      // </ sequence. Should add a flag to allow this compatibility mode and
-      // prevent this sequence from occurring.
-      default:
-        if (isControlCharacter(*c)) {
-          std::ostringstream oss;
-          oss << "\\u" << std::hex << std::uppercase << std::setfill('0')
-              << std::setw(4) << static_cast<int>(*c);
-          result += oss.str();
-        } else {
-          result += *c;
-        }
-        break;
-    }
+  static void AssignString(gd::String& str,
+                           const char* value,
+                           std::size_t length) {
+    str.RawMutable().assign(value, length);
+    if (!::utf8::is_valid(str.Raw().begin(), str.Raw().end()))
+      str.ReplaceInvalid();
+  }
+
+  SerializerElement& root;
+  std::vector<SerializerElement*> elements;  ///< The objects and arrays being
+                                             ///< filled.
+  gd::String currentKey;  ///< The key of the next value, if in an object.
+};
+
+bool ReadJSON(JSONReader& reader, FlatSerializerTree& tree) {
+  FlatSerializerTree::JSONBuilder builder(tree);
+  if (!reader.Read(builder)) {
+    std::cout << "Parsing error: " << reader.GetError() << " (at byte "
+              << reader.GetErrorPosition() << ")." << std::endl;
+    tree.Clear();
+    return false;
   }
-  result += "\"";
-  return gd::String::FromUTF8(result);
+
+  return true;
 }
 
-gd::String ValueToJSON(const SerializerValue& val) {
-  if (val.IsBoolean())
-    return val.GetBool() ? "true" : "false";
-  else if (val.IsInt())
-    return gd::String::From(val.GetInt());
-  else if (val.IsDouble())
-    return gd::String::From(val.GetDouble());
-  else
-    return StringToQuotedJSONString(val.GetString().c_str());
+SerializerElement ReadJSON(JSONReader& reader) {
+  SerializerElement element;
+  SerializerElementBuilder builder(element);
+  if (!reader.Read(builder)) {
+    std::cout << "Parsing error: " << reader.GetError() << " (at byte "
+              << reader.GetErrorPosition() << ")." << std::endl;
+  }
+
+  return element;
 }
 }  // namespace
 
-gd::String Serializer::ToJSON(const SerializerElement& element) {
-  if (element.IsValueUndefined()) {
-    if (element.ConsideredAsArray()) {
-      // Store the element as an array in JSON:
-      gd::String str = "[";
-      bool firstChild = true;
+bool Serializer::VisitAsJSON(const SerializerElement& element,
+                             JSONVisitor& visitor) {
+  if (!element.IsValueUndefined())
+    return VisitValueAsJSON(element.GetValue(), visitor);
+
+  if (element.ConsideredAsArray()) {
+    // Store the element as an array in JSON:
+    if (!visitor.OnBeginArray()) return false;
+
+    if (element.GetAllAttributes().size() > 0) {
+      std::cout << "ERROR: A SerializerElement is considered as an array of "
+                << (element.ConsideredAsArrayOf().empty()
+                        ? "[unnamed elements]"
+                        : element.ConsideredAsArrayOf())
+                << " but has attributes. These attributes won't be saved!"
+                << std::endl;
+    }
 
-      if (element.GetAllAttributes().size() > 0) {
+    const std::vector<
+        std::pair<gd::String, std::shared_ptr<SerializerElement> > >&
+        children = element.GetAllChildren();
+    for (size_t i = 0; i < children.size(); ++i) {
+      if (children[i].second == std::shared_ptr<SerializerElement>())
+        continue;
+      if (children[i].first != element.ConsideredAsArrayOf()) {
         std::cout << "ERROR: A SerializerElement is considered as an array of "
                   << (element.ConsideredAsArrayOf().empty()
                           ? "[unnamed elements]"
                           : element.ConsideredAsArrayOf())
-                  << " but has attributes. These attributes won't be saved!"
-                  << std::endl;
+                  << " but has a child called \"" << children[i].first
+                  << "\". This child won't be saved!" << std::endl;
+        continue;
       }
 
-      const std::vector<
-          std::pair<gd::String, std::shared_ptr<SerializerElement> > >&
-          children = element.GetAllChildren();
-      for (size_t i = 0; i < children.size(); ++i) {
-        if (children[i].second == std::shared_ptr<SerializerElement>())
-          continue;
-        if (children[i].first != element.ConsideredAsArrayOf()) {
-          std::cout
-              << "ERROR: A SerializerElement is considered as an array of "
-              << (element.ConsideredAsArrayOf().empty()
-                      ? "[unnamed elements]"
-                      : element.ConsideredAsArrayOf())
-              << " but has a child called \"" << children[i].first
-              << "\". This child won't be saved!" << std::endl;
-          continue;
-        }
-
-        if (!firstChild) str += ",";
-        str += ToJSON(*children[i].second);
-
-        firstChild = false;
-      }
+      if (!VisitAsJSON(*children[i].second, visitor)) return false;
+    }
 
-      str += "]";
-      return str;
-    } else {
-      gd::String str = "{";
-      bool firstChild = true;
-
-      const std::map<gd::String, SerializerValue>& attributes =
-          element.GetAllAttributes();
-      for (std::map<gd::String, SerializerValue>::const_iterator it =
-               attributes.begin();
-           it != attributes.end();
-           ++it) {
-        if (!firstChild) str += ",";
-        str += StringToQuotedJSONString(it->first.c_str()) + ": " +
-               ValueToJSON(it->second);
-
-        firstChild = false;
-      }
+    return visitor.OnEndArray();
+  } else {
+    if (!visitor.OnBeginObject()) return false;
+
+    const std::map<gd::String, SerializerValue>& attributes =
+        element.GetAllAttributes();
+    for (std::map<gd::String, SerializerValue>::const_iterator it =
+             attributes.begin();
+         it != attributes.end();
+         ++it) {
+      if (!visitor.OnKey(it->first.Raw().data(), it->first.Raw().size()) ||
+          !VisitValueAsJSON(it->second, visitor))
+        return false;
+    }
 
-      const std::vector<
-          std::pair<gd::String, std::shared_ptr<SerializerElement> > >&
-          children = element.GetAllChildren();
-      for (size_t i = 0; i < children.size(); ++i) {
-        if (children[i].second == std::shared_ptr<SerializerElement>())
-          continue;
-
-        if (attributes.find(children[i].first) != attributes.end()) {
-          std::cout << "ERROR: An attribute and a children called \""
-                    << children[i].first
-                    << "\" both exist. The children will erase the attribute - "
-                       "fix the usage of the attribute or (better) use "
-                       "children methods only."
-                    << std::endl;
-        }
-
-        if (!firstChild) str += ",";
-        str += StringToQuotedJSONString(children[i].first.c_str()) + ": " +
-               ToJSON(*children[i].second);
-
-        firstChild = false;
+    const std::vector<
+        std::pair<gd::String, std::shared_ptr<SerializerElement> > >&
+        children = element.GetAllChildren();
+    for (size_t i = 0; i < children.size(); ++i) {
+      if (children[i].second == std::shared_ptr<SerializerElement>())
+        continue;
+
+      if (attributes.find(children[i].first) != attributes.end()) {
+        std::cout << "ERROR: An attribute and a children called \""
+                  << children[i].first
+                  << "\" both exist. The children will erase the attribute - "
+                     "fix the usage of the attribute or (better) use "
+                     "children methods only."
+                  << std::endl;
       }
 
-      str += "}";
-      return str;
+      const gd::String& name = children[i].first;
+      if (!visitor.OnKey(name.Raw().data(), name.Raw().size()) ||
+          !VisitAsJSON(*children[i].second, visitor))
+        return false;
     }
-  } else {
-    return ValueToJSON(element.GetValue());
-  }
-}
 
-// Private functions for JSON parsing
-namespace {
-size_t SkipBlankChar(const std::string& str, size_t pos) {
-  const std::string blankChar = " \n";
-  return str.find_first_not_of(blankChar, pos);
+    return visitor.OnEndObject();
+  }
 }
 
-/**
- * Adapted from https://github.com/hjiang/jsonxx
- */
-std::string DecodeString(const std::string& original) {
-  std::string value;
-  value.reserve(original.size());
-  std::istringstream input("\"" + original + "\"");
-
-  char ch = '\0', delimiter = '"';
-  input.get(ch);
-  if (ch != delimiter) return "";
-
-  while (!input.eof() && input.good()) {
-    input.get(ch);
-    if (ch == delimiter) {
-      break;
-    }
-    if (ch == '\\') {
-      input.get(ch);
-      switch (ch) {
-        case '\\':
-        case '/':
-          value.push_back(ch);
-          break;
-        case 'b':
-          value.push_back('\b');
-          break;
-        case 'f':
-          value.push_back('\f');
-          break;
-        case 'n':
-          value.push_back('\n');
-          break;
-        case 'r':
-          value.push_back('\r');
-          break;
-        case 't':
-          value.push_back('\t');
-          break;
-        case 'u': {
-          int i;
-          std::stringstream ss;
-          for (i = 0; (!input.eof() && input.good()) && i < 4; ++i) {
-            input.get(ch);
-            ss << ch;
-          }
-          if (input.good() && (ss >> i)) value.push_back(i);
-        } break;
-        default:
-          if (ch != delimiter) {
-            value.push_back('\\');
-            value.push_back(ch);
-          } else
-            value.push_back(ch);
-          break;
-      }
-    } else {
-      value.push_back(ch);
-    }
-  }
-  if (input && ch == delimiter) {
-    return value;
-  } else {
-    return "";
-  }
+void Serializer::ToJSON(const SerializerElement& element,
+                        std::ostream& stream) {
+  JSONWriter writer(stream);
+  VisitAsJSON(element, writer);
 }
 
-/**
- * Return the position of the end of the string. Blank are skipped if necessary
- * @param str The string to be used
- * @param startPos The start position
- * @param strContent A reference to a string that will be filled with the string
- * content.
- */
-size_t SkipString(const std::string& str,
-                  size_t startPos,
-                  std::string& strContent) {
-  startPos = SkipBlankChar(str, startPos);
-  if (startPos >= str.length()) return std::string::npos;
+gd::String Serializer::ToJSON(const SerializerElement& element) {
+  std::ostringstream stream;
+  ToJSON(element, stream);
 
-  size_t endPos = startPos;
+  gd::String json;
+  json.RawMutable() = stream.str();
+  return json;
+}
 
-  if (str[startPos] == '"') {
-    if (startPos + 1 >= str.length()) return std::string::npos;
+SerializerElement Serializer::FromJSON(const char* json, std::size_t size) {
+  if (size == 0) return SerializerElement();
 
-    while (endPos == startPos || (str[endPos - 1] == '\\')) {
-      endPos = str.find_first_of('\"', endPos + 1);
-      if (endPos == std::string::npos)
-        return std::string::npos;  // Invalid string
-    }
+  JSONReader reader(json, size);
+  return ReadJSON(reader);
+}
 
-    strContent = DecodeString(str.substr(startPos + 1, endPos - 1 - startPos));
-    return endPos;
-  }
+SerializerElement Serializer::FromJSON(const std::string& jsonStr) {
+  return FromJSON(jsonStr.data(), jsonStr.size());
+}
 
-  endPos = str.find_first_of(" \n,:");
-  if (endPos >= str.length()) return std::string::npos;  // Invalid string
+SerializerElement Serializer::FromJSON(std::istream& stream) {
+  JSONReader reader(stream);
+  return ReadJSON(reader);
+}
 
-  strContent = DecodeString(str.substr(startPos, endPos - 1 - startPos));
-  return endPos - 1;
+bool Serializer::FromJSON(const char* json,
+                          std::size_t size,
+                          FlatSerializerTree& tree) {
+  JSONReader reader(json, size);
+  return ReadJSON(reader, tree);
 }
 
-/**
- * Parse a JSON string, starting from pos, and storing the result into the
- * specified element. Note that the parsing is stopped as soon as a valid object
- * is parsed. \return The position at the end of the valid object stored into
- * the element.
- */
-size_t ParseJSONObject(const std::string& jsonStr,
-                       size_t startPos,
-                       gd::SerializerElement& element) {
-  size_t pos = SkipBlankChar(jsonStr, startPos);
-  if (pos >= jsonStr.length()) return std::string::npos;
-
-  if (jsonStr[pos] == '{')  // Object
-  {
-    bool firstChild = true;
-    while (firstChild || jsonStr[pos] == ',') {
-      pos++;
-      if (pos < jsonStr.length() && jsonStr[pos] == '}') break;
-
-      std::string childName;
-      pos = SkipString(jsonStr, pos, childName);
-
-      pos++;
-      pos = SkipBlankChar(jsonStr, pos);
-      if (pos >= jsonStr.length() || jsonStr[pos] != ':')
-        return std::string::npos;
-
-      pos++;
-      pos = ParseJSONObject(
-          jsonStr,
-          pos,
-          element.AddChild(gd::String::FromUTF8(childName).ReplaceInvalid()));
-
-      pos = SkipBlankChar(jsonStr, pos);
-      if (pos >= jsonStr.length()) return std::string::npos;
-      firstChild = false;
-    }
+bool Serializer::FromJSON(std::istream& stream, FlatSerializerTree& tree) {
+  JSONReader reader(stream);
+  return ReadJSON(reader, tree);
+}
 
-    if (jsonStr[pos] != '}') {
-      std::cout << "Parsing error: Object not properly formed.";
-      return std::string::npos;
-    }
-    return pos + 1;
-  } else if (jsonStr[pos] == '[')  // Array
-  {
-    element.ConsiderAsArray();
-    unsigned int index = 0;
-    while (index == 0 || jsonStr[pos] == ',') {
-      pos++;
-      if (pos < jsonStr.length() && jsonStr[pos] == ']') break;
-      pos = ParseJSONObject(jsonStr, pos, element.AddChild(""));
-
-      pos = SkipBlankChar(jsonStr, pos);
-      if (pos >= jsonStr.length()) {
-        std::cout << "Parsing error: element of array not properly formed.";
-        return std::string::npos;
-      }
-      index++;
-    }
+std::string Serializer::ToBinary(const SerializerElement& element) {
+  BinarySnapshotWriter writer;
+  VisitAsJSON(element, writer);
 
-    if (jsonStr[pos] != ']') {
-      std::cout << "Parsing error: array not properly ended";
-      return std::string::npos;
-    }
-    return pos + 1;
-  } else if (jsonStr[pos] == '"')  // String
-  {
-    std::string str;
-    pos = SkipString(jsonStr, pos, str);
-    if (pos >= jsonStr.length()) {
-      std::cout << "Parsing error: Invalid string";
-      return std::string::npos;
-    }
+  std::string snapshot;
+  writer.Write(snapshot);
+  return snapshot;
+}
 
-    element.SetValue(gd::String::FromUTF8(str).ReplaceInvalid());
-    return pos + 1;
-  } else  // Number or boolean
-  {
-    std::string str;
-    size_t endPos = pos;
-    const std::string separators = " \n,}]";
-    while (endPos < jsonStr.length() &&
-           separators.find_first_of(jsonStr[endPos]) == std::string::npos) {
-      endPos++;
-    }
+void Serializer::ToBinary(const SerializerElement& element,
+                          std::ostream& stream) {
+  BinarySnapshotWriter writer;
+  VisitAsJSON(element, writer);
+  writer.Write(stream);
+}
 
-    str = jsonStr.substr(pos, endPos - pos);
-    if (str == "true")
-      element.SetValue(true);
-    else if (str == "false")
-      element.SetValue(false);
-    else
-      element.SetValue(gd::String::FromUTF8(str).To<double>());
-    return endPos;
+SerializerElement Serializer::FromBinary(const char* data, std::size_t size) {
+  BinarySnapshot snapshot(data, size);
+  if (!snapshot.IsValid()) {
+    std::cout << "Invalid binary snapshot." << std::endl;
+    return SerializerElement();
   }
+
+  return FromBinary(snapshot.GetRoot());
 }
-}  // namespace
 
-SerializerElement Serializer::FromJSON(const std::string& jsonStr) {
+SerializerElement Serializer::FromBinary(
+    const BinarySnapshotElement& snapshotElement) {
   SerializerElement element;
-  if (!jsonStr.empty()) gd::ParseJSONObject(jsonStr, 0, element);
+  SerializerElementBuilder builder(element);
+  if (!snapshotElement.Visit(builder))
+    std::cout << "Error while decoding a binary snapshot." << std::endl;
+
   return element;
 }
 
@@ -6,9 +6,16 @@
 
 #ifndef GDCORE_SERIALIZER_H
 #define GDCORE_SERIALIZER_H
+#include <cstddef>
+#include <iosfwd>
 #include <string>
 #include "GDCore/Serialization/SerializerElement.h"
 class TiXmlElement;
+namespace gd {
+class JSONVisitor;
+class FlatSerializerTree;
+class BinarySnapshotElement;
+}
 
 namespace gd {
 
@@ -42,14 +49,97 @@ class GD_CORE_API Serializer {
    */
   static gd::String ToJSON(const SerializerElement& element);
 
+  /**
+   * \brief Serialize a gd::SerializerElement to JSON, directly written into a
+   * stream (without storing the whole JSON string in memory).
+   */
+  static void ToJSON(const SerializerElement& element, std::ostream& stream);
+
   static SerializerElement FromJSON(const std::string& json);
 
   /**
    * \brief Parse a JSON string and returns a gd::SerializerElement for it.
    */
   static SerializerElement FromJSON(const gd::String& json) {
-    return FromJSON(json.ToUTF8());
+    return FromJSON(json.Raw());
   }
+
+  /**
+   * \brief Parse the JSON stored in a buffer and returns a
+   * gd::SerializerElement for it.
+   */
+  static SerializerElement FromJSON(const char* json, std::size_t size);
+
+  /**
+   * \brief Parse the JSON read from a stream and returns a
+   * gd::SerializerElement for it, without storing the whole JSON string in
+   * memory.
+   */
+  static SerializerElement FromJSON(std::istream& stream);
+
+  /**
+   * \brief Parse the JSON stored in a buffer into a gd::FlatSerializerTree,
+   * which is faster to build and uses less memory than a
+   * gd::SerializerElement, for read-only usages.
+   *
+   * \return false if the JSON is invalid (the tree is then empty).
+   */
+  static bool FromJSON(const char* json,
+                       std::size_t size,
+                       FlatSerializerTree& tree);
+
+  /**
+   * \brief Parse the JSON read from a stream into a gd::FlatSerializerTree.
+   *
+   * \return false if the JSON is invalid (the tree is then empty).
+   */
+  static bool FromJSON(std::istream& stream, FlatSerializerTree& tree);
+
+  /**
+   * \brief Send the content of a gd::SerializerElement to a visitor, as if it
+   * was read from its JSON serialization by a gd::JSONReader.
+   *
+   * Used to stream an element to a gd::JSONWriter or to any other consumer of
+   * JSON, without building the JSON string.
+   *
+   * \return false if the visitor stopped the visit.
+   */
+  static bool VisitAsJSON(const SerializerElement& element,
+                          JSONVisitor& visitor);
+  ///@}
+
+  /** \name Binary serialization.
+   * Serialize a SerializerElement from/to a binary snapshot (see
+   * gd::BinarySnapshotWriter), which is smaller and faster to read than JSON.
+   * A snapshot contains exactly the same information as the JSON
+   * serialization.
+   */
+  ///@{
+  /**
+   * \brief Serialize a gd::SerializerElement to a binary snapshot.
+   */
+  static std::string ToBinary(const SerializerElement& element);
+
+  /**
+   * \brief Serialize a gd::SerializerElement to a binary snapshot, written
+   * into a stream.
+   */
+  static void ToBinary(const SerializerElement& element, std::ostream& stream);
+
+  /**
+   * \brief Decode a binary snapshot and return a gd::SerializerElement for it
+   * (the same as the one returned by FromJSON for the JSON serialization).
+   */
+  static SerializerElement FromBinary(const char* data, std::size_t size);
+
+  /**
+   * \brief Decode an element of a binary snapshot (and its children) and
+   * return a gd::SerializerElement for it, the rest of the snapshot being left
+   * untouched.
+   *
+   * This allows to decode only a layout or an external layout of a project.
+   */
+  static SerializerElement FromBinary(const BinarySnapshotElement& element);
   ///@}
 
   virtual ~Serializer(){};
@@ -6,6 +6,9 @@
 
 #include "GDCore/String.h"
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
 #include <SFML/System/String.hpp>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Utf8/utf8proc.h"
@@ -14,30 +17,119 @@ namespace gd
 {
 
 constexpr String::size_type String::npos;
+constexpr String::size_type String::indexInterval;
+constexpr String::size_type String::minIndexedSize;
 
-String::String() : m_string()
+namespace
 {
+    bool IsContinuationByte(char byte)
+    {
+        return (static_cast<unsigned char>(byte) & 0xC0) == 0x80;
+    }
+
+    /**
+     * Count the characters of an UTF8 encoded buffer, i.e. the bytes that are
+     * not continuation bytes (10xxxxxx), 8 bytes at a time.
+     */
+    std::size_t CountCharacters(const char *begin, const char *end)
+    {
+        const std::size_t length = end - begin;
+        std::size_t continuationBytesCount = 0;
 
+        std::size_t i = 0;
+        for(; i + 8 <= length; i += 8)
+        {
+            std::uint64_t bytes;
+            std::memcpy(&bytes, begin + i, 8);
+
+            //Keep the 7th bit of the bytes having their 6th bit not set...
+            std::uint64_t continuationBytes =
+                bytes & ~(bytes << 1) & 0x8080808080808080ULL;
+            //...and sum them in the highest byte.
+            continuationBytesCount +=
+                ((continuationBytes >> 7) * 0x0101010101010101ULL) >> 56;
+        }
+        for(; i < length; ++i)
+        {
+            if(IsContinuationByte(begin[i]))
+                continuationBytesCount++;
+        }
+
+        return length - continuationBytesCount;
+    }
 }
 
-String::String(const char *characters) : m_string()
+String::String() : m_string(), m_sizeCache(0), m_index(nullptr)
+{
+
+}
+
+String::String(const char *characters) : m_string(), m_sizeCache(0), m_index(nullptr)
 {
     *this = characters;
 }
 
-String::String(const sf::String &string) : m_string()
+String::String(const sf::String &string) : m_string(), m_sizeCache(0), m_index(nullptr)
 {
     *this = string;
 }
 
-String::String(const std::u32string &string) : m_string()
+String::String(const std::u32string &string) : m_string(), m_sizeCache(0), m_index(nullptr)
 {
     *this = string;
 }
 
+String::String(const String &other) :
+    m_string(other.m_string),
+    m_sizeCache(other.m_sizeCache.load(std::memory_order_relaxed)),
+    m_index(nullptr)
+{
+
+}
+
+String::String(String &&other) :
+    m_string(std::move(other.m_string)),
+    m_sizeCache(other.m_sizeCache.load(std::memory_order_relaxed)),
+    m_index(other.m_index.exchange(nullptr))
+{
+    other.InvalidateCache();
+}
+
+String::~String()
+{
+    delete m_index.load(std::memory_order_relaxed);
+}
+
+String& String::operator=(const String &other)
+{
+    if(this == &other)
+        return *this;
+
+    m_string = other.m_string;
+    InvalidateCache();
+    m_sizeCache.store(other.m_sizeCache.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    return *this;
+}
+
+String& String::operator=(String &&other)
+{
+    if(this == &other)
+        return *this;
+
+    m_string = std::move(other.m_string);
+    InvalidateCache();
+    m_sizeCache.store(other.m_sizeCache.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_index.store(other.m_index.exchange(nullptr));
+    other.InvalidateCache();
+
+    return *this;
+}
+
 String& String::operator=(const char *characters)
 {
     m_string = std::string(characters);
+    InvalidateCache();
     return *this;
 }
 
@@ -57,6 +149,7 @@ String& String::operator=(const sf::String &string)
     }
 
     m_string.shrink_to_fit();
+    InvalidateCache();
 
     return *this;
 }
@@ -77,13 +170,113 @@ String& String::operator=(const std::u32string &string)
     }
 
     m_string.shrink_to_fit();
+    InvalidateCache();
 
     return *this;
 }
 
 String::size_type String::size() const
 {
-    return std::distance(begin(), end());
+    const std::uint64_t byteSize = m_string.size();
+    const std::uint64_t sizeCache = m_sizeCache.load(std::memory_order_relaxed);
+    if((sizeCache >> 32) == byteSize + 1)
+        return sizeCache & 0xFFFFFFFF;
+
+    const size_type charactersCount = CountCharacters(m_string.data(), m_string.data() + m_string.size());
+    if(byteSize < 0xFFFFFFFF)
+        m_sizeCache.store(((byteSize + 1) << 32) | charactersCount, std::memory_order_relaxed);
+
+    return charactersCount;
+}
+
+void String::InvalidateCache()
+{
+    m_sizeCache.store(0, std::memory_order_relaxed);
+    if(m_index.load(std::memory_order_relaxed))
+        delete m_index.exchange(nullptr);
+}
+
+const std::vector<std::uint32_t>* String::GetIndex() const
+{
+    if(m_string.size() < minIndexedSize || m_string.size() >= 0xFFFFFFFF)
+        return nullptr;
+
+    Index *index = m_index.load(std::memory_order_acquire);
+    if(index && index->byteSize == m_string.size())
+        return &index->positions;
+
+    std::unique_ptr<Index> newIndex(new Index());
+    newIndex->byteSize = m_string.size();
+    newIndex->positions.reserve(size() / indexInterval + 1);
+    size_type position = 0;
+    for(std::string::size_type i = 0; i < m_string.size(); ++i)
+    {
+        if(IsContinuationByte(m_string[i]))
+            continue;
+
+        if(position % indexInterval == 0)
+            newIndex->positions.push_back(i);
+        position++;
+    }
+
+    //Another thread may have built the index in the meantime.
+    if(!m_index.compare_exchange_strong(index, newIndex.get()))
+        return &index->positions;
+
+    //A previous index is stale (the string was modified through RawMutable).
+    //Other threads may still read it, so it's only deleted when the string is
+    //modified again.
+    newIndex->staleIndex.reset(index);
+    return &newIndex.release()->positions;
+}
+
+std::string::size_type String::GetByteOffset( String::size_type position ) const
+{
+    const size_type charactersCount = size();
+    if(position >= charactersCount)
+        return m_string.size();
+    if(charactersCount == m_string.size()) //Only ASCII characters
+        return position;
+
+    std::string::size_type byteOffset = 0;
+    size_type remainingCharacters = position;
+    const std::vector<std::uint32_t> *index = GetIndex();
+    if(index && position / indexInterval < index->size())
+    {
+        byteOffset = std::min<std::string::size_type>((*index)[position / indexInterval], m_string.size());
+        remainingCharacters = position % indexInterval;
+    }
+
+    const std::string::size_type byteSize = m_string.size();
+    for(; remainingCharacters > 0 && byteOffset < byteSize; --remainingCharacters)
+    {
+        ++byteOffset;
+        while(byteOffset < byteSize && IsContinuationByte(m_string[byteOffset]))
+            ++byteOffset;
+    }
+
+    return byteOffset;
+}
+
+String::size_type String::GetCharacterPosition( std::string::size_type byteOffset ) const
+{
+    byteOffset = std::min(byteOffset, m_string.size());
+    if(size() == m_string.size()) //Only ASCII characters
+        return byteOffset;
+
+    const std::vector<std::uint32_t> *index = GetIndex();
+    if(!index || index->empty())
+        return CountCharacters(m_string.data(), m_string.data() + byteOffset);
+
+    //Start from the last indexed character before the offset.
+    std::vector<std::uint32_t>::const_iterator indexIt =
+        std::upper_bound(index->begin(), index->end(), byteOffset);
+    if(indexIt != index->begin())
+        --indexIt;
+
+    std::string::size_type indexedOffset = std::min<std::string::size_type>(*indexIt, byteOffset);
+    return (indexIt - index->begin()) * indexInterval +
+        CountCharacters(m_string.data() + indexedOffset, m_string.data() + byteOffset);
 }
 
 String::iterator String::begin()
@@ -150,9 +343,9 @@ String String::FromWide( const std::wstring &wstr )
     String str;
 
     #ifdef WINDOWS //std::wstring is an UTF16 string on Windows
-    ::utf8::utf16to8(wstr.begin(), wstr.end(), std::back_inserter(str.Raw()));
+    ::utf8::utf16to8(wstr.begin(), wstr.end(), std::back_inserter(str.RawMutable()));
     #else //and a UTF32 string on other OSes
-    ::utf8::utf32to8(wstr.begin(), wstr.end(), std::back_inserter(str.Raw()));
+    ::utf8::utf32to8(wstr.begin(), wstr.end(), std::back_inserter(str.RawMutable()));
     #endif
 
     return str;
@@ -231,20 +424,20 @@ String& String::ReplaceInvalid( value_type replacement )
     ::utf8::replace_invalid(m_string.begin(), m_string.end(), std::back_inserter(validStr), replacement);
 
     m_string = validStr;
+    InvalidateCache();
 
     return *this;
 }
 
 String::value_type String::operator[]( const String::size_type position ) const
 {
-    const_iterator it = begin();
-    std::advance(it, position);
-    return *it;
+    return ::utf8::unchecked::peek_next(m_string.begin() + GetByteOffset(position));
 }
 
 String& String::operator+=( const String &other )
 {
     m_string += other.m_string;
+    InvalidateCache();
     return *this;
 }
 
@@ -263,20 +456,23 @@ String& String::operator+=( value_type character )
 void String::push_back( String::value_type character )
 {
     ::utf8::unchecked::append(character, std::back_inserter(m_string));
+    InvalidateCache();
 }
 
 void String::pop_back()
 {
     m_string.erase((--end()).base(), end().base());
+    InvalidateCache();
 }
 
 String& String::insert( size_type pos, const String &str )
 {
-    iterator it = begin();
-    std::advance(it, pos);
+    if(pos > size())
+        throw std::out_of_range("[gd::String::insert] pos greater than size");
 
-    //Use the real position as bytes using the std::string::iterators
-    m_string.insert( std::distance(m_string.begin(), it.base()), str.m_string );
+    //Use the real position as bytes
+    m_string.insert( GetByteOffset(pos), str.m_string );
+    InvalidateCache();
 
     return *this;
 }
@@ -284,54 +480,57 @@ String& String::insert( size_type pos, const String &str )
 String& String::replace( iterator i1, iterator i2, const String &str )
 {
     m_string.replace(i1.base(), i2.base(), str.m_string);
+    InvalidateCache();
 
     return *this;
 }
 
 String& String::replace( String::size_type pos, String::size_type len, const String &str )
 {
-    if(pos > size())
+    const size_type charactersCount = size();
+    if(pos > charactersCount)
         throw std::out_of_range("[gd::String::replace] starting pos greater than size");
 
-    iterator i1 = begin();
-    std::advance( i1, pos );
+    //Stop at the end of the string if len is too large
+    std::string::size_type begin = GetByteOffset(pos);
+    std::string::size_type end = len >= charactersCount - pos ?
+        m_string.size() : GetByteOffset(pos + len);
 
-    iterator i2 = i1;
-    while(i2 != end() && len > 0) //Increment "len" times and stop if end() is reached
-    {
-        ++i2;
-        --len;
-    }
+    m_string.replace( begin, end - begin, str.m_string );
+    InvalidateCache();
 
-    return replace( i1, i2, str );
+    return *this;
 }
 
 String::iterator String::erase( String::iterator first, String::iterator last )
 {
-    return iterator( m_string.erase( first.base(), last.base() ) );
+    iterator it( m_string.erase( first.base(), last.base() ) );
+    InvalidateCache();
+
+    return it;
 }
 
 String::iterator String::erase( String::iterator p )
 {
-    return iterator( m_string.erase( p.base() ) );
+    iterator it( m_string.erase( p.base() ) );
+    InvalidateCache();
+
+    return it;
 }
 
 void String::erase( String::size_type pos, String::size_type len )
 {
-    if(pos > size())
+    const size_type charactersCount = size();
+    if(pos > charactersCount)
         throw std::out_of_range("[gd::String::erase] starting pos greater than size");
 
-    iterator i1 = begin();
-    std::advance(i1, pos);
-
-    iterator i2 = i1;
-    while(i2 != end() && len != 0) //Increment "len" times and stop if end() is reached
-    {
-        ++i2;
-        len--;
-    }
+    //Stop at the end of the string if len is too large
+    std::string::size_type begin = GetByteOffset(pos);
+    std::string::size_type end = len >= charactersCount - pos ?
+        m_string.size() : GetByteOffset(pos + len);
 
-    erase( i1, i2 );
+    m_string.erase( begin, end - begin );
+    InvalidateCache();
 }
 
 std::vector<String> String::Split( String::value_type delimiter ) const
@@ -417,6 +616,7 @@ String& String::Normalize(String::NormForm form)
         newStr = utf8proc_NFKC((unsigned char*)m_string.c_str());
 
     m_string = (char*)newStr;
+    InvalidateCache();
 
     free(newStr);
 
@@ -427,50 +627,34 @@ String String::substr( String::size_type start, String::size_type length ) const
 {
     String str;
 
-    const_iterator startIt = begin();
-    while(start > 0 && startIt != end())
-    {
-        ++startIt;
-        --start;
-    }
-    if(start > 0) //We reach the end of the string before the start position
+    const size_type charactersCount = size();
+    if(start > charactersCount) //The start position is after the end of the string
         throw std::out_of_range("[gd::String::substr] starting pos greater than size");
 
-    const_iterator endIt = startIt;
-    while(length > 0 && endIt != end())
-    {
-        ++endIt;
-        --length;
-    }
+    //Stop at the end of the string if length is too large
+    std::string::size_type begin = GetByteOffset(start);
+    std::string::size_type end = length >= charactersCount - start ?
+        m_string.size() : GetByteOffset(start + length);
 
-    str.m_string = std::string( startIt.base(), endIt.base() );
+    str.m_string.assign( m_string, begin, end - begin );
 
     return str;
 }
 
 String::size_type String::find( const String &search, String::size_type pos ) const
 {
-    const_iterator it = begin();
-
-    //Move to pos
-    if(pos < size())
-        std::advance( it, pos );
-    else
+    if(pos >= size())
         return npos;
 
-    //Use the standard std::string to find a string (using their internal std::strings).
-    //Use the raw std::string iterator to get the offset as a **byte** count for the starting
-    //position.
+    //Use the standard std::string to find a string (using their internal std::strings),
+    //starting from the position of the character as a **byte** count.
     std::string::size_type findPos =
-        m_string.find( search.m_string, std::distance( m_string.begin(), it.base() ) );
+        m_string.find( search.m_string, GetByteOffset(pos) );
 
     if( findPos != std::string::npos )
     {
-        //Create a String::iterator from the std::string::iterator pointing to the find result.
-        const_iterator findPosIt( m_string.begin() + findPos );
-
-        //Return the distance in **characters** count (that's why we need a String::iterator).
-        return std::distance( begin(), findPosIt );
+        //Return the position in **characters** count.
+        return GetCharacterPosition(findPos);
     }
     else
         return npos;
@@ -488,32 +672,17 @@ String::size_type String::find( const String::value_type search, String::size_ty
 
 String::size_type String::rfind( const String &search, String::size_type pos ) const
 {
-    //Move to pos + 1 (we will then get the last byte of the character at pos)
-    const_iterator it = begin();
-    std::string::const_iterator baseIt;
-    if( pos < size() ) //little optimization by testing npos directly (avoid calculating size())
-    {
-        std::advance( it, pos + 1 );
-        baseIt = it.base();
-        --baseIt; //Decrement the std::string::iterator by one because we need
-        //it to point to the last byte of the character at pos
-    }
-
     //The last character is included, so we need to put the position
-    //of the last byte of the character at the position "pos"
+    //of the last byte of the character at the position "pos" (the byte
+    //before the character at pos + 1)
     std::string::size_type findPos = m_string.rfind( search.m_string,
-        pos < size() ? std::distance( m_string.begin(), baseIt ) : std::string::npos
+        pos < size() ? GetByteOffset(pos + 1) - 1 : std::string::npos
         );
 
     if( findPos != std::string::npos )
     {
-        //Create a String::iterator to the find position to be able to get the real
-        //distance as characters count (it would be a distance as bytes count
-        //with a std::string::iterator)
-        const_iterator findPosIt( m_string.begin() + findPos );
-
-        //Return the distance (which is a distance as characters count)
-        return std::distance( begin(), findPosIt );
+        //Return the position as characters count
+        return GetCharacterPosition(findPos);
     }
     else
         return npos;
@@ -7,9 +7,12 @@
 #ifndef GDCORE_UTF8_STRING_H
 #define GDCORE_UTF8_STRING_H
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -126,6 +129,12 @@ public:
      */
     String(const sf::String &string);
 
+    String(const String &other);
+
+    String(String &&other);
+
+    ~String();
+
 /**
  * \}
  */
@@ -150,6 +159,10 @@ public:
 
     String& operator=(const std::u32string &string);
 
+    String& operator=(const String &other);
+
+    String& operator=(String &&other);
+
 /**
  * \}
  */
@@ -166,6 +179,9 @@ public:
 
     /**
      * \brief Returns the string's length.
+     *
+     * \note The length is computed once and cached until the string is
+     * modified, so this is constant time except for the first call.
      */
     size_type size() const;
 
@@ -179,7 +195,7 @@ public:
      *
      * **Iterators :** Obviously, all iterators are invalidated.
      */
-    void clear() { m_string.clear(); }
+    void clear() { m_string.clear(); InvalidateCache(); }
 
 /**
  * \}
@@ -366,21 +382,33 @@ public:
 
     /**
      * \brief Returns the code point at the specified position
-     * \warning This operator has a linear complexity on the character's
-     * position. You should avoid to use it in a loop and use the iterators
-     * provided by this class instead.
+     *
+     * This is constant time for strings containing only ASCII characters.
+     * For other strings, the position of the characters are indexed the
+     * first time a character is accessed in a long string, then the access is
+     * constant time too (until the string is modified).
+     * Iterators are still the fastest way to go through a string.
      */
     value_type operator[]( const size_type position ) const;
 
     /**
      * \brief Get the raw UTF8-encoded std::string
+     *
+     * \note The caches are left untouched, so this can be called from several
+     * threads at the same time.
      */
-    std::string& Raw() { return m_string; }
+    const std::string& Raw() const { return m_string; }
 
     /**
-     * \brief Get the raw UTF8-encoded std::string
+     * \brief Get the raw UTF8-encoded std::string, to modify it.
+     *
+     * \warning The cached length and positions of characters are reset when
+     * this is called. They are computed again if the size of the string
+     * changed, but a modification keeping the same size in bytes after other
+     * methods were called is not detected: call RawMutable again before
+     * modifying the string in this case.
      */
-    const std::string& Raw() const { return m_string; }
+    std::string& RawMutable() { InvalidateCache(); return m_string; }
 
     /**
      * \brief Get the C-string.
@@ -633,8 +661,66 @@ public:
  */
 
 private:
+    /**
+     * Number of characters between two entries of the characters positions
+     * index (see GetByteOffset).
+     */
+    static constexpr size_type indexInterval = 32;
+
+    /**
+     * Strings with less bytes than this are never indexed.
+     */
+    static constexpr size_type minIndexedSize = 128;
+
+    /**
+     * \brief The positions of the characters of a string, see GetIndex.
+     */
+    struct Index
+    {
+        std::string::size_type byteSize; ///< The size in bytes of the string when the index was built.
+        std::vector<std::uint32_t> positions; ///< The position in bytes of every indexInterval-th character.
+        std::unique_ptr<Index> staleIndex; ///< The index replaced by this one, which may still be read by other threads.
+    };
+
+    /**
+     * \brief Return the position, in bytes, of the character at \a position
+     * (or the size in bytes of the string if \a position is past the end).
+     */
+    std::string::size_type GetByteOffset( size_type position ) const;
+
+    /**
+     * \brief Return the position of the character starting at the position
+     * (in bytes) \a byteOffset.
+     */
+    size_type GetCharacterPosition( std::string::size_type byteOffset ) const;
+
+    /**
+     * \brief Return the index of the characters positions, building it if
+     * needed (or if the size of the string changed since it was built), or
+     * nullptr if the string is not indexed.
+     */
+    const std::vector<std::uint32_t>* GetIndex() const;
+
+    /**
+     * \brief Must be called each time m_string is modified.
+     */
+    void InvalidateCache();
+
     std::string m_string; ///< Internal std::string container
 
+    /**
+     * The number of characters (low 32 bits) and the size in bytes of the
+     * string plus one (high 32 bits) when it was computed. 0 if not computed.
+     * The string only contains ASCII characters if both are equal.
+     * Atomic so that const methods can be called from multiple threads.
+     */
+    mutable std::atomic<std::uint64_t> m_sizeCache;
+
+    /**
+     * For long strings with non ASCII characters, the position in bytes of
+     * every indexInterval-th character, built when needed.
+     */
+    mutable std::atomic<Index*> m_index;
 };
 
 /**
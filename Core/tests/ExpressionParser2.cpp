@@ -5,6 +5,7 @@
  */
 #include "GDCore/Events/Parsers/ExpressionParser2.h"
 #include "DummyPlatform.h"
+#include "GDCore/Events/Parsers/ExpressionParser2NodePrinter.h"
 #include "GDCore/Extensions/Platform.h"
 #include "GDCore/Extensions/PlatformExtension.h"
 #include "GDCore/IDE/Events/ExpressionValidator.h"
@@ -1076,6 +1077,25 @@ TEST_CASE("ExpressionParser2", "[common][events]") {
     }
   }
 
+  SECTION("Invalid UTF8") {
+    // gd::String does not validate the UTF8 it's constructed from: the parser
+    // must still go through the whole expression.
+    auto testExpression = [&parser](const char *expression) {
+      auto node = parser.ParseExpression("number", expression);
+      REQUIRE(node != nullptr);
+      gd::ExpressionValidator validator;
+      node->Visit(validator);
+      REQUIRE(validator.GetErrors().size() != 0);
+    };
+
+    testExpression("1+\x80");
+    testExpression("\x80\x80+1");
+    testExpression("1+\xff");
+    testExpression("1+\xe2\x82");
+    testExpression("1+\xf0");
+    testExpression("\"\x80\xe2\"");
+  }
+
   SECTION("Location") {
     SECTION("Single node locations") {
       {
@@ -1496,4 +1516,46 @@ TEST_CASE("ExpressionParser2", "[common][events]") {
       }
     }
   }
+
+  SECTION("Arena allocation") {
+    gd::ExpressionNodeArena arena(4096);
+    {
+      auto node = parser.ParseExpression(
+          "number",
+          "MySpriteObject.GetObjectNumber() + 3 * MyExtension::GetNumber()",
+          arena);
+      REQUIRE(node != nullptr);
+      REQUIRE(arena.GetMemoryUsage() == 4096);
+      REQUIRE(gd::ExpressionParser2NodePrinter::PrintNode(*node) ==
+              "MySpriteObject.GetObjectNumber() + 3 * "
+              "MyExtension::GetNumber()");
+      REQUIRE(gd::ExpressionValidator::HasNoErrors(*node));
+
+      // Nodes allocated on the heap can be mixed with nodes of the arena.
+      auto &operatorNode = dynamic_cast<gd::OperatorNode &>(*node);
+      operatorNode.leftHandSide = gd::make_unique<gd::NumberNode>("1");
+      REQUIRE(gd::ExpressionParser2NodePrinter::PrintNode(*node) ==
+              "1 + 3 * MyExtension::GetNumber()");
+    }
+    {
+      // The memory is reused after the arena is cleared.
+      arena.Clear();
+      auto node = parser.ParseExpression("string", "\"abc\" + 1", arena);
+      REQUIRE(node != nullptr);
+      REQUIRE(arena.GetMemoryUsage() == 4096);
+
+      gd::ExpressionValidator validator;
+      node->Visit(validator);
+      REQUIRE(validator.GetErrors().size() == 1);
+      REQUIRE(validator.GetErrors()[0]->GetMessage() ==
+              "You entered a number, but a text was expected (in quotes).");
+    }
+    {
+      // Parsing without an arena after using one still allocates on the heap.
+      auto node = parser.ParseExpression("number", "1 + 2");
+      REQUIRE(node != nullptr);
+      arena.Clear();
+      REQUIRE(gd::ExpressionParser2NodePrinter::PrintNode(*node) == "1 + 2");
+    }
+  }
 }
@@ -119,4 +119,69 @@ TEST_CASE("ExpressionParser2 - Benchmarks", "[common][events]") {
           "AndAgainAndAgainAndAgainAndAgainAndAgainAndAgainAndAgain"));
     });
   }
+
+  SECTION("Parse with an arena") {
+    gd::String expression;
+    for (size_t i = 0; i < 100; i++)
+      expression += "MySpriteObject.X()/cos(3.1234)+ToNumber(\"Text\")+";
+    expression += "0";
+
+    doBenchmark("Parse and destroy (heap)", 100, [&]() {
+      auto node = parser.ParseExpression("number", expression);
+      REQUIRE(node != nullptr);
+    });
+
+    gd::ExpressionNodeArena arena;
+    doBenchmark("Parse and destroy (arena)", 100, [&]() {
+      {
+        auto node = parser.ParseExpression("number", expression, arena);
+        REQUIRE(node != nullptr);
+      }
+      arena.Clear();
+    });
+  }
+
+  SECTION("Parse expressions of increasing length") {
+    // Parsing must be linear in the length of the expression, whatever the
+    // characters used in it.
+    auto makeExpression = [](const gd::String &pattern, size_t length) {
+      gd::String expression;
+      while (expression.size() < length) expression += pattern;
+      return expression + "0";
+    };
+    auto parseTime = [&parser](const gd::String &expression) {
+      long long bestTime = -1;
+      for (size_t i = 0; i < 5; i++) {
+        auto start = std::chrono::steady_clock::now();
+        auto node = parser.ParseExpression("number", expression);
+        auto end = std::chrono::steady_clock::now();
+        REQUIRE(node != nullptr);
+
+        long long time =
+            std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+                .count();
+        if (bestTime == -1 || time < bestTime) bestTime = time;
+      }
+      return bestTime;
+    };
+
+    for (const gd::String &pattern :
+         {gd::String("MySpriteObject.X()/cos(3.1234)+ToNumber(\"Text\")+"),
+          gd::String(u8"MySpriteObject.X()/cos(3.1234)+ToNumber(\"Téxte "
+                     u8"官话\")+")}) {
+      long long previousTime = 0;
+      for (size_t length : {1000, 10000, 100000}) {
+        gd::String expression = makeExpression(pattern, length);
+        long long time = parseTime(expression);
+        std::cout << "Parse a " << expression.size()
+                  << " characters expression benchmark: " << time
+                  << " microseconds" << std::endl;
+
+        // Each expression is 10 times longer than the previous one: allow
+        // for some noise but not for a quadratic time.
+        if (previousTime > 100) REQUIRE(time < previousTime * 30);
+        previousTime = time;
+      }
+    }
+  }
 }
@@ -0,0 +1,155 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the search of metadata in the extensions of a platform.
+ */
+#include "GDCore/Extensions/Metadata/MetadataProvider.h"
+#include "DummyPlatform.h"
+#include "GDCore/Extensions/Metadata/BehaviorMetadata.h"
+#include "GDCore/Extensions/Metadata/ObjectMetadata.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Extensions/PlatformExtension.h"
+#include "GDCore/Project/Behavior.h"
+#include "GDCore/Project/BehaviorsSharedData.h"
+#include "GDCore/Project/Project.h"
+#include "GDCore/Tools/MakeUnique.h"
+#include "catch.hpp"
+
+TEST_CASE("MetadataProvider", "[common]") {
+  gd::Project project;
+  gd::Platform platform;
+  SetupProjectWithDummyPlatform(project, platform);
+
+  SECTION("Objects and behaviors") {
+    REQUIRE(gd::MetadataProvider::GetExtensionAndObjectMetadata(
+                platform, "MyExtension::Sprite")
+                .GetExtension()
+                .GetName() == "MyExtension");
+    REQUIRE(gd::MetadataProvider::GetObjectMetadata(platform, "")
+                .GetFullName() == "Dummy Base Object");
+    REQUIRE(gd::MetadataProvider::GetExtensionAndBehaviorMetadata(
+                platform, "MyExtension::MyBehavior")
+                .GetExtension()
+                .GetName() == "MyExtension");
+    REQUIRE(gd::MetadataProvider::GetBehaviorMetadata(
+                platform, "MyExtension::MyBehavior")
+                .GetFullName() == "Dummy behavior");
+    REQUIRE(gd::MetadataProvider::GetExtensionAndBehaviorMetadata(
+                platform, "MyExtension::UnknownBehavior")
+                .GetExtension()
+                .GetName() == "");
+  }
+
+  SECTION("Instructions") {
+    REQUIRE(gd::MetadataProvider::HasAction(platform,
+                                            "MyExtension::DoSomething"));
+    REQUIRE(gd::MetadataProvider::GetActionMetadata(
+                platform, "MyExtension::DoSomething")
+                .GetFullName() == "Do something");
+    REQUIRE(!gd::MetadataProvider::HasCondition(platform,
+                                                "MyExtension::DoSomething"));
+    REQUIRE(!gd::MetadataProvider::HasObjectAction(
+        platform, "MyExtension::Sprite", "MyExtension::DoSomething"));
+  }
+
+  SECTION("Expressions") {
+    REQUIRE(gd::MetadataProvider::HasExpression(platform,
+                                                "MyExtension::GetNumber"));
+    REQUIRE(!gd::MetadataProvider::HasStrExpression(platform,
+                                                    "MyExtension::GetNumber"));
+    REQUIRE(gd::MetadataProvider::HasObjectExpression(
+        platform, "MyExtension::Sprite", "GetObjectNumber"));
+    REQUIRE(gd::MetadataProvider::HasObjectStrExpression(
+        platform, "MyExtension::Sprite", "GetObjectStringWith1Param"));
+    REQUIRE(!gd::MetadataProvider::HasObjectExpression(
+        platform, "MyExtension::Sprite", "GetObjectStringWith1Param"));
+
+    REQUIRE(&gd::MetadataProvider::GetObjectExpressionMetadata(
+                platform, "MyExtension::Sprite", "GetObjectNumber") ==
+            &platform.GetExtension("MyExtension")
+                 ->GetAllExpressionsForObject("MyExtension::Sprite")
+                 .find("GetObjectNumber")
+                 ->second);
+    REQUIRE(gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetObjectExpressionMetadata(
+            platform, "MyExtension::Sprite", "UnknownExpression")));
+    REQUIRE(gd::MetadataProvider::IsBadExpressionMetadata(
+        gd::MetadataProvider::GetExpressionMetadata(platform,
+                                                    "UnknownExpression")));
+  }
+
+  SECTION("Base object functions") {
+    // Expressions of the base object (type "") are available for all objects.
+    REQUIRE(!gd::MetadataProvider::HasObjectExpression(
+        platform, "MyExtension::Sprite", "GetBaseNumber"));
+    auto baseObjectExtension = platform.GetExtension("BuiltinObject");
+    baseObjectExtension->GetObjectMetadata("")
+        .AddExpression("GetBaseNumber", "Get base number", "", "", "")
+        .AddParameter("object", "Object");
+
+    // The extension was modified after being added to the platform.
+    platform.InvalidateMetadataIndex();
+    REQUIRE(gd::MetadataProvider::HasObjectExpression(
+        platform, "MyExtension::Sprite", "GetBaseNumber"));
+    REQUIRE(gd::MetadataProvider::GetExtensionAndObjectExpressionMetadata(
+                platform, "MyExtension::Sprite", "GetBaseNumber")
+                .GetExtension()
+                .GetName() == "BuiltinObject");
+  }
+
+  SECTION("Adding and removing extensions") {
+    std::shared_ptr<gd::PlatformExtension> extension =
+        std::make_shared<gd::PlatformExtension>();
+    extension->SetExtensionInformation(
+        "MyOtherExtension", "My other extension", "", "", "");
+    extension->AddExpression("GetOtherNumber", "Get other number", "", "", "");
+    extension
+        ->AddBehavior("OtherBehavior",
+                      "Other behavior",
+                      "OtherBehavior",
+                      "",
+                      "",
+                      "",
+                      "",
+                      gd::make_unique<gd::Behavior>(),
+                      gd::make_unique<gd::BehaviorsSharedData>())
+        .AddAction("BehaviorDoSomething",
+                   "Do something on behavior",
+                   "",
+                   "",
+                   "",
+                   "",
+                   "");
+    REQUIRE(!gd::MetadataProvider::HasExpression(
+        platform, "MyOtherExtension::GetOtherNumber"));
+
+    platform.AddExtension(extension);
+    REQUIRE(gd::MetadataProvider::HasExpression(
+        platform, "MyOtherExtension::GetOtherNumber"));
+
+    // Behavior actions are found when searching all actions, but are not
+    // free actions.
+    REQUIRE(gd::MetadataProvider::GetActionMetadata(
+                platform, "MyOtherExtension::BehaviorDoSomething")
+                .GetFullName() == "Do something on behavior");
+    REQUIRE(!gd::MetadataProvider::HasAction(
+        platform, "MyOtherExtension::BehaviorDoSomething"));
+    REQUIRE(gd::MetadataProvider::HasBehaviorAction(
+        platform,
+        "MyOtherExtension::OtherBehavior",
+        "MyOtherExtension::BehaviorDoSomething"));
+    REQUIRE(gd::MetadataProvider::GetExtensionAndExpressionMetadata(
+                platform, "MyOtherExtension::GetOtherNumber")
+                .GetExtension()
+                .GetName() == "MyOtherExtension");
+
+    platform.RemoveExtension("MyOtherExtension");
+    REQUIRE(!gd::MetadataProvider::HasExpression(
+        platform, "MyOtherExtension::GetOtherNumber"));
+    REQUIRE(gd::MetadataProvider::HasExpression(platform,
+                                                "MyExtension::GetNumber"));
+  }
+}
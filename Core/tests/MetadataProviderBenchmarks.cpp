@@ -0,0 +1,109 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Benchmarks of the search of metadata, done for every instruction and
+ * function call when parsing expressions or generating code.
+ */
+#include <chrono>
+#include <iostream>
+#include "DummyPlatform.h"
+#include "GDCore/Events/CodeGeneration/EventsCodeGenerationContext.h"
+#include "GDCore/Events/CodeGeneration/EventsCodeGenerator.h"
+#include "GDCore/Events/CodeGeneration/ExpressionCodeGenerator.h"
+#include "GDCore/Events/Parsers/ExpressionParser2.h"
+#include "GDCore/Extensions/Metadata/MetadataProvider.h"
+#include "GDCore/Extensions/Platform.h"
+#include "GDCore/Extensions/PlatformExtension.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Project.h"
+#include "catch.hpp"
+
+namespace {
+void DoBenchmark(const gd::String& benchmarkName, std::function<void()> func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  auto end = std::chrono::steady_clock::now();
+
+  std::cout << benchmarkName << " benchmark: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end -
+                                                                     start)
+                   .count()
+            << " milliseconds" << std::endl;
+}
+
+/**
+ * \brief Add extensions with objects, behaviors, instructions and
+ * expressions, like the extensions of a real platform.
+ */
+void AddExtensions(gd::Platform& platform, std::size_t extensionsCount) {
+  for (std::size_t i = 0; i < extensionsCount; ++i) {
+    gd::String name = "Extension" + gd::String::From(i);
+    std::shared_ptr<gd::PlatformExtension> extension =
+        std::make_shared<gd::PlatformExtension>();
+    extension->SetExtensionInformation(name, name, "", "", "");
+    for (std::size_t j = 0; j < 10; ++j) {
+      gd::String suffix = gd::String::From(j);
+      extension->AddAction("Action" + suffix, "", "", "", "", "", "");
+      extension->AddCondition("Condition" + suffix, "", "", "", "", "", "");
+      extension->AddExpression("Expression" + suffix, "", "", "", "");
+    }
+
+    auto& object =
+        extension->AddObject<gd::Object>("Object", "Object", "Object", "");
+    for (std::size_t j = 0; j < 10; ++j) {
+      gd::String suffix = gd::String::From(j);
+      object.AddAction("ObjectAction" + suffix, "", "", "", "", "", "");
+      object.AddExpression("ObjectExpression" + suffix, "", "", "", "");
+    }
+    platform.AddExtension(extension);
+  }
+}
+}  // namespace
+
+TEST_CASE("MetadataProvider - Benchmarks", "[common][benchmarks]") {
+  gd::Project project;
+  gd::Platform platform;
+  platform.EnableExtensionLoadingLogs(false);
+  // Extensions with the same names as the ones of the dummy platform are
+  // replacing them, so add them first.
+  AddExtensions(platform, 100);
+  SetupProjectWithDummyPlatform(project, platform);
+  auto& layout = project.InsertNewLayout("Layout", 0);
+  layout.InsertNewObject(project, "MyExtension::Sprite", "MySpriteObject", 0);
+
+  DoBenchmark("Search 100000 actions and object expressions", [&]() {
+    for (std::size_t i = 0; i < 50000; ++i) {
+      REQUIRE(gd::MetadataProvider::GetActionMetadata(
+                  platform, "MyExtension::DoSomething")
+                  .GetFullName() == "Do something");
+      REQUIRE(!gd::MetadataProvider::IsBadExpressionMetadata(
+          gd::MetadataProvider::GetObjectExpressionMetadata(
+              platform, "MyExtension::Sprite", "GetObjectNumber")));
+    }
+  });
+
+  // Code generation of a large project: search the metadata of every
+  // function called in its expressions.
+  gd::ExpressionParser2 parser(platform, project, layout);
+  unsigned int maxDepth = 0;
+  gd::EventsCodeGenerationContext context(&maxDepth);
+  gd::EventsCodeGenerator codeGenerator(project, layout, platform);
+  gd::String expression;
+  for (std::size_t i = 0; i < 10; ++i)
+    expression +=
+        "MySpriteObject.GetObjectNumber() + MyExtension::GetNumber() + ";
+  expression += "0";
+
+  DoBenchmark("Code generation of 10000 expressions", [&]() {
+    for (std::size_t i = 0; i < 10000; ++i) {
+      auto node = parser.ParseExpression("number", expression);
+      gd::ExpressionCodeGenerator expressionCodeGenerator(codeGenerator,
+                                                          context);
+      node->Visit(expressionCodeGenerator);
+      REQUIRE(!expressionCodeGenerator.GetOutput().empty());
+    }
+  });
+}
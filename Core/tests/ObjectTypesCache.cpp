@@ -0,0 +1,153 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the search of the types of objects, groups and
+ * behaviors, and the invalidation of their cache.
+ */
+#include "GDCore/Project/ObjectTypesCache.h"
+#include "GDCore/Project/BehaviorContent.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCore/Project/ObjectGroup.h"
+#include "GDCore/Project/ObjectGroupsContainer.h"
+#include "GDCore/Project/ObjectsContainer.h"
+#include "catch.hpp"
+
+namespace {
+gd::Object& InsertObject(gd::ObjectsContainer& container,
+                         const gd::String& name,
+                         const gd::String& type) {
+  gd::Object object(name);
+  object.SetType(type);
+  return container.InsertObject(object, container.GetObjectsCount());
+}
+}  // namespace
+
+TEST_CASE("ObjectTypesCache", "[common]") {
+  gd::ObjectsContainer globalObjects;
+  gd::ObjectsContainer objects;
+  InsertObject(globalObjects, "GlobalSprite", "Sprite");
+  InsertObject(globalObjects, "MyObject", "Text");
+  InsertObject(objects, "MySprite", "Sprite");
+  InsertObject(objects, "MyOtherSprite", "Sprite");
+  InsertObject(objects, "MyText", "Text");
+  InsertObject(objects, "MyObject", "Sprite");
+
+  objects.GetObjectGroups().InsertNew("Sprites");
+  objects.GetObjectGroups().Get("Sprites").AddObject("MySprite");
+  objects.GetObjectGroups().Get("Sprites").AddObject("GlobalSprite");
+  objects.GetObjectGroups().InsertNew("Mixed");
+  objects.GetObjectGroups().Get("Mixed").AddObject("MySprite");
+  objects.GetObjectGroups().Get("Mixed").AddObject("MyText");
+  globalObjects.GetObjectGroups().InsertNew("Empty");
+
+  SECTION("Objects") {
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "MySprite") ==
+            "Sprite");
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "GlobalSprite") ==
+            "Sprite");
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "Unknown") == "");
+
+    // Objects of the layout hide the global objects with the same name.
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "MyObject") ==
+            "Sprite");
+    REQUIRE(gd::GetTypeOfObject(globalObjects, globalObjects, "MyObject") ==
+            "Text");
+  }
+
+  SECTION("Groups") {
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "Sprites") ==
+            "Sprite");
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "Sprites", false) ==
+            "");
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "Mixed") == "");
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "Empty") == "");
+  }
+
+  SECTION("Behaviors") {
+    objects.GetObject("MySprite").AddBehavior(
+        gd::BehaviorContent("Physics", "PhysicsBehavior::PhysicsBehavior"));
+    globalObjects.GetObject("GlobalSprite")
+        .AddBehavior(gd::BehaviorContent("Physics", "OtherPhysics::Physics"));
+    globalObjects.GetObject("GlobalSprite")
+        .AddBehavior(gd::BehaviorContent("Platform", "Platform::Platform"));
+
+    REQUIRE(gd::GetTypeOfBehavior(globalObjects, objects, "Physics") ==
+            "PhysicsBehavior::PhysicsBehavior");
+    REQUIRE(gd::GetTypeOfBehavior(globalObjects, objects, "Platform") ==
+            "Platform::Platform");
+    REQUIRE(gd::GetTypeOfBehavior(globalObjects, objects, "Unknown") == "");
+  }
+
+  SECTION("Changes to objects") {
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "MySprite") ==
+            "Sprite");
+
+    objects.GetObject("MySprite").SetName("MyRenamedSprite");
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "MySprite") == "");
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "MyRenamedSprite") ==
+            "Sprite");
+
+    objects.RemoveObject("MyObject");
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "MyObject") ==
+            "Text");
+
+    InsertObject(globalObjects, "NewObject", "Text");
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "NewObject") ==
+            "Text");
+  }
+
+  SECTION("Changes to groups") {
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "Sprites") ==
+            "Sprite");
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "Mixed") == "");
+
+    objects.GetObjectGroups().Get("Sprites").AddObject("MyText");
+    objects.GetObjectGroups().Get("Mixed").RemoveObject("MyText");
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "Sprites") == "");
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "Mixed") == "Sprite");
+
+    objects.GetObjectGroups().Rename("Mixed", "NotMixed");
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "Mixed") == "");
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "NotMixed") ==
+            "Sprite");
+
+    objects.GetObjectGroups().Remove("NotMixed");
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "NotMixed") == "");
+  }
+
+  SECTION("Changes to behaviors") {
+    gd::Object& mySprite = objects.GetObject("MySprite");
+    mySprite.AddBehavior(gd::BehaviorContent("Physics", "Physics::Physics"));
+    REQUIRE(gd::GetTypeOfBehavior(globalObjects, objects, "Physics") ==
+            "Physics::Physics");
+
+    // The object is modified after a lookup was made.
+    mySprite.RenameBehavior("Physics", "Physics2");
+    REQUIRE(gd::GetTypeOfBehavior(globalObjects, objects, "Physics") == "");
+    REQUIRE(gd::GetTypeOfBehavior(globalObjects, objects, "Physics2") ==
+            "Physics::Physics");
+
+    mySprite.GetBehavior("Physics2").SetTypeName("Physics2::Physics");
+    REQUIRE(gd::GetTypeOfBehavior(globalObjects, objects, "Physics2") ==
+            "Physics2::Physics");
+
+    mySprite.RemoveBehavior("Physics2");
+    REQUIRE(gd::GetTypeOfBehavior(globalObjects, objects, "Physics2") == "");
+  }
+
+  SECTION("Other global objects") {
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "GlobalSprite") ==
+            "Sprite");
+
+    gd::ObjectsContainer otherGlobalObjects;
+    InsertObject(otherGlobalObjects, "GlobalSprite", "Text");
+    REQUIRE(gd::GetTypeOfObject(otherGlobalObjects, objects, "GlobalSprite") ==
+            "Text");
+    REQUIRE(gd::GetTypeOfObject(globalObjects, objects, "GlobalSprite") ==
+            "Sprite");
+  }
+}
@@ -0,0 +1,202 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the copy of the resources of a project, in particular
+ * the incremental copy used for previews.
+ */
+#include "GDCore/IDE/Project/ProjectResourcesCopier.h"
+#include <functional>
+#include <map>
+#include "GDCore/IDE/AbstractFileSystem.h"
+#include "GDCore/Project/Project.h"
+#include "catch.hpp"
+
+namespace {
+/**
+ * \brief A file system keeping files in memory, and counting the files copied.
+ */
+class InMemoryFileSystem : public gd::AbstractFileSystem {
+ public:
+  struct File {
+    gd::String content;
+    std::int64_t modificationTime;
+  };
+
+  InMemoryFileSystem()
+      : supportsStats(true), copiesCount(0), time(0){};
+  virtual ~InMemoryFileSystem(){};
+
+  void SetFile(const gd::String& path, const gd::String& content) {
+    files[path] = File{content, ++time};
+  }
+  void TouchFile(const gd::String& path) {
+    files[path].modificationTime = ++time;
+  }
+
+  virtual void MkDir(const gd::String& path){};
+  virtual bool DirExists(const gd::String& path) { return true; };
+  virtual bool FileExists(const gd::String& path) {
+    return files.find(path) != files.end();
+  };
+  virtual gd::String FileNameFrom(const gd::String& file) {
+    size_t pos = file.find_last_of("/");
+    return pos != gd::String::npos ? file.substr(pos + 1) : file;
+  };
+  virtual gd::String DirNameFrom(const gd::String& file) {
+    size_t pos = file.find_last_of("/");
+    return pos != gd::String::npos ? file.substr(0, pos) : "";
+  };
+  virtual bool MakeAbsolute(gd::String& filename,
+                            const gd::String& baseDirectory) {
+    if (!IsAbsolute(filename)) filename = baseDirectory + "/" + filename;
+    return true;
+  };
+  virtual bool MakeRelative(gd::String& filename,
+                            const gd::String& baseDirectory) {
+    gd::String prefix = baseDirectory + "/";
+    if (filename.substr(0, prefix.size()) != prefix) return false;
+    filename = filename.substr(prefix.size());
+    return true;
+  };
+  virtual bool IsAbsolute(const gd::String& filename) {
+    return !filename.empty() && filename[0] == '/';
+  }
+  virtual bool CopyFile(const gd::String& file, const gd::String& destination) {
+    if (!FileExists(file)) return false;
+    SetFile(destination, files[file].content);
+    copiesCount++;
+    return true;
+  }
+  virtual bool ClearDir(const gd::String& directory) { return true; }
+  virtual bool WriteToFile(const gd::String& file, const gd::String& content) {
+    SetFile(file, content);
+    return true;
+  }
+  virtual gd::String ReadFile(const gd::String& file) {
+    return FileExists(file) ? files[file].content : "";
+  }
+  virtual gd::String GetTempDir() { return "/tmp"; }
+  virtual std::vector<gd::String> ReadDir(const gd::String& path,
+                                          const gd::String& extension = "") {
+    return std::vector<gd::String>();
+  }
+  virtual bool GetFileStats(const gd::String& file,
+                            std::uint64_t& size,
+                            std::int64_t& modificationTime) {
+    if (!supportsStats || !FileExists(file)) return false;
+    size = files[file].content.size();
+    modificationTime = files[file].modificationTime;
+    return true;
+  }
+  virtual gd::String GetFileHash(const gd::String& file) {
+    if (!FileExists(file)) return "";
+    return gd::String::From(
+        std::hash<std::string>()(files[file].content.Raw()));
+  }
+  virtual bool RemoveFile(const gd::String& file) {
+    return files.erase(file) != 0;
+  }
+
+  std::map<gd::String, File> files;
+  bool supportsStats;
+  std::size_t copiesCount;
+
+ private:
+  std::int64_t time;
+};
+}  // namespace
+
+TEST_CASE("ProjectResourcesCopier", "[common]") {
+  InMemoryFileSystem fs;
+  fs.SetFile("/project/image1.png", "Image 1");
+  fs.SetFile("/project/image2.png", "Image 2");
+  fs.SetFile("/project/sounds/sound1.ogg", "Sound 1");
+
+  gd::Project project;
+  project.SetProjectFile("/project/game.json");
+  project.GetResourcesManager().AddResource("Image1", "image1.png", "image");
+  project.GetResourcesManager().AddResource("Image2", "image2.png", "image");
+  project.GetResourcesManager().AddResource(
+      "Sound1", "sounds/sound1.ogg", "audio");
+
+  auto copyAllResources = [&](bool incrementalCopy) {
+    REQUIRE(gd::ProjectResourcesCopier::CopyAllResourcesTo(
+        project, fs, "/export", false, true, true, incrementalCopy));
+  };
+
+  SECTION("Copy") {
+    copyAllResources(false);
+    REQUIRE(fs.copiesCount == 3);
+    REQUIRE(fs.ReadFile("/export/image1.png") == "Image 1");
+    REQUIRE(fs.ReadFile("/export/sounds/sound1.ogg") == "Sound 1");
+    REQUIRE(!fs.FileExists("/export/resourcesManifest.json"));
+
+    copyAllResources(false);
+    REQUIRE(fs.copiesCount == 6);
+  }
+
+  SECTION("Incremental copy of unchanged files") {
+    copyAllResources(true);
+    REQUIRE(fs.copiesCount == 3);
+    REQUIRE(fs.ReadFile("/export/image2.png") == "Image 2");
+    REQUIRE(fs.FileExists("/export/resourcesManifest.json"));
+
+    copyAllResources(true);
+    REQUIRE(fs.copiesCount == 3);
+  }
+
+  SECTION("Incremental copy of changed files") {
+    copyAllResources(true);
+
+    fs.SetFile("/project/image1.png", "Image 1 modified");
+    copyAllResources(true);
+    REQUIRE(fs.copiesCount == 4);
+    REQUIRE(fs.ReadFile("/export/image1.png") == "Image 1 modified");
+
+    // Files saved again without changes are not copied.
+    fs.TouchFile("/project/image2.png");
+    copyAllResources(true);
+    REQUIRE(fs.copiesCount == 4);
+
+    // Files with the same size are compared by content.
+    fs.SetFile("/project/image2.png", "Image 3");
+    copyAllResources(true);
+    REQUIRE(fs.copiesCount == 5);
+    REQUIRE(fs.ReadFile("/export/image2.png") == "Image 3");
+
+    // Removed copies are made again.
+    fs.files.erase("/export/sounds/sound1.ogg");
+    copyAllResources(true);
+    REQUIRE(fs.copiesCount == 6);
+    REQUIRE(fs.ReadFile("/export/sounds/sound1.ogg") == "Sound 1");
+  }
+
+  SECTION("Incremental copy of removed resources") {
+    copyAllResources(true);
+
+    // The copies of removed resources are removed...
+    project.GetResourcesManager().RemoveResource("Image2");
+    copyAllResources(true);
+    REQUIRE(fs.copiesCount == 3);
+    REQUIRE(!fs.FileExists("/export/image2.png"));
+    REQUIRE(fs.FileExists("/export/image1.png"));
+    REQUIRE(fs.FileExists("/project/image2.png"));
+
+    // ...and made again if the resources are added back.
+    project.GetResourcesManager().AddResource("Image2", "image2.png", "image");
+    copyAllResources(true);
+    REQUIRE(fs.copiesCount == 4);
+    REQUIRE(fs.ReadFile("/export/image2.png") == "Image 2");
+  }
+
+  SECTION("Incremental copy without files stats") {
+    // Files are copied every time if their modifications can't be known.
+    fs.supportsStats = false;
+    copyAllResources(true);
+    copyAllResources(true);
+    REQUIRE(fs.copiesCount == 6);
+  }
+}
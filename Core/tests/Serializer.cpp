@@ -7,6 +7,7 @@
  * @file Tests covering serialization to JSON.
  */
 #include "GDCore/Serialization/Serializer.h"
+#include <sstream>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Events/Builtin/StandardEvent.h"
 #include "GDCore/Events/Event.h"
@@ -15,6 +16,10 @@
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Project.h"
 #include "GDCore/Project/Variable.h"
+#include "GDCore/Serialization/BinarySnapshot.h"
+#include "GDCore/Serialization/FlatSerializerTree.h"
+#include "GDCore/Serialization/JSONReader.h"
+#include "GDCore/Serialization/JSONWriter.h"
 #include "GDCore/Tools/SystemStats.h"
 #include "GDCore/Tools/VersionWrapper.h"
 #include "catch.hpp"
@@ -204,3 +209,344 @@ TEST_CASE("Serializer", "[common]") {
     REQUIRE(json == "{\"hello\": \"world1\",\"ok\": true,\"hello2\": \"world2\"}");
   }
 }
+
+TEST_CASE("JSONReader and JSONWriter", "[common]") {
+  auto readAndWriteJSON = [](const gd::String& originalJSON,
+                             std::size_t bufferSize) {
+    std::istringstream inputStream(originalJSON.Raw());
+    gd::JSONReader reader(inputStream, bufferSize);
+    std::ostringstream outputStream;
+    gd::JSONWriter writer(outputStream);
+    REQUIRE(reader.Read(writer) == true);
+    return gd::String::FromUTF8(outputStream.str());
+  };
+
+  SECTION("Reading from a stream, with values split between reads") {
+    gd::String json =
+        u8"{\"hello\": {\"world\": [{},[],3,\"4\"],\"world2\": [-1.5,"
+        u8"\"-2\",{\"-3\": [-4e2]}]},\"Hello 官话 world\": \"官话\","
+        u8"\"\\\"hello\\\"\": \" \\\"quote\\\" \",\"ok\": true,"
+        u8"\"notOk\": false}";
+    gd::String expectedJSON =
+        u8"{\"hello\": {\"world\": [{},[],3,\"4\"],\"world2\": [-1.5,"
+        u8"\"-2\",{\"-3\": [-400]}]},\"Hello 官话 world\": \"官话\","
+        u8"\"\\\"hello\\\"\": \" \\\"quote\\\" \",\"ok\": true,"
+        u8"\"notOk\": false}";
+    for (std::size_t bufferSize = 1; bufferSize < 20; ++bufferSize) {
+      REQUIRE(readAndWriteJSON(json, bufferSize) == expectedJSON);
+    }
+
+    std::istringstream stream(json.Raw());
+    SerializerElement element = Serializer::FromJSON(stream);
+    REQUIRE(Serializer::ToJSON(element) == expectedJSON);
+  }
+
+  SECTION("Blank characters and trailing commas") {
+    gd::String json =
+        "\t{ \"a\" :\r\n[ 1 , 2, ] , \"b\": {\"c\": 3,}, }  ";
+    REQUIRE(readAndWriteJSON(json, 16) == "{\"a\": [1,2],\"b\": {\"c\": 3}}");
+  }
+
+  SECTION("Escaped unicode characters") {
+    gd::String json = "{\"a\": \"\\u00e9t\\u00C9\",\"b\": \"\\ud83d\\ude00\"}";
+    SerializerElement element = Serializer::FromJSON(json);
+    REQUIRE(element.GetChild("a").GetStringValue() == u8"étÉ");
+    REQUIRE(element.GetChild("b").GetStringValue() == u8"\U0001F600");
+
+    gd::String controlCharacterJSON = "\"\\u0001\"";
+    REQUIRE(Serializer::ToJSON(Serializer::FromJSON(controlCharacterJSON)) ==
+            controlCharacterJSON);
+  }
+
+  SECTION("Numbers") {
+    auto readNumber = [](const gd::String& json) {
+      return Serializer::FromJSON(json).GetDoubleValue();
+    };
+    REQUIRE(readNumber("0.1") == 0.1);
+    REQUIRE(readNumber("-123.455") == -123.455);
+    REQUIRE(readNumber("1e3") == 1000);
+    REQUIRE(readNumber("1.5E-3") == 1.5E-3);
+    REQUIRE(readNumber("1e300") == 1e300);
+    REQUIRE(readNumber("3.14159265358979323846") == 3.14159265358979323846);
+    REQUIRE(readNumber("null") == 0);
+
+    REQUIRE(Serializer::ToJSON(SerializerElement(1234567)) == "1234567");
+    REQUIRE(Serializer::ToJSON(SerializerElement(1234567.0)) == "1.23457e+06");
+    REQUIRE(Serializer::ToJSON(SerializerElement(-0.0)) == "-0");
+    REQUIRE(Serializer::ToJSON(SerializerElement(0.25)) == "0.25");
+  }
+
+  SECTION("Invalid documents") {
+    auto readJSON = [](const gd::String& json) {
+      gd::JSONReader reader(json.Raw().data(), json.Raw().size());
+      std::ostringstream outputStream;
+      gd::JSONWriter writer(outputStream);
+      return reader.Read(writer);
+    };
+
+    REQUIRE(readJSON("{\"a\": 1") == false);
+    REQUIRE(readJSON("{\"a\" 1}") == false);
+    REQUIRE(readJSON("{\"a\": [1}") == false);
+    REQUIRE(readJSON("{\"a\": \"b}") == false);
+    REQUIRE(readJSON("{\"a\": abc}") == false);
+    REQUIRE(readJSON("") == false);
+
+    // Anything after the first value is ignored.
+    gd::JSONReader reader("[1, ]]", 6);
+    std::ostringstream outputStream;
+    gd::JSONWriter writer(outputStream);
+    REQUIRE(reader.Read(writer) == true);
+    REQUIRE(outputStream.str() == "[1]");
+  }
+
+  SECTION("Writing an element to a stream") {
+    gd::String json =
+        "{\"hello\": {\"world\": [{},[],3,\"4\"],\"world2\": [-1]}}";
+    SerializerElement element = Serializer::FromJSON(json);
+    std::ostringstream stream;
+    Serializer::ToJSON(element, stream);
+    REQUIRE(stream.str() == json.Raw());
+  }
+}
+
+TEST_CASE("FlatSerializerTree", "[common]") {
+  auto readJSON = [](const gd::String& json, FlatSerializerTree& tree) {
+    return Serializer::FromJSON(json.Raw().data(), json.Raw().size(), tree);
+  };
+
+  SECTION("Values and attributes") {
+    FlatSerializerTree tree;
+    REQUIRE(readJSON("{\"ok\": true,\"hello\": \"world\",\"a\": 1.5,"
+                     "\"b\": -3,\"c\": null,\"d\": \"false\"}",
+                     tree) == true);
+
+    FlatSerializerElement root = tree.GetRoot();
+    REQUIRE(root.IsValid() == true);
+    REQUIRE(root.IsValueUndefined() == true);
+    REQUIRE(root.ConsideredAsArray() == false);
+    REQUIRE(root.GetAllChildrenCount() == 6);
+    REQUIRE(root.GetChild("ok").GetBoolValue() == true);
+    REQUIRE(root.GetChild("hello").GetStringValue() == "world");
+    REQUIRE(root.GetChild("hello").GetName() == "hello");
+    REQUIRE(root.GetChild("a").GetDoubleValue() == 1.5);
+    REQUIRE(root.GetChild("b").GetIntValue() == -3);
+    REQUIRE(root.GetChild("b").GetStringValue() == "-3");
+    REQUIRE(root.GetChild("c").GetIntValue() == 0);
+    REQUIRE(root.GetChild("d").GetBoolValue() == false);
+
+    REQUIRE(root.GetBoolAttribute("ok") == true);
+    REQUIRE(root.GetStringAttribute("hello") == "world");
+    REQUIRE(root.GetDoubleAttribute("a") == 1.5);
+    REQUIRE(root.GetIntAttribute("notexisting", 42) == 42);
+    REQUIRE(root.GetStringAttribute("notexisting", "default", "hello") ==
+            "world");
+    REQUIRE(root.GetChildrenCount("hello") == 1);
+    REQUIRE(root.GetChildrenCount("notexisting", "hello") == 1);
+    REQUIRE(root.HasChild("ok") == true);
+    REQUIRE(root.HasChild("notexisting") == false);
+    REQUIRE(root.HasChild("notexisting", "ok") == true);
+  }
+
+  SECTION("Children and arrays") {
+    FlatSerializerTree tree;
+    REQUIRE(readJSON("{\"hello\": {\"world\": [{},[],3,\"4\"],"
+                     "\"world2\": [-1]},\"a\": 1,\"a\": 2}",
+                     tree) == true);
+
+    FlatSerializerElement root = tree.GetRoot();
+    FlatSerializerElement world = root.GetChild("hello").GetChild("world");
+    REQUIRE(world.ConsideredAsArray() == true);
+    REQUIRE(world.GetChildrenCount() == 4);
+    REQUIRE(world.GetChildrenCount("anything") == 4);
+    REQUIRE(world.GetChild(0).IsValueUndefined() == true);
+    REQUIRE(world.GetChild(1).ConsideredAsArray() == true);
+    REQUIRE(world.GetChild(1).GetChildrenCount() == 0);
+    REQUIRE(world.GetChild(2).GetIntValue() == 3);
+    REQUIRE(world.GetChild("anything", 3).GetStringValue() == "4");
+    REQUIRE(world.GetChild(4).IsValid() == false);
+    REQUIRE(root.GetChild("hello").GetChild("world2").GetChild(0).GetIntValue()
+            == -1);
+
+    // Children with the same name are all kept.
+    REQUIRE(root.GetChildrenCount("a") == 2);
+    REQUIRE(root.GetChild("a", 1).GetIntValue() == 2);
+
+    // Children not existing are null elements.
+    FlatSerializerElement notExisting = root.GetChild("notexisting");
+    REQUIRE(notExisting.IsValid() == false);
+    REQUIRE(notExisting.GetChild("a").IsValid() == false);
+    REQUIRE(notExisting.GetChildrenCount() == 0);
+    REQUIRE(notExisting.GetStringValue() == "");
+    REQUIRE(root.GetChild("a").GetChild("b").IsValid() == false);
+  }
+
+  SECTION("Conversion to a SerializerElement") {
+    gd::String json =
+        "{\"hello\": {\"world\": [{},[],3,\"4\"],\"world2\": [-1,\"-2\","
+        "{\"-3\": [-4]}]},\"ok\": true,\"\\\"quotes\\\"\": \"\\n\"}";
+    FlatSerializerTree tree;
+    REQUIRE(readJSON(json, tree) == true);
+
+    SerializerElement element;
+    tree.GetRoot().ToSerializerElement(element);
+    REQUIRE(Serializer::ToJSON(element) == json);
+    REQUIRE(Serializer::ToJSON(element) ==
+            Serializer::ToJSON(Serializer::FromJSON(json)));
+
+    SerializerElement childElement;
+    tree.GetRoot().GetChild("hello").ToSerializerElement(childElement);
+    REQUIRE(childElement.GetChild("world").ConsideredAsArray() == true);
+    REQUIRE(childElement.GetChild("world").GetChildrenCount() == 4);
+  }
+
+  SECTION("Reading from a stream, invalid documents and clearing") {
+    FlatSerializerTree tree;
+    std::istringstream stream(u8"{\"官话\": \"官话\"}");
+    REQUIRE(Serializer::FromJSON(stream, tree) == true);
+    REQUIRE(tree.GetRoot().GetStringAttribute(u8"官话") == u8"官话");
+
+    REQUIRE(readJSON("{\"a\": [1}", tree) == false);
+    REQUIRE(tree.GetRoot().IsValid() == false);
+
+    REQUIRE(readJSON("[1, 2]", tree) == true);
+    REQUIRE(tree.GetRoot().GetChildrenCount() == 2);
+    REQUIRE(tree.GetMemoryUsage() > 0);
+    tree.Clear();
+    REQUIRE(tree.GetRoot().IsValid() == false);
+  }
+
+  SECTION("Invalid UTF8 characters are replaced") {
+    FlatSerializerTree tree;
+    gd::String json;
+    json.RawMutable() = "{\"a\xFF\": \"b\xFF\"}";
+    REQUIRE(readJSON(json, tree) == true);
+
+    SerializerElement element = Serializer::FromJSON(json);
+    FlatSerializerElement child = tree.GetRoot().GetChildAt(0);
+    REQUIRE(child.GetName() == element.GetAllChildren()[0].first);
+    REQUIRE(child.GetStringValue() ==
+            element.GetAllChildren()[0].second->GetStringValue());
+  }
+}
+
+TEST_CASE("Binary snapshots", "[common]") {
+  auto toBinaryAndBackToJSON = [](const gd::String& json) {
+    std::string snapshot =
+        Serializer::ToBinary(Serializer::FromJSON(json));
+    return Serializer::ToJSON(
+        Serializer::FromBinary(snapshot.data(), snapshot.size()));
+  };
+
+  SECTION("Round trips") {
+    std::vector<gd::String> jsons = {
+        "{}",
+        "[]",
+        "\"hello\"",
+        "{\"hello\": \"world\"}",
+        "{\"hello\": {\"world\": [{},[],3,\"4\"],\"world2\": [-1,\"-2\","
+        "{\"-3\": [-4]}]}}",
+        "{\"ok\": true,\"notok\": false,\"\": \"\",\"a\": \"a\",\"a\": 1}",
+        "[0,-0,1.5,-1.5,1e+300,-1e-300,123456,-2147483648,4.5036e+15]",
+        u8"{\"\\\"quotes\\\"\": \"\\n\\t\",\"官话\": \"官话\"}"};
+    for (std::size_t i = 0; i < jsons.size(); ++i) {
+      INFO(jsons[i]);
+      REQUIRE(toBinaryAndBackToJSON(jsons[i]) ==
+              Serializer::ToJSON(Serializer::FromJSON(jsons[i])));
+    }
+
+    // Integers and doubles are kept as is.
+    SerializerElement element;
+    element.AddChild("int").SetIntValue(-42);
+    element.AddChild("double").SetDoubleValue(0.1);
+    element.AddChild("bool").SetBoolValue(false);
+    std::string snapshot = Serializer::ToBinary(element);
+    SerializerElement decodedElement =
+        Serializer::FromBinary(snapshot.data(), snapshot.size());
+    REQUIRE(decodedElement.GetChild("int").GetIntValue() == -42);
+    REQUIRE(decodedElement.GetChild("double").GetDoubleValue() == 0.1);
+    REQUIRE(decodedElement.GetChild("bool").GetBoolValue() == false);
+    REQUIRE(Serializer::ToJSON(decodedElement) == Serializer::ToJSON(element));
+
+    std::ostringstream stream;
+    Serializer::ToBinary(element, stream);
+    REQUIRE(stream.str() == snapshot);
+  }
+
+  SECTION("Strings are stored once") {
+    SerializerElement element;
+    element.ConsiderAsArray();
+    for (std::size_t i = 0; i < 100; ++i)
+      element.AddChild("").SetAttribute("name", "A long name repeated");
+
+    std::string snapshot = Serializer::ToBinary(element);
+    REQUIRE(snapshot.size() < Serializer::ToJSON(element).Raw().size() / 2);
+  }
+
+  SECTION("Lazy decoding of an element") {
+    gd::String json =
+        "{\"properties\": {\"name\": \"My game\"},\"layouts\": [{\"name\": "
+        "\"Layout1\",\"objects\": [1,2]},{\"name\": \"Layout2\",\"objects\": "
+        "[3,{\"a\": true}]}]}";
+    std::string data = Serializer::ToBinary(Serializer::FromJSON(json));
+    BinarySnapshot snapshot(data.data(), data.size());
+    REQUIRE(snapshot.IsValid() == true);
+
+    BinarySnapshotElement root = snapshot.GetRoot();
+    REQUIRE(root.IsValueUndefined() == true);
+    REQUIRE(root.GetAllChildrenCount() == 2);
+    REQUIRE(root.GetChildAt(1).GetName() == "layouts");
+    REQUIRE(root.GetChild("properties").GetChild("name").GetStringValue() ==
+            "My game");
+    REQUIRE(root.GetChild("notexisting").IsValid() == false);
+    REQUIRE(root.GetChild("properties", 1).IsValid() == false);
+
+    BinarySnapshotElement layouts = root.GetChild("layouts");
+    REQUIRE(layouts.ConsideredAsArray() == true);
+    REQUIRE(layouts.GetAllChildrenCount() == 2);
+    REQUIRE(layouts.GetChildAt(2).IsValid() == false);
+    BinarySnapshotElement layout = layouts.GetChildAt(1);
+    REQUIRE(layout.GetChild("name").GetStringValue() == "Layout2");
+    REQUIRE(layout.GetChild("objects").GetChildAt(0).GetIntValue() == 3);
+
+    SerializerElement layoutElement = Serializer::FromBinary(layout);
+    REQUIRE(Serializer::ToJSON(layoutElement) ==
+            "{\"name\": \"Layout2\",\"objects\": [3,{\"a\": true}]}");
+
+    // Decoded elements can also be a FlatSerializerTree.
+    FlatSerializerTree tree;
+    {
+      FlatSerializerTree::JSONBuilder builder(tree);
+      REQUIRE(layout.Visit(builder) == true);
+    }
+    REQUIRE(tree.GetRoot().GetChild("objects").GetChildrenCount() == 2);
+  }
+
+  SECTION("Invalid or truncated snapshots") {
+    REQUIRE(BinarySnapshot("", 0).IsValid() == false);
+    REQUIRE(BinarySnapshot("{}", 2).IsValid() == false);
+
+    gd::String json =
+        "{\"hello\": {\"world\": [{},[],3,\"4\",1.5]},\"ok\": true}";
+    std::string data = Serializer::ToBinary(Serializer::FromJSON(json));
+    for (std::size_t size = 0; size < data.size(); ++size) {
+      BinarySnapshot snapshot(data.data(), size);
+      std::ostringstream stream;
+      JSONWriter visitor(stream);
+      REQUIRE(snapshot.GetRoot().Visit(visitor) == false);
+      snapshot.GetRoot().GetChild("hello").GetChild("world").GetChildAt(4)
+          .GetDoubleValue();
+    }
+
+    // Corrupting any byte must not read outside of the snapshot.
+    for (std::size_t i = 0; i < data.size(); ++i) {
+      std::string corruptedData = data;
+      corruptedData[i] = static_cast<char>(0xFF);
+      BinarySnapshot snapshot(corruptedData.data(), corruptedData.size());
+      std::ostringstream stream;
+      JSONWriter visitor(stream);
+      snapshot.GetRoot().Visit(visitor);
+      snapshot.GetRoot().GetChild("hello").GetChild("world").GetChildAt(3)
+          .GetStringValue();
+    }
+  }
+}
@@ -0,0 +1,206 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Benchmarks of the serialization to/from JSON of a large project.
+ */
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include "GDCore/Serialization/BinarySnapshot.h"
+#include "GDCore/Serialization/FlatSerializerTree.h"
+#include "GDCore/Serialization/JSONReader.h"
+#include "GDCore/Serialization/JSONWriter.h"
+#include "GDCore/Serialization/Serializer.h"
+#include "catch.hpp"
+
+namespace {
+/**
+ * Fill \a element with a synthetic project having the same structure as the
+ * serialization of a gd::Project, with \a layoutsCount layouts of
+ * \a instancesCount initial instances.
+ */
+void CreateSyntheticProject(gd::SerializerElement& element,
+                            std::size_t layoutsCount,
+                            std::size_t instancesCount) {
+  element.AddChild("firstLayout").SetStringValue("Layout0");
+  gd::SerializerElement& propertiesElement = element.AddChild("properties");
+  propertiesElement.AddChild("name").SetStringValue("Synthetic project");
+  propertiesElement.AddChild("author").SetStringValue(u8"Benchmark – 官话");
+  propertiesElement.AddChild("windowWidth").SetIntValue(800);
+  propertiesElement.AddChild("windowHeight").SetIntValue(600);
+
+  gd::SerializerElement& layoutsElement = element.AddChild("layouts");
+  layoutsElement.ConsiderAsArrayOf("layout");
+  for (std::size_t i = 0; i < layoutsCount; ++i) {
+    gd::SerializerElement& layoutElement = layoutsElement.AddChild("layout");
+    layoutElement.SetAttribute("name", "Layout" + gd::String::From(i));
+    layoutElement.SetAttribute("title", "My \"layout\"\n");
+    layoutElement.SetAttribute("r", 209.0);
+    layoutElement.SetAttribute("v", 209.0);
+    layoutElement.SetAttribute("b", 209.0);
+
+    gd::SerializerElement& instancesElement =
+        layoutElement.AddChild("instances");
+    instancesElement.ConsiderAsArrayOf("instance");
+    for (std::size_t j = 0; j < instancesCount; ++j) {
+      gd::SerializerElement& instanceElement =
+          instancesElement.AddChild("instance");
+      instanceElement
+          .SetAttribute("name", "MyObject" + gd::String::From(j % 20))
+          .SetAttribute("x", j * 32.5)
+          .SetAttribute("y", j * -7.25)
+          .SetAttribute("zOrder", (int)(j % 7))
+          .SetAttribute("layer", "")
+          .SetAttribute("angle", (j % 360) * 1.0)
+          .SetAttribute("customSize", j % 2 == 0)
+          .SetAttribute("width", 64.0)
+          .SetAttribute("height", 32.0)
+          .SetAttribute("locked", false)
+          .SetAttribute("persistentUuid",
+                        "0a1b2c3d-4e5f-4a6b-8c7d-" + gd::String::From(j));
+
+      gd::SerializerElement& numberPropertiesElement =
+          instanceElement.AddChild("numberProperties");
+      numberPropertiesElement.ConsiderAsArrayOf("property");
+      numberPropertiesElement.AddChild("property")
+          .SetAttribute("name", "animation")
+          .SetAttribute("value", 1.0);
+      gd::SerializerElement& stringPropertiesElement =
+          instanceElement.AddChild("stringProperties");
+      stringPropertiesElement.ConsiderAsArrayOf("property");
+      gd::SerializerElement& variablesElement =
+          instanceElement.AddChild("initialVariables");
+      variablesElement.ConsiderAsArrayOf("variable");
+      variablesElement.AddChild("variable")
+          .SetAttribute("name", "Health")
+          .SetAttribute("value", "100");
+    }
+  }
+}
+
+/**
+ * A visitor doing nothing, to measure the time spent only in the reader.
+ */
+class NullJSONVisitor : public gd::JSONVisitor {
+ public:
+  bool OnBeginObject() override { return true; }
+  bool OnKey(const char* key, std::size_t length) override { return true; }
+  bool OnEndObject() override { return true; }
+  bool OnBeginArray() override { return true; }
+  bool OnEndArray() override { return true; }
+  bool OnString(const char* value, std::size_t length) override {
+    return true;
+  }
+  bool OnNumber(double value) override { return true; }
+  bool OnBool(bool value) override { return true; }
+  bool OnNull() override { return true; }
+};
+
+void DoBenchmark(const gd::String& benchmarkName, std::function<void()> func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  auto end = std::chrono::steady_clock::now();
+
+  std::cout << benchmarkName << " benchmark: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(end -
+                                                                     start)
+                   .count()
+            << " milliseconds" << std::endl;
+}
+}  // namespace
+
+TEST_CASE("Serializer - Benchmarks", "[common][benchmarks]") {
+  // 110 layouts of 1500 instances give a JSON file of about 50 MB.
+  gd::SerializerElement projectElement;
+  CreateSyntheticProject(projectElement, 110, 1500);
+
+  gd::String json;
+  DoBenchmark("ToJSON (to a string) of a 50 MB project",
+              [&]() { json = gd::Serializer::ToJSON(projectElement); });
+  std::cout << "JSON size: " << json.Raw().size() / 1024 / 1024 << " MB"
+            << std::endl;
+
+  DoBenchmark("ToJSON (to a stream) of a 50 MB project", [&]() {
+    std::ostringstream stream;
+    gd::Serializer::ToJSON(projectElement, stream);
+    REQUIRE(stream.str().size() == json.Raw().size());
+  });
+
+  DoBenchmark("JSONReader (no visitor) of a 50 MB project", [&]() {
+    gd::JSONReader reader(json.Raw().data(), json.Raw().size());
+    NullJSONVisitor visitor;
+    REQUIRE(reader.Read(visitor) == true);
+  });
+
+  gd::SerializerElement unserializedElement;
+  DoBenchmark("FromJSON (from a string) of a 50 MB project", [&]() {
+    unserializedElement = gd::Serializer::FromJSON(json);
+  });
+  REQUIRE(gd::Serializer::ToJSON(unserializedElement) == json);
+
+  std::istringstream stream(json.Raw());
+  DoBenchmark("FromJSON (from a stream) of a 50 MB project", [&]() {
+    unserializedElement = gd::Serializer::FromJSON(stream);
+  });
+  REQUIRE(gd::Serializer::ToJSON(unserializedElement) == json);
+
+  gd::FlatSerializerTree tree;
+  DoBenchmark("FromJSON (to a FlatSerializerTree) of a 50 MB project", [&]() {
+    REQUIRE(gd::Serializer::FromJSON(
+                json.Raw().data(), json.Raw().size(), tree) == true);
+  });
+  std::cout << "FlatSerializerTree memory usage: "
+            << tree.GetMemoryUsage() / 1024 / 1024 << " MB" << std::endl;
+
+  double flatTreeSum = 0;
+  DoBenchmark("Reading instances positions in a FlatSerializerTree", [&]() {
+    gd::FlatSerializerElement layouts = tree.GetRoot().GetChild("layouts");
+    for (std::size_t i = 0; i < layouts.GetChildrenCount(); ++i) {
+      gd::FlatSerializerElement instances =
+          layouts.GetChild(i).GetChild("instances");
+      for (std::size_t j = 0; j < instances.GetChildrenCount(); ++j)
+        flatTreeSum += instances.GetChild(j).GetDoubleAttribute("x");
+    }
+  });
+
+  double elementSum = 0;
+  DoBenchmark("Reading instances positions in a SerializerElement", [&]() {
+    const gd::SerializerElement& layouts =
+        unserializedElement.GetChild("layouts");
+    for (std::size_t i = 0; i < layouts.GetChildrenCount(); ++i) {
+      const gd::SerializerElement& instances =
+          layouts.GetChild(i).GetChild("instances");
+      for (std::size_t j = 0; j < instances.GetChildrenCount(); ++j)
+        elementSum += instances.GetChild(j).GetDoubleAttribute("x");
+    }
+  });
+  REQUIRE(flatTreeSum == elementSum);
+
+  std::string snapshot;
+  DoBenchmark("ToBinary of a 50 MB project", [&]() {
+    snapshot = gd::Serializer::ToBinary(unserializedElement);
+  });
+  std::cout << "Binary snapshot size: " << snapshot.size() / 1024 / 1024
+            << " MB" << std::endl;
+
+  DoBenchmark("FromBinary of a 50 MB project", [&]() {
+    gd::SerializerElement element =
+        gd::Serializer::FromBinary(snapshot.data(), snapshot.size());
+    REQUIRE(element.GetChild("layouts").GetChildrenCount() == 110);
+  });
+
+  DoBenchmark("FromBinary of a single layout of a 50 MB project", [&]() {
+    gd::BinarySnapshot binarySnapshot(snapshot.data(), snapshot.size());
+    gd::SerializerElement layoutElement = gd::Serializer::FromBinary(
+        binarySnapshot.GetRoot().GetChild("layouts").GetChildAt(100));
+    REQUIRE(layoutElement.GetStringAttribute("name") == "Layout100");
+  });
+
+  DoBenchmark("Destruction of a FlatSerializerTree", [&]() { tree.Clear(); });
+  DoBenchmark("Destruction of a SerializerElement",
+              [&]() { unserializedElement = gd::SerializerElement(); });
+}
@@ -0,0 +1,89 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Benchmarks of gd::String accesses by position, as done when parsing
+ * long expressions.
+ */
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include "GDCore/String.h"
+#include "catch.hpp"
+
+namespace {
+void DoBenchmark(const gd::String& benchmarkName, std::function<void()> func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  auto end = std::chrono::steady_clock::now();
+
+  std::cout << benchmarkName << " benchmark: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                     start)
+                   .count()
+            << " microseconds" << std::endl;
+}
+
+/**
+ * Go through the expression like a parser would: character by character with
+ * operator[], extracting identifiers with substr and searching the end of
+ * string literals with find.
+ */
+std::size_t ScanExpression(const gd::String& expression) {
+  std::size_t tokensCount = 0;
+  std::size_t position = 0;
+  while (position < expression.size()) {
+    gd::String::value_type character = expression[position];
+    if (character == '"') {
+      std::size_t end = expression.find("\"", position + 1);
+      if (end == gd::String::npos) break;
+      position = end + 1;
+      tokensCount++;
+    } else if ((character >= 'a' && character <= 'z') ||
+               (character >= 'A' && character <= 'Z') || character > 127) {
+      std::size_t start = position;
+      while (position < expression.size() &&
+             ((expression[position] >= 'a' && expression[position] <= 'z') ||
+              (expression[position] >= 'A' && expression[position] <= 'Z') ||
+              expression[position] > 127))
+        position++;
+      gd::String identifier = expression.substr(start, position - start);
+      if (!identifier.empty()) tokensCount++;
+    } else {
+      position++;
+    }
+  }
+
+  return tokensCount;
+}
+}  // namespace
+
+TEST_CASE("Utf8 String - Benchmarks", "[common][utf8][benchmarks]") {
+  gd::String asciiExpression;
+  gd::String unicodeExpression;
+  for (std::size_t i = 0; i < 500; ++i) {
+    asciiExpression +=
+        "MySpriteObject.Variable(Score)+ToNumber(\"Some text\")*2+";
+    unicodeExpression += u8"MonObjetSprité.Variable(Scoré)+ToNumber(\"Du "
+                         u8"texte 官话\")*2+";
+  }
+  asciiExpression += "0";
+  unicodeExpression += "0";
+
+  DoBenchmark("Scan a long ASCII expression (28K characters)", [&]() {
+    REQUIRE(ScanExpression(asciiExpression) == 2500);
+  });
+  DoBenchmark("Scan a long non ASCII expression (28K characters)", [&]() {
+    REQUIRE(ScanExpression(unicodeExpression) == 2500);
+  });
+
+  DoBenchmark("Random accesses in a long non ASCII expression", [&]() {
+    std::size_t size = unicodeExpression.size();
+    gd::String::value_type sum = 0;
+    for (std::size_t i = 0; i < 100000; ++i)
+      sum += unicodeExpression[(i * 7919) % size];
+    REQUIRE(sum != 0);
+  });
+}
@@ -289,4 +289,86 @@ TEST_CASE("Utf8 String", "[common][utf8]") {
     gd::String str6 = u8"ßßß";
     REQUIRE(str6.FindAndReplace(u8"ßß", u8"ß") == u8"ßß");
   }
+
+  SECTION("indexed access in long strings") {
+    // Long enough strings, mixing characters of 1 to 4 bytes, are indexed.
+    gd::String str;
+    std::u32string u32str;
+    for (std::size_t i = 0; i < 1000; ++i) {
+      char32_t character = i % 7 == 0 ? U'é'
+                                      : i % 11 == 0 ? U'官'
+                                                    : i % 13 == 0 ? U'😀' : U'a';
+      str.push_back(character);
+      u32str.push_back(character);
+    }
+
+    REQUIRE(str.size() == 1000);
+    for (std::size_t i = 0; i < u32str.size(); ++i)
+      REQUIRE(str[i] == u32str[i]);
+    REQUIRE(str.substr(500, 40).ToUTF32() == u32str.substr(500, 40));
+    REQUIRE(str.substr(990).ToUTF32() == u32str.substr(990));
+    REQUIRE(str.find(U'😀', 500) == u32str.find(U'😀', 500));
+    REQUIRE(str.find(u8"é", 995) == gd::String::npos);
+    REQUIRE(str.rfind(U'官', 600) == u32str.rfind(U'官', 600));
+    REQUIRE(str.rfind(U'官') == u32str.rfind(U'官'));
+
+    // Modifications update the length and the positions.
+    str.insert(100, u8"ßß");
+    u32str.insert(100, U"ßß");
+    str.erase(0, 3);
+    u32str.erase(0, 3);
+    str.replace(300, 10, u8"官");
+    u32str.replace(300, 10, U"官");
+    str += u8"éé";
+    u32str += U"éé";
+    REQUIRE(str.size() == u32str.size());
+    for (std::size_t i = 0; i < u32str.size(); ++i)
+      REQUIRE(str[i] == u32str[i]);
+
+    // Including when the internal string is modified.
+    str.RawMutable().insert(0, u8"é");
+    u32str.insert(0, U"é");
+    REQUIRE(str.size() == u32str.size());
+    REQUIRE(str[600] == u32str[600]);
+    REQUIRE(str.find(U'😀', 700) == u32str.find(U'😀', 700));
+
+    // Even with a reference kept after the positions were indexed again.
+    std::string& raw = str.RawMutable();
+    REQUIRE(str[600] == u32str[600]);
+    raw.insert(0, u8"官");
+    u32str.insert(0, U"官");
+    REQUIRE(str.size() == u32str.size());
+    for (std::size_t i = 0; i < u32str.size(); ++i)
+      REQUIRE(str[i] == u32str[i]);
+    REQUIRE(str.substr(990).ToUTF32() == u32str.substr(990));
+    raw.erase(0, 3);
+    u32str.erase(0, 1);
+    for (std::size_t i = 0; i < u32str.size(); ++i)
+      REQUIRE(str[i] == u32str[i]);
+
+    // Copies keep the same content.
+    gd::String copy = str;
+    gd::String moved = std::move(copy);
+    REQUIRE(moved.size() == u32str.size());
+    REQUIRE(moved[600] == u32str[600]);
+    copy = moved;
+    copy.pop_back();
+    REQUIRE(copy.size() == u32str.size() - 1);
+    REQUIRE(moved.size() == u32str.size());
+  }
+
+  SECTION("ASCII strings") {
+    gd::String str;
+    for (std::size_t i = 0; i < 1000; ++i) str.push_back(U'a' + i % 26);
+
+    REQUIRE(str.size() == 1000);
+    REQUIRE(str[500] == U'a' + 500 % 26);
+    REQUIRE(str.substr(26, 3) == "abc");
+    REQUIRE(str.find("xyz", 100) == 101);
+
+    str.push_back(U'é');
+    REQUIRE(str.size() == 1001);
+    REQUIRE(str[1000] == U'é');
+    REQUIRE(str.find(u8"é") == 1000);
+  }
 }
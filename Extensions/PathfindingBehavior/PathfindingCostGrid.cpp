@@ -0,0 +1,122 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#include "PathfindingCostGrid.h"
+#include <algorithm>
+#include <cmath>
+#include "ScenePathfindingObstaclesManager.h"
+
+PathfindingCostGrid::PathfindingCostGrid(
+    const ScenePathfindingObstaclesManager& obstacles_,
+    float cellWidth_,
+    float cellHeight_,
+    float leftBorder_,
+    float topBorder_,
+    float rightBorder_,
+    float bottomBorder_)
+    : obstacles(obstacles_),
+      cellWidth(cellWidth_),
+      cellHeight(cellHeight_),
+      leftBorder(leftBorder_),
+      topBorder(topBorder_),
+      rightBorder(rightBorder_),
+      bottomBorder(bottomBorder_),
+      lastChunk(NULL),
+      lastChunkX(0),
+      lastChunkY(0),
+      chunksComputationsCount(0) {}
+
+void PathfindingCostGrid::MarkAsDirty(float left,
+                                      float top,
+                                      float right,
+                                      float bottom) {
+  int minX, minY, maxX, maxY;
+  GetCoveredCells(left, top, right, bottom, minX, minY, maxX, maxY);
+  if (minX > maxX || minY > maxY) return;
+
+  for (int chunkY = FloorDivide(minY, chunkSize);
+       chunkY <= FloorDivide(maxY, chunkSize);
+       ++chunkY) {
+    for (int chunkX = FloorDivide(minX, chunkSize);
+         chunkX <= FloorDivide(maxX, chunkSize);
+         ++chunkX) {
+      auto it = chunks.find(GetChunkKey(chunkX, chunkY));
+      if (it != chunks.end()) it->second.dirty = true;
+    }
+  }
+}
+
+void PathfindingCostGrid::GetCoveredCells(float left,
+                                          float top,
+                                          float right,
+                                          float bottom,
+                                          int& minX,
+                                          int& minY,
+                                          int& maxX,
+                                          int& maxY) const {
+  // The object moving on the cells is considered to be on a cell as soon as
+  // its borders overlap the obstacle.
+  minX = floor((left - rightBorder) / cellWidth) + 1;
+  minY = floor((top - bottomBorder) / cellHeight) + 1;
+  maxX = ceil((right + leftBorder) / cellWidth) - 1;
+  maxY = ceil((bottom + topBorder) / cellHeight) - 1;
+}
+
+void PathfindingCostGrid::ComputeChunk(Chunk& chunk, int chunkX, int chunkY) {
+  int firstX = chunkX * chunkSize;
+  int firstY = chunkY * chunkSize;
+  int lastX = firstX + chunkSize - 1;
+  int lastY = firstY + chunkSize - 1;
+
+  // Only the obstacles in this area can cover a cell of the chunk.
+  std::vector<const ScenePathfindingObstaclesManager::ObstacleArea*> areas;
+  obstacles.GetObstaclesAreasIn((firstX - 1) * cellWidth - leftBorder,
+                                (firstY - 1) * cellHeight - topBorder,
+                                (lastX + 1) * cellWidth + rightBorder,
+                                (lastY + 1) * cellHeight + bottomBorder,
+                                areas);
+
+  // coveredCells is 0 for cells without obstacles, 1 for cells with passable
+  // obstacles only and 2 for impassable cells.
+  chunk.costs.assign(chunkSize * chunkSize, 0);
+  coveredCells.assign(chunkSize * chunkSize, 0);
+  for (const auto* area : areas) {
+    int minX, minY, maxX, maxY;
+    GetCoveredCells(area->left,
+                    area->top,
+                    area->right,
+                    area->bottom,
+                    minX,
+                    minY,
+                    maxX,
+                    maxY);
+    minX = std::max(minX, firstX);
+    minY = std::max(minY, firstY);
+    maxX = std::min(maxX, lastX);
+    maxY = std::min(maxY, lastY);
+
+    for (int y = minY; y <= maxY; ++y) {
+      for (int x = minX; x <= maxX; ++x) {
+        std::size_t i = (y - firstY) * chunkSize + (x - firstX);
+        if (area->impassable) {
+          chunk.costs[i] = -1;
+          coveredCells[i] = 2;
+        } else if (coveredCells[i] != 2) {  // Superimpose obstacles
+          chunk.costs[i] += area->cost;
+          coveredCells[i] = 1;
+        }
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < coveredCells.size(); ++i) {
+    if (coveredCells[i] == 0)
+      chunk.costs[i] = 1;  // Default cost when no objects put on the cell.
+  }
+
+  chunk.dirty = false;
+  chunksComputationsCount++;
+}
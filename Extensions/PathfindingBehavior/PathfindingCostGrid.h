@@ -0,0 +1,130 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#ifndef PATHFINDINGCOSTGRID_H
+#define PATHFINDINGCOSTGRID_H
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+class ScenePathfindingObstaclesManager;
+
+/**
+ * \brief The cost of moving on each cell of the scene, for objects of a given
+ * size moving on cells of a given size.
+ *
+ * The grid is split in chunks of cells, computed from the obstacles the first
+ * time one of their cells is read. When an obstacle is added, changed or
+ * removed, only the chunks containing cells covered by the obstacle are marked
+ * as dirty, to be computed again when read.
+ *
+ * \see ScenePathfindingObstaclesManager::GetCostGrid
+ */
+class PathfindingCostGrid {
+ public:
+  PathfindingCostGrid(const ScenePathfindingObstaclesManager& obstacles,
+                      float cellWidth,
+                      float cellHeight,
+                      float leftBorder,
+                      float topBorder,
+                      float rightBorder,
+                      float bottomBorder);
+
+  /**
+   * \brief Return the cost of moving on a cell: -1 if an impassable obstacle
+   * covers it, the sum of the costs of the obstacles covering it, or 1 if there
+   * are no obstacles on it.
+   */
+  float GetCost(int x, int y) {
+    int chunkX = FloorDivide(x, chunkSize);
+    int chunkY = FloorDivide(y, chunkSize);
+    const Chunk& chunk = GetChunk(chunkX, chunkY);
+    return chunk.costs[(y - chunkY * chunkSize) * chunkSize +
+                       (x - chunkX * chunkSize)];
+  }
+
+  /**
+   * \brief Mark as dirty the chunks containing cells covered by an obstacle
+   * occupying the given area (in "world" coordinates).
+   */
+  void MarkAsDirty(float left, float top, float right, float bottom);
+
+  /**
+   * \brief Return the number of times a chunk was computed since the creation
+   * of the grid.
+   */
+  std::size_t GetChunksComputationsCount() const {
+    return chunksComputationsCount;
+  }
+
+  /**
+   * \brief Compute the cells covered by an obstacle occupying the given area,
+   * from (minX;minY) to (maxX;maxY) included.
+   */
+  void GetCoveredCells(float left,
+                       float top,
+                       float right,
+                       float bottom,
+                       int& minX,
+                       int& minY,
+                       int& maxX,
+                       int& maxY) const;
+
+  static const int chunkSize = 32;  ///< The number of cells on each side of a
+                                    ///< chunk.
+
+ private:
+  struct Chunk {
+    std::vector<float> costs;  ///< The cost of each cell, row by row.
+    bool dirty;
+  };
+
+  /**
+   * \brief Return the chunk, computing it if needed.
+   */
+  const Chunk& GetChunk(int chunkX, int chunkY) {
+    if (lastChunk && chunkX == lastChunkX && chunkY == lastChunkY &&
+        !lastChunk->dirty)
+      return *lastChunk;
+
+    Chunk& chunk = chunks[GetChunkKey(chunkX, chunkY)];
+    if (chunk.costs.empty() || chunk.dirty) ComputeChunk(chunk, chunkX, chunkY);
+
+    lastChunk = &chunk;
+    lastChunkX = chunkX;
+    lastChunkY = chunkY;
+    return chunk;
+  }
+
+  void ComputeChunk(Chunk& chunk, int chunkX, int chunkY);
+
+  static int FloorDivide(int a, int b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+  }
+
+  static std::uint64_t GetChunkKey(int chunkX, int chunkY) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkX))
+            << 32) |
+           static_cast<std::uint32_t>(chunkY);
+  }
+
+  const ScenePathfindingObstaclesManager& obstacles;
+  float cellWidth;
+  float cellHeight;
+  float leftBorder;
+  float topBorder;
+  float rightBorder;
+  float bottomBorder;
+  std::unordered_map<std::uint64_t, Chunk> chunks;
+  Chunk* lastChunk;  ///< The last chunk read, to avoid searching it again when
+                     ///< reading the neighbor cells.
+  int lastChunkX;
+  int lastChunkY;
+  std::size_t chunksComputationsCount;
+  std::vector<char> coveredCells;  ///< Temporary buffer used when computing a
+                                   ///< chunk.
+};
+
+#endif  // PATHFINDINGCOSTGRID_H
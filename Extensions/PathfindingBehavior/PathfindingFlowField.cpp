@@ -0,0 +1,114 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#include "PathfindingFlowField.h"
+#include "PathfindingCostGrid.h"
+
+const int PathfindingFlowField::radius = 64;
+
+namespace {
+const std::size_t noCell = static_cast<std::size_t>(-1);
+const float sqrt2 = 1.414213562;
+}  // namespace
+
+PathfindingFlowField::PathfindingFlowField(PathfindingCostGrid& costGrid_,
+                                           int destinationX_,
+                                           int destinationY_,
+                                           bool allowsDiagonal_)
+    : costGrid(costGrid_),
+      destinationX(destinationX_),
+      destinationY(destinationY_),
+      allowsDiagonal(allowsDiagonal_),
+      size(2 * radius + 1),
+      dirty(true),
+      computationsCount(0) {}
+
+bool PathfindingFlowField::CanStartFrom(int x, int y) {
+  return IsInField(x, y) && costGrid.GetCost(x, y) >= 0;
+}
+
+bool PathfindingFlowField::CanReachDestination(int x, int y) {
+  if (!IsInField(x, y)) return false;
+  if (dirty) Reset();
+
+  std::size_t index = GetIndex(x, y);
+  while (!closedCells[index] && !openCells.empty()) ExpandNextCell();
+
+  return closedCells[index] != 0;
+}
+
+void PathfindingFlowField::MarkAsDirty(float left,
+                                       float top,
+                                       float right,
+                                       float bottom) {
+  if (dirty) return;
+
+  int minX, minY, maxX, maxY;
+  costGrid.GetCoveredCells(left, top, right, bottom, minX, minY, maxX, maxY);
+  if (maxX >= destinationX - radius && minX <= destinationX + radius &&
+      maxY >= destinationY - radius && minY <= destinationY + radius)
+    dirty = true;
+}
+
+void PathfindingFlowField::Reset() {
+  costs.assign(size * size, -1);
+  nextCells.assign(size * size, noCell);
+  closedCells.assign(size * size, 0);
+  openCells = decltype(openCells)();
+  dirty = false;
+  computationsCount++;
+
+  // The destination is the start of the search.
+  if (costGrid.GetCost(destinationX, destinationY) < 0) return;
+  std::size_t destination = GetIndex(destinationX, destinationY);
+  costs[destination] = 0;
+  openCells.push(OpenCell(0, destination));
+}
+
+void PathfindingFlowField::ExpandNextCell() {
+  std::size_t index = openCells.top().second;
+  openCells.pop();
+  if (closedCells[index]) return;  // The cell was added again with a smaller
+                                   // cost, and already explored.
+  closedCells[index] = 1;
+
+  // Explore the neighbors in the same order as the A* of the objects.
+  int x = destinationX - radius + static_cast<int>(index % size);
+  int y = destinationY - radius + static_cast<int>(index / size);
+  float cost = costGrid.GetCost(x, y);
+  UpdateNeighbor(index, cost, x + 1, y, 1);
+  UpdateNeighbor(index, cost, x - 1, y, 1);
+  UpdateNeighbor(index, cost, x, y + 1, 1);
+  UpdateNeighbor(index, cost, x, y - 1, 1);
+  if (allowsDiagonal) {
+    UpdateNeighbor(index, cost, x + 1, y + 1, sqrt2);
+    UpdateNeighbor(index, cost, x + 1, y - 1, sqrt2);
+    UpdateNeighbor(index, cost, x - 1, y - 1, sqrt2);
+    UpdateNeighbor(index, cost, x - 1, y + 1, sqrt2);
+  }
+}
+
+void PathfindingFlowField::UpdateNeighbor(std::size_t index,
+                                          float cost,
+                                          int x,
+                                          int y,
+                                          float factor) {
+  if (!IsInField(x, y)) return;
+
+  std::size_t neighbor = GetIndex(x, y);
+  if (closedCells[neighbor]) return;
+
+  float neighborCost = costGrid.GetCost(x, y);
+  if (neighborCost < 0) return;  // Impassable obstacle
+
+  // Moving from the neighbor to the cell costs as much as the opposite.
+  double newCost = costs[index] + (cost + neighborCost) / 2.0 * factor;
+  if (costs[neighbor] == -1 || costs[neighbor] > newCost) {
+    costs[neighbor] = newCost;
+    nextCells[neighbor] = index;
+    openCells.push(OpenCell(costs[neighbor], neighbor));
+  }
+}
@@ -0,0 +1,154 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#ifndef PATHFINDINGFLOWFIELD_H
+#define PATHFINDINGFLOWFIELD_H
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+class PathfindingCostGrid;
+
+/**
+ * \brief The shortest paths from all the cells around a destination to this
+ * destination, shared by all the objects moving to it.
+ *
+ * The field stores, for each cell at most \a radius cells away from the
+ * destination, the cost of the shortest path to the destination and the next
+ * cell to go to. It's computed with Dijkstra's algorithm starting from the
+ * destination, incrementally: the search is only continued until the cells
+ * asked by the objects are reached, and resumed when a farther cell is asked.
+ *
+ * Paths going farther than \a radius cells from the destination are not
+ * considered. When an obstacle covering some cells of the field changes, the
+ * field is marked as dirty and computed again the next time it's used.
+ *
+ * \see ScenePathfindingObstaclesManager::GetFlowField
+ */
+class PathfindingFlowField {
+ public:
+  /**
+   * \param costGrid The costs of the cells, which must outlive the field.
+   * \param allowsDiagonal true to allow moving to the diagonal neighbors.
+   */
+  PathfindingFlowField(PathfindingCostGrid& costGrid,
+                       int destinationX,
+                       int destinationY,
+                       bool allowsDiagonal);
+
+  /**
+   * \brief Return true if the cell is covered by the field.
+   */
+  bool IsInField(int x, int y) const {
+    return x >= destinationX - radius && x <= destinationX + radius &&
+           y >= destinationY - radius && y <= destinationY + radius;
+  }
+
+  /**
+   * \brief Return true if the cell is covered by the field and is not covered
+   * by an impassable obstacle, i.e. if the paths starting from it can be read
+   * from the field.
+   */
+  bool CanStartFrom(int x, int y);
+
+  /**
+   * \brief Return true if the destination can be reached from the cell,
+   * continuing the computation of the field until the cell is reached if
+   * needed.
+   */
+  bool CanReachDestination(int x, int y);
+
+  /**
+   * \brief Move to the next cell of the shortest path to the destination.
+   * \warning The destination must be reachable from the cell, which must not
+   * be the destination (see CanReachDestination).
+   */
+  void GoToNextCell(int& x, int& y) const {
+    std::size_t next = nextCells[GetIndex(x, y)];
+    x = destinationX - radius + static_cast<int>(next % size);
+    y = destinationY - radius + static_cast<int>(next / size);
+  }
+
+  /**
+   * \brief Return the cost of the shortest path from the cell to the
+   * destination, or -1 if it's not computed yet or not reachable.
+   */
+  float GetCostToDestination(int x, int y) const {
+    return IsInField(x, y) && !dirty ? costs[GetIndex(x, y)] : -1;
+  }
+
+  /**
+   * \brief Mark the field as dirty if an obstacle occupying the given area
+   * (in "world" coordinates) covers some of its cells.
+   */
+  void MarkAsDirty(float left, float top, float right, float bottom);
+
+  /**
+   * \brief Return the grid of the costs of the cells used by the field.
+   */
+  const PathfindingCostGrid& GetCostGrid() const { return costGrid; }
+
+  /**
+   * \brief Return the number of times the computation of the field was
+   * started since its creation.
+   */
+  std::size_t GetComputationsCount() const { return computationsCount; }
+
+  static const int radius;  ///< The number of cells covered by the field on
+                            ///< each side of the destination.
+
+ private:
+  std::size_t GetIndex(int x, int y) const {
+    return static_cast<std::size_t>(y - destinationY + radius) * size +
+           (x - destinationX + radius);
+  }
+
+  /**
+   * \brief Forget the computed cells and start the computation again from
+   * the destination.
+   */
+  void Reset();
+
+  /**
+   * \brief Close the open cell nearest to the destination and update its
+   * neighbors.
+   */
+  void ExpandNextCell();
+
+  /**
+   * \brief Update the cost of a neighbor of the cell at \a index, whose cost
+   * of moving on it is \a cost, if going to the destination through the cell
+   * is shorter.
+   */
+  void UpdateNeighbor(std::size_t index,
+                      float cost,
+                      int x,
+                      int y,
+                      float factor);
+
+  typedef std::pair<float, std::size_t> OpenCell;  ///< A cell to explore and
+                                                   ///< its cost.
+
+  PathfindingCostGrid& costGrid;
+  int destinationX;
+  int destinationY;
+  bool allowsDiagonal;
+  std::size_t size;  ///< The number of cells on each side of the field.
+  std::vector<float> costs;  ///< The cost of the shortest path found from
+                             ///< each cell to the destination, or -1.
+  std::vector<std::size_t> nextCells;  ///< The index of the next cell of the
+                                       ///< shortest path from each cell.
+  std::vector<char> closedCells;  ///< 1 for the cells whose shortest path is
+                                  ///< known.
+  std::priority_queue<OpenCell, std::vector<OpenCell>, std::greater<OpenCell>>
+      openCells;  ///< The cells to explore. A cell can be there several times
+                  ///< if its cost decreased: only the first one is explored.
+  bool dirty;
+  std::size_t computationsCount;
+};
+
+#endif  // PATHFINDINGFLOWFIELD_H
@@ -0,0 +1,163 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#include "PathfindingNodesArena.h"
+#include <algorithm>
+
+const std::size_t PathfindingNodesArena::noNode = static_cast<std::size_t>(-1);
+const int PathfindingNodesArena::maxWindowSize = 1024;
+
+PathfindingNodesArena::PathfindingNodesArena()
+    : outsideNodesCount(0),
+      windowX(0),
+      windowY(0),
+      windowWidth(0),
+      windowHeight(0),
+      generation(0),
+      nextOpeningOrder(0) {}
+
+void PathfindingNodesArena::StartSearch(int minX,
+                                        int minY,
+                                        int maxX,
+                                        int maxY) {
+  generation++;
+  if (generation == 0) {
+    // The counter wrapped around: forget the generation of all nodes.
+    for (Node& node : nodes) node.generation = 0;
+    generation = 1;
+  }
+  heap.clear();
+  nextOpeningOrder = 0;
+  outsideNodes.clear();
+  outsideNodesCount = 0;
+
+  windowWidth = std::min(maxX - minX + 1, maxWindowSize);
+  windowHeight = std::min(maxY - minY + 1, maxWindowSize);
+  windowX = minX + (maxX - minX + 1 - windowWidth) / 2;
+  windowY = minY + (maxY - minY + 1 - windowHeight) / 2;
+  std::size_t size = static_cast<std::size_t>(windowWidth) * windowHeight;
+  if (nodes.size() < size) {
+    Node node;
+    node.generation = 0;
+    nodes.resize(size, node);
+  }
+}
+
+std::size_t PathfindingNodesArena::GetNode(int x, int y, bool& isNew) {
+  if (IsInWindow(x, y)) return InitializeNode(x, y, isNew);
+
+  // The nodes outside of the window are stored after the nodes of the window.
+  auto it = outsideNodes.find(GetCellKey(x, y));
+  if (it != outsideNodes.end()) {
+    isNew = false;
+    return it->second;
+  }
+
+  std::size_t index = static_cast<std::size_t>(windowWidth) * windowHeight +
+                      outsideNodesCount++;
+  if (index >= nodes.size()) nodes.push_back(Node());
+  ResetNode(nodes[index], x, y);
+  outsideNodes[GetCellKey(x, y)] = index;
+  isNew = true;
+  return index;
+}
+
+std::size_t PathfindingNodesArena::GetNodeInWindow(int x,
+                                                   int y,
+                                                   bool& isNew) {
+  if (!IsInWindow(x, y)) {
+    isNew = false;
+    return noNode;
+  }
+
+  return InitializeNode(x, y, isNew);
+}
+
+std::size_t PathfindingNodesArena::InitializeNode(int x, int y, bool& isNew) {
+  std::size_t index = GetIndex(x, y);
+  Node& node = nodes[index];
+  isNew = node.generation != generation;
+  if (isNew) ResetNode(node, x, y);
+
+  return index;
+}
+
+void PathfindingNodesArena::ResetNode(Node& node, int x, int y) {
+  node.x = x;
+  node.y = y;
+  node.cost = 0;
+  node.smallestCost = -1;
+  node.estimateCost = -1;
+  node.parent = noNode;
+  node.heapIndex = noNode;
+  node.openingOrder = 0;
+  node.generation = generation;
+  node.closed = false;
+}
+
+std::size_t PathfindingNodesArena::PopOpenNode() {
+  std::size_t index = heap.front();
+  nodes[index].heapIndex = noNode;
+  heap.front() = heap.back();
+  heap.pop_back();
+  if (!heap.empty()) {
+    nodes[heap.front()].heapIndex = 0;
+    SiftDown(0);
+  }
+
+  return index;
+}
+
+void PathfindingNodesArena::OpenNode(std::size_t index) {
+  // Like a node removed then added again, the node is after the other nodes
+  // having the same estimate cost.
+  Node& node = nodes[index];
+  node.openingOrder = nextOpeningOrder++;
+  if (node.heapIndex == noNode) {
+    node.heapIndex = heap.size();
+    heap.push_back(index);
+  }
+
+  // The estimate cost usually decreased, but it can also be the same (when
+  // the cost decreased by less than the precision of a float), in which case
+  // the node must move after the other nodes with the same estimate cost.
+  SiftUp(node.heapIndex);
+  SiftDown(node.heapIndex);
+}
+
+void PathfindingNodesArena::SiftUp(std::size_t heapIndex) {
+  std::size_t index = heap[heapIndex];
+  while (heapIndex > 0) {
+    std::size_t parentHeapIndex = (heapIndex - 1) / 2;
+    if (!IsBefore(index, heap[parentHeapIndex])) break;
+
+    heap[heapIndex] = heap[parentHeapIndex];
+    nodes[heap[heapIndex]].heapIndex = heapIndex;
+    heapIndex = parentHeapIndex;
+  }
+
+  heap[heapIndex] = index;
+  nodes[index].heapIndex = heapIndex;
+}
+
+void PathfindingNodesArena::SiftDown(std::size_t heapIndex) {
+  std::size_t index = heap[heapIndex];
+  while (true) {
+    std::size_t childHeapIndex = heapIndex * 2 + 1;
+    if (childHeapIndex >= heap.size()) break;
+    if (childHeapIndex + 1 < heap.size() &&
+        IsBefore(heap[childHeapIndex + 1], heap[childHeapIndex]))
+      childHeapIndex++;
+    if (!IsBefore(heap[childHeapIndex], index)) break;
+
+    heap[heapIndex] = heap[childHeapIndex];
+    nodes[heap[heapIndex]].heapIndex = heapIndex;
+    heapIndex = childHeapIndex;
+  }
+
+  heap[heapIndex] = index;
+  nodes[index].heapIndex = heapIndex;
+}
@@ -0,0 +1,149 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#ifndef PATHFINDINGNODESARENA_H
+#define PATHFINDINGNODESARENA_H
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \brief The nodes used when searching a path, stored in a flat array indexed
+ * by the position of their cell in a window of the grid, and the list of the
+ * nodes still to be explored.
+ *
+ * The arena is kept from one search to the other. Instead of clearing the
+ * nodes, each search increments a generation counter, and the nodes of an
+ * older generation are considered as not visited yet. The window has at most
+ * maxWindowSize cells on each side. The nodes of the cells visited outside of
+ * it are stored after the nodes of the window, and found using a hash map, so
+ * that searches are not limited to the window.
+ *
+ * The open nodes are stored in a binary heap, ordered by their estimate cost,
+ * then by the order in which they were opened. Each node knows its position
+ * in the heap so that its estimate cost can be decreased without searching it.
+ *
+ * \see ScenePathfindingObstaclesManager::GetNodesArena
+ */
+class PathfindingNodesArena {
+ public:
+  /**
+   * \brief A node, i.e. a cell visited when searching a path.
+   */
+  struct Node {
+    int x;
+    int y;
+    float cost;          ///< The cost for traveling on this node
+    float smallestCost;  ///< the cost to go to this node (when considering the
+                         ///< shortest path).
+    float estimateCost;  ///< the estimate cost total to go to the destination
+                         ///< through this node (when considering the shortest
+                         ///< path).
+    std::size_t parent;  ///< The index of the previous node to be visited to go
+                         ///< to this node (when considering the shortest path).
+    std::size_t heapIndex;  ///< The position of the node in the open nodes, or
+                            ///< noNode if it's not open.
+    std::uint64_t openingOrder;  ///< Used to order open nodes having the same
+                                 ///< estimate cost.
+    unsigned int generation;     ///< The search which visited the node.
+    bool closed;  ///< true if the node was already explored.
+  };
+
+  static const std::size_t noNode;  ///< Index used for "no node".
+  static const int maxWindowSize;  ///< The maximum number of cells on each side
+                                   ///< of the window.
+
+  PathfindingNodesArena();
+
+  /**
+   * \brief Start a new search, forgetting the nodes of the previous one.
+   *
+   * The window is set to contain the cells from (minX;minY) to (maxX;maxY),
+   * or the cells around their center if it would be bigger than
+   * maxWindowSize.
+   */
+  void StartSearch(int minX, int minY, int maxX, int maxY);
+
+  /**
+   * \brief Return the index of the node of a cell.
+   *
+   * \param isNew Set to true if the node was not visited yet by the search, in
+   * which case it's initialized with a cost of 0.
+   * \warning References to the nodes are invalidated when a node is created
+   * outside of the window.
+   */
+  std::size_t GetNode(int x, int y, bool& isNew);
+
+  /**
+   * \brief Return the index of the node of a cell if the cell is in the
+   * window, without growing it, or noNode.
+   */
+  std::size_t GetNodeInWindow(int x, int y, bool& isNew);
+
+  Node& operator[](std::size_t index) { return nodes[index]; }
+  const Node& operator[](std::size_t index) const { return nodes[index]; }
+
+  /**
+   * \brief Return true if the cell is in the current window.
+   */
+  bool IsInWindow(int x, int y) const {
+    return x >= windowX && y >= windowY && x < windowX + windowWidth &&
+           y < windowY + windowHeight;
+  }
+
+  /**
+   * \brief Return true if there are open nodes, to be explored.
+   */
+  bool HasOpenNodes() const { return !heap.empty(); }
+
+  /**
+   * \brief Remove and return the index of the open node with the smallest
+   * estimate cost.
+   */
+  std::size_t PopOpenNode();
+
+  /**
+   * \brief Add the node to the open nodes, or update its position if its
+   * estimate cost changed.
+   */
+  void OpenNode(std::size_t index);
+
+ private:
+  std::size_t GetIndex(int x, int y) const {
+    return static_cast<std::size_t>(y - windowY) * windowWidth + (x - windowX);
+  }
+  static std::uint64_t GetCellKey(int x, int y) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+           static_cast<std::uint32_t>(y);
+  }
+  std::size_t InitializeNode(int x, int y, bool& isNew);
+  void ResetNode(Node& node, int x, int y);
+
+  bool IsBefore(std::size_t a, std::size_t b) const {
+    const Node& nodeA = nodes[a];
+    const Node& nodeB = nodes[b];
+    return nodeA.estimateCost < nodeB.estimateCost ||
+           (nodeA.estimateCost == nodeB.estimateCost &&
+            nodeA.openingOrder < nodeB.openingOrder);
+  }
+  void SiftUp(std::size_t heapIndex);
+  void SiftDown(std::size_t heapIndex);
+
+  std::vector<Node> nodes;  ///< The nodes of the window, row by row, then
+                            ///< the nodes outside of the window.
+  std::unordered_map<std::uint64_t, std::size_t>
+      outsideNodes;  ///< The index of the nodes outside of the window.
+  std::size_t outsideNodesCount;
+  std::vector<std::size_t> heap;  ///< The indices of the open nodes.
+  int windowX;
+  int windowY;
+  int windowWidth;
+  int windowHeight;
+  unsigned int generation;  ///< The generation of the current search.
+  std::uint64_t nextOpeningOrder;
+};
+
+#endif  // PATHFINDINGNODESARENA_H
@@ -56,6 +56,10 @@ void PathfindingObstacleRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
       sceneManager->AddObstacle(this);
       registeredInManager = true;
     }
+  } else if (registeredInManager) {
+    // Update the cost grids if the object was moved, resized or its cost
+    // changed.
+    if (sceneManager) sceneManager->UpdateObstacle(this);
   }
 }
 
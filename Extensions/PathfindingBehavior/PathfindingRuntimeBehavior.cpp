@@ -10,8 +10,6 @@ This project is released under the MIT License.
 #include <cmath>
 #include <iostream>
 #include <memory>
-#include <set>
-#include <unordered_map>
 #include "GDCore/Tools/Localization.h"
 #include "GDCpp/Extensions/Builtin/MathematicalTools.h"
 #include "GDCpp/Runtime/CommonTools.h"
@@ -19,6 +17,9 @@ This project is released under the MIT License.
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
 #include "GDCpp/Runtime/Serialization/SerializerElement.h"
+#include "PathfindingCostGrid.h"
+#include "PathfindingFlowField.h"
+#include "PathfindingNodesArena.h"
 #include "PathfindingObstacleRuntimeBehavior.h"
 #include "ScenePathfindingObstaclesManager.h"
 
@@ -43,91 +44,31 @@ bool operator==(const NodePosition& a, const NodePosition& b) {
   return ((a.x == b.x) && (a.y == b.y));
 }
 
-namespace std {
-/**
- * \brief Tool function used to store a NodePosition as key in
- * std::unordered_set.
- */
-template <>
-struct hash<NodePosition> {
-  std::size_t operator()(NodePosition const& n) const {
-    return (std::hash<int>()(n.x)) ^ (std::hash<int>()(n.y) << 1);
-  }
-};
-
-}  // namespace std
-
 namespace {
-/**
- * \brief Internal tool class representing a node when looking for a path
- */
-class Node {
- public:
-  Node()
-      : pos(0, 0),
-        cost(0),
-        smallestCost(-1),
-        estimateCost(-1),
-        parent(NULL),
-        open(true){};
-  Node(int x, int y)
-      : pos(x, y),
-        cost(0),
-        smallestCost(-1),
-        estimateCost(-1),
-        parent(NULL),
-        open(true){};
-  Node(const NodePosition& pos_)
-      : pos(pos_),
-        cost(0),
-        smallestCost(-1),
-        estimateCost(-1),
-        parent(NULL),
-        open(true){};
-
-  NodePosition pos;
-  float cost;          ///< The cost for traveling on this node
-  float smallestCost;  ///< the cost to go to this node (when considering the
-                       ///< shortest path).
-  float estimateCost;  ///< the estimate cost total to go to the destination
-                       ///< through this node (when considering the shortest
-                       ///< path).
-  const Node* parent;  ///< The previous node to be visited to go to this node
-                       ///< (when considering the shortest path).
-  bool open;  ///< true if the node is "open" (must be explored), false if
-              ///< "close" (already explored)
-
-  /**
-   * \brief Tool function used to store a Node in a priority_queue.
-   */
-  class NodeComparator {
-   public:
-    bool operator()(const Node* n1, const Node* n2) {
-      return n1->estimateCost < n2->estimateCost;
-    }
-  };
-};
-
-bool operator==(Node const& n1, Node const& n2) {
-  return n1.pos.x == n2.pos.x && n1.pos.y == n2.pos.y;
-};
-
+typedef PathfindingNodesArena::Node Node;
 typedef float (*DistanceFunPtr)(const NodePosition&, const NodePosition&);
 
 /**
  * \brief Internal tool class containing the structures used by A* and members
  * functions related to them.
+ *
+ * The nodes are stored in the PathfindingNodesArena of the obstacles manager,
+ * so that they are not allocated again for each search.
  */
 class SearchContext {
  public:
   SearchContext(ScenePathfindingObstaclesManager& obstacles_,
                 bool allowsDiagonal_ = true)
       : obstacles(obstacles_),
-        finalNode(NULL),
+        nodes(obstacles_.GetNodesArena()),
+        costGrid(NULL),
+        finalNode(PathfindingNodesArena::noNode),
         destination(0, 0),
         startX(0),
         startY(0),
         allowsDiagonal(allowsDiagonal_),
+        jumpPointSearch(false),
+        jumping(false),
         maxComplexityFactor(50),
         cellWidth(20),
         cellHeight(20),
@@ -176,11 +117,21 @@ class SearchContext {
     return *this;
   }
 
+  /**
+   * \brief Use Jump Point Search when the cost of moving on all cells is the
+   * same and diagonals are allowed: only the nodes where the path can change
+   * of direction are explored.
+   */
+  SearchContext& SetJumpPointSearch(bool enable) {
+    jumpPointSearch = enable;
+    return *this;
+  }
+
   /**
    * \brief Compute a path to the specified position, considering the obstacles
    * and the start position passed in the constructor.
    * \return true if computation found a path, in which case you can call
-   * GetFinalNode method to construct the path. \param x The coordinate on X
+   * GetPath method to construct the path. \param x The coordinate on X
    * axis of the target position, in "world" coordinates. \param y The
    * coordinate on Y axis of the target position, in "world" coordinates.
    */
@@ -191,127 +142,237 @@ class SearchContext {
                        GDRound(startY / cellHeight));
 
     // Initialize the algorithm
-    allNodes.clear();
-    Node& startNode = GetNode(start);
-    startNode.smallestCost = 0;
-    startNode.estimateCost = 0 + distanceFunction(start, destination);
-    openNodes.clear();
-    openNodes.insert(&startNode);
+    costGrid = &obstacles.GetCostGrid(cellWidth,
+                                      cellHeight,
+                                      leftBorder,
+                                      topBorder,
+                                      rightBorder,
+                                      bottomBorder);
+    finalNode = PathfindingNodesArena::noNode;
+    jumping =
+        jumpPointSearch && allowsDiagonal && !obstacles.HasPassableObstacles();
+    if (Search(start)) return true;
+
+    // Jumps are only done in the window of the nodes: search again with A*,
+    // which is not limited to the window, if no path was found.
+    if (!jumping) return false;
+    jumping = false;
+    return Search(start);
+  }
+
+  /**
+   * \brief Add the positions of the nodes of the computed path to \a path,
+   * from the destination to the start. Beware, the coordinates of the nodes
+   * must be multiplied by the cell size to get the "world" coordinates of the
+   * path.
+   */
+  void GetPath(std::vector<NodePosition>& path) const {
+    std::size_t node = finalNode;
+    while (node != PathfindingNodesArena::noNode) {
+      NodePosition position(nodes[node].x, nodes[node].y);
+      path.push_back(position);
+
+      // Add the cells between two jump points.
+      std::size_t parent = nodes[node].parent;
+      if (parent != PathfindingNodesArena::noNode) {
+        NodePosition parentPosition(nodes[parent].x, nodes[parent].y);
+        int dx = GetDirection(position.x, parentPosition.x);
+        int dy = GetDirection(position.y, parentPosition.y);
+        position.x += dx;
+        position.y += dy;
+        while (!(position == parentPosition)) {
+          path.push_back(position);
+          position.x += dx;
+          position.y += dy;
+        }
+      }
+
+      node = parent;
+    }
+  }
+
+ private:
+  /**
+   * \brief Search a path from \a start to the destination, with Jump Point
+   * Search if \a jumping is true, or with A*.
+   */
+  bool Search(const NodePosition& start) {
+    int margin = jumping ? std::max(jumpPointSearchMinMargin,
+                                    2 * std::max(abs(destination.x - start.x),
+                                                 abs(destination.y - start.y)))
+                         : searchWindowMargin;
+    nodes.StartSearch(std::min(start.x, destination.x) - margin,
+                      std::min(start.y, destination.y) - margin,
+                      std::max(start.x, destination.x) + margin,
+                      std::max(start.y, destination.y) + margin);
+
+    std::size_t startNode = GetNode(start);
+    if (startNode == PathfindingNodesArena::noNode) return false;
+    nodes[startNode].smallestCost = 0;
+    nodes[startNode].estimateCost = 0 + distanceFunction(start, destination);
+    nodes.OpenNode(startNode);
 
     // A* algorithm main loop
     std::size_t iterationCount = 0;
     std::size_t maxIterationCount =
-        startNode.estimateCost * maxComplexityFactor;
-    while (!openNodes.empty()) {
+        nodes[startNode].estimateCost * maxComplexityFactor;
+    while (nodes.HasOpenNodes()) {
       if (iterationCount++ > maxIterationCount)
         return false;  // Make sure we do not search forever.
 
-      Node* n = *openNodes.begin();  // Get the most promising node...
-      n->open = false;               //...and flag it as explored
-      openNodes.erase(
-          openNodes.begin());  // Be sure to remove ONLY the first element!
+      std::size_t n = nodes.PopOpenNode();  // Get the most promising node...
+      nodes[n].closed = true;               //...and flag it as explored
 
       // Check if we reached destination?
-      if (n->pos.x == destination.x && n->pos.y == destination.y) {
+      NodePosition position(nodes[n].x, nodes[n].y);
+      if (position == destination) {
         finalNode = n;
         return true;
       }
 
       // No, so add neighbors to the nodes to explore.
-      InsertNeighbors(*n);
+      if (jumping)
+        InsertJumpPoints(position);
+      else
+        InsertNeighbors(position);
     }
 
     return false;
   }
 
-  /**
-   * @return The final node of the computed path.
-   * Iterate on the parent member to create the path. Beware, the coordinates of
-   * the node must be multiplied by the cell size to get the "world" coordinates
-   * of the path.
-   */
-  Node* GetFinalNode() const { return finalNode; }
-
- private:
   /**
    * Insert the neighbors of the current node in the open list
    * (Only if they are not closed, and if the cost is better than the already
    * existing smallest cost).
    */
-  void InsertNeighbors(const Node& currentNode) {
-    AddOrUpdateNode(
-        NodePosition(currentNode.pos.x + 1, currentNode.pos.y), currentNode, 1);
-    AddOrUpdateNode(
-        NodePosition(currentNode.pos.x - 1, currentNode.pos.y), currentNode, 1);
-    AddOrUpdateNode(
-        NodePosition(currentNode.pos.x, currentNode.pos.y + 1), currentNode, 1);
-    AddOrUpdateNode(
-        NodePosition(currentNode.pos.x, currentNode.pos.y - 1), currentNode, 1);
+  void InsertNeighbors(const NodePosition& current) {
+    AddOrUpdateNode(NodePosition(current.x + 1, current.y), current, 1);
+    AddOrUpdateNode(NodePosition(current.x - 1, current.y), current, 1);
+    AddOrUpdateNode(NodePosition(current.x, current.y + 1), current, 1);
+    AddOrUpdateNode(NodePosition(current.x, current.y - 1), current, 1);
     if (allowsDiagonal) {
       AddOrUpdateNode(
-          NodePosition(currentNode.pos.x + 1, currentNode.pos.y + 1),
-          currentNode,
-          sqrt2);
+          NodePosition(current.x + 1, current.y + 1), current, sqrt2);
       AddOrUpdateNode(
-          NodePosition(currentNode.pos.x + 1, currentNode.pos.y - 1),
-          currentNode,
-          sqrt2);
+          NodePosition(current.x + 1, current.y - 1), current, sqrt2);
       AddOrUpdateNode(
-          NodePosition(currentNode.pos.x - 1, currentNode.pos.y - 1),
-          currentNode,
-          sqrt2);
+          NodePosition(current.x - 1, current.y - 1), current, sqrt2);
       AddOrUpdateNode(
-          NodePosition(currentNode.pos.x - 1, currentNode.pos.y + 1),
-          currentNode,
-          sqrt2);
+          NodePosition(current.x - 1, current.y + 1), current, sqrt2);
     }
   }
 
   /**
-   * \brief Get (or dynamically construct) a node.
-   *
-   * *All* nodes should be created using this method: The cost of the node is
-   * computed thanks to the objects flagged as obstacles.
+   * Insert in the open list the jump points found from the current node, in
+   * the directions where a path can continue (Jump Point Search).
    */
-  Node& GetNode(const NodePosition& pos) {
-    if (allNodes.find(pos) != allNodes.end()) return allNodes.find(pos)->second;
-
-    Node newNode(pos);
-
-    bool objectsOnCell = false;
-    const std::set<PathfindingObstacleRuntimeBehavior*>& allObstacles =
-        obstacles.GetAllObstacles();
-    for (std::set<PathfindingObstacleRuntimeBehavior*>::const_iterator it =
-             allObstacles.begin();
-         it != allObstacles.end();
-         ++it) {
-      RuntimeObject* obj = (*it)->GetObject();
-      int topLeftCellX =
-          floor((obj->GetDrawableX() - rightBorder) / (float)cellWidth);
-      int topLeftCellY =
-          floor((obj->GetDrawableY() - bottomBorder) / (float)cellHeight);
-      int bottomRightCellX =
-          ceil((obj->GetDrawableX() + obj->GetWidth() + leftBorder) /
-               (float)cellWidth);
-      int bottomRightCellY =
-          ceil((obj->GetDrawableY() + obj->GetHeight() + topBorder) /
-               (float)cellHeight);
-      if (topLeftCellX < pos.x && pos.x < bottomRightCellX &&
-          topLeftCellY < pos.y && pos.y < bottomRightCellY) {
-        objectsOnCell = true;
-        if ((*it)->IsImpassable()) {
-          newNode.cost = -1;
-          break;  // The cell is impassable, stop here.
-        } else    // Superimpose obstacles
-          newNode.cost += (*it)->GetCost();
+  void InsertJumpPoints(const NodePosition& current) {
+    std::size_t parent = nodes[GetNode(current)].parent;
+    if (parent == PathfindingNodesArena::noNode) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        for (int dy = -1; dy <= 1; ++dy) {
+          if (dx != 0 || dy != 0) InsertJumpPoint(current, dx, dy);
+        }
       }
+      return;
     }
 
-    if (!objectsOnCell)
-      newNode.cost = 1;  // Default cost when no objects put on the cell.
+    // Only the neighbors that can't be reached with a path as short without
+    // going through the current node are explored.
+    int x = current.x;
+    int y = current.y;
+    int dx = GetDirection(nodes[parent].x, x);
+    int dy = GetDirection(nodes[parent].y, y);
+    if (dx != 0 && dy != 0) {
+      InsertJumpPoint(current, dx, 0);
+      InsertJumpPoint(current, 0, dy);
+      InsertJumpPoint(current, dx, dy);
+      if (!IsWalkable(x - dx, y)) InsertJumpPoint(current, -dx, dy);
+      if (!IsWalkable(x, y - dy)) InsertJumpPoint(current, dx, -dy);
+    } else if (dx != 0) {
+      InsertJumpPoint(current, dx, 0);
+      if (!IsWalkable(x, y + 1)) InsertJumpPoint(current, dx, 1);
+      if (!IsWalkable(x, y - 1)) InsertJumpPoint(current, dx, -1);
+    } else {
+      InsertJumpPoint(current, 0, dy);
+      if (!IsWalkable(x + 1, y)) InsertJumpPoint(current, 1, dy);
+      if (!IsWalkable(x - 1, y)) InsertJumpPoint(current, -1, dy);
+    }
+  }
 
-    allNodes[pos] = newNode;
-    return allNodes[pos];
+  void InsertJumpPoint(const NodePosition& current, int dx, int dy) {
+    NodePosition jumpPoint(current);
+    if (!Jump(jumpPoint, dx, dy)) return;
+
+    // The cost of all cells is 1.
+    int steps = std::max(abs(jumpPoint.x - current.x),
+                         abs(jumpPoint.y - current.y));
+    AddOrUpdateNode(jumpPoint, current, 0, steps * (dx && dy ? sqrt2 : 1));
+  }
+
+  /**
+   * \brief Move \a position in the direction until finding a jump point: the
+   * destination, or a cell from which a path can continue in another direction
+   * because of an obstacle.
+   * \return false if an obstacle or the border of the window is reached before.
+   */
+  bool Jump(NodePosition& position, int dx, int dy) {
+    while (true) {
+      position.x += dx;
+      position.y += dy;
+      int x = position.x;
+      int y = position.y;
+      if (!IsWalkable(x, y)) return false;
+      if (position == destination) return true;
+
+      if (dx != 0 && dy != 0) {
+        if ((!IsWalkable(x - dx, y) && IsWalkable(x - dx, y + dy)) ||
+            (!IsWalkable(x, y - dy) && IsWalkable(x + dx, y - dy)))
+          return true;
+
+        NodePosition horizontalJump(position);
+        NodePosition verticalJump(position);
+        if (Jump(horizontalJump, dx, 0) || Jump(verticalJump, 0, dy))
+          return true;
+      } else if (dx != 0) {
+        if ((!IsWalkable(x, y + 1) && IsWalkable(x + dx, y + 1)) ||
+            (!IsWalkable(x, y - 1) && IsWalkable(x + dx, y - 1)))
+          return true;
+      } else {
+        if ((!IsWalkable(x + 1, y) && IsWalkable(x + 1, y + dy)) ||
+            (!IsWalkable(x - 1, y) && IsWalkable(x - 1, y + dy)))
+          return true;
+      }
+    }
+  }
+
+  /**
+   * \brief Return -1, 0 or 1 to go from a coordinate to another.
+   */
+  static int GetDirection(int from, int to) {
+    return (to > from) - (to < from);
+  }
+
+  bool IsWalkable(int x, int y) {
+    return nodes.IsInWindow(x, y) && costGrid->GetCost(x, y) >= 0;
+  }
+
+  /**
+   * \brief Get (or dynamically construct) a node, and return its index, or
+   * PathfindingNodesArena::noNode if it's outside of the window when using
+   * Jump Point Search.
+   *
+   * *All* nodes should be created using this method: The cost of the node is
+   * read from the cost grid of the obstacles.
+   * \warning References to the nodes are invalidated when a node is created.
+   */
+  std::size_t GetNode(const NodePosition& pos) {
+    bool isNew = false;
+    std::size_t index = jumping ? nodes.GetNodeInWindow(pos.x, pos.y, isNew)
+                                : nodes.GetNode(pos.x, pos.y, isNew);
+    if (isNew) nodes[index].cost = costGrid->GetCost(pos.x, pos.y);
+
+    return index;
   }
 
   /**
@@ -329,56 +390,59 @@ class SearchContext {
   }
 
   /**
-   * Add a node to the openNodes (only if the cost to reach it is less than the
-   * existing cost, if any).
+   * Add a node to the open nodes (only if the cost to reach it is less than
+   * the existing cost, if any).
+   * \param factor The distance to the node, multiplied by the average cost of
+   * the nodes. \param distance If not 0, the cost to go to the node, used
+   * instead of the factor.
    */
   void AddOrUpdateNode(const NodePosition& newNodePosition,
-                       const Node& currentNode,
-                       float factor) {
-    Node& neighbor = GetNode(newNodePosition);
-    if (!neighbor.open ||
-        neighbor.cost < 0)  // cost < 0 means impassable obstacle
-      return;
+                       const NodePosition& currentNodePosition,
+                       float factor,
+                       float distance = 0) {
+    std::size_t neighborIndex = GetNode(newNodePosition);
+    if (neighborIndex == PathfindingNodesArena::noNode) return;
+    std::size_t currentIndex = GetNode(currentNodePosition);
+
+    Node& neighbor = nodes[neighborIndex];
+    const Node& currentNode = nodes[currentIndex];
+    if (neighbor.closed || neighbor.cost < 0)  // cost < 0 means impassable
+      return;                                  // obstacle
 
     // Update the node costs and parent if the path coming from currentNode is
     // better:
-    if (neighbor.smallestCost == -1 ||
-        neighbor.smallestCost >
-            currentNode.smallestCost +
-                (currentNode.cost + neighbor.cost) / 2.0 * factor) {
-      if (neighbor.smallestCost != -1)  // The node is already in the open list:
-      {
-        // remove it as its estimate cost will be updated.
-        auto it = openNodes.find(&neighbor);
-        if (it !=
-            openNodes.end())  // /!\ ALWAYS use an iterator with multiset::erase
-          openNodes.erase(it);  // otherwise, other nodes which are equivalent
-                                // get removed too.
-      }
-
-      neighbor.smallestCost = currentNode.smallestCost +
-                              (currentNode.cost + neighbor.cost) / 2.0 * factor;
-      neighbor.parent = &currentNode;
+    double newCost =
+        currentNode.smallestCost +
+        (distance != 0 ? distance
+                       : (currentNode.cost + neighbor.cost) / 2.0 * factor);
+    if (neighbor.smallestCost == -1 || neighbor.smallestCost > newCost) {
+      neighbor.smallestCost = newCost;
+      neighbor.parent = currentIndex;
       neighbor.estimateCost =
-          neighbor.smallestCost + distanceFunction(neighbor.pos, destination);
+          neighbor.smallestCost +
+          distanceFunction(newNodePosition, destination);
 
-      openNodes.insert(&neighbor);
+      // Add the node to the open nodes, or move it if it's already there.
+      nodes.OpenNode(neighborIndex);
     }
   }
 
-  std::unordered_map<NodePosition, Node> allNodes;  ///< All the nodes
-  std::multiset<Node*, Node::NodeComparator>
-      openNodes;  ///< Only the open nodes (Such that Node::open == true)
-  const ScenePathfindingObstaclesManager&
-      obstacles;    ///< A reference to all the obstacles of the scene
-  Node* finalNode;  // If computation succeeded, the final node is stored here.
+  ScenePathfindingObstaclesManager&
+      obstacles;  ///< A reference to all the obstacles of the scene
+  PathfindingNodesArena& nodes;   ///< All the nodes
+  PathfindingCostGrid* costGrid;  ///< The costs of the cells, for the size of
+                                  ///< the cells and of the object.
+  std::size_t finalNode;  // If computation succeeded, the final node is stored
+                          // here.
   NodePosition destination;
   int startX;  ///< The start X position, in "world" coordinates (not in "node"
                ///< coordinates!).
   int startY;  ///< The start Y position, in "world" coordinates (not in "node"
                ///< coordinates!).
   DistanceFunPtr distanceFunction;
-  bool allowsDiagonal;  ///< True to allow diagonals when planning the path.
+  bool allowsDiagonal;   ///< True to allow diagonals when planning the path.
+  bool jumpPointSearch;  ///< True to use Jump Point Search when possible.
+  bool jumping;  ///< True if the current search uses Jump Point Search.
   std::size_t maxComplexityFactor;
   float cellWidth;
   float cellHeight;
@@ -388,9 +452,15 @@ class SearchContext {
   float bottomBorder;
 
   static const float sqrt2;
+  static const int searchWindowMargin;  ///< The number of cells around the
+                                        ///< start and the destination in the
+                                        ///< window of the nodes.
+  static const int jumpPointSearchMinMargin;
 };
 
 const float SearchContext::sqrt2 = 1.414213562;
+const int SearchContext::searchWindowMargin = 16;
+const int SearchContext::jumpPointSearchMinMargin = 32;
 
 }  // namespace
 
@@ -409,6 +479,8 @@ PathfindingRuntimeBehavior::PathfindingRuntimeBehavior(
       cellWidth(20),
       cellHeight(20),
       extraBorder(0),
+      jumpPointSearch(false),
+      flowField(false),
       speed(0),
       angularSpeed(0),
       timeOnSegment(0),
@@ -456,25 +528,58 @@ void PathfindingRuntimeBehavior::MoveTo(RuntimeScene& scene, float x, float y) {
     return;
   }
 
+  float leftBorder = object->GetX() - object->GetDrawableX() + extraBorder;
+  float topBorder = object->GetY() - object->GetDrawableY() + extraBorder;
+  float rightBorder = object->GetWidth() -
+                      (object->GetX() - object->GetDrawableX()) + extraBorder;
+  float bottomBorder = object->GetHeight() -
+                       (object->GetY() - object->GetDrawableY()) + extraBorder;
+
+  // Read the path from the flow field of the destination, if it covers the
+  // object. The path of an object inside an obstacle is searched with A*,
+  // allowing it to get out of the obstacle.
+  if (flowField) {
+    PathfindingFlowField& field = sceneManager->GetFlowField(cellWidth,
+                                                             cellHeight,
+                                                             leftBorder,
+                                                             topBorder,
+                                                             rightBorder,
+                                                             bottomBorder,
+                                                             targetCellX,
+                                                             targetCellY,
+                                                             allowDiagonals);
+    if (field.CanStartFrom(startCellX, startCellY)) {
+      pathFound = field.CanReachDestination(startCellX, startCellY);
+      if (!pathFound) return;
+
+      path.push_back(sf::Vector2f(object->GetX(), object->GetY()));
+      int cellX = startCellX;
+      int cellY = startCellY;
+      while (cellX != targetCellX || cellY != targetCellY) {
+        field.GoToNextCell(cellX, cellY);
+        path.push_back(sf::Vector2f(cellX * (float)cellWidth,
+                                    cellY * (float)cellHeight));
+      }
+
+      EnterSegment(0);
+      return;
+    }
+  }
+
   // Start searching for a path
   // TODO: Customizable heuristic.
   ::SearchContext ctx(*sceneManager, allowDiagonals);
   ctx.SetCellSize(cellWidth, cellHeight)
-      .SetStartPosition(object->GetX(), object->GetY());
-  ctx.SetObjectSize(object->GetX() - object->GetDrawableX() + extraBorder,
-                    object->GetY() - object->GetDrawableY() + extraBorder,
-                    object->GetWidth() -
-                        (object->GetX() - object->GetDrawableX()) + extraBorder,
-                    object->GetHeight() -
-                        (object->GetY() - object->GetDrawableY()) +
-                        extraBorder);
+      .SetStartPosition(object->GetX(), object->GetY())
+      .SetJumpPointSearch(jumpPointSearch);
+  ctx.SetObjectSize(leftBorder, topBorder, rightBorder, bottomBorder);
   if (ctx.ComputePathTo(x, y)) {
     // Path found: memorize it
-    const ::Node* node = ctx.GetFinalNode();
-    while (node) {
-      path.push_back(sf::Vector2f(node->pos.x * (float)cellWidth,
-                                  node->pos.y * (float)cellHeight));
-      node = node->parent;
+    std::vector<NodePosition> nodes;
+    ctx.GetPath(nodes);
+    for (const NodePosition& node : nodes) {
+      path.push_back(sf::Vector2f(node.x * (float)cellWidth,
+                                  node.y * (float)cellHeight));
     }
 
     std::reverse(path.begin(), path.end());
@@ -504,16 +609,9 @@ void PathfindingRuntimeBehavior::EnterSegment(std::size_t segmentNumber) {
 }
 
 void PathfindingRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
-  if (parentScene != &scene)  // Parent scene has changed
-  {
-    parentScene = &scene;
-    sceneManager = parentScene
-                       ? &ScenePathfindingObstaclesManager::managers[&scene]
-                       : NULL;
-  }
-
-  if (!sceneManager) return;
-
+  // The obstacles manager of the scene is not needed to follow the path. It is
+  // fetched when the path is computed (see MoveTo), so that the shared map of
+  // managers is not accessed by the steps, which can run in parallel.
   if (path.empty() || reachedEnd) return;
 
   // Update the speed of the object
@@ -549,15 +647,6 @@ void PathfindingRuntimeBehavior::DoStepPreEvents(RuntimeScene& scene) {
   if (rotateObject) object->RotateTowardAngle(pathAngle, angularSpeed, scene);
 }
 
-void PathfindingRuntimeBehavior::DoStepPostEvents(RuntimeScene& scene) {
-  if (parentScene != &scene)  // Parent scene has changed
-  {
-    parentScene = &scene;
-    sceneManager = parentScene
-                       ? &ScenePathfindingObstaclesManager::managers[&scene]
-                       : NULL;
-  }
-}
 
 float PathfindingRuntimeBehavior::GetNodeX(std::size_t index) const {
   if (index < path.size()) return path[index].x;
@@ -31,6 +31,12 @@ class GD_EXTENSION_API PathfindingRuntimeBehavior : public RuntimeBehavior {
   virtual ~PathfindingRuntimeBehavior(){};
   virtual RuntimeBehavior* Clone() const { return new PathfindingRuntimeBehavior(*this); }
 
+  /**
+   * \brief Following the path only changes the object, so objects can follow
+   * their paths in parallel.
+   */
+  virtual bool IsThreadSafe() const { return true; }
+
   /**
    * \brief Compute and move on the path to the specified destination.
    */
@@ -69,6 +75,18 @@ class GD_EXTENSION_API PathfindingRuntimeBehavior : public RuntimeBehavior {
   unsigned int GetCellHeight() { return cellHeight; };
   float GetExtraBorder() { return extraBorder; };
 
+  /**
+   * \brief Return true if paths are computed using Jump Point Search when
+   * possible.
+   */
+  bool IsJumpPointSearchEnabled() const { return jumpPointSearch; }
+
+  /**
+   * \brief Return true if paths are read from the flow fields shared by the
+   * objects moving to the same destination.
+   */
+  bool IsFlowFieldEnabled() const { return flowField; }
+
   void SetAllowDiagonals(bool allowDiagonals_) {
     allowDiagonals = allowDiagonals_;
   };
@@ -83,12 +101,37 @@ class GD_EXTENSION_API PathfindingRuntimeBehavior : public RuntimeBehavior {
   void SetCellHeight(unsigned int cellHeight_) { cellHeight = cellHeight_; };
   void SetExtraBorder(float extraBorder_) { extraBorder = extraBorder_; };
 
+  /**
+   * \brief Enable or disable Jump Point Search, disabled by default.
+   *
+   * Jump Point Search only explores the cells where the path can change of
+   * direction, finding a path as short as A* much faster in large open areas.
+   * It's used only if diagonals are allowed and all the obstacles of the scene
+   * are impassable (i.e. moving on any cell has the same cost), otherwise
+   * paths are computed with A*. Jumps are limited to an area around the start
+   * and the destination: A* is also used if no path is found in it.
+   */
+  void EnableJumpPointSearch(bool enable = true) { jumpPointSearch = enable; }
+
+  /**
+   * \brief Enable or disable the flow fields, disabled by default.
+   *
+   * When enabled, the path is read from the flow field of the destination,
+   * computed once and shared by all the objects moving to the same
+   * destination (with the same cell size and borders), which is much faster
+   * than a search for each object when a lot of objects go to the same place.
+   * The path is searched with A* if the object is too far from the destination
+   * to be covered by the flow field.
+   *
+   * \see ScenePathfindingObstaclesManager::GetFlowField
+   */
+  void EnableFlowField(bool enable = true) { flowField = enable; }
+
   float GetSpeed() { return speed; };
   void SetSpeed(float speed_) { speed = speed_; };
 
  private:
   virtual void DoStepPreEvents(RuntimeScene& scene);
-  virtual void DoStepPostEvents(RuntimeScene& scene);
   void EnterSegment(std::size_t segmentNumber);
 
   RuntimeScene* parentScene;  ///< The scene the object belongs to.
@@ -109,6 +152,8 @@ class GD_EXTENSION_API PathfindingRuntimeBehavior : public RuntimeBehavior {
   unsigned int cellWidth;
   unsigned int cellHeight;
   float extraBorder;
+  bool jumpPointSearch;  ///< True to use Jump Point Search when possible.
+  bool flowField;  ///< True to read paths from the shared flow fields.
 
   // Attributes used for traveling on the path:
   float speed;
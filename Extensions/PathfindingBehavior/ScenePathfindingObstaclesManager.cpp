@@ -5,16 +5,26 @@ Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
 This project is released under the MIT License.
 */
 #include "ScenePathfindingObstaclesManager.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include "GDCpp/Runtime/RuntimeObject.h"
 #include "PathfindingObstacleRuntimeBehavior.h"
 
 std::map<RuntimeScene*, ScenePathfindingObstaclesManager>
     ScenePathfindingObstaclesManager::managers;
 
+const float ScenePathfindingObstaclesManager::bucketSize = 256;
+const std::size_t ScenePathfindingObstaclesManager::maxCostGridsCount = 16;
+const std::size_t ScenePathfindingObstaclesManager::maxFlowFieldsCount = 16;
+
 ScenePathfindingObstaclesManager::~ScenePathfindingObstaclesManager() {
+  // Deactivating an obstacle removes it from allObstacles, so iterate on a
+  // copy.
+  std::set<PathfindingObstacleRuntimeBehavior*> obstacles = allObstacles;
   for (std::set<PathfindingObstacleRuntimeBehavior*>::iterator it =
-           allObstacles.begin();
-       it != allObstacles.end();
+           obstacles.begin();
+       it != obstacles.end();
        ++it) {
     (*it)->Activate(false);
   }
@@ -22,9 +32,227 @@ ScenePathfindingObstaclesManager::~ScenePathfindingObstaclesManager() {
 
 void ScenePathfindingObstaclesManager::AddObstacle(
     PathfindingObstacleRuntimeBehavior* obstacle) {
-  allObstacles.insert(obstacle);
+  if (!allObstacles.insert(obstacle).second) {
+    UpdateObstacle(obstacle);
+    return;
+  }
+
+  ObstacleArea& area = obstaclesAreas[obstacle];
+  area = GetObstacleArea(*obstacle);
+  if (!area.impassable) passableObstaclesCount++;
+  AddToBuckets(area);
+  MarkAsDirty(area);
 }
+
 void ScenePathfindingObstaclesManager::RemoveObstacle(
     PathfindingObstacleRuntimeBehavior* obstacle) {
   allObstacles.erase(obstacle);
+
+  auto it = obstaclesAreas.find(obstacle);
+  if (it == obstaclesAreas.end()) return;
+
+  if (!it->second.impassable) passableObstaclesCount--;
+  MarkAsDirty(it->second);
+  RemoveFromBuckets(it->second);
+  obstaclesAreas.erase(it);
+}
+
+void ScenePathfindingObstaclesManager::UpdateObstacle(
+    PathfindingObstacleRuntimeBehavior* obstacle) {
+  auto it = obstaclesAreas.find(obstacle);
+  if (it == obstaclesAreas.end()) return;
+
+  ObstacleArea newArea = GetObstacleArea(*obstacle);
+  ObstacleArea& area = it->second;
+  if (area == newArea) return;
+
+  if (area.impassable != newArea.impassable)
+    passableObstaclesCount += newArea.impassable ? -1 : 1;
+  MarkAsDirty(area);
+  RemoveFromBuckets(area);
+  area = newArea;
+  AddToBuckets(area);
+  MarkAsDirty(area);
+}
+
+ScenePathfindingObstaclesManager::CostGridKey
+ScenePathfindingObstaclesManager::GetCostGridKey(float cellWidth,
+                                                 float cellHeight,
+                                                 float leftBorder,
+                                                 float topBorder,
+                                                 float rightBorder,
+                                                 float bottomBorder) {
+  return std::make_tuple(static_cast<int>(std::round(cellWidth)),
+                         static_cast<int>(std::round(cellHeight)),
+                         static_cast<int>(std::round(leftBorder)),
+                         static_cast<int>(std::round(topBorder)),
+                         static_cast<int>(std::round(rightBorder)),
+                         static_cast<int>(std::round(bottomBorder)));
+}
+
+PathfindingCostGrid& ScenePathfindingObstaclesManager::GetCostGrid(
+    float cellWidth,
+    float cellHeight,
+    float leftBorder,
+    float topBorder,
+    float rightBorder,
+    float bottomBorder) {
+  CostGridKey key = GetCostGridKey(
+      cellWidth, cellHeight, leftBorder, topBorder, rightBorder, bottomBorder);
+  auto it = costGrids.find(key);
+  if (it == costGrids.end()) {
+    // Forget the grid used the least recently, and the flow fields using it,
+    // if there are too many grids.
+    if (costGrids.size() >= maxCostGridsCount) {
+      auto oldest = costGrids.begin();
+      for (auto grid = costGrids.begin(); grid != costGrids.end(); ++grid)
+        if (grid->second.lastUse < oldest->second.lastUse) oldest = grid;
+
+      for (auto field = flowFields.begin(); field != flowFields.end();) {
+        if (&field->second.field->GetCostGrid() == oldest->second.grid.get())
+          field = flowFields.erase(field);
+        else
+          ++field;
+      }
+      costGrids.erase(oldest);
+    }
+
+    it = costGrids.insert(std::make_pair(key, CachedCostGrid())).first;
+    it->second.grid.reset(new PathfindingCostGrid(*this,
+                                                  std::get<0>(key),
+                                                  std::get<1>(key),
+                                                  std::get<2>(key),
+                                                  std::get<3>(key),
+                                                  std::get<4>(key),
+                                                  std::get<5>(key)));
+  }
+
+  it->second.lastUse = usesCount++;
+  return *it->second.grid;
+}
+
+PathfindingFlowField& ScenePathfindingObstaclesManager::GetFlowField(
+    float cellWidth,
+    float cellHeight,
+    float leftBorder,
+    float topBorder,
+    float rightBorder,
+    float bottomBorder,
+    int destinationX,
+    int destinationY,
+    bool allowsDiagonal) {
+  auto key = std::tuple_cat(GetCostGridKey(cellWidth,
+                                            cellHeight,
+                                            leftBorder,
+                                            topBorder,
+                                            rightBorder,
+                                            bottomBorder),
+                             std::make_tuple(
+                                 destinationX, destinationY, allowsDiagonal));
+  auto it = flowFields.find(key);
+  if (it == flowFields.end()) {
+    // Forget the field used the least recently if there are too many fields.
+    if (flowFields.size() >= maxFlowFieldsCount) {
+      auto oldest = flowFields.begin();
+      for (auto field = flowFields.begin(); field != flowFields.end(); ++field)
+        if (field->second.lastUse < oldest->second.lastUse) oldest = field;
+      flowFields.erase(oldest);
+    }
+
+    // Get the grid first, as it can forget the fields using another grid.
+    PathfindingCostGrid& grid = GetCostGrid(cellWidth,
+                                            cellHeight,
+                                            leftBorder,
+                                            topBorder,
+                                            rightBorder,
+                                            bottomBorder);
+    it = flowFields.insert(std::make_pair(key, CachedFlowField())).first;
+    it->second.field.reset(new PathfindingFlowField(
+        grid, destinationX, destinationY, allowsDiagonal));
+  }
+
+  it->second.lastUse = usesCount++;
+  return *it->second.field;
+}
+
+void ScenePathfindingObstaclesManager::GetObstaclesAreasIn(
+    float left,
+    float top,
+    float right,
+    float bottom,
+    std::vector<const ObstacleArea*>& result) const {
+  std::size_t firstResult = result.size();
+  for (int y = floor(top / bucketSize); y <= floor(bottom / bucketSize); ++y) {
+    for (int x = floor(left / bucketSize); x <= floor(right / bucketSize);
+         ++x) {
+      auto bucket = buckets.find(GetBucketKey(x, y));
+      if (bucket == buckets.end()) continue;
+
+      for (const ObstacleArea* area : bucket->second) {
+        if (area->right >= left && area->left <= right &&
+            area->bottom >= top && area->top <= bottom)
+          result.push_back(area);
+      }
+    }
+  }
+
+  // Areas spanning several buckets are found several times.
+  std::sort(result.begin() + firstResult, result.end());
+  result.erase(std::unique(result.begin() + firstResult, result.end()),
+               result.end());
+}
+
+ScenePathfindingObstaclesManager::ObstacleArea
+ScenePathfindingObstaclesManager::GetObstacleArea(
+    const PathfindingObstacleRuntimeBehavior& obstacle) {
+  const RuntimeObject* object = obstacle.GetObject();
+
+  ObstacleArea area;
+  area.left = object->GetDrawableX();
+  area.top = object->GetDrawableY();
+  area.right = object->GetDrawableX() + object->GetWidth();
+  area.bottom = object->GetDrawableY() + object->GetHeight();
+  area.impassable = obstacle.IsImpassable();
+  area.cost = obstacle.GetCost();
+  return area;
+}
+
+void ScenePathfindingObstaclesManager::AddToBuckets(const ObstacleArea& area) {
+  for (int y = floor(area.top / bucketSize);
+       y <= floor(area.bottom / bucketSize);
+       ++y) {
+    for (int x = floor(area.left / bucketSize);
+         x <= floor(area.right / bucketSize);
+         ++x)
+      buckets[GetBucketKey(x, y)].push_back(&area);
+  }
+}
+
+void ScenePathfindingObstaclesManager::RemoveFromBuckets(
+    const ObstacleArea& area) {
+  for (int y = floor(area.top / bucketSize);
+       y <= floor(area.bottom / bucketSize);
+       ++y) {
+    for (int x = floor(area.left / bucketSize);
+         x <= floor(area.right / bucketSize);
+         ++x) {
+      auto bucket = buckets.find(GetBucketKey(x, y));
+      if (bucket == buckets.end()) continue;
+
+      std::vector<const ObstacleArea*>& areas = bucket->second;
+      auto it = std::find(areas.begin(), areas.end(), &area);
+      if (it != areas.end()) {
+        *it = areas.back();
+        areas.pop_back();
+      }
+      if (areas.empty()) buckets.erase(bucket);
+    }
+  }
+}
+
+void ScenePathfindingObstaclesManager::MarkAsDirty(const ObstacleArea& area) {
+  for (auto& it : costGrids)
+    it.second.grid->MarkAsDirty(area.left, area.top, area.right, area.bottom);
+  for (auto& it : flowFields)
+    it.second.field->MarkAsDirty(area.left, area.top, area.right, area.bottom);
 }
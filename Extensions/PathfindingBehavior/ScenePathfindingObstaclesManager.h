@@ -6,26 +6,59 @@ This project is released under the MIT License.
 */
 #ifndef SCENEPLATFORMOBJECTSMANAGER_H
 #define SCENEPLATFORMOBJECTSMANAGER_H
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <set>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 #include "GDCpp/Runtime/RuntimeScene.h"
+#include "PathfindingCostGrid.h"
+#include "PathfindingFlowField.h"
+#include "PathfindingNodesArena.h"
 class PathfindingObstacleRuntimeBehavior;
 
 /**
- * \brief Contains lists of all obstacle related objects of a scene.
+ * \brief Contains lists of all obstacle related objects of a scene, and the
+ * grids of the costs of moving on the scene computed from them.
  *
- * \note Could be drastically improved by using spatial hashing (see JS
- * implementation).
+ * The areas of the obstacles are stored using spatial hashing, so that the
+ * grids only search the obstacles near the cells they compute.
+ *
+ * The manager also caches the flow fields leading to the destinations of the
+ * objects, so that objects moving to the same destination share the same
+ * shortest paths instead of searching them one by one.
  */
 class ScenePathfindingObstaclesManager {
  public:
+  /**
+   * \brief The area covered by an obstacle, and the cost of moving on it, as
+   * known by the manager.
+   */
+  struct ObstacleArea {
+    float left;
+    float top;
+    float right;
+    float bottom;
+    bool impassable;
+    float cost;
+
+    bool operator==(const ObstacleArea& other) const {
+      return left == other.left && top == other.top && right == other.right &&
+             bottom == other.bottom && impassable == other.impassable &&
+             cost == other.cost;
+    }
+  };
+
   /**
    * \brief Map containing, for each RuntimeScene, its associated
    * ScenePathfindingObstaclesManager.
    */
   static std::map<RuntimeScene*, ScenePathfindingObstaclesManager> managers;
 
-  ScenePathfindingObstaclesManager(){};
+  ScenePathfindingObstaclesManager()
+      : usesCount(0), passableObstaclesCount(0){};
   virtual ~ScenePathfindingObstaclesManager();
 
   /**
@@ -40,6 +73,14 @@ class ScenePathfindingObstaclesManager {
    */
   void RemoveObstacle(PathfindingObstacleRuntimeBehavior* obstacle);
 
+  /**
+   * \brief Notify the manager that an obstacle may have been moved, resized,
+   * or had its cost changed. The cells of the grids covered by its old and
+   * new areas are computed again if something changed.
+   * \param obstacle The obstacle, already added to the manager.
+   */
+  void UpdateObstacle(PathfindingObstacleRuntimeBehavior* obstacle);
+
   /**
    * \brief Get a read only access to the list of all obstacles
    */
@@ -47,9 +88,141 @@ class ScenePathfindingObstaclesManager {
     return allObstacles;
   }
 
+  /**
+   * \brief Return the grid of the costs of moving on the scene for an object
+   * with the given borders (distances from its position to its sides), moving
+   * on cells of the given size. The grid is created the first time it's asked.
+   *
+   * The cell size and the borders are rounded to the nearest integer, so that
+   * objects whose borders only differ by a rounding error share the same grid.
+   * The grid is kept until maxCostGridsCount other grids are used more
+   * recently, in which case the flow fields using it are forgotten too.
+   */
+  PathfindingCostGrid& GetCostGrid(float cellWidth,
+                                   float cellHeight,
+                                   float leftBorder,
+                                   float topBorder,
+                                   float rightBorder,
+                                   float bottomBorder);
+
+  /**
+   * \brief Return the flow field leading to the given destination cell, on the
+   * grid returned by GetCostGrid for the same cell size and borders, which
+   * are rounded in the same way.
+   *
+   * The field is created the first time it's asked, and kept until
+   * maxFlowFieldsCount other fields are used more recently. It's computed
+   * again after a change of the obstacles covering its cells.
+   */
+  PathfindingFlowField& GetFlowField(float cellWidth,
+                                     float cellHeight,
+                                     float leftBorder,
+                                     float topBorder,
+                                     float rightBorder,
+                                     float bottomBorder,
+                                     int destinationX,
+                                     int destinationY,
+                                     bool allowsDiagonal);
+
+  /**
+   * \brief Return the number of grids currently kept by the manager.
+   */
+  std::size_t GetCostGridsCount() const { return costGrids.size(); }
+
+  /**
+   * \brief Return the number of flow fields currently kept by the manager.
+   */
+  std::size_t GetFlowFieldsCount() const { return flowFields.size(); }
+
+  /**
+   * \brief Return true if some obstacles are not impassable, i.e. if moving on
+   * some cells can have a cost different from 1.
+   */
+  bool HasPassableObstacles() const { return passableObstaclesCount > 0; }
+
+  /**
+   * \brief Return the nodes used to search paths on the scene, shared by all
+   * the searches as they are done one after the other.
+   */
+  PathfindingNodesArena& GetNodesArena() { return nodesArena; }
+
+  /**
+   * \brief Add to \a result the areas of the obstacles intersecting the given
+   * area (in "world" coordinates).
+   */
+  void GetObstaclesAreasIn(float left,
+                           float top,
+                           float right,
+                           float bottom,
+                           std::vector<const ObstacleArea*>& result) const;
+
  private:
+  /**
+   * \brief Return the current area of the obstacle.
+   */
+  static ObstacleArea GetObstacleArea(
+      const PathfindingObstacleRuntimeBehavior& obstacle);
+
+  void AddToBuckets(const ObstacleArea& area);
+  void RemoveFromBuckets(const ObstacleArea& area);
+  void MarkAsDirty(const ObstacleArea& area);
+
+  typedef std::tuple<int, int, int, int, int, int> CostGridKey;
+
+  /**
+   * \brief Return the key of the grid for the given cell size and borders,
+   * rounded to the nearest integer.
+   */
+  static CostGridKey GetCostGridKey(float cellWidth,
+                                    float cellHeight,
+                                    float leftBorder,
+                                    float topBorder,
+                                    float rightBorder,
+                                    float bottomBorder);
+
+  /**
+   * \brief A grid and the last time it was used.
+   */
+  struct CachedCostGrid {
+    std::unique_ptr<PathfindingCostGrid> grid;
+    std::uint64_t lastUse;
+  };
+
+  /**
+   * \brief A flow field and the last time it was used.
+   */
+  struct CachedFlowField {
+    std::unique_ptr<PathfindingFlowField> field;
+    std::uint64_t lastUse;
+  };
+
+  static std::uint64_t GetBucketKey(int x, int y) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+           static_cast<std::uint32_t>(y);
+  }
+
   std::set<PathfindingObstacleRuntimeBehavior*>
       allObstacles;  ///< The list of all obstacles of the scene.
+  std::unordered_map<PathfindingObstacleRuntimeBehavior*, ObstacleArea>
+      obstaclesAreas;  ///< The area of each obstacle, when it was last added
+                       ///< or updated.
+  std::unordered_map<std::uint64_t, std::vector<const ObstacleArea*>>
+      buckets;  ///< The areas of the obstacles, stored in each bucket of
+                ///< bucketSize*bucketSize pixels they intersect.
+  std::map<CostGridKey, CachedCostGrid>
+      costGrids;  ///< The grids, by rounded cell size and borders.
+  std::map<std::tuple<int, int, int, int, int, int, int, int, bool>,
+           CachedFlowField>
+      flowFields;  ///< The flow fields, by rounded cell size and borders,
+                   ///< destination and diagonals allowed or not.
+  std::uint64_t usesCount;  ///< Incremented each time a grid or a flow field
+                            ///< is used.
+  std::size_t passableObstaclesCount;
+  PathfindingNodesArena nodesArena;
+
+  static const float bucketSize;
+  static const std::size_t maxCostGridsCount;
+  static const std::size_t maxFlowFieldsCount;
 };
 
 #endif
@@ -8,10 +8,17 @@ This project is released under the MIT License.
  * @file Tests for the Pathfinding extension.
  */
 #define CATCH_CONFIG_MAIN
+#include <cmath>
+#include <map>
+#include <random>
+#include <set>
 #include "../PathfindingBehavior.h"
+#include "../PathfindingCostGrid.h"
+#include "../PathfindingFlowField.h"
 #include "../PathfindingObstacleBehavior.h"
 #include "../PathfindingObstacleRuntimeBehavior.h"
 #include "../PathfindingRuntimeBehavior.h"
+#include "../ScenePathfindingObstaclesManager.h"
 #include "GDCore/CommonTools.h"
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Object.h"
@@ -46,6 +53,124 @@ std::unique_ptr<TRuntimeBehavior> CreateNewRuntimeBehavior() {
   behavior.InitializeContent(behaviorContent);
   return std::move(gd::make_unique<TRuntimeBehavior>(behaviorContent));
 };
+
+/**
+ * \brief The A* used by PathfindingRuntimeBehavior before its nodes were
+ * stored in a PathfindingNodesArena, used as a reference.
+ *
+ * \return true if a path was found, in which case the cells of the path are
+ * stored in \a path.
+ */
+bool ComputeReferencePath(PathfindingCostGrid &grid,
+                          int startX,
+                          int startY,
+                          int destinationX,
+                          int destinationY,
+                          bool allowsDiagonal,
+                          std::vector<std::pair<int, int>> &path) {
+  struct Node {
+    int x;
+    int y;
+    float cost;
+    float smallestCost;
+    float estimateCost;
+    const Node *parent;
+    bool open;
+  };
+  struct NodeComparator {
+    bool operator()(const Node *n1, const Node *n2) const {
+      return n1->estimateCost < n2->estimateCost;
+    }
+  };
+  std::map<std::pair<int, int>, Node> allNodes;
+  std::multiset<Node *, NodeComparator> openNodes;
+
+  auto distance = [&](int x, int y) -> float {
+    return allowsDiagonal ? sqrt((x - destinationX) * (x - destinationX) +
+                                 (y - destinationY) * (y - destinationY))
+                          : abs(x - destinationX) + abs(y - destinationY);
+  };
+  auto getNode = [&](int x, int y) -> Node & {
+    auto it = allNodes.find(std::make_pair(x, y));
+    if (it != allNodes.end()) return it->second;
+
+    Node node = {x, y, grid.GetCost(x, y), -1, -1, NULL, true};
+    return allNodes[std::make_pair(x, y)] = node;
+  };
+  auto addOrUpdateNode = [&](int x, int y, const Node &current, float factor) {
+    Node &neighbor = getNode(x, y);
+    if (!neighbor.open || neighbor.cost < 0) return;
+
+    double newCost =
+        current.smallestCost + (current.cost + neighbor.cost) / 2.0 * factor;
+    if (neighbor.smallestCost == -1 || neighbor.smallestCost > newCost) {
+      if (neighbor.smallestCost != -1) {
+        auto range = openNodes.equal_range(&neighbor);
+        for (auto it = range.first; it != range.second; ++it) {
+          if (*it == &neighbor) {
+            openNodes.erase(it);
+            break;
+          }
+        }
+      }
+
+      neighbor.smallestCost = newCost;
+      neighbor.parent = &current;
+      neighbor.estimateCost = neighbor.smallestCost + distance(x, y);
+      openNodes.insert(&neighbor);
+    }
+  };
+
+  Node &startNode = getNode(startX, startY);
+  startNode.smallestCost = 0;
+  startNode.estimateCost = distance(startX, startY);
+  openNodes.insert(&startNode);
+
+  std::size_t iterationCount = 0;
+  std::size_t maxIterationCount = startNode.estimateCost * 50;
+  while (!openNodes.empty()) {
+    if (iterationCount++ > maxIterationCount) return false;
+
+    Node *n = *openNodes.begin();
+    n->open = false;
+    openNodes.erase(openNodes.begin());
+    if (n->x == destinationX && n->y == destinationY) {
+      for (const Node *node = n; node; node = node->parent)
+        path.insert(path.begin(), std::make_pair(node->x, node->y));
+      return true;
+    }
+
+    const float sqrt2 = 1.414213562;
+    addOrUpdateNode(n->x + 1, n->y, *n, 1);
+    addOrUpdateNode(n->x - 1, n->y, *n, 1);
+    addOrUpdateNode(n->x, n->y + 1, *n, 1);
+    addOrUpdateNode(n->x, n->y - 1, *n, 1);
+    if (allowsDiagonal) {
+      addOrUpdateNode(n->x + 1, n->y + 1, *n, sqrt2);
+      addOrUpdateNode(n->x + 1, n->y - 1, *n, sqrt2);
+      addOrUpdateNode(n->x - 1, n->y - 1, *n, sqrt2);
+      addOrUpdateNode(n->x - 1, n->y + 1, *n, sqrt2);
+    }
+  }
+
+  return false;
+}
+
+/**
+ * \brief Return the cost of moving along the path, like A*.
+ */
+float GetPathCost(PathfindingCostGrid &grid,
+                  const PathfindingRuntimeBehavior &behavior) {
+  float cost = 0;
+  for (std::size_t i = 1; i < behavior.GetNodeCount(); ++i) {
+    int x1 = behavior.GetNodeX(i - 1) / 20, y1 = behavior.GetNodeY(i - 1) / 20;
+    int x2 = behavior.GetNodeX(i) / 20, y2 = behavior.GetNodeY(i) / 20;
+    float factor = (x1 != x2 && y1 != y2) ? 1.414213562 : 1;
+    cost += (grid.GetCost(x1, y1) + grid.GetCost(x2, y2)) / 2.0 * factor;
+  }
+
+  return cost;
+}
 }  // namespace
 
 TEST_CASE("PathfindingRuntimeBehavior", "[game-engine][pathfinding]") {
@@ -233,4 +358,337 @@ TEST_CASE("PathfindingRuntimeBehavior", "[game-engine][pathfinding]") {
     REQUIRE(runtimeBehavior->GetNodeX(4) == 20);
     REQUIRE(runtimeBehavior->GetNodeY(4) == 80);
   }
+  SECTION("Cost grid") {
+    // Prepare some objects and the context
+    RuntimeGame game;
+
+    gd::Object obstacleObj("obstacle");
+
+    RuntimeScene scene(NULL, &game);
+    auto *obstacle =
+        scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+            new ResizableRuntimeObject(scene, obstacleObj)));
+    obstacle->AddBehavior(
+        "PathfindingObstacle",
+        CreateNewRuntimeBehavior<PathfindingObstacleRuntimeBehavior,
+                                 PathfindingObstacleBehavior>());
+
+    obstacle->SetX(100);
+    obstacle->SetY(100);
+    obstacle->SetWidth(60);
+    obstacle->SetHeight(60);
+    scene.RenderAndStep();
+
+    PathfindingCostGrid &grid =
+        ScenePathfindingObstaclesManager::managers[&scene].GetCostGrid(
+            10, 10, 0, 0, 0, 0);
+    REQUIRE(&ScenePathfindingObstaclesManager::managers[&scene].GetCostGrid(
+                10, 10, 0, 0, 0, 0) == &grid);
+
+    // Borders differing only by a rounding error share the same grid.
+    REQUIRE(&ScenePathfindingObstaclesManager::managers[&scene].GetCostGrid(
+                10, 10, 0.0001, -0.0001, 0.4, 0) == &grid);
+
+    // Cells on the sides of the obstacle are not covered by it
+    REQUIRE(grid.GetCost(10, 10) == 1);
+    REQUIRE(grid.GetCost(11, 11) == -1);
+    REQUIRE(grid.GetCost(15, 15) == -1);
+    REQUIRE(grid.GetCost(16, 16) == 1);
+    REQUIRE(grid.GetChunksComputationsCount() == 1);
+    REQUIRE(grid.GetCost(-1000, 1000) == 1);
+    REQUIRE(grid.GetChunksComputationsCount() == 2);
+
+    // Only the chunks covered by the obstacle are computed again when it moves
+    obstacle->SetX(2000);
+    scene.RenderAndStep();
+    REQUIRE(grid.GetCost(11, 11) == 1);
+    REQUIRE(grid.GetChunksComputationsCount() == 3);
+    REQUIRE(grid.GetCost(-1000, 1000) == 1);
+    REQUIRE(grid.GetChunksComputationsCount() == 3);
+    REQUIRE(grid.GetCost(201, 11) == -1);
+    REQUIRE(grid.GetChunksComputationsCount() == 4);
+
+    // Change the cost of the obstacle
+    auto *obstacleBehavior = static_cast<PathfindingObstacleRuntimeBehavior *>(
+        obstacle->GetBehaviorRawPointer("PathfindingObstacle"));
+    obstacleBehavior->SetImpassable(false);
+    obstacleBehavior->SetCost(3);
+    scene.RenderAndStep();
+    REQUIRE(grid.GetCost(201, 11) == 3);
+    REQUIRE(grid.GetChunksComputationsCount() == 5);
+
+    // Remove the obstacle
+    obstacleBehavior->Activate(false);
+    REQUIRE(grid.GetCost(201, 11) == 1);
+    REQUIRE(grid.GetChunksComputationsCount() == 6);
+
+    // Only the grids used the most recently are kept.
+    ScenePathfindingObstaclesManager &manager =
+        ScenePathfindingObstaclesManager::managers[&scene];
+    for (int border = 1; border <= 20; ++border)
+      manager.GetCostGrid(10, 10, border, border, border, border);
+    REQUIRE(manager.GetCostGridsCount() == 16);
+  }
+  SECTION("Same paths as the reference A*") {
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> cells(0, 39);
+    for (std::size_t scenario = 0; scenario < 40; ++scenario) {
+      // Prepare some objects and the context
+      RuntimeGame game;
+
+      gd::Object playerObj("player");
+      gd::Object obstacleObj("obstacle");
+
+      RuntimeScene scene(NULL, &game);
+      auto *player = scene.objectsInstances.AddObject(
+          std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, playerObj)));
+      player->AddBehavior("Pathfinding",
+                          CreateNewRuntimeBehavior<PathfindingRuntimeBehavior,
+                                                   PathfindingBehavior>());
+
+      // Use obstacles with a cost in half of the scenarios, where Jump Point
+      // Search can't be used.
+      bool uniformCost = scenario % 2 == 0;
+      for (std::size_t i = 0; i < 30; ++i) {
+        auto *obstacle =
+            scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+                new ResizableRuntimeObject(scene, obstacleObj)));
+        obstacle->AddBehavior(
+            "PathfindingObstacle",
+            CreateNewRuntimeBehavior<PathfindingObstacleRuntimeBehavior,
+                                     PathfindingObstacleBehavior>());
+        obstacle->SetX(cells(random) * 20);
+        obstacle->SetY(cells(random) * 20);
+        obstacle->SetWidth(cells(random) * 4 + 20);
+        obstacle->SetHeight(cells(random) * 4 + 20);
+        if (!uniformCost && i % 3 == 0) {
+          auto *obstacleBehavior =
+              static_cast<PathfindingObstacleRuntimeBehavior *>(
+                  obstacle->GetBehaviorRawPointer("PathfindingObstacle"));
+          obstacleBehavior->SetImpassable(false);
+          obstacleBehavior->SetCost(cells(random) % 4 + 1);
+        }
+      }
+      scene.RenderAndStep();
+
+      int startX = cells(random), startY = cells(random);
+      int destinationX = cells(random), destinationY = cells(random);
+      if (startX == destinationX && startY == destinationY) continue;
+      player->SetX(startX * 20);
+      player->SetY(startY * 20);
+
+      PathfindingRuntimeBehavior *runtimeBehavior =
+          static_cast<PathfindingRuntimeBehavior *>(
+              player->GetBehaviorRawPointer("Pathfinding"));
+      PathfindingCostGrid &grid =
+          ScenePathfindingObstaclesManager::managers[&scene].GetCostGrid(
+              20, 20, 0, 0, 0, 0);
+      for (bool allowsDiagonal : {true, false}) {
+        INFO("Scenario " << scenario << ", diagonals: " << allowsDiagonal);
+        std::vector<std::pair<int, int>> referencePath;
+        bool referencePathFound = ComputeReferencePath(grid,
+                                                       startX,
+                                                       startY,
+                                                       destinationX,
+                                                       destinationY,
+                                                       allowsDiagonal,
+                                                       referencePath);
+
+        // A* must find the same path as the reference.
+        runtimeBehavior->SetAllowDiagonals(allowsDiagonal);
+        runtimeBehavior->EnableJumpPointSearch(false);
+        runtimeBehavior->MoveTo(scene, destinationX * 20, destinationY * 20);
+        REQUIRE(runtimeBehavior->PathFound() == referencePathFound);
+        if (!referencePathFound) continue;
+
+        REQUIRE(runtimeBehavior->GetNodeCount() == referencePath.size());
+        for (std::size_t i = 0; i < referencePath.size(); ++i) {
+          REQUIRE(runtimeBehavior->GetNodeX(i) == referencePath[i].first * 20);
+          REQUIRE(runtimeBehavior->GetNodeY(i) == referencePath[i].second * 20);
+        }
+        float referenceCost = GetPathCost(grid, *runtimeBehavior);
+
+        // Jump Point Search must find a path as short, going from a cell to
+        // a neighbor.
+        runtimeBehavior->EnableJumpPointSearch();
+        runtimeBehavior->MoveTo(scene, destinationX * 20, destinationY * 20);
+        REQUIRE(runtimeBehavior->PathFound() == true);
+        REQUIRE(GetPathCost(grid, *runtimeBehavior) ==
+                Approx(referenceCost).epsilon(0.0001));
+        for (std::size_t i = 1; i < runtimeBehavior->GetNodeCount(); ++i) {
+          REQUIRE(std::abs(runtimeBehavior->GetNodeX(i) -
+                           runtimeBehavior->GetNodeX(i - 1)) <= 20);
+          REQUIRE(std::abs(runtimeBehavior->GetNodeY(i) -
+                           runtimeBehavior->GetNodeY(i - 1)) <= 20);
+          REQUIRE(grid.GetCost(runtimeBehavior->GetNodeX(i) / 20,
+                               runtimeBehavior->GetNodeY(i) / 20) >= 0);
+        }
+
+        // The flow field of the destination must give a path as short.
+        runtimeBehavior->EnableJumpPointSearch(false);
+        runtimeBehavior->EnableFlowField();
+        runtimeBehavior->MoveTo(scene, destinationX * 20, destinationY * 20);
+        runtimeBehavior->EnableFlowField(false);
+        REQUIRE(runtimeBehavior->PathFound() == true);
+        REQUIRE(GetPathCost(grid, *runtimeBehavior) ==
+                Approx(referenceCost).epsilon(0.0001));
+      }
+    }
+  }
+  SECTION("Paths going out of the window of the nodes") {
+    // Prepare some objects and the context
+    RuntimeGame game;
+
+    gd::Object playerObj("player");
+    gd::Object obstacleObj("obstacle");
+
+    RuntimeScene scene(NULL, &game);
+    auto *player = scene.objectsInstances.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, playerObj)));
+    player->AddBehavior("Pathfinding",
+                        CreateNewRuntimeBehavior<PathfindingRuntimeBehavior,
+                                                 PathfindingBehavior>());
+    player->SetX(0);
+    player->SetY(0);
+
+    // A wall between the player and the destination, going farther than the
+    // margin of the window around them.
+    auto *obstacle =
+        scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+            new ResizableRuntimeObject(scene, obstacleObj)));
+    obstacle->AddBehavior(
+        "PathfindingObstacle",
+        CreateNewRuntimeBehavior<PathfindingObstacleRuntimeBehavior,
+                                 PathfindingObstacleBehavior>());
+    obstacle->SetX(580);
+    obstacle->SetY(-500);
+    obstacle->SetWidth(40);
+    obstacle->SetHeight(1000);
+    scene.RenderAndStep();
+
+    PathfindingRuntimeBehavior *runtimeBehavior =
+        static_cast<PathfindingRuntimeBehavior *>(
+            player->GetBehaviorRawPointer("Pathfinding"));
+    PathfindingCostGrid &grid =
+        ScenePathfindingObstaclesManager::managers[&scene].GetCostGrid(
+            20, 20, 0, 0, 0, 0);
+    std::vector<std::pair<int, int>> referencePath;
+    REQUIRE(ComputeReferencePath(grid, 0, 0, 60, 0, true, referencePath));
+
+    for (bool jumpPointSearch : {false, true}) {
+      INFO("Jump Point Search: " << jumpPointSearch);
+      runtimeBehavior->EnableJumpPointSearch(jumpPointSearch);
+      runtimeBehavior->MoveTo(scene, 1200, 0);
+      REQUIRE(runtimeBehavior->PathFound() == true);
+      REQUIRE(runtimeBehavior->GetDestinationX() == 1200);
+      if (!jumpPointSearch) {
+        REQUIRE(runtimeBehavior->GetNodeCount() == referencePath.size());
+        for (std::size_t i = 0; i < referencePath.size(); ++i) {
+          REQUIRE(runtimeBehavior->GetNodeX(i) == referencePath[i].first * 20);
+          REQUIRE(runtimeBehavior->GetNodeY(i) == referencePath[i].second * 20);
+        }
+      }
+
+      // Paths longer than the maximum size of the window.
+      runtimeBehavior->MoveTo(scene, -30000, 0);
+      REQUIRE(runtimeBehavior->PathFound() == true);
+      REQUIRE(runtimeBehavior->GetNodeCount() == 1501);
+    }
+  }
+  SECTION("Flow field") {
+    // Prepare some objects and the context
+    RuntimeGame game;
+
+    gd::Object playerObj("player");
+    gd::Object obstacleObj("obstacle");
+
+    RuntimeScene scene(NULL, &game);
+    std::vector<PathfindingRuntimeBehavior *> runtimeBehaviors;
+    for (std::size_t i = 0; i < 3; ++i) {
+      auto *player = scene.objectsInstances.AddObject(
+          std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, playerObj)));
+      player->AddBehavior("Pathfinding",
+                          CreateNewRuntimeBehavior<PathfindingRuntimeBehavior,
+                                                   PathfindingBehavior>());
+      player->SetX(100);
+      player->SetY(100 + i * 100);
+
+      auto *runtimeBehavior = static_cast<PathfindingRuntimeBehavior *>(
+          player->GetBehaviorRawPointer("Pathfinding"));
+      runtimeBehavior->EnableFlowField();
+      runtimeBehaviors.push_back(runtimeBehavior);
+    }
+
+    // A wall between the players and the destination.
+    auto *obstacle =
+        scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+            new ResizableRuntimeObject(scene, obstacleObj)));
+    obstacle->AddBehavior(
+        "PathfindingObstacle",
+        CreateNewRuntimeBehavior<PathfindingObstacleRuntimeBehavior,
+                                 PathfindingObstacleBehavior>());
+    obstacle->SetX(200);
+    obstacle->SetY(0);
+    obstacle->SetWidth(40);
+    obstacle->SetHeight(400);
+    scene.RenderAndStep();
+
+    // All the players share the same field, even if their borders differ by a
+    // rounding error.
+    runtimeBehaviors[0]->SetExtraBorder(0.0001);
+    runtimeBehaviors[2]->SetExtraBorder(-0.0001);
+    ScenePathfindingObstaclesManager &manager =
+        ScenePathfindingObstaclesManager::managers[&scene];
+    for (auto *runtimeBehavior : runtimeBehaviors) {
+      runtimeBehavior->MoveTo(scene, 400, 200);
+      REQUIRE(runtimeBehavior->PathFound() == true);
+      REQUIRE(runtimeBehavior->GetDestinationX() == 400);
+      REQUIRE(runtimeBehavior->GetDestinationY() == 200);
+      for (std::size_t i = 0; i < runtimeBehavior->GetNodeCount(); ++i) {
+        REQUIRE((runtimeBehavior->GetNodeX(i) != 220 ||
+                 runtimeBehavior->GetNodeY(i) <= 0 ||
+                 runtimeBehavior->GetNodeY(i) >= 400));
+      }
+    }
+    REQUIRE(manager.GetFlowFieldsCount() == 1);
+    PathfindingFlowField &field =
+        manager.GetFlowField(20, 20, 0, 0, 0, 0, 20, 10, true);
+    REQUIRE(field.GetComputationsCount() == 1);
+    REQUIRE(field.GetCostToDestination(20, 10) == 0);
+    REQUIRE(field.GetCostToDestination(11, 10) == -1);
+
+    // The same path as A* is found.
+    PathfindingCostGrid &grid = manager.GetCostGrid(20, 20, 0, 0, 0, 0);
+    float flowFieldCost = GetPathCost(grid, *runtimeBehaviors[1]);
+    runtimeBehaviors[1]->EnableFlowField(false);
+    runtimeBehaviors[1]->MoveTo(scene, 400, 200);
+    REQUIRE(GetPathCost(grid, *runtimeBehaviors[1]) ==
+            Approx(flowFieldCost).epsilon(0.0001));
+    runtimeBehaviors[1]->EnableFlowField();
+
+    // The field is computed again when the wall is moved away...
+    obstacle->SetX(2000);
+    scene.RenderAndStep();
+    runtimeBehaviors[1]->MoveTo(scene, 400, 200);
+    REQUIRE(field.GetComputationsCount() == 2);
+    REQUIRE(runtimeBehaviors[1]->GetNodeCount() == 16);
+
+    // ...but not when an obstacle far from it is moved.
+    obstacle->SetX(3000);
+    scene.RenderAndStep();
+    runtimeBehaviors[0]->MoveTo(scene, 400, 200);
+    REQUIRE(runtimeBehaviors[0]->PathFound() == true);
+    REQUIRE(field.GetComputationsCount() == 2);
+
+    // Objects too far from the destination search their path with A*.
+    runtimeBehaviors[0]->MoveTo(scene, 4000, 200);
+    REQUIRE(runtimeBehaviors[0]->PathFound() == true);
+    REQUIRE(runtimeBehaviors[0]->GetNodeCount() == 196);
+
+    // The fields are forgotten with the grid they use.
+    REQUIRE(manager.GetFlowFieldsCount() == 2);
+    for (int border = 1; border <= 16; ++border)
+      manager.GetCostGrid(20, 20, border, border, border, border);
+    REQUIRE(manager.GetFlowFieldsCount() == 0);
+  }
 }
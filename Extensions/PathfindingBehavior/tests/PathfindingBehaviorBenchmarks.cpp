@@ -0,0 +1,175 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+/**
+ * @file Benchmarks of the Pathfinding extension.
+ */
+#include <chrono>
+#include <iostream>
+#include "../PathfindingBehavior.h"
+#include "../PathfindingObstacleBehavior.h"
+#include "../PathfindingObstacleRuntimeBehavior.h"
+#include "../PathfindingRuntimeBehavior.h"
+#include "GDCore/CommonTools.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+namespace {
+class SizedRuntimeObject : public RuntimeObject {
+ public:
+  SizedRuntimeObject(RuntimeScene &scene, const gd::Object &obj)
+      : RuntimeObject(scene, obj) {}
+
+  float GetWidth() const override { return 32; }
+  float GetHeight() const override { return 32; }
+};
+
+template <class TRuntimeBehavior, class TBehavior>
+std::unique_ptr<TRuntimeBehavior> CreateNewRuntimeBehavior() {
+  gd::SerializerElement behaviorContent;
+  TBehavior behavior;
+  behavior.InitializeContent(behaviorContent);
+  return gd::make_unique<TRuntimeBehavior>(behaviorContent);
+};
+
+/**
+ * \brief Add 1000 obstacles on a 40x25 grid to the scene.
+ */
+std::vector<RuntimeObject *> CreateObstacles(RuntimeScene &scene,
+                                             const gd::Object &obstacleObj) {
+  std::vector<RuntimeObject *> obstacles;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    auto *obstacle =
+        scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(
+            new SizedRuntimeObject(scene, obstacleObj)));
+    obstacle->AddBehavior(
+        "PathfindingObstacle",
+        CreateNewRuntimeBehavior<PathfindingObstacleRuntimeBehavior,
+                                 PathfindingObstacleBehavior>());
+    obstacle->SetX(100 + (i % 40) * 100 + (i / 40 % 2) * 50);
+    obstacle->SetY(100 + (i / 40) * 100);
+    obstacles.push_back(obstacle);
+  }
+
+  return obstacles;
+}
+
+long long GetTimeMicroseconds() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+TEST_CASE("PathfindingRuntimeBehavior - Benchmarks",
+          "[game-engine][pathfinding][benchmarks]") {
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+  gd::Object agentObj("agent");
+  gd::Object obstacleObj("obstacle");
+
+  // 1000 obstacles, with some of them moving every frame.
+  std::vector<RuntimeObject *> obstacles = CreateObstacles(scene, obstacleObj);
+
+  std::vector<RuntimeObject *> agents;
+  for (std::size_t i = 0; i < 200; ++i) {
+    auto *agent = scene.objectsInstances.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, agentObj)));
+    agent->AddBehavior("Pathfinding",
+                       CreateNewRuntimeBehavior<PathfindingRuntimeBehavior,
+                                                PathfindingBehavior>());
+    agent->SetX(60 + (i % 20) * 200);
+    agent->SetY(60 + (i / 20) * 250);
+    agents.push_back(agent);
+  }
+  scene.RenderAndStep();
+
+  // Each frame, every agent computes a path to a destination 600 pixels away.
+  const std::size_t framesCount = 10;
+  std::size_t pathsFoundCount = 0;
+  long long start = GetTimeMicroseconds();
+  for (std::size_t frame = 0; frame < framesCount; ++frame) {
+    for (std::size_t i = 0; i < 50; ++i) {
+      RuntimeObject *obstacle = obstacles[(frame * 50 + i) % obstacles.size()];
+      obstacle->SetX(obstacle->GetX() + (frame % 2 ? -20 : 20));
+    }
+
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+      auto *behavior = static_cast<PathfindingRuntimeBehavior *>(
+          agents[i]->GetBehaviorRawPointer("Pathfinding"));
+      behavior->MoveTo(scene,
+                       agents[i]->GetX() + ((i + frame) % 2 ? 600 : -600),
+                       agents[i]->GetY() + ((i + frame) % 3 ? 430 : -430));
+      if (behavior->PathFound()) pathsFoundCount++;
+    }
+
+    scene.RenderAndStep();
+  }
+  long long duration = GetTimeMicroseconds() - start;
+  std::cout << "Pathfinding of 200 agents among 1000 obstacles: "
+            << duration / framesCount << " microseconds per frame."
+            << std::endl;
+
+  REQUIRE(pathsFoundCount > 0);
+}
+
+TEST_CASE("PathfindingRuntimeBehavior - Benchmarks of flow fields",
+          "[game-engine][pathfinding][benchmarks]") {
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+  gd::Object agentObj("agent");
+  gd::Object obstacleObj("obstacle");
+  std::vector<RuntimeObject *> obstacles = CreateObstacles(scene, obstacleObj);
+
+  // 200 agents around the center of the scene.
+  std::vector<RuntimeObject *> agents;
+  for (std::size_t i = 0; i < 200; ++i) {
+    auto *agent = scene.objectsInstances.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, agentObj)));
+    agent->AddBehavior("Pathfinding",
+                       CreateNewRuntimeBehavior<PathfindingRuntimeBehavior,
+                                                PathfindingBehavior>());
+    agent->SetX(860 + (i % 20) * 120);
+    agent->SetY(690 + (i / 20) * 120);
+    agents.push_back(agent);
+  }
+  scene.RenderAndStep();
+
+  // Each frame, all the agents compute a path to the same destination, with
+  // A* and then with the flow field of the destination.
+  for (bool flowField : {false, true}) {
+    const std::size_t framesCount = 10;
+    std::size_t pathsFoundCount = 0;
+    long long start = GetTimeMicroseconds();
+    for (std::size_t frame = 0; frame < framesCount; ++frame) {
+      for (std::size_t i = 0; i < 50; ++i) {
+        RuntimeObject *obstacle =
+            obstacles[(frame * 50 + i) % obstacles.size()];
+        obstacle->SetX(obstacle->GetX() + (frame % 2 ? -20 : 20));
+      }
+
+      for (auto *agent : agents) {
+        auto *behavior = static_cast<PathfindingRuntimeBehavior *>(
+            agent->GetBehaviorRawPointer("Pathfinding"));
+        behavior->EnableFlowField(flowField);
+        behavior->MoveTo(scene, 2020, 1300);
+        if (behavior->PathFound()) pathsFoundCount++;
+      }
+
+      scene.RenderAndStep();
+    }
+    long long duration = GetTimeMicroseconds() - start;
+    std::cout << "Pathfinding of 200 agents to the same destination"
+              << (flowField ? " with a flow field: " : ": ")
+              << duration / framesCount << " microseconds per frame."
+              << std::endl;
+
+    REQUIRE(pathsFoundCount > 0);
+  }
+}
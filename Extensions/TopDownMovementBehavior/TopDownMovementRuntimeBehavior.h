@@ -27,6 +27,12 @@ class GD_EXTENSION_API TopDownMovementRuntimeBehavior : public RuntimeBehavior {
     return new TopDownMovementRuntimeBehavior(*this);
   }
 
+  /**
+   * \brief The movement only depends on the inputs and on the object, so
+   * objects can be moved in parallel.
+   */
+  virtual bool IsThreadSafe() const { return true; }
+
   // Configuration:
   bool DiagonalsAllowed() const { return allowDiagonals; };
   float GetAcceleration() const { return acceleration; };
@@ -391,24 +391,22 @@ gd::String EventsCodeGenerator::GenerateObject(
     std::vector<gd::String> realObjects =
         ExpandObjectsName(objectName, context);
 
-    output += "runtimeContext->ClearObjectListsMap()";
+    output += "runtimeContext->GetPickedObjectsLists()";
     for (std::size_t i = 0; i < realObjects.size(); ++i) {
       context.ObjectsListNeeded(realObjects[i]);
-      output += ".AddObjectListToMap(\"" + ConvertToString(realObjects[i]) +
-                "\", " + ManObjListName(realObjects[i]) + ")";
+      output += ".Add(" + GenerateObjectNameIdCode(realObjects[i]) + ", " +
+                ManObjListName(realObjects[i]) + ")";
     }
-    output += ".ReturnObjectListsMap()";
   } else if (type == "objectListWithoutPicking") {
     std::vector<gd::String> realObjects =
         ExpandObjectsName(objectName, context);
 
-    output += "runtimeContext->ClearObjectListsMap()";
+    output += "runtimeContext->GetPickedObjectsLists()";
     for (std::size_t i = 0; i < realObjects.size(); ++i) {
       context.ObjectsListWithoutPickingNeeded(realObjects[i]);
-      output += ".AddObjectListToMap(\"" + ConvertToString(realObjects[i]) +
-                "\", " + ManObjListName(realObjects[i]) + ")";
+      output += ".Add(" + GenerateObjectNameIdCode(realObjects[i]) + ", " +
+                ManObjListName(realObjects[i]) + ")";
     }
-    output += ".ReturnObjectListsMap()";
   } else if (type == "objectPtr") {
     std::vector<gd::String> realObjects =
         ExpandObjectsName(objectName, context);
@@ -497,6 +495,40 @@ gd::String EventsCodeGenerator::GenerateGetVariable(
   return output;
 }
 
+gd::String EventsCodeGenerator::GenerateObjectNameIdCode(
+    const gd::String& objectName) {
+  // The identifier of the name is cached in a static variable, so that the
+  // name is not hashed each time the objects are needed.
+  gd::String nameIdVariable = "GDObjectNameId" + ManObjListName(objectName);
+  AddGlobalDeclaration("static ObjectNameId " + nameIdVariable + "(" +
+                       ConvertToStringExplicit(objectName) + ");");
+
+  return nameIdVariable;
+}
+
+gd::String EventsCodeGenerator::GenerateAllInstancesGetterCode(
+    const gd::String& objectName) {
+  return "runtimeContext->GetObjectsRawPointers(" +
+         GenerateObjectNameIdCode(objectName) + ")";
+}
+
+gd::String EventsCodeGenerator::GenerateFrameProfilerScopeCode(
+    const gd::String& sectionName) {
+  AddIncludeFile("GDCpp/Runtime/FrameProfiler.h");
+  AddIncludeFile("GDCpp/Runtime/RuntimeScene.h");
+
+  // The identifier of the section is cached in a static variable, so that the
+  // section is only searched once.
+  gd::String sectionIdVariable = "GDProfilerSection" + ManObjListName(sectionName);
+  AddGlobalDeclaration("static const std::size_t " + sectionIdVariable +
+                       " = FrameProfiler::GetSectionId(" +
+                       ConvertToStringExplicit(sectionName) + ");");
+
+  return "FrameProfiler::Scope GDProfilerScope(runtimeContext->scene->"
+         "GetFrameProfiler(), " +
+         sectionIdVariable + ");\n";
+}
+
 gd::String EventsCodeGenerator::GenerateSceneEventsCompleteCode(
     gd::Project& project,
     gd::Layout& scene,
@@ -58,6 +58,13 @@ class GD_API EventsCodeGenerator : public gd::EventsCodeGenerator {
    */
   void PreprocessEventList(gd::EventsList& listEvent);
 
+  /**
+   * \brief Generate the code declaring a FrameProfiler::Scope, measuring the
+   * time spent until the end of the current C++ block in the section
+   * \a sectionName of the profiler of the scene.
+   */
+  gd::String GenerateFrameProfilerScopeCode(const gd::String& sectionName);
+
   /**
    * \note This is unused for C++ code generation.
    */
@@ -156,6 +163,14 @@ class GD_API EventsCodeGenerator : public gd::EventsCodeGenerator {
 
   virtual gd::String GenerateGetBehaviorNameCode(const gd::String& behaviorName);
 
+  virtual gd::String GenerateAllInstancesGetterCode(const gd::String& objectName);
+
+  /**
+   * \brief Declare the ObjectNameId caching the identifier of the name of an
+   * object, and return the name of the variable.
+   */
+  gd::String GenerateObjectNameIdCode(const gd::String& objectName);
+
   /**
    * \brief Construct a code generator for the specified project and layout.
    */
@@ -12,6 +12,7 @@
 #if defined(GD_IDE_ONLY)
 #include "GDCore/Events/Builtin/CommentEvent.h"
 #include "GDCore/Events/Builtin/ForEachEvent.h"
+#include "GDCore/Events/Builtin/GroupEvent.h"
 #include "GDCore/Events/Builtin/LinkEvent.h"
 #include "GDCore/Events/Builtin/RepeatEvent.h"
 #include "GDCore/Events/Builtin/StandardEvent.h"
@@ -29,6 +30,7 @@
 #include "GDCore/Project/ObjectGroup.h"
 #include "GDCore/Project/Project.h"
 #include "GDCpp/Events/Builtin/CppCodeEvent.h"
+#include "GDCpp/Events/CodeGeneration/EventsCodeGenerator.h"
 #include "GDCpp/Extensions/Builtin/CommonInstructionsExtension.h"
 #include "GDCpp/Extensions/Builtin/CommonInstructionsTools.h"
 #include "GDCpp/Extensions/ExtensionBase.h"
@@ -564,11 +566,22 @@ CommonInstructionsExtension::CommonInstructionsExtension() {
       });
 
   GetAllEvents()["BuiltinCommonInstructions::Group"].SetCodeGenerator(
-      [](gd::BaseEvent& event,
+      [](gd::BaseEvent& event_,
          gd::EventsCodeGenerator& codeGenerator,
          gd::EventsCodeGenerationContext& context) {
-        return codeGenerator.GenerateEventsListCode(event.GetSubEvents(),
-                                                    context);
+        gd::String subEventsCode =
+            codeGenerator.GenerateEventsListCode(event_.GetSubEvents(), context);
+
+        // Measure the time spent in the group with the profiler of the scene.
+        gd::GroupEvent& event = dynamic_cast<gd::GroupEvent&>(event_);
+        ::EventsCodeGenerator* cppCodeGenerator =
+            dynamic_cast<::EventsCodeGenerator*>(&codeGenerator);
+        if (!cppCodeGenerator || event.GetName().empty()) return subEventsCode;
+
+        return "{\n" +
+               cppCodeGenerator->GenerateFrameProfilerScopeCode(
+                   "Events: " + event.GetName()) +
+               subEventsCode + "}\n";
       });
 
   AddEvent("CppCode",
@@ -14,40 +14,38 @@
 
 using namespace std;
 
-double GD_API PickedObjectsCount(
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists) {
+double GD_API PickedObjectsCount(const PickedObjectsLists &objectsLists) {
   std::size_t size = 0;
-  std::map<gd::String, std::vector<RuntimeObject *> *>::const_iterator it =
-      objectsLists.begin();
-  for (; it != objectsLists.end(); ++it) {
-    if (it->second == NULL) continue;
+  for (const PickedObjectsLists::value_type &list : objectsLists) {
+    if (list.second == NULL) continue;
 
-    size += (it->second)->size();
+    size += list.second->size();
   }
 
   return size;
 }
 
-bool GD_API HitBoxesCollision(
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
-    bool conditionInverted,
-    RuntimeScene & /*scene*/,
-    bool ignoreTouchingEdges) {
-  return TwoObjectListsTest(
+bool GD_API HitBoxesCollision(const PickedObjectsLists &objectsLists1,
+                              const PickedObjectsLists &objectsLists2,
+                              bool conditionInverted,
+                              RuntimeScene &scene,
+                              bool ignoreTouchingEdges) {
+  // IsCollidingWith is always false for objects which bounding circles are not
+  // overlapping, so only these pairs need to be tested.
+  return TwoObjectListsTestWithBroadPhase(
       objectsLists1,
       objectsLists2,
       conditionInverted,
+      scene.GetObjectsBroadPhase(),
       [ignoreTouchingEdges](RuntimeObject *obj1, RuntimeObject *obj2) {
         return obj1->IsCollidingWith(obj2, ignoreTouchingEdges);
       });
 }
 
-bool GD_API ObjectsTurnedToward(
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
-    float tolerance,
-    bool conditionInverted) {
+bool GD_API ObjectsTurnedToward(const PickedObjectsLists &objectsLists1,
+                                const PickedObjectsLists &objectsLists2,
+                                float tolerance,
+                                bool conditionInverted) {
   return TwoObjectListsTest(
       objectsLists1,
       objectsLists2,
@@ -65,11 +63,10 @@ bool GD_API ObjectsTurnedToward(
       });
 }
 
-float GD_API DistanceBetweenObjects(
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
-    float length,
-    bool conditionInverted) {
+float GD_API DistanceBetweenObjects(const PickedObjectsLists &objectsLists1,
+                                    const PickedObjectsLists &objectsLists2,
+                                    float length,
+                                    bool conditionInverted) {
   length *= length;
   return TwoObjectListsTest(
       objectsLists1,
@@ -85,11 +82,10 @@ float GD_API DistanceBetweenObjects(
       });
 }
 
-bool GD_API
-MovesToward(std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
-            std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
-            float tolerance,
-            bool conditionInverted) {
+bool GD_API MovesToward(const PickedObjectsLists &objectsLists1,
+                        const PickedObjectsLists &objectsLists2,
+                        float tolerance,
+                        bool conditionInverted) {
   return TwoObjectListsTest(
       objectsLists1,
       objectsLists2,
@@ -109,11 +105,10 @@ MovesToward(std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
       });
 }
 
-bool GD_API CursorOnObject(
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists,
-    RuntimeScene &scene,
-    bool precise,
-    bool conditionInverted) {
+bool GD_API CursorOnObject(const PickedObjectsLists &objectsLists,
+                           RuntimeScene &scene,
+                           bool precise,
+                           bool conditionInverted) {
   return PickObjectsIf(
       objectsLists, conditionInverted, [&scene, precise](RuntimeObject *obj) {
         return obj->CursorOnObject(scene, precise);
@@ -91,34 +91,14 @@ void GD_API MoveObjects(RuntimeScene &scene) {
 
 namespace {
 
-void DoCreateObjectOnScene(
-    RuntimeScene &scene,
-    gd::String objectName,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
-    float positionX,
-    float positionY,
-    const gd::String &layer) {
-  if (pickedObjectLists.empty()) return;
-
-  // Find the object to be created
-  std::vector<ObjSPtr>::const_iterator sceneObject =
-      std::find_if(scene.GetObjects().begin(),
-                   scene.GetObjects().end(),
-                   std::bind2nd(ObjectHasName(), objectName));
-  std::vector<ObjSPtr>::const_iterator globalObject =
-      std::find_if(scene.game->GetObjects().begin(),
-                   scene.game->GetObjects().end(),
-                   std::bind2nd(ObjectHasName(), objectName));
-
-  RuntimeObjSPtr newObject = std::unique_ptr<RuntimeObject>();
-
-  if (sceneObject !=
-      scene.GetObjects().end())  // We check first scene's objects' list.
-    newObject = CppPlatform::Get().CreateRuntimeObject(scene, **sceneObject);
-  else if (globalObject !=
-           scene.game->GetObjects().end())  // Then the global object list
-    newObject = CppPlatform::Get().CreateRuntimeObject(scene, **globalObject);
-
+void DoCreateObjectOnScene(RuntimeScene &scene,
+                           const gd::String &objectName,
+                           std::vector<RuntimeObject *> &pickedObjects,
+                           float positionX,
+                           float positionY,
+                           const gd::String &layer) {
+  // Create the object from its prototype
+  RuntimeObjSPtr newObject = scene.CreateObject(objectName);
   if (newObject == std::unique_ptr<RuntimeObject>())
     return;  // Unable to create the object
 
@@ -128,7 +108,7 @@ void DoCreateObjectOnScene(
   newObject->SetLayer(layer);
 
   // Add object to scene and let it be concerned by futures actions
-  pickedObjectLists[objectName]->push_back(
+  pickedObjects.push_back(
       scene.objectsInstances.AddObject(std::move(newObject)));
 }
 
@@ -136,15 +116,15 @@ void DoCreateObjectOnScene(
 
 void GD_API CreateObjectOnScene(
     RuntimeScene &scene,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
+    const PickedObjectsLists &pickedObjectLists,
     float positionX,
     float positionY,
     const gd::String &layer) {
-  if (pickedObjectLists.empty()) return;
+  if (pickedObjectLists.empty() || !pickedObjectLists.begin()->second) return;
 
   ::DoCreateObjectOnScene(scene,
-                          pickedObjectLists.begin()->first,
-                          pickedObjectLists,
+                          pickedObjectLists.GetName(*pickedObjectLists.begin()),
+                          *pickedObjectLists.begin()->second,
                           positionX,
                           positionY,
                           layer);
@@ -152,21 +132,22 @@ void GD_API CreateObjectOnScene(
 
 void GD_API CreateObjectFromGroupOnScene(
     RuntimeScene &scene,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
+    const PickedObjectsLists &pickedObjectLists,
     const gd::String &objectWanted,
     float positionX,
     float positionY,
     const gd::String &layer) {
-  if (pickedObjectLists[objectWanted] == nullptr)
+  std::vector<RuntimeObject *> *pickedObjects =
+      pickedObjectLists.Get(objectWanted);
+  if (pickedObjects == nullptr)
     return;  // Bail out if the object is not present in the specified group
 
   ::DoCreateObjectOnScene(
-      scene, objectWanted, pickedObjectLists, positionX, positionY, layer);
+      scene, objectWanted, *pickedObjects, positionX, positionY, layer);
 }
 
-bool GD_API PickAllObjects(
-    RuntimeScene &scene,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists) {
+bool GD_API PickAllObjects(RuntimeScene &scene,
+                           const PickedObjectsLists &pickedObjectLists) {
   for (auto it = pickedObjectLists.begin(); it != pickedObjectLists.end();
        ++it) {
     if (it->second != nullptr) {
@@ -184,9 +165,8 @@ bool GD_API PickAllObjects(
   return true;
 }
 
-bool GD_API PickRandomObject(
-    RuntimeScene &,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists) {
+bool GD_API PickRandomObject(RuntimeScene &,
+                             const PickedObjectsLists &pickedObjectLists) {
   // Create a list with all objects
   std::vector<RuntimeObject *> allObjects;
   for (auto it = pickedObjectLists.begin(); it != pickedObjectLists.end();
@@ -204,11 +184,10 @@ bool GD_API PickRandomObject(
   return true;
 }
 
-bool GD_API PickNearestObject(
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
-    double x,
-    double y,
-    bool inverted) {
+bool GD_API PickNearestObject(const PickedObjectsLists &pickedObjectLists,
+                              double x,
+                              double y,
+                              bool inverted) {
   double best = 0;
   bool first = true;
   RuntimeObject *bestObject = NULL;
@@ -235,7 +214,7 @@ bool GD_API PickNearestObject(
 }
 
 bool GD_API RaycastObject(
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
+    const PickedObjectsLists &pickedObjectLists,
     float x,
     float y,
     float angle,
@@ -251,7 +230,7 @@ bool GD_API RaycastObject(
 }
 
 bool GD_API RaycastObjectToPosition(
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
+    const PickedObjectsLists &pickedObjectLists,
     float x,
     float y,
     float endX,
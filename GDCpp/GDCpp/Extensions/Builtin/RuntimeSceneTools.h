@@ -4,6 +4,7 @@
 #include <map>
 #include <string>
 #include <vector>
+#include "GDCpp/Runtime/PickedObjectsLists.h"
 class RuntimeScene;
 namespace gd {
 class Variable;
@@ -72,7 +73,7 @@ void GD_API DisableInputWhenFocusIsLost(RuntimeScene &scene, bool disable);
  */
 void GD_API CreateObjectOnScene(
     RuntimeScene &scene,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
+    const PickedObjectsLists &pickedObjectLists,
     float positionX,
     float positionY,
     const gd::String &layer);
@@ -82,7 +83,7 @@ void GD_API CreateObjectOnScene(
  */
 void GD_API CreateObjectFromGroupOnScene(
     RuntimeScene &scene,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
+    const PickedObjectsLists &pickedObjectLists,
     const gd::String &objectWanted,
     float positionX,
     float positionY,
@@ -93,35 +94,32 @@ void GD_API CreateObjectFromGroupOnScene(
  *
  * \return true ( always )
  */
-bool GD_API PickAllObjects(
-    RuntimeScene &scene,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists);
+bool GD_API PickAllObjects(RuntimeScene &scene,
+                           const PickedObjectsLists &pickedObjectLists);
 
 /**
  * Only used internally by GD events generated code.
  *
  * \return true if an object was picked, false otherwise
  */
-bool GD_API PickRandomObject(
-    RuntimeScene &scene,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists);
+bool GD_API PickRandomObject(RuntimeScene &scene,
+                             const PickedObjectsLists &pickedObjectLists);
 
 /**
  * Only used internally by GD events generated code.
  *
  * \return true if an object was picked, false otherwise
  */
-bool GD_API PickNearestObject(
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
-    double x,
-    double y,
-    bool inverted);
+bool GD_API PickNearestObject(const PickedObjectsLists &pickedObjectLists,
+                              double x,
+                              double y,
+                              bool inverted);
 
 /**
  * Only used internally by GD events generated code.
  */
 bool GD_API RaycastObject(
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
+    const PickedObjectsLists &pickedObjectLists,
     float x,
     float y,
     float angle,
@@ -134,7 +132,7 @@ bool GD_API RaycastObject(
  * Only used internally by GD events generated code.
  */
 bool GD_API RaycastObjectToPosition(
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
+    const PickedObjectsLists &pickedObjectLists,
     float x,
     float y,
     float targetX,
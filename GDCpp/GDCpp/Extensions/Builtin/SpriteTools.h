@@ -5,14 +5,14 @@
 #include <string>
 #include <vector>
 
+#include "GDCpp/Runtime/PickedObjectsLists.h"
 #include "GDCpp/Runtime/String.h"
 
 class RuntimeScene;
 class RuntimeObject;
 
-bool GD_API SpriteCollision(
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists1,
-    std::map<gd::String, std::vector<RuntimeObject *> *> objectsLists2,
-    bool conditionInverted);
+bool GD_API SpriteCollision(const PickedObjectsLists &objectsLists1,
+                            const PickedObjectsLists &objectsLists2,
+                            bool conditionInverted);
 
 #endif  // SPRITETOOLS_H
@@ -54,8 +54,8 @@ gd::String GD_API ToLowerCase(const gd::String& str) { return str.LowerCase(); }
 gd::String GD_API StrRepeat(const gd::String& str, std::size_t repCount) {
   gd::String result;
 
-  result.Raw().reserve(str.Raw().size() * repCount);
-  for (std::size_t i = 0; i < repCount; ++i) result.Raw() += str.Raw();
+  result.RawMutable().reserve(str.Raw().size() * repCount);
+  for (std::size_t i = 0; i < repCount; ++i) result.RawMutable() += str.Raw();
 
   return result;
 }
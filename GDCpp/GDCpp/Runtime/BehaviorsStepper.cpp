@@ -0,0 +1,66 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/BehaviorsStepper.h"
+#include <typeinfo>
+#include "GDCpp/Runtime/RuntimeBehavior.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/ThreadPool.h"
+
+namespace {
+/**
+ * The number of behaviors stepped by a thread before looking for other
+ * behaviors to step.
+ */
+const std::size_t behaviorsChunkSize = 64;
+}
+
+void BehaviorsStepper::StepObjectBehaviors(RuntimeObject& object,
+                                           RuntimeScene& scene,
+                                           Step step) {
+  for (auto it = object.behaviors.cbegin(); it != object.behaviors.cend();
+       ++it) {
+    RuntimeBehavior& behavior = *it->second;
+    if (deterministic || !behavior.IsThreadSafe()) {
+      StepBehavior(behavior, scene, step);
+      continue;
+    }
+
+    std::type_index type(typeid(behavior));
+    auto group = threadSafeBehaviors.begin();
+    while (group != threadSafeBehaviors.end() && group->first != type) ++group;
+    if (group == threadSafeBehaviors.end()) {
+      threadSafeBehaviors.emplace_back(type, std::vector<RuntimeBehavior*>());
+      group = threadSafeBehaviors.end() - 1;
+    }
+
+    group->second.push_back(&behavior);
+  }
+}
+
+void BehaviorsStepper::StepThreadSafeBehaviors(RuntimeScene& scene,
+                                               Step step) {
+  for (auto& group : threadSafeBehaviors) {
+    std::vector<RuntimeBehavior*>& behaviors = group.second;
+    ThreadPool::Get().ParallelFor(
+        behaviors.size(),
+        behaviorsChunkSize,
+        [&](std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin; i < end; ++i)
+            StepBehavior(*behaviors[i], scene, step);
+        });
+
+    behaviors.clear();
+  }
+}
+
+void BehaviorsStepper::StepBehavior(RuntimeBehavior& behavior,
+                                    RuntimeScene& scene,
+                                    Step step) {
+  if (step == PRE_EVENTS)
+    behavior.StepPreEvents(scene);
+  else
+    behavior.StepPostEvents(scene);
+}
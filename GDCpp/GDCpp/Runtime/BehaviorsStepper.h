@@ -0,0 +1,81 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef BEHAVIORSSTEPPER_H
+#define BEHAVIORSSTEPPER_H
+
+#include <cstddef>
+#include <typeindex>
+#include <utility>
+#include <vector>
+class RuntimeBehavior;
+class RuntimeObject;
+class RuntimeScene;
+
+/**
+ * \brief Run the steps of the behaviors of the objects of a scene, stepping
+ * the thread-safe behaviors in parallel.
+ *
+ * Behaviors which are not thread-safe (see RuntimeBehavior::IsThreadSafe) are
+ * stepped when StepObjectBehaviors is called for their object. The thread-safe
+ * behaviors are kept and stepped by StepThreadSafeBehaviors, in parallel, one
+ * type of behavior after the other: they are stepped after all the behaviors
+ * which are not thread-safe, whatever their order in their object.
+ *
+ * In deterministic mode, all the behaviors are stepped by the calling thread
+ * when StepObjectBehaviors is called, in the order of the behaviors of each
+ * object, so that games can be replayed exactly.
+ *
+ * \see RuntimeScene::GetBehaviorsStepper
+ * \ingroup GameEngine
+ */
+class GD_API BehaviorsStepper {
+ public:
+  enum Step { PRE_EVENTS, POST_EVENTS };
+
+  BehaviorsStepper() : deterministic(false){};
+  virtual ~BehaviorsStepper(){};
+
+  /**
+   * \brief Set if thread-safe behaviors must be stepped by the calling thread,
+   * in the order of the behaviors of their object.
+   */
+  void SetDeterministic(bool enable = true) { deterministic = enable; }
+
+  /**
+   * \brief Return true if thread-safe behaviors are stepped by the calling
+   * thread, in the order of the behaviors of their object.
+   */
+  bool IsDeterministic() const { return deterministic; }
+
+  /**
+   * \brief Step the behaviors of the object which are not thread-safe, and
+   * keep the others to be stepped by StepThreadSafeBehaviors (unless in
+   * deterministic mode, where all the behaviors are stepped).
+   */
+  void StepObjectBehaviors(RuntimeObject& object,
+                           RuntimeScene& scene,
+                           Step step);
+
+  /**
+   * \brief Step the thread-safe behaviors kept by StepObjectBehaviors.
+   */
+  void StepThreadSafeBehaviors(RuntimeScene& scene, Step step);
+
+ private:
+  static void StepBehavior(RuntimeBehavior& behavior,
+                           RuntimeScene& scene,
+                           Step step);
+
+  /**
+   * \brief The thread-safe behaviors of each type, in the order in which they
+   * were found. Vectors are kept between steps to avoid allocations.
+   */
+  std::vector<std::pair<std::type_index, std::vector<RuntimeBehavior*>>>
+      threadSafeBehaviors;
+  bool deterministic;
+};
+
+#endif  // BEHAVIORSSTEPPER_H
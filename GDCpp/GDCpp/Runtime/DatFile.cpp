@@ -189,6 +189,27 @@ char* DatFile::GetFile(gd::String filename) {
   return (NULL);
 }
 
+bool DatFile::ReadFile(const gd::String& filename, std::vector<char>& buffer) {
+  for (std::size_t i = 0; i < m_header.nb_files; i++) {
+    if (gd::String(m_entries[i].name) == filename) {
+      gd::FileStream datfile;
+      datfile.open(m_datfile, std::ios_base::in | std::ios_base::binary);
+      if (!datfile.is_open()) {
+        cout << "Unable to open file " << m_datfile << " when loading "
+             << filename << endl;
+        return false;
+      }
+
+      buffer.resize(m_entries[i].size);
+      datfile.seekg(m_entries[i].offset, std::ios::beg);
+      datfile.read(buffer.data(), m_entries[i].size);
+      return true;
+    }
+  }
+
+  return false;
+}
+
 long int DatFile::GetFileSize(gd::String filename) {
   // First, we have to find the file needed
   for (std::size_t i = 0; i < m_header.nb_files; i++) {
@@ -57,6 +57,9 @@ class GD_API DatFile {
   bool ContainsFile(const gd::String& filename);
   bool Read(gd::String source);
   char* GetFile(gd::String filename);
+  /// Read a file in \a buffer instead of the buffer returned by GetFile, so
+  /// that it can be called from any thread.
+  bool ReadFile(const gd::String& filename, std::vector<char>& buffer);
   long int GetFileSize(gd::String filename);
 };
 
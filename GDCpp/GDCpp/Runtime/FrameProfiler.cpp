@@ -0,0 +1,240 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/FrameProfiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <ostream>
+
+namespace {
+/**
+ * The names of the sections, shared by all the profilers.
+ */
+struct SectionsNames {
+  SectionsNames() {
+    // Must be in the same order as FrameProfiler::BuiltinSection.
+    const char* builtinNames[] = {"Frame",
+                                  "Inputs",
+                                  "Behaviors (pre-events)",
+                                  "Sounds garbage collection",
+                                  "Events",
+                                  "Objects deletion",
+                                  "Forces",
+                                  "Objects update (post-events)",
+                                  "Rendering"};
+    for (const char* name : builtinNames) {
+      ids[name] = names.size();
+      names.push_back(name);
+    }
+  }
+
+  std::mutex mutex;
+  std::vector<gd::String> names;
+  std::map<gd::String, std::size_t> ids;
+};
+
+SectionsNames& GetSectionsNames() {
+  static SectionsNames sectionsNames;
+  return sectionsNames;
+}
+
+void WriteJSONString(std::ostream& stream, const gd::String& str) {
+  stream << '"';
+  for (char c : str.Raw()) {
+    if (c == '"' || c == '\\')
+      stream << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[7];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      stream << escaped;
+    } else
+      stream << c;
+  }
+  stream << '"';
+}
+}
+
+std::size_t FrameProfiler::GetSectionId(const gd::String& name) {
+  SectionsNames& sectionsNames = GetSectionsNames();
+  std::lock_guard<std::mutex> lock(sectionsNames.mutex);
+
+  auto it = sectionsNames.ids.find(name);
+  if (it != sectionsNames.ids.end()) return it->second;
+
+  sectionsNames.ids[name] = sectionsNames.names.size();
+  sectionsNames.names.push_back(name);
+  return sectionsNames.names.size() - 1;
+}
+
+gd::String FrameProfiler::GetSectionName(std::size_t sectionId) {
+  SectionsNames& sectionsNames = GetSectionsNames();
+  std::lock_guard<std::mutex> lock(sectionsNames.mutex);
+
+  return sectionId < sectionsNames.names.size()
+             ? sectionsNames.names[sectionId]
+             : gd::String();
+}
+
+FrameProfiler::FrameProfiler()
+    : enabled(false),
+      creationTime(std::chrono::steady_clock::now()),
+      traceCapacity(100000),
+      nextSample(0),
+      samplesCount(0),
+      frameStart(-1),
+      histogramFramesCount(600) {}
+
+void FrameProfiler::Enable(bool enable) {
+  enabled = enable;
+  if (enabled && samples.empty()) samples.resize(traceCapacity);
+}
+
+void FrameProfiler::Clear() {
+  nextSample = 0;
+  samplesCount = 0;
+  frameStart = -1;
+  for (std::size_t sectionId : frameSections) frameSectionsTimes[sectionId] = 0;
+  frameSections.clear();
+  histograms.clear();
+}
+
+void FrameProfiler::BeginFrame() {
+  if (!enabled) return;
+
+  frameStart = Now();
+}
+
+void FrameProfiler::EndFrame() {
+  if (!enabled) return;
+  if (frameStart >= 0) AddSample(FRAME, frameStart, Now());
+  frameStart = -1;
+
+  for (std::size_t sectionId : frameSections) {
+    if (histograms.size() <= sectionId) histograms.resize(sectionId + 1);
+    SectionHistogram& histogram = histograms[sectionId];
+    if (histogram.framesTimes.empty()) {
+      histogram.framesTimes.resize(histogramFramesCount);
+      histogram.bucketsCounts.resize(bucketsCount);
+    }
+
+    // Replace the oldest frame by the current one.
+    long long& frameTime = histogram.framesTimes[histogram.nextFrame];
+    if (histogram.framesCount == histogram.framesTimes.size())
+      histogram.bucketsCounts[GetBucket(frameTime)]--;
+    else
+      histogram.framesCount++;
+
+    frameTime = frameSectionsTimes[sectionId];
+    histogram.bucketsCounts[GetBucket(frameTime)]++;
+    histogram.nextFrame = (histogram.nextFrame + 1) % histogram.framesTimes.size();
+
+    frameSectionsTimes[sectionId] = 0;
+  }
+  frameSections.clear();
+}
+
+void FrameProfiler::SetTraceCapacity(std::size_t samplesCount_) {
+  traceCapacity = std::max<std::size_t>(samplesCount_, 1);
+  std::vector<Sample>().swap(samples);
+  if (enabled) samples.resize(traceCapacity);
+  nextSample = 0;
+  samplesCount = 0;
+}
+
+void FrameProfiler::ExportChromeTrace(std::ostream& stream) const {
+  stream << "{\"traceEvents\":[";
+
+  std::vector<gd::String> sectionsNames;
+  {
+    SectionsNames& allSectionsNames = GetSectionsNames();
+    std::lock_guard<std::mutex> lock(allSectionsNames.mutex);
+    sectionsNames = allSectionsNames.names;
+  }
+
+  std::size_t firstSample =
+      samples.empty()
+          ? 0
+          : (nextSample + samples.size() - samplesCount) % samples.size();
+  for (std::size_t i = 0; i < samplesCount; ++i) {
+    const Sample& sample = samples[(firstSample + i) % samples.size()];
+    if (i != 0) stream << ",";
+    stream << "\n{\"name\":";
+    WriteJSONString(stream,
+                    sample.sectionId < sectionsNames.size()
+                        ? sectionsNames[sample.sectionId]
+                        : gd::String());
+    stream << ",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":" << sample.start
+           << ",\"dur\":" << sample.duration << "}";
+  }
+
+  stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+bool FrameProfiler::SaveChromeTrace(const gd::String& filename) const {
+  std::ofstream file(filename.ToLocale().c_str());
+  if (!file.is_open()) return false;
+
+  ExportChromeTrace(file);
+  return file.good();
+}
+
+void FrameProfiler::SetHistogramFramesCount(std::size_t framesCount) {
+  histogramFramesCount = std::max<std::size_t>(framesCount, 1);
+  histograms.clear();
+}
+
+FrameProfiler::Histogram FrameProfiler::GetHistogram(
+    std::size_t sectionId) const {
+  Histogram result;
+  result.bucketsCounts.resize(bucketsCount, 0);
+  if (sectionId >= histograms.size()) return result;
+
+  const SectionHistogram& histogram = histograms[sectionId];
+  result.framesCount = histogram.framesCount;
+  if (!histogram.bucketsCounts.empty())
+    result.bucketsCounts = histogram.bucketsCounts;
+  for (std::size_t i = 0; i < histogram.framesCount; ++i) {
+    result.totalTime += histogram.framesTimes[i];
+    result.maxTime = std::max(result.maxTime, histogram.framesTimes[i]);
+  }
+
+  return result;
+}
+
+long long FrameProfiler::GetBucketMinTime(std::size_t bucket) {
+  return bucket == 0 ? 0 : 1LL << (bucket - 1);
+}
+
+void FrameProfiler::AddSample(std::size_t sectionId,
+                              long long start,
+                              long long end) {
+  if (!samples.empty()) {
+    Sample& sample = samples[nextSample];
+    sample.sectionId = sectionId;
+    sample.start = start;
+    sample.duration = end - start;
+    nextSample = (nextSample + 1) % samples.size();
+    samplesCount = std::min(samplesCount + 1, samples.size());
+  }
+
+  if (frameSectionsTimes.size() <= sectionId)
+    frameSectionsTimes.resize(sectionId + 1, 0);
+  if (frameSectionsTimes[sectionId] == 0 &&
+      std::find(frameSections.begin(), frameSections.end(), sectionId) ==
+          frameSections.end())
+    frameSections.push_back(sectionId);
+  frameSectionsTimes[sectionId] += end - start;
+}
+
+std::size_t FrameProfiler::GetBucket(long long time) {
+  std::size_t bucket = 0;
+  while (bucket + 1 < bucketsCount && time >= GetBucketMinTime(bucket + 1))
+    bucket++;
+
+  return bucket;
+}
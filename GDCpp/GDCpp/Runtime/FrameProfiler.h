@@ -0,0 +1,245 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+#include "GDCpp/Runtime/String.h"
+
+/**
+ * \brief Measure the time taken by each phase of the frames of a scene.
+ *
+ * Phases are measured with FrameProfiler::Scope, which only reads the clock
+ * when the profiler is enabled, so that scopes can be left in production
+ * builds. Each measure (a "sample") is:
+ * - kept in a ring buffer of the latest samples, which can be exported as a
+ *   Chrome trace (see ExportChromeTrace),
+ * - added to the time taken by its section during the frame. At the end of
+ *   the frame, this time is added to the histogram of the section, which
+ *   covers the latest frames (see GetHistogram).
+ *
+ * Sections are identified by an id returned by GetSectionId, shared by all
+ * the profilers.
+ *
+ * \note Scopes must only be used from the thread running the scene.
+ * \see RuntimeScene::GetFrameProfiler
+ * \ingroup GameEngine
+ */
+class GD_API FrameProfiler {
+ public:
+  /**
+   * \brief Measure the time spent in a section until destroyed.
+   */
+  class Scope {
+   public:
+    Scope(FrameProfiler& profiler_, std::size_t sectionId_)
+        : profiler(profiler_.IsEnabled() ? &profiler_ : nullptr),
+          sectionId(sectionId_),
+          start(profiler ? profiler->Now() : 0){};
+    ~Scope() {
+      if (profiler) profiler->AddSample(sectionId, start, profiler->Now());
+    };
+
+   private:
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    FrameProfiler* profiler;
+    std::size_t sectionId;
+    long long start;
+  };
+
+  /**
+   * \brief The time taken by a section during the latest frames.
+   */
+  struct Histogram {
+    Histogram() : framesCount(0), totalTime(0), maxTime(0){};
+
+    std::vector<std::size_t> bucketsCounts;  ///< The number of frames for
+                                             ///< each bucket (see
+                                             ///< GetBucketMinTime).
+    std::size_t framesCount;  ///< The number of frames where the section was
+                              ///< measured.
+    long long totalTime;      ///< Total time, in microseconds.
+    long long maxTime;        ///< Longest time, in microseconds.
+  };
+
+  /** \name Sections
+   */
+  ///@{
+  /**
+   * \brief The sections of the frames of a scene.
+   */
+  enum BuiltinSection {
+    FRAME = 0,
+    INPUTS,
+    BEHAVIORS_PRE_EVENTS,
+    SOUNDS_GARBAGE_COLLECTION,
+    EVENTS,
+    OBJECTS_DELETION,
+    FORCES,
+    OBJECTS_UPDATE,
+    RENDERING
+  };
+
+  /**
+   * \brief Return the id of the section with the specified name, adding the
+   * section if needed.
+   */
+  static std::size_t GetSectionId(const gd::String& name);
+
+  /**
+   * \brief Return the name of a section.
+   */
+  static gd::String GetSectionName(std::size_t sectionId);
+  ///@}
+
+  FrameProfiler();
+  virtual ~FrameProfiler(){};
+
+  /**
+   * \brief Enable or disable the profiler. Nothing is measured when disabled.
+   *
+   * The samples of the trace are allocated the first time the profiler is
+   * enabled.
+   */
+  void Enable(bool enable = true);
+
+  /**
+   * \brief Return true if the profiler is enabled.
+   */
+  bool IsEnabled() const { return enabled; }
+
+  /**
+   * \brief Remove all the samples and histograms.
+   */
+  void Clear();
+
+  /** \name Frames
+   */
+  ///@{
+  /**
+   * \brief Start measuring a frame.
+   */
+  void BeginFrame();
+
+  /**
+   * \brief Stop measuring a frame, and update the histograms with the time
+   * taken by each section during the frame.
+   */
+  void EndFrame();
+  ///@}
+
+  /** \name Trace
+   */
+  ///@{
+  /**
+   * \brief Change the number of samples kept for the trace (100000 by
+   * default). Existing samples are removed.
+   */
+  void SetTraceCapacity(std::size_t samplesCount);
+
+  /**
+   * \brief Return the number of samples currently kept for the trace.
+   */
+  std::size_t GetTraceSamplesCount() const { return samplesCount; }
+
+  /**
+   * \brief Write the samples as a Chrome trace (JSON trace event format), to
+   * be opened with chrome://tracing.
+   */
+  void ExportChromeTrace(std::ostream& stream) const;
+
+  /**
+   * \brief Write the samples as a Chrome trace to the specified file.
+   * \return true if the file was written.
+   */
+  bool SaveChromeTrace(const gd::String& filename) const;
+  ///@}
+
+  /** \name Histograms
+   */
+  ///@{
+  /**
+   * \brief Change the number of frames covered by the histograms (600 by
+   * default). Existing histograms are removed.
+   */
+  void SetHistogramFramesCount(std::size_t framesCount);
+
+  /**
+   * \brief Return the histogram of the time taken by a section during the
+   * latest frames.
+   */
+  Histogram GetHistogram(std::size_t sectionId) const;
+
+  /**
+   * \brief Return the minimum time, in microseconds, of the frames counted in
+   * a bucket of a histogram.
+   *
+   * Bucket 0 is for frames taking less than 1 microsecond, and each bucket
+   * after is for frames taking up to twice the time of the previous one.
+   */
+  static long long GetBucketMinTime(std::size_t bucket);
+
+  /**
+   * \brief Return the number of buckets of the histograms.
+   */
+  static std::size_t GetBucketsCount() { return bucketsCount; }
+  ///@}
+
+ private:
+  struct Sample {
+    std::size_t sectionId;
+    long long start;  ///< In microseconds, since the creation of the profiler.
+    long long duration;
+  };
+
+  /**
+   * \brief The time taken by a section during each of the latest frames.
+   */
+  struct SectionHistogram {
+    SectionHistogram() : nextFrame(0), framesCount(0){};
+
+    std::vector<long long> framesTimes;  ///< Ring buffer of the times.
+    std::size_t nextFrame;
+    std::size_t framesCount;
+    std::vector<std::size_t> bucketsCounts;
+  };
+
+  long long Now() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - creationTime)
+        .count();
+  }
+
+  void AddSample(std::size_t sectionId, long long start, long long end);
+  static std::size_t GetBucket(long long time);
+
+  bool enabled;
+  std::chrono::steady_clock::time_point creationTime;
+
+  std::vector<Sample> samples;  ///< Ring buffer of the latest samples, empty
+                                ///< until the profiler is enabled.
+  std::size_t traceCapacity;  ///< The size of the ring buffer.
+  std::size_t nextSample;
+  std::size_t samplesCount;
+
+  long long frameStart;
+  std::vector<long long> frameSectionsTimes;  ///< Time taken by each section
+                                              ///< during the current frame,
+                                              ///< indexed by section id.
+  std::vector<std::size_t> frameSections;  ///< The sections measured during
+                                           ///< the current frame.
+  std::vector<SectionHistogram> histograms;  ///< Indexed by section id.
+  std::size_t histogramFramesCount;
+
+  static const std::size_t bucketsCount = 24;
+};
+
+#endif  // FRAMEPROFILER_H
@@ -4,63 +4,201 @@
  * reserved. This project is released under the MIT License.
  */
 #include "GDCpp/Runtime/ObjInstancesHolder.h"
+#include <limits>
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/profile.h"
 
+const std::size_t ObjInstancesHolder::noRenderingLayer =
+    std::numeric_limits<std::size_t>::max();
+
 RuntimeObject* ObjInstancesHolder::AddObject(RuntimeObjSPtr&& object) {
-  auto it = objectsInstances[object->GetName()].insert(
-      objectsInstances[object->GetName()].end(), std::move(object));
-  objectsInstancesRefs[(*it)->GetName()].push_back(it->get());
+  std::size_t objectNameId = objectNames->GetId(object->GetName());
+  if (objectNameId >= objectsInstances.size()) ResizeLists(objectNameId + 1);
+
+  RuntimeObject* addedObject = object.get();
+  addedObject->objectNameId = objectNameId;
+  addedObject->objectIndex = objectsInstances[objectNameId].size();
+  objectsInstances[objectNameId].push_back(std::move(object));
+  objectsInstancesRefs[objectNameId].push_back(addedObject);
+
+  if (addedObject->instancesHolder != this) {
+    addedObject->instancesHolder = this;
+    transforms.Add(addedObject);
+    AddToRenderingList(addedObject);
+  }
 
-  return it->get();
+  return addedObject;
 }
 
 RuntimeObjNonOwningPtrList ObjInstancesHolder::GetObjectsRawPointers(
     const gd::String& name) {
-  return objectsInstancesRefs[name];
+  return GetObjectsRawPointers(objectNames->GetId(name));
+}
+
+RuntimeObjNonOwningPtrList ObjInstancesHolder::GetObjectsRawPointers(
+    std::size_t objectNameId) {
+  if (objectNameId >= objectsInstancesRefs.size())
+    return RuntimeObjNonOwningPtrList();
+
+  return objectsInstancesRefs[objectNameId];
 }
 
 void ObjInstancesHolder::ObjectNameHasChanged(const RuntimeObject* object) {
-  std::unique_ptr<RuntimeObject> theObject;  // We need the object to keep
-                                             // alive.
-
-  // Find and erase the object from the object lists.
-  for (auto it = objectsInstances.begin(); it != objectsInstances.end(); ++it) {
-    RuntimeObjList& list = it->second;
-    for (std::size_t i = 0; i < list.size(); ++i) {
-      if (list[i].get() == object) {
-        theObject = std::move(list[i]);
-        list.erase(list.begin() + i);
-        break;
-      }
-    }
+  if (object->instancesHolder != this) return;
+
+  // Keep the object alive while it is moved to the list of its new name.
+  AddObject(TakeObject(const_cast<RuntimeObject*>(object)));
+}
+
+void ObjInstancesHolder::SetObjectNamesTable(
+    std::shared_ptr<ObjectNamesTable> objectNames_) {
+  if (objectNames_ == objectNames) return;
+
+  // Identifiers are specific to a table: objects must be classified again.
+  std::vector<RuntimeObjList> oldObjectsInstances;
+  std::swap(oldObjectsInstances, objectsInstances);
+  objectsInstancesRefs.clear();
+  objectNames = objectNames_;
+
+  for (auto& list : oldObjectsInstances) {
+    for (auto& object : list) AddObject(std::move(object));
+  }
+}
+
+void ObjInstancesHolder::ResizeLists(std::size_t size) {
+  objectsInstances.resize(size);
+  objectsInstancesRefs.resize(size);
+}
+
+RuntimeObjSPtr ObjInstancesHolder::TakeObject(RuntimeObject* object) {
+  RuntimeObjList& list = objectsInstances[object->objectNameId];
+  RuntimeObjNonOwningPtrList& refsList =
+      objectsInstancesRefs[object->objectNameId];
+
+  // Replace the object by the last one of the list rather than erasing it,
+  // so that removing an object does not move all the objects after it.
+  std::size_t index = object->objectIndex;
+  RuntimeObjSPtr theObject = std::move(list[index]);
+  if (index != list.size() - 1) {
+    list[index] = std::move(list.back());
+    refsList[index] = refsList.back();
+    list[index]->objectIndex = index;
+  }
+  list.pop_back();
+  refsList.pop_back();
+
+  return theObject;
+}
+
+void ObjInstancesHolder::SetRenderingLayers(
+    const std::vector<gd::String>& layersNames) {
+  renderingLayersNames = layersNames;
+  renderingLists.clear();
+  renderingLists.resize(renderingLayersNames.size());
+
+  for (auto& list : objectsInstances) {
+    for (auto& object : list) AddToRenderingList(object.get());
   }
-  // Find and erase the object from the object raw pointers lists.
-  for (auto it = objectsInstancesRefs.begin(); it != objectsInstancesRefs.end();
-       ++it) {
-    RuntimeObjNonOwningPtrList& associatedList = it->second;
-    associatedList.erase(
-        std::remove(associatedList.begin(), associatedList.end(), object),
-        associatedList.end());
+}
+
+const RuntimeObjNonOwningPtrList& ObjInstancesHolder::GetObjectsToRender(
+    std::size_t layerIndex, bool stableSort) {
+  RenderingList& renderingList = renderingLists[layerIndex];
+  RuntimeObjNonOwningPtrList& objects = renderingList.objects;
+  if (renderingList.removedCount > 0) CompactRenderingList(renderingList);
+  if (!renderingList.needsSorting) return objects;
+
+  auto compareZOrder = [](const RuntimeObject* o1, const RuntimeObject* o2) {
+    return o1->GetZOrder() < o2->GetZOrder();
+  };
+  if (stableSort)
+    std::stable_sort(objects.begin(), objects.end(), compareZOrder);
+  else
+    std::sort(objects.begin(), objects.end(), compareZOrder);
+
+  for (std::size_t i = 0; i < objects.size(); ++i)
+    objects[i]->renderingIndex = i;
+
+  renderingList.needsSorting = false;
+  return objects;
+}
+
+void ObjInstancesHolder::ObjectLayerHasChanged(RuntimeObject* object) {
+  RemoveFromRenderingList(object);
+  AddToRenderingList(object);
+}
+
+void ObjInstancesHolder::ObjectZOrderHasChanged(RuntimeObject* object) {
+  if (object->instancesHolder != this ||
+      object->renderingLayerIndex == noRenderingLayer)
+    return;
+
+  renderingLists[object->renderingLayerIndex].needsSorting = true;
+}
+
+void ObjInstancesHolder::AddToRenderingList(RuntimeObject* object) {
+  object->renderingLayerIndex = noRenderingLayer;
+  for (std::size_t i = 0; i < renderingLayersNames.size(); ++i) {
+    if (renderingLayersNames[i] == object->GetLayer()) {
+      object->renderingLayerIndex = i;
+      break;
+    }
   }
+  transforms.SetLayerIndex(object->transformIndex, object->renderingLayerIndex);
+  if (object->renderingLayerIndex == noRenderingLayer) return;
+
+  RenderingList& renderingList = renderingLists[object->renderingLayerIndex];
+  object->renderingIndex = renderingList.objects.size();
+  renderingList.objects.push_back(object);
+  renderingList.needsSorting = true;
+}
+
+void ObjInstancesHolder::RemoveFromRenderingList(RuntimeObject* object) {
+  if (object->instancesHolder != this ||
+      object->renderingLayerIndex == noRenderingLayer)
+    return;
+
+  // Don't erase the object now, to avoid moving all the objects after it:
+  // the list will be compacted before being rendered, or as soon as half of
+  // it is made of removed objects (so that lists of layers that are never
+  // rendered don't grow forever).
+  RenderingList& renderingList = renderingLists[object->renderingLayerIndex];
+  renderingList.objects[object->renderingIndex] = nullptr;
+  renderingList.removedCount++;
+  object->renderingLayerIndex = noRenderingLayer;
+  transforms.SetLayerIndex(object->transformIndex, noRenderingLayer);
+
+  if (renderingList.removedCount * 2 > renderingList.objects.size())
+    CompactRenderingList(renderingList);
+}
+
+void ObjInstancesHolder::CompactRenderingList(RenderingList& renderingList) {
+  // The order of the objects is kept, so the list stays sorted.
+  RuntimeObjNonOwningPtrList& objects = renderingList.objects;
+  objects.erase(std::remove(objects.begin(), objects.end(), nullptr),
+                objects.end());
+  for (std::size_t i = 0; i < objects.size(); ++i)
+    objects[i]->renderingIndex = i;
 
-  AddObject(std::move(theObject));
+  renderingList.removedCount = 0;
 }
 
 void ObjInstancesHolder::Init(const ObjInstancesHolder& other) {
+  transforms.Clear();
   objectsInstances.clear();
   objectsInstancesRefs.clear();
+  objectNames = other.objectNames;
+  SetRenderingLayers(other.renderingLayersNames);
 
-  for (auto it = other.objectsInstances.cbegin();
-       it != other.objectsInstances.cend();
-       ++it) {
-    for (std::size_t i = 0; i < it->second.size();
+  for (auto& list : other.objectsInstances) {
+    for (std::size_t i = 0; i < list.size();
          ++i)  // We need to really copy the objects
-      AddObject(std::unique_ptr<RuntimeObject>(it->second[i]->Clone()));
+      AddObject(std::unique_ptr<RuntimeObject>(list[i]->Clone()));
   }
 }
 
-ObjInstancesHolder::ObjInstancesHolder(const ObjInstancesHolder& other) {
+ObjInstancesHolder::ObjInstancesHolder(const ObjInstancesHolder& other)
+    : objectNames(other.objectNames) {
   Init(other);
 }
 
@@ -5,8 +5,9 @@
 #include <map>
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <vector>
+#include "GDCpp/Runtime/ObjectNamesTable.h"
+#include "GDCpp/Runtime/ObjectsTransforms.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/String.h"
 
@@ -20,6 +21,13 @@ using RuntimeObjSPtr = std::unique_ptr<RuntimeObject>;
 /**
  * \brief Contains lists of objects classified by the name of the objects.
  *
+ * Lists are stored in vectors indexed by the identifiers given to the names
+ * by an ObjectNamesTable, which is shared with the game when the container is
+ * used by a RuntimeScene.
+ *
+ * The position, Z order and forces of the objects are kept in an
+ * ObjectsTransforms owned by the container.
+ *
  * \see RuntimeScene
  * \ingroup GameEngine
  */
@@ -28,7 +36,7 @@ class GD_API ObjInstancesHolder {
   /**
    * \brief Default constructor
    */
-  ObjInstancesHolder(){};
+  ObjInstancesHolder() : objectNames(std::make_shared<ObjectNamesTable>()){};
 
   /**
    * \brief Copy constructor
@@ -57,7 +65,18 @@ class GD_API ObjInstancesHolder {
    * \brief Get all objects with the specified name
    */
   inline const RuntimeObjList& GetObjects(const gd::String& name) {
-    return objectsInstances[name];
+    return GetObjects(objectNames->GetId(name));
+  }
+
+  /**
+   * \brief Get all objects with the name having the specified identifier in
+   * the table returned by GetObjectNamesTable.
+   */
+  inline const RuntimeObjList& GetObjects(std::size_t objectNameId) {
+    if (objectNameId >= objectsInstances.size())
+      ResizeLists(objectNameId + 1);
+
+    return objectsInstances[objectNameId];
   }
 
   /**
@@ -65,60 +84,114 @@ class GD_API ObjInstancesHolder {
    */
   RuntimeObjNonOwningPtrList GetObjectsRawPointers(const gd::String& name);
 
+  /**
+   * \brief Get a "raw pointers" list to objects with the name having the
+   * specified identifier in the table returned by GetObjectNamesTable.
+   */
+  RuntimeObjNonOwningPtrList GetObjectsRawPointers(std::size_t objectNameId);
+
   /**
    * \brief Get a list of all objects contained.
    */
   inline RuntimeObjNonOwningPtrList GetAllObjects() {
     RuntimeObjNonOwningPtrList objList;
 
-    for (auto it = objectsInstances.begin(); it != objectsInstances.end();
-         ++it) {
-      for (auto it2 = it->second.begin(); it2 != it->second.end(); ++it2) {
-        objList.push_back(it2->get());
+    for (auto& list : objectsInstances) {
+      for (auto it = list.begin(); it != list.end(); ++it) {
+        objList.push_back(it->get());
       }
     }
 
     return objList;
   }
 
+  /**
+   * \brief Return the table giving the identifiers of the names of objects.
+   */
+  ObjectNamesTable& GetObjectNamesTable() { return *objectNames; }
+
+  /**
+   * \brief Change the table giving the identifiers of the names of objects.
+   *
+   * Used by RuntimeScene so that all scenes of a game share the same
+   * identifiers. Objects already in the container are kept.
+   */
+  void SetObjectNamesTable(std::shared_ptr<ObjectNamesTable> objectNames);
+
   /**
    * \brief Remove an object
    *
+   * The object is replaced in its list by the last object of the list, so
+   * that removing an object is done in constant time.
+   *
+   * \return The removed object, which is destroyed if the result is not kept.
+   *
    * \warning During the game, do not directly remove an object using this
    * function, but make its name empty instead. Example: \code
    * myObject->SetName(""); //The scene will take care of deleting the object
    * scene.objectsInstances.ObjectNameHasChanged(myObject);
    * \endcode
    */
-  inline void RemoveObject(RuntimeObject* object) {
-    for (auto it = objectsInstances.begin(); it != objectsInstances.end();
-         ++it) {
-      RuntimeObjList& associatedList = it->second;
-      associatedList.erase(
-          std::remove_if(
-              associatedList.begin(),
-              associatedList.end(),
-              [&object](const std::unique_ptr<RuntimeObject>& objectPtr) {
-                return objectPtr.get() == object;
-              }),
-          associatedList.end());
-    }
-    for (auto it = objectsInstancesRefs.begin();
-         it != objectsInstancesRefs.end();
-         ++it) {
-      RuntimeObjNonOwningPtrList& associatedList = it->second;
-      associatedList.erase(
-          std::remove(associatedList.begin(), associatedList.end(), object),
-          associatedList.end());
-    }
+  inline RuntimeObjSPtr RemoveObject(RuntimeObject* object) {
+    if (object->instancesHolder != this) return nullptr;
+
+    RemoveFromRenderingList(object);
+    transforms.Remove(object);
+    object->instancesHolder = nullptr;
+    return TakeObject(object);
   }
 
   /**
    * \brief Remove an entire list of object with a given name
    */
   inline void RemoveObjects(const gd::String& name) {
-    objectsInstances[name].clear();
-    objectsInstancesRefs[name].clear();
+    std::size_t objectNameId = objectNames->GetId(name);
+    if (objectNameId >= objectsInstances.size()) return;
+
+    for (auto& object : objectsInstances[objectNameId]) {
+      RemoveFromRenderingList(object.get());
+      transforms.Remove(object.get());
+    }
+
+    objectsInstances[objectNameId].clear();
+    objectsInstancesRefs[objectNameId].clear();
+  }
+
+  /**
+   * \brief Remove all the objects for which \a predicate returns true.
+   *
+   * Each list is compacted in a single pass, keeping the order of the
+   * remaining objects.
+   *
+   * \param predicate A function taking a RuntimeObject* and returning true if
+   * the object must be removed.
+   */
+  template <typename Predicate>
+  void RemoveObjectsIf(Predicate predicate) {
+    for (std::size_t id = 0; id < objectsInstances.size(); ++id) {
+      RuntimeObjList& list = objectsInstances[id];
+      RuntimeObjNonOwningPtrList& refsList = objectsInstancesRefs[id];
+
+      std::size_t keptCount = 0;
+      for (std::size_t i = 0; i < list.size(); ++i) {
+        RuntimeObject* object = list[i].get();
+        if (predicate(object)) {
+          RemoveFromRenderingList(object);
+          transforms.Remove(object);
+          continue;
+        }
+
+        if (keptCount != i) {
+          list[keptCount] = std::move(list[i]);  // Can destroy a removed object.
+          refsList[keptCount] = object;
+        }
+        object->objectIndex = keptCount;
+        keptCount++;
+      }
+
+      list.resize(keptCount);
+      refsList.resize(keptCount);
+    }
   }
 
   /**
@@ -131,18 +204,90 @@ class GD_API ObjInstancesHolder {
    * \note All objects contained inside are destroyed.
    */
   inline void Clear() {
+    for (auto& renderingList : renderingLists) renderingList = RenderingList();
+    transforms.Clear();
     objectsInstances.clear();
     objectsInstancesRefs.clear();
   }
 
+  /** \name Rendering
+   * Members functions keeping the objects sorted by layer and Z order, so that
+   * they can be rendered without sorting all the objects at each frame.
+   */
+  ///@{
+  /**
+   * \brief Set the layers for which objects are kept sorted.
+   *
+   * Objects on a layer that is not in the list are not rendered.
+   */
+  void SetRenderingLayers(const std::vector<gd::String>& layersNames);
+
+  /**
+   * \brief Get the objects of a layer, sorted by Z order.
+   *
+   * \param layerIndex The index of the layer in the list given to
+   * SetRenderingLayers. \param stableSort If true, objects having the same Z
+   * order keep the order in which they were added.
+   *
+   * \note The list is only sorted again if an object was added or had its
+   * Z order or layer changed since the last call.
+   */
+  const RuntimeObjNonOwningPtrList& GetObjectsToRender(std::size_t layerIndex,
+                                                       bool stableSort = true);
+
+  /**
+   * \brief To be called when an object has changed its layer.
+   * \note Automatically called by RuntimeObject::SetLayer.
+   */
+  void ObjectLayerHasChanged(RuntimeObject* object);
+
+  /**
+   * \brief To be called when an object has changed its Z order.
+   * \note Automatically called by RuntimeObject::SetZOrder.
+   */
+  void ObjectZOrderHasChanged(RuntimeObject* object);
+  ///@}
+
+  /**
+   * \brief Return the store containing the position, Z order and forces of
+   * the objects.
+   */
+  ObjectsTransforms& GetTransforms() { return transforms; }
+
  private:
+  struct RenderingList {
+    RenderingList() : needsSorting(false), removedCount(0){};
+
+    RuntimeObjNonOwningPtrList objects;  ///< The objects of the layer. Removed
+                                         ///< objects are set to NULL until the
+                                         ///< list is compacted.
+    bool needsSorting;         ///< True if objects must be sorted by Z order.
+    std::size_t removedCount;  ///< The number of NULL objects in the list.
+  };
+
   void Init(const ObjInstancesHolder& other);
+  void ResizeLists(std::size_t size);
+  RuntimeObjSPtr TakeObject(RuntimeObject* object);
+  void AddToRenderingList(RuntimeObject* object);
+  void RemoveFromRenderingList(RuntimeObject* object);
+  static void CompactRenderingList(RenderingList& renderingList);
 
-  std::unordered_map<gd::String, RuntimeObjList>
-      objectsInstances;  ///< The list of all objects, classified by name
-  std::unordered_map<gd::String, RuntimeObjNonOwningPtrList>
+  std::shared_ptr<ObjectNamesTable>
+      objectNames;  ///< The identifiers of the names of objects.
+  std::vector<RuntimeObjList>
+      objectsInstances;  ///< The list of all objects, indexed by the
+                         ///< identifier of their name.
+  std::vector<RuntimeObjNonOwningPtrList>
       objectsInstancesRefs;  ///< Clones of the objectsInstances lists, but with
                              ///< references instead.
+  std::vector<gd::String>
+      renderingLayersNames;  ///< The layers, see SetRenderingLayers.
+  std::vector<RenderingList>
+      renderingLists;  ///< The objects of each layer, sorted by Z order.
+  ObjectsTransforms transforms;  ///< The position, Z order and forces of the
+                                 ///< objects.
+
+  static const std::size_t noRenderingLayer;
 };
 
 #endif  // OBJINSTANCESHOLDER_H
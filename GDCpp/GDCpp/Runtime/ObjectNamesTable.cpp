@@ -0,0 +1,20 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/ObjectNamesTable.h"
+
+std::size_t ObjectNamesTable::nextSerialNumber = 1;
+
+ObjectNamesTable::ObjectNamesTable() : serialNumber(nextSerialNumber++) {}
+
+std::size_t ObjectNamesTable::GetId(const gd::String& name) {
+  auto it = ids.find(name);
+  if (it != ids.end()) return it->second;
+
+  std::size_t id = names.size();
+  names.push_back(name);
+  ids[name] = id;
+  return id;
+}
@@ -0,0 +1,99 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef OBJECTNAMESTABLE_H
+#define OBJECTNAMESTABLE_H
+
+#include <unordered_map>
+#include <vector>
+#include "GDCpp/Runtime/String.h"
+
+/**
+ * \brief Associate a dense identifier to each name of object used in a game.
+ *
+ * Identifiers start from 0 and are never removed, so that they can be used
+ * as indices in flat vectors (see ObjInstancesHolder) instead of hashing the
+ * names of objects each time a list of objects is needed.
+ *
+ * \see ObjectNameId
+ * \ingroup GameEngine
+ */
+class GD_API ObjectNamesTable {
+ public:
+  ObjectNamesTable();
+  virtual ~ObjectNamesTable(){};
+
+  /**
+   * \brief Return the identifier of the specified name, adding it to the table
+   * if it was not already known.
+   */
+  std::size_t GetId(const gd::String& name);
+
+  /**
+   * \brief Return the name associated to an identifier.
+   */
+  const gd::String& GetName(std::size_t id) const { return names[id]; }
+
+  /**
+   * \brief Return the number of names in the table, which is also the first
+   * identifier which is not used.
+   */
+  std::size_t GetCount() const { return names.size(); }
+
+  /**
+   * \brief Return a number identifying this table among all the tables
+   * created during the execution, so that identifiers cached for a table are
+   * not used with another one.
+   */
+  std::size_t GetSerialNumber() const { return serialNumber; }
+
+ private:
+  std::unordered_map<gd::String, std::size_t> ids;  ///< Names to identifiers.
+  std::vector<gd::String> names;  ///< Names, indexed by their identifier.
+  std::size_t serialNumber;
+
+  static std::size_t nextSerialNumber;
+};
+
+/**
+ * \brief Cache the identifier of an object name.
+ *
+ * Used by events generated code: each object name used by events is declared
+ * once as a static ObjectNameId, so that the name is only resolved the first
+ * time it is used for a game.
+ *
+ * \see RuntimeContext::GetObjectsRawPointers
+ * \ingroup GameEngine
+ */
+class GD_API ObjectNameId {
+ public:
+  ObjectNameId(const gd::String& name_)
+      : name(name_), id(0), tableSerialNumber(0){};
+
+  /**
+   * \brief Return the identifier of the name in the specified table.
+   */
+  std::size_t Get(ObjectNamesTable& table) {
+    if (tableSerialNumber != table.GetSerialNumber()) {
+      id = table.GetId(name);
+      tableSerialNumber = table.GetSerialNumber();
+    }
+
+    return id;
+  }
+
+  /**
+   * \brief Return the name of the object.
+   */
+  const gd::String& GetName() const { return name; }
+
+ private:
+  gd::String name;
+  std::size_t id;
+  std::size_t tableSerialNumber;  ///< The table for which id was computed, or
+                                  ///< 0 if not computed yet.
+};
+
+#endif  // OBJECTNAMESTABLE_H
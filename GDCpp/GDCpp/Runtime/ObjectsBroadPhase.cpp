@@ -0,0 +1,121 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/ObjectsBroadPhase.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "GDCpp/Runtime/RuntimeObject.h"
+
+const std::size_t ObjectsBroadPhase::maxCellsPerEntry = 16;
+
+void ObjectsBroadPhase::Clear() {
+  entries.clear();
+  cells.clear();
+  largeEntries.clear();
+}
+
+void ObjectsBroadPhase::Insert(RuntimeObject* object,
+                               RuntimeObject* const* slot,
+                               std::size_t listIndex,
+                               std::size_t objectIndex) {
+  Entry entry;
+  entry.bounds = GetBoundsOf(object);
+  entry.slot = slot;
+  entry.listIndex = listIndex;
+  entry.objectIndex = objectIndex;
+  entry.stamp = 0;
+  entries.push_back(entry);
+}
+
+void ObjectsBroadPhase::Build() {
+  stamp = 0;
+  cells.clear();
+  largeEntries.clear();
+
+  // Use the average size of the objects as the size of the cells,
+  // so that most objects are only covering a few cells.
+  double totalSize = 0;
+  std::size_t finiteCount = 0;
+  for (const Entry& entry : entries) {
+    if (!entry.bounds.finite) continue;
+    totalSize += std::max(entry.bounds.maxX - entry.bounds.minX,
+                          entry.bounds.maxY - entry.bounds.minY);
+    finiteCount++;
+  }
+  cellSize = finiteCount != 0
+                 ? std::max(static_cast<float>(totalSize / finiteCount), 1.0f)
+                 : 1.0f;
+
+  for (std::size_t i = 0; i < entries.size(); ++i) {
+    const Entry& entry = entries[i];
+
+    CellRange range;
+    if (!entry.bounds.finite || !GetCellRange(entry.bounds, range) ||
+        range.GetCellsCount() > maxCellsPerEntry) {
+      largeEntries.push_back(i);
+      continue;
+    }
+
+    for (std::int64_t y = range.minY; y <= range.maxY; ++y) {
+      for (std::int64_t x = range.minX; x <= range.maxX; ++x) {
+        Cell cell;
+        cell.key = MakeCellKey(x, y);
+        cell.entryIndex = i;
+        cells.push_back(cell);
+      }
+    }
+  }
+
+  std::sort(cells.begin(), cells.end());
+}
+
+ObjectsBroadPhase::Bounds ObjectsBroadPhase::GetBoundsOf(
+    RuntimeObject* object) {
+  // Same bounding circle as RuntimeObject::IsCollidingWith. The square is
+  // slightly enlarged so that rounding errors can't discard a pair that the
+  // bounding circle test would accept.
+  float width = object->GetWidth();
+  float height = object->GetHeight();
+  float centerX = object->GetDrawableX() + object->GetCenterX();
+  float centerY = object->GetDrawableY() + object->GetCenterY();
+  float radius = sqrt(width * width + height * height) / 2.0;
+  float margin = 1.0f + (std::abs(centerX) + std::abs(centerY) + radius) *
+                            std::numeric_limits<float>::epsilon() * 4;
+
+  Bounds bounds;
+  bounds.minX = centerX - radius - margin;
+  bounds.minY = centerY - radius - margin;
+  bounds.maxX = centerX + radius + margin;
+  bounds.maxY = centerY + radius + margin;
+  bounds.finite = std::isfinite(bounds.minX) && std::isfinite(bounds.minY) &&
+                  std::isfinite(bounds.maxX) && std::isfinite(bounds.maxY);
+  return bounds;
+}
+
+bool ObjectsBroadPhase::GetCellRange(const Bounds& bounds,
+                                     CellRange& range) const {
+  const double limit = std::numeric_limits<std::int32_t>::max() / 2;
+  double minX = std::floor(bounds.minX / cellSize);
+  double minY = std::floor(bounds.minY / cellSize);
+  double maxX = std::floor(bounds.maxX / cellSize);
+  double maxY = std::floor(bounds.maxY / cellSize);
+  if (minX < -limit || minY < -limit || maxX > limit || maxY > limit)
+    return false;
+
+  range.minX = static_cast<std::int64_t>(minX);
+  range.minY = static_cast<std::int64_t>(minY);
+  range.maxX = static_cast<std::int64_t>(maxX);
+  range.maxY = static_cast<std::int64_t>(maxY);
+  return true;
+}
+
+std::size_t ObjectsBroadPhase::LowerBound(std::uint64_t key) const {
+  Cell searched;
+  searched.key = key;
+  searched.entryIndex = 0;
+  return std::lower_bound(cells.begin(), cells.end(), searched) -
+         cells.begin();
+}
@@ -0,0 +1,175 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef OBJECTSBROADPHASE_H
+#define OBJECTSBROADPHASE_H
+
+#include <cstdint>
+#include <vector>
+#include "GDCpp/Runtime/String.h"
+class RuntimeObject;
+
+/**
+ * \brief A uniform grid used to quickly find the objects that could be
+ * colliding with another object.
+ *
+ * Objects are inserted using the square containing their bounding circle (the
+ * same circle as the one used by RuntimeObject::IsCollidingWith to discard
+ * objects that are too far), so that the candidates returned for an object are
+ * a superset of the objects which could be colliding with it.
+ *
+ * The grid is owned by the RuntimeScene and its storage is reused between each
+ * use, so that filling it does not allocate memory once the scene is running.
+ *
+ * \see TwoObjectListsTestWithBroadPhase
+ * \ingroup GameEngine
+ */
+class GD_API ObjectsBroadPhase {
+ public:
+  ObjectsBroadPhase() : cellSize(1), stamp(0){};
+  virtual ~ObjectsBroadPhase(){};
+
+  /**
+   * \brief Remove all the objects from the grid. Memory is kept to be reused.
+   */
+  void Clear();
+
+  /**
+   * \brief Add an object in the grid.
+   *
+   * \param object The object to add.
+   * \param slot The address of the object in its list (used to recognize the
+   * same object in the two lists of TwoObjectListsTestWithBroadPhase).
+   * \param listIndex A number identifying the list containing the object.
+   * \param objectIndex The index of the object in its list.
+   *
+   * \note Build() must be called after all objects are inserted, before
+   * querying candidates.
+   */
+  void Insert(RuntimeObject* object,
+              RuntimeObject* const* slot,
+              std::size_t listIndex,
+              std::size_t objectIndex);
+
+  /**
+   * \brief Compute the size of the cells and sort the objects in them.
+   */
+  void Build();
+
+  /**
+   * \brief Call \a func for each inserted object which bounding circle could
+   * overlap the bounding circle of \a object.
+   *
+   * \a func is called at most once per inserted object, with the slot, list
+   * index and object index given to Insert.
+   */
+  template <typename Func>
+  void ForEachCandidate(RuntimeObject* object, Func func) {
+    stamp++;
+    Bounds bounds = GetBoundsOf(object);
+
+    for (std::size_t index : largeEntries) {
+      Entry& entry = entries[index];
+      if (entry.stamp == stamp) continue;
+      entry.stamp = stamp;
+      func(entry.slot, entry.listIndex, entry.objectIndex);
+    }
+
+    CellRange range;
+    if (!bounds.finite || !GetCellRange(bounds, range) ||
+        range.GetCellsCount() > entries.size()) {
+      // The query covers too many cells (or its position is not a number):
+      // just test every entry.
+      for (Entry& entry : entries) {
+        if (entry.stamp == stamp ||
+            (bounds.finite && !Overlap(entry.bounds, bounds)))
+          continue;
+        entry.stamp = stamp;
+        func(entry.slot, entry.listIndex, entry.objectIndex);
+      }
+      return;
+    }
+
+    for (std::int64_t y = range.minY; y <= range.maxY; ++y) {
+      for (std::int64_t x = range.minX; x <= range.maxX; ++x) {
+        std::size_t first = LowerBound(MakeCellKey(x, y));
+        for (std::size_t i = first;
+             i < cells.size() && cells[i].key == MakeCellKey(x, y);
+             ++i) {
+          Entry& entry = entries[cells[i].entryIndex];
+          if (entry.stamp == stamp || !Overlap(entry.bounds, bounds)) continue;
+          entry.stamp = stamp;
+          func(entry.slot, entry.listIndex, entry.objectIndex);
+        }
+      }
+    }
+  }
+
+  /**
+   * \brief Return the number of objects inserted in the grid.
+   */
+  std::size_t GetObjectsCount() const { return entries.size(); }
+
+ private:
+  struct Bounds {
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+    bool finite;
+  };
+
+  struct CellRange {
+    std::int64_t minX;
+    std::int64_t minY;
+    std::int64_t maxX;
+    std::int64_t maxY;
+
+    std::size_t GetCellsCount() const {
+      return static_cast<std::size_t>((maxX - minX + 1) * (maxY - minY + 1));
+    }
+  };
+
+  struct Entry {
+    Bounds bounds;
+    RuntimeObject* const* slot;
+    std::size_t listIndex;
+    std::size_t objectIndex;
+    std::size_t stamp;
+  };
+
+  struct Cell {
+    std::uint64_t key;
+    std::size_t entryIndex;
+
+    bool operator<(const Cell& other) const {
+      return key < other.key ||
+             (key == other.key && entryIndex < other.entryIndex);
+    }
+  };
+
+  static Bounds GetBoundsOf(RuntimeObject* object);
+  static bool Overlap(const Bounds& a, const Bounds& b) {
+    return a.minX <= b.maxX && b.minX <= a.maxX && a.minY <= b.maxY &&
+           b.minY <= a.maxY;
+  }
+  static std::uint64_t MakeCellKey(std::int64_t x, std::int64_t y) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+           static_cast<std::uint64_t>(static_cast<std::uint32_t>(y));
+  }
+  bool GetCellRange(const Bounds& bounds, CellRange& range) const;
+  std::size_t LowerBound(std::uint64_t key) const;
+
+  std::vector<Entry> entries;  ///< All the inserted objects.
+  std::vector<Cell> cells;  ///< The cells covered by each entry, sorted by key.
+  std::vector<std::size_t>
+      largeEntries;  ///< Entries covering too many cells to be put in the grid.
+  float cellSize;    ///< The size of a cell, computed in Build().
+  std::size_t stamp;  ///< Incremented for each query to avoid duplicates.
+
+  static const std::size_t maxCellsPerEntry;
+};
+
+#endif  // OBJECTSBROADPHASE_H
@@ -0,0 +1,11 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/ObjectsPickingMarks.h"
+
+ObjectsPickingMarks& ObjectsPickingMarks::Get() {
+  static thread_local ObjectsPickingMarks marks;
+  return marks;
+}
@@ -0,0 +1,122 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef OBJECTSPICKINGMARKS_H
+#define OBJECTSPICKINGMARKS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * \brief Scratch memory used to mark the objects picked by a condition.
+ *
+ * Marks are stored as bits in a single vector of words, allocated like a
+ * stack: a Scope gives back all the bits allocated after its creation when it
+ * is destroyed. The memory is kept between conditions, so that marking objects
+ * does not allocate memory once the game is running.
+ *
+ * Bitsets are referenced by the index of their first word rather than by a
+ * pointer, as allocating a new bitset can move the existing ones. This first
+ * word stores the size of the bitset, so that bitsets allocated one after the
+ * other can be iterated with GetNext.
+ *
+ * \see PickObjectsIf
+ * \see TwoObjectListsTest
+ * \ingroup GameEngine
+ */
+class GD_API ObjectsPickingMarks {
+ public:
+  /**
+   * \brief Release all the bitsets allocated during its lifetime when
+   * destroyed.
+   */
+  class Scope {
+   public:
+    Scope(ObjectsPickingMarks& marks_)
+        : marks(marks_), usedWordsCount(marks_.usedWordsCount){};
+    ~Scope() { marks.usedWordsCount = usedWordsCount; };
+
+   private:
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    ObjectsPickingMarks& marks;
+    std::size_t usedWordsCount;
+  };
+
+  ObjectsPickingMarks() : usedWordsCount(0){};
+  virtual ~ObjectsPickingMarks(){};
+
+  /**
+   * \brief Allocate a bitset of \a bitsCount bits, all set to false.
+   * \return The index of the bitset, to be given to the other methods.
+   */
+  std::size_t Allocate(std::size_t bitsCount) {
+    std::size_t bitset = usedWordsCount;
+    usedWordsCount += 1 + GetWordsCount(bitsCount);
+    if (words.size() < usedWordsCount) words.resize(usedWordsCount);
+    words[bitset] = bitsCount;
+    std::fill(words.begin() + bitset + 1, words.begin() + usedWordsCount, 0);
+
+    return bitset;
+  }
+
+  /**
+   * \brief Return the number of bits of a bitset.
+   */
+  std::size_t GetSize(std::size_t bitset) const {
+    return static_cast<std::size_t>(words[bitset]);
+  }
+
+  /**
+   * \brief Return the bitset allocated just after \a bitset.
+   */
+  std::size_t GetNext(std::size_t bitset) const {
+    return bitset + 1 + GetWordsCount(GetSize(bitset));
+  }
+
+  /**
+   * \brief Return true if the bit \a index of the bitset is set.
+   */
+  bool IsMarked(std::size_t bitset, std::size_t index) const {
+    return (words[bitset + 1 + index / wordBitsCount] >>
+            (index % wordBitsCount)) &
+           1;
+  }
+
+  /**
+   * \brief Set the bit \a index of the bitset.
+   */
+  void Mark(std::size_t bitset, std::size_t index) {
+    words[bitset + 1 + index / wordBitsCount] |= std::uint64_t(1)
+                                                 << (index % wordBitsCount);
+  }
+
+  /**
+   * \brief Return the number of words currently allocated (mainly for tests).
+   */
+  std::size_t GetUsedWordsCount() const { return usedWordsCount; }
+
+  /**
+   * \brief Return the marks used by the events run by the calling thread.
+   *
+   * \note Each thread has its own marks, so that scenes can run their events
+   * in different threads.
+   */
+  static ObjectsPickingMarks& Get();
+
+ private:
+  static std::size_t GetWordsCount(std::size_t bitsCount) {
+    return (bitsCount + wordBitsCount - 1) / wordBitsCount;
+  }
+
+  std::vector<std::uint64_t> words;  ///< All the bitsets.
+  std::size_t usedWordsCount;  ///< The number of words currently allocated.
+
+  static const std::size_t wordBitsCount = 64;
+};
+
+#endif  // OBJECTSPICKINGMARKS_H
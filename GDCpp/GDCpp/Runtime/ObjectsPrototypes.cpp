@@ -0,0 +1,88 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/ObjectsPrototypes.h"
+#include "GDCpp/Extensions/CppPlatform.h"
+#include "GDCpp/Runtime/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+
+#undef GetObject  // Disable an annoying macro
+
+ObjectsPrototypes::ObjectsPrototypes()
+    : poolingEnabled(false), maxPooledObjectsCount(1000) {}
+
+ObjectsPrototypes::~ObjectsPrototypes() {}
+
+std::unique_ptr<RuntimeObject> ObjectsPrototypes::CreateObject(
+    RuntimeScene& scene, const gd::String& name) {
+  const RuntimeObject* prototype = GetPrototype(scene, name);
+  if (!prototype) return nullptr;
+
+  if (poolingEnabled) {
+    auto pool = pools.find(prototype->GetType());
+    if (pool != pools.end() && !pool->second.empty()) {
+      std::unique_ptr<RuntimeObject> object = std::move(pool->second.back());
+      pool->second.pop_back();
+      if (object->Reinitialize(*prototype)) return object;
+
+      // Objects of this type must be created again each time.
+      notRecyclableTypes.insert(prototype->GetType());
+      pools.erase(pool);
+    }
+  }
+
+  return prototype->Clone();
+}
+
+const RuntimeObject* ObjectsPrototypes::GetPrototype(RuntimeScene& scene,
+                                                     const gd::String& name) {
+  std::size_t id = scene.objectsInstances.GetObjectNamesTable().GetId(name);
+  if (id >= prototypes.size()) {
+    prototypes.resize(id + 1);
+    prototypesSearched.resize(id + 1, false);
+  }
+  if (prototypesSearched[id]) return prototypes[id].get();
+
+  // Objects of the scene hide the global objects with the same name.
+  prototypesSearched[id] = true;
+  if (scene.HasObjectNamed(name))
+    prototypes[id] =
+        CppPlatform::Get().CreateRuntimeObject(scene, scene.GetObject(name));
+  else if (scene.game && scene.game->HasObjectNamed(name))
+    prototypes[id] = CppPlatform::Get().CreateRuntimeObject(
+        scene, scene.game->GetObject(name));
+
+  return prototypes[id].get();
+}
+
+void ObjectsPrototypes::Recycle(std::unique_ptr<RuntimeObject>&& object) {
+  if (!object || !poolingEnabled) return;
+
+  const gd::String& type = object->GetType();
+  if (notRecyclableTypes.find(type) != notRecyclableTypes.end()) return;
+
+  std::vector<std::unique_ptr<RuntimeObject>>& pool = pools[type];
+  if (pool.size() < maxPooledObjectsCount) pool.push_back(std::move(object));
+}
+
+void ObjectsPrototypes::EnablePooling(bool enable) {
+  poolingEnabled = enable;
+  if (!poolingEnabled) pools.clear();
+}
+
+std::size_t ObjectsPrototypes::GetPooledObjectsCount(
+    const gd::String& type) const {
+  auto pool = pools.find(type);
+  return pool != pools.end() ? pool->second.size() : 0;
+}
+
+void ObjectsPrototypes::Clear() {
+  prototypes.clear();
+  prototypesSearched.clear();
+  pools.clear();
+  notRecyclableTypes.clear();
+}
@@ -0,0 +1,114 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef OBJECTSPROTOTYPES_H
+#define OBJECTSPROTOTYPES_H
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "GDCpp/Runtime/String.h"
+class RuntimeObject;
+class RuntimeScene;
+
+/**
+ * \brief Create the objects of a scene by cloning a prototype of each object,
+ * and optionally recycle the objects deleted from the scene.
+ *
+ * The prototype of an object is created from its gd::Object the first time
+ * it's needed. New instances are then copies of the prototype, so that they
+ * are created without searching the object in the scene and global objects,
+ * loading its resources or unserializing its behaviors again.
+ *
+ * When pooling is enabled, the objects deleted from the scene are kept, by
+ * type, to be reinitialized as copies of the next prototype of the same type
+ * (see RuntimeObject::Reinitialize), reusing the memory they allocated.
+ *
+ * \see RuntimeScene::GetObjectsPrototypes
+ * \ingroup GameEngine
+ */
+class GD_API ObjectsPrototypes {
+ public:
+  ObjectsPrototypes();
+  virtual ~ObjectsPrototypes();
+
+  /**
+   * \brief Create a new instance of the object called \a name, searched in the
+   * objects of the scene then in the global objects.
+   *
+   * \return The new object, or nullptr if no object has this name.
+   */
+  std::unique_ptr<RuntimeObject> CreateObject(RuntimeScene& scene,
+                                              const gd::String& name);
+
+  /**
+   * \brief Return the prototype of the object called \a name, creating it if
+   * needed, or nullptr if no object has this name.
+   */
+  const RuntimeObject* GetPrototype(RuntimeScene& scene,
+                                    const gd::String& name);
+
+  /**
+   * \brief Keep an object deleted from the scene, so that it's reused to
+   * create a new object of the same type. The object is destroyed if pooling
+   * is disabled or if the pool of its type is full.
+   */
+  void Recycle(std::unique_ptr<RuntimeObject>&& object);
+
+  /**
+   * \brief Enable or disable the recycling of deleted objects. Disabled by
+   * default.
+   *
+   * \warning The behaviors of the objects are not destroyed when the objects
+   * are kept in a pool: only enable it if their behaviors don't do anything
+   * when destroyed.
+   */
+  void EnablePooling(bool enable = true);
+
+  /**
+   * \brief Return true if the recycling of deleted objects is enabled.
+   */
+  bool IsPoolingEnabled() const { return poolingEnabled; }
+
+  /**
+   * \brief Set the maximum number of deleted objects kept for each type.
+   */
+  void SetMaxPooledObjectsCount(std::size_t count) {
+    maxPooledObjectsCount = count;
+  }
+
+  /**
+   * \brief Return the number of deleted objects kept for \a type.
+   */
+  std::size_t GetPooledObjectsCount(const gd::String& type) const;
+
+  /**
+   * \brief Destroy the prototypes and the pooled objects.
+   *
+   * \note To be called when the objects of the scene are changed.
+   */
+  void Clear();
+
+ private:
+  std::vector<std::unique_ptr<RuntimeObject>>
+      prototypes;  ///< The prototypes, indexed by the identifier of the name
+                   ///< of their object (see ObjectNamesTable).
+  std::vector<bool> prototypesSearched;  ///< True for the objects for which a
+                                         ///< prototype was created, or which
+                                         ///< don't exist.
+  std::unordered_map<gd::String, std::vector<std::unique_ptr<RuntimeObject>>>
+      pools;  ///< The deleted objects, by type.
+  std::unordered_set<gd::String>
+      notRecyclableTypes;  ///< The types of the objects that can't be
+                           ///< reinitialized, and so are not pooled.
+  bool poolingEnabled;
+  std::size_t maxPooledObjectsCount;
+
+  ObjectsPrototypes(const ObjectsPrototypes&) = delete;
+  ObjectsPrototypes& operator=(const ObjectsPrototypes&) = delete;
+};
+
+#endif  // OBJECTSPROTOTYPES_H
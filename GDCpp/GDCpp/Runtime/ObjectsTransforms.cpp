@@ -0,0 +1,120 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/ObjectsTransforms.h"
+#include <limits>
+#include "GDCpp/Runtime/RuntimeObject.h"
+
+namespace {
+template <typename T>
+void RemoveByReplacingWithLast(std::vector<T>& vector, std::size_t index) {
+  vector[index] = vector.back();
+  vector.pop_back();
+}
+}
+
+void ObjectsTransforms::Add(RuntimeObject* object) {
+  if (object->transforms) object->transforms->Remove(object);
+
+  const Transform& transform = object->transform;
+  objects.push_back(object);
+  xs.push_back(transform.x);
+  ys.push_back(transform.y);
+  zOrders.push_back(transform.zOrder);
+  instantForcesX.push_back(transform.instantForceX);
+  instantForcesY.push_back(transform.instantForceY);
+  persistentForcesX.push_back(transform.persistentForceX);
+  persistentForcesY.push_back(transform.persistentForceY);
+  layersIndices.push_back(std::numeric_limits<std::size_t>::max());
+  elapsedTimes.push_back(0);
+
+  object->transforms = this;
+  object->transformIndex = objects.size() - 1;
+}
+
+void ObjectsTransforms::Remove(RuntimeObject* object) {
+  if (object->transforms != this) return;
+
+  std::size_t index = object->transformIndex;
+  object->transform = Get(index);
+  object->transforms = nullptr;
+
+  RemoveByReplacingWithLast(objects, index);
+  RemoveByReplacingWithLast(xs, index);
+  RemoveByReplacingWithLast(ys, index);
+  RemoveByReplacingWithLast(zOrders, index);
+  RemoveByReplacingWithLast(instantForcesX, index);
+  RemoveByReplacingWithLast(instantForcesY, index);
+  RemoveByReplacingWithLast(persistentForcesX, index);
+  RemoveByReplacingWithLast(persistentForcesY, index);
+  RemoveByReplacingWithLast(layersIndices, index);
+  RemoveByReplacingWithLast(elapsedTimes, index);
+  if (index < objects.size()) objects[index]->transformIndex = index;
+}
+
+void ObjectsTransforms::Clear() {
+  objects.clear();
+  xs.clear();
+  ys.clear();
+  zOrders.clear();
+  instantForcesX.clear();
+  instantForcesY.clear();
+  persistentForcesX.clear();
+  persistentForcesY.clear();
+  layersIndices.clear();
+  elapsedTimes.clear();
+}
+
+ObjectsTransforms::Transform ObjectsTransforms::Get(std::size_t index) const {
+  Transform transform;
+  transform.x = xs[index];
+  transform.y = ys[index];
+  transform.zOrder = zOrders[index];
+  transform.instantForceX = instantForcesX[index];
+  transform.instantForceY = instantForcesY[index];
+  transform.persistentForceX = persistentForcesX[index];
+  transform.persistentForceY = persistentForcesY[index];
+  return transform;
+}
+
+void ObjectsTransforms::Set(std::size_t index, const Transform& transform) {
+  xs[index] = transform.x;
+  ys[index] = transform.y;
+  zOrders[index] = transform.zOrder;
+  instantForcesX[index] = transform.instantForceX;
+  instantForcesY[index] = transform.instantForceY;
+  persistentForcesX[index] = transform.persistentForceX;
+  persistentForcesY[index] = transform.persistentForceY;
+}
+
+void ObjectsTransforms::ApplyForces(const std::vector<float>& layersElapsedTimes,
+                                    float defaultElapsedTime) {
+  const std::size_t count = objects.size();
+  for (std::size_t i = 0; i < count; ++i) {
+    elapsedTimes[i] = layersIndices[i] < layersElapsedTimes.size()
+                          ? layersElapsedTimes[layersIndices[i]]
+                          : defaultElapsedTime;
+  }
+
+  // Keep these loops simple (no branches, no calls, one array per component)
+  // so that they can be vectorized by the compiler.
+  float* x = xs.data();
+  float* y = ys.data();
+  const float* instantForceX = instantForcesX.data();
+  const float* instantForceY = instantForcesY.data();
+  const float* persistentForceX = persistentForcesX.data();
+  const float* persistentForceY = persistentForcesY.data();
+  const float* elapsedTime = elapsedTimes.data();
+  for (std::size_t i = 0; i < count; ++i)
+    x[i] += (instantForceX[i] + persistentForceX[i]) * elapsedTime[i];
+  for (std::size_t i = 0; i < count; ++i)
+    y[i] += (instantForceY[i] + persistentForceY[i]) * elapsedTime[i];
+}
+
+float ObjectsTransforms::GetElapsedTime(const RuntimeObject* object) const {
+  if (object->transforms != this) return 0;
+
+  return elapsedTimes[object->transformIndex];
+}
@@ -0,0 +1,176 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef OBJECTSTRANSFORMS_H
+#define OBJECTSTRANSFORMS_H
+
+#include <cstddef>
+#include <vector>
+class RuntimeObject;
+
+/**
+ * \brief Store the position, the Z order and the forces of the objects of a
+ * scene, with one contiguous array per component.
+ *
+ * Objects are added to the store by the ObjInstancesHolder containing them.
+ * RuntimeObject accessors (GetX, SetX, TotalForceX...) then read and write the
+ * store, so that objects are used as before, while forces can be applied to
+ * all the objects in a single loop over the arrays (see ApplyForces).
+ *
+ * \see ObjInstancesHolder
+ * \ingroup GameEngine
+ */
+class GD_API ObjectsTransforms {
+ public:
+  /**
+   * \brief The components of an object which are stored by ObjectsTransforms.
+   *
+   * Used by RuntimeObject to keep its components when it is not in a store.
+   */
+  struct Transform {
+    Transform()
+        : x(0),
+          y(0),
+          zOrder(0),
+          instantForceX(0),
+          instantForceY(0),
+          persistentForceX(0),
+          persistentForceY(0){};
+
+    float x;                 ///< X position on the scene
+    float y;                 ///< Y position on the scene
+    int zOrder;              ///< Z order on the scene
+    float instantForceX;     ///< Sum of the forces applied only during the
+                             ///< current frame.
+    float instantForceY;     ///< See instantForceX.
+    float persistentForceX;  ///< Sum of the forces applied during more than a
+                             ///< frame.
+    float persistentForceY;  ///< See persistentForceX.
+  };
+
+  ObjectsTransforms(){};
+  virtual ~ObjectsTransforms(){};
+
+  /**
+   * \brief Move the components of an object into the store.
+   */
+  void Add(RuntimeObject* object);
+
+  /**
+   * \brief Move the components of an object back into the object.
+   *
+   * The object is replaced by the last object of the store, so that removing
+   * an object is done in constant time.
+   */
+  void Remove(RuntimeObject* object);
+
+  /**
+   * \brief Remove all the objects, without giving them back their components.
+   * \warning Only to be used when all the objects are destroyed.
+   */
+  void Clear();
+
+  /**
+   * \brief Return the number of objects in the store.
+   */
+  std::size_t GetCount() const { return objects.size(); }
+
+  /**
+   * \brief Return the object stored at the specified index.
+   */
+  RuntimeObject* GetObject(std::size_t index) const { return objects[index]; }
+
+  /**
+   * \brief Return all the components of the object stored at \a index.
+   */
+  Transform Get(std::size_t index) const;
+
+  /**
+   * \brief Change all the components of the object stored at \a index.
+   */
+  void Set(std::size_t index, const Transform& transform);
+
+  /** \name Components
+   * Members functions used by RuntimeObject to access to its components.
+   */
+  ///@{
+  float GetX(std::size_t index) const { return xs[index]; }
+  void SetX(std::size_t index, float x) { xs[index] = x; }
+  float GetY(std::size_t index) const { return ys[index]; }
+  void SetY(std::size_t index, float y) { ys[index] = y; }
+  int GetZOrder(std::size_t index) const { return zOrders[index]; }
+  void SetZOrder(std::size_t index, int zOrder) { zOrders[index] = zOrder; }
+
+  float GetTotalForceX(std::size_t index) const {
+    return instantForcesX[index] + persistentForcesX[index];
+  }
+  float GetTotalForceY(std::size_t index) const {
+    return instantForcesY[index] + persistentForcesY[index];
+  }
+  void AddInstantForce(std::size_t index, float forceX, float forceY) {
+    instantForcesX[index] += forceX;
+    instantForcesY[index] += forceY;
+  }
+  void ClearInstantForce(std::size_t index) {
+    instantForcesX[index] = 0;
+    instantForcesY[index] = 0;
+  }
+  void SetPersistentForce(std::size_t index, float forceX, float forceY) {
+    persistentForcesX[index] = forceX;
+    persistentForcesY[index] = forceY;
+  }
+  ///@}
+
+  /** \name Forces integration
+   */
+  ///@{
+  /**
+   * \brief Set the index of the layer of an object, used to find the elapsed
+   * time of the object in ApplyForces.
+   * \note Automatically called by ObjInstancesHolder.
+   */
+  void SetLayerIndex(std::size_t index, std::size_t layerIndex) {
+    layersIndices[index] = layerIndex;
+  }
+
+  /**
+   * \brief Move all the objects according to the forces applied on them.
+   *
+   * \param layersElapsedTimes The time elapsed during the frame for each
+   * layer, in seconds, indexed by the indices given to SetLayerIndex.
+   * \param defaultElapsedTime The elapsed time, in seconds, of objects having
+   * a layer index not in layersElapsedTimes.
+   *
+   * \note Objects are not notified that they were moved: the caller must call
+   * RuntimeObject::OnPositionChanged for them.
+   */
+  void ApplyForces(const std::vector<float>& layersElapsedTimes,
+                   float defaultElapsedTime);
+
+  /**
+   * \brief Return the elapsed time, in seconds, used to move the object during
+   * the last call to ApplyForces.
+   */
+  float GetElapsedTime(const RuntimeObject* object) const;
+  ///@}
+
+ private:
+  ObjectsTransforms(const ObjectsTransforms&) = delete;
+  ObjectsTransforms& operator=(const ObjectsTransforms&) = delete;
+
+  std::vector<RuntimeObject*> objects;  ///< The objects owning the components.
+  std::vector<float> xs;
+  std::vector<float> ys;
+  std::vector<int> zOrders;
+  std::vector<float> instantForcesX;
+  std::vector<float> instantForcesY;
+  std::vector<float> persistentForcesX;
+  std::vector<float> persistentForcesY;
+  std::vector<std::size_t> layersIndices;
+  std::vector<float> elapsedTimes;  ///< Elapsed time of each object during the
+                                    ///< last call to ApplyForces, in seconds.
+};
+
+#endif  // OBJECTSTRANSFORMS_H
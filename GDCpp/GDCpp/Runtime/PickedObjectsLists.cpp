@@ -0,0 +1,57 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/PickedObjectsLists.h"
+
+constexpr std::size_t PickedObjectsLists::inlineListsCount;
+
+PickedObjectsLists &PickedObjectsLists::Add(
+    std::size_t objectNameId, std::vector<RuntimeObject *> &list) {
+  value_type *lists =
+      count <= inlineListsCount ? inlineLists : moreLists.data();
+  for (std::size_t i = 0; i < count; ++i) {
+    if (lists[i].first == objectNameId) {
+      lists[i].second = &list;
+      return *this;
+    }
+  }
+
+  if (count < inlineListsCount) {
+    inlineLists[count] = value_type(objectNameId, &list);
+  } else {
+    if (count == inlineListsCount)
+      moreLists.assign(inlineLists, inlineLists + inlineListsCount);
+    moreLists.push_back(value_type(objectNameId, &list));
+  }
+  count++;
+
+  return *this;
+}
+
+std::vector<RuntimeObject *> *PickedObjectsLists::Get(
+    std::size_t objectNameId) const {
+  for (const value_type &list : *this) {
+    if (list.first == objectNameId) return list.second;
+  }
+
+  return nullptr;
+}
+
+std::vector<RuntimeObject *> *PickedObjectsLists::Get(
+    const gd::String &objectName) const {
+  for (const value_type &list : *this) {
+    if (GetName(list) == objectName) return list.second;
+  }
+
+  return nullptr;
+}
+
+PickedObjectsLists::operator std::map<gd::String,
+                                      std::vector<RuntimeObject *> *>() const {
+  std::map<gd::String, std::vector<RuntimeObject *> *> lists;
+  for (const value_type &list : *this) lists[GetName(list)] = list.second;
+
+  return lists;
+}
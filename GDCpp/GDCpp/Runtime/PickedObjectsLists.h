@@ -0,0 +1,115 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef PICKEDOBJECTSLISTS_H
+#define PICKEDOBJECTSLISTS_H
+
+#include <map>
+#include <utility>
+#include <vector>
+#include "GDCpp/Runtime/ObjectNamesTable.h"
+#include "GDCpp/Runtime/String.h"
+class RuntimeObject;
+
+/**
+ * \brief The lists of picked objects given by events generated code to the
+ * functions of conditions and actions taking objects.
+ *
+ * Lists are identified by the identifier of the name of their objects in an
+ * ObjectNamesTable, so that no name is hashed or copied when the lists are
+ * built or searched. Up to inlineListsCount lists are stored without
+ * allocating memory, which is enough for most objects groups.
+ *
+ * Functions (usually from extensions) taking a RuntimeObjectsLists (a
+ * std::map indexed by the names of the objects) still work: the lists are
+ * implicitly converted to a map when given to these functions.
+ *
+ * \see RuntimeContext::GetPickedObjectsLists
+ * \ingroup GameEngine
+ */
+class GD_API PickedObjectsLists {
+ public:
+  /**
+   * The identifier of the name of the objects, and the list of the objects.
+   */
+  typedef std::pair<std::size_t, std::vector<RuntimeObject *> *> value_type;
+  typedef const value_type *const_iterator;
+
+  /**
+   * \brief Construct empty lists, for objects which names identifiers are
+   * given by \a objectNames.
+   */
+  PickedObjectsLists(ObjectNamesTable &objectNames_)
+      : objectNames(&objectNames_), count(0){};
+
+  /**
+   * \brief Add the list of the objects with the name having the specified
+   * identifier. The list previously added for this name, if any, is replaced.
+   */
+  PickedObjectsLists &Add(std::size_t objectNameId,
+                          std::vector<RuntimeObject *> &list);
+
+  /**
+   * \brief Add the list of the objects with the name which identifier is
+   * cached by \a nameId.
+   */
+  PickedObjectsLists &Add(ObjectNameId &nameId,
+                          std::vector<RuntimeObject *> &list) {
+    return Add(nameId.Get(*objectNames), list);
+  }
+
+  /**
+   * \brief Return the list of the objects with the name having the specified
+   * identifier, or NULL if there is no list for this name.
+   */
+  std::vector<RuntimeObject *> *Get(std::size_t objectNameId) const;
+
+  /**
+   * \brief Return the list of the objects with the specified name, or NULL if
+   * there is no list for this name.
+   *
+   * \note The names of the lists are compared, without hashing \a objectName.
+   */
+  std::vector<RuntimeObject *> *Get(const gd::String &objectName) const;
+
+  /**
+   * \brief Return the name of the objects of a list.
+   */
+  const gd::String &GetName(const value_type &list) const {
+    return objectNames->GetName(list.first);
+  }
+
+  /**
+   * \brief Return the table giving the identifiers of the names of objects.
+   */
+  ObjectNamesTable &GetObjectNamesTable() const { return *objectNames; }
+
+  const_iterator begin() const { return GetLists(); }
+  const_iterator end() const { return GetLists() + count; }
+  std::size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  /**
+   * \brief Return the lists in a map indexed by the names of the objects, for
+   * the functions taking a RuntimeObjectsLists.
+   */
+  operator std::map<gd::String, std::vector<RuntimeObject *> *>() const;
+
+ private:
+  const value_type *GetLists() const {
+    return count <= inlineListsCount ? inlineLists : moreLists.data();
+  }
+
+  static constexpr std::size_t inlineListsCount = 4;
+
+  ObjectNamesTable *objectNames;
+  std::size_t count;  ///< The number of lists.
+  value_type inlineLists[inlineListsCount];  ///< The lists, if there are no
+                                             ///< more than inlineListsCount.
+  std::vector<value_type> moreLists;  ///< The lists, if there are more than
+                                      ///< inlineListsCount.
+};
+
+#endif  // PICKEDOBJECTSLISTS_H
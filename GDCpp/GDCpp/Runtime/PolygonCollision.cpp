@@ -7,8 +7,24 @@
 #include <algorithm>
 #include <cfloat>
 #include <cmath>
+#include <cstdint>
+#include <vector>
 #include "GDCpp/Runtime/Polygon2d.h"
 
+// SIMD implementations are only built for x86-64, where SSE2 is always
+// available and where scalar floating point operations are also done with SSE
+// registers, so that all implementations give the same results.
+#if defined(__x86_64__) || defined(_M_X64)
+#define GD_POLYGON_COLLISION_SIMD
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define GD_TARGET_AVX
+#else
+#define GD_TARGET_AVX __attribute__((target("avx")))
+#endif
+#endif
+
 namespace {
 
 void normalise(sf::Vector2f& v) {
@@ -33,17 +49,103 @@ float crossProduct(const sf::Vector2f a, const sf::Vector2f b) {
   return cp;
 }
 
-void project(const sf::Vector2f axis,
-             const Polygon2d& p,
-             float& min,
-             float& max) {
-  float dp = dotProduct(axis, p.vertices[0]);
+void computeEdgesIfNeeded(const Polygon2d& p) {
+  if (p.edges.size() != p.vertices.size()) p.ComputeEdges();
+}
+
+/**
+ * The number of floats processed at once by the widest SIMD implementation.
+ * Arrays of axes are padded to a multiple of this number.
+ */
+const std::size_t lanesCount = 8;
+
+std::size_t padToLanesCount(std::size_t count) {
+  return (count + lanesCount - 1) / lanesCount * lanesCount;
+}
+
+/**
+ * \brief Array of floats aligned for SIMD instructions, stored on the stack
+ * for polygons having a usual number of vertices.
+ */
+class AlignedFloats {
+ public:
+  AlignedFloats(std::size_t size) : data(stackData) {
+    if (size > stackSize) {
+      heapData.resize(size + alignment / sizeof(float));
+      std::uintptr_t address =
+          reinterpret_cast<std::uintptr_t>(heapData.data());
+      data = reinterpret_cast<float*>((address + alignment - 1) / alignment *
+                                      alignment);
+    }
+  }
+
+  float* Get() { return data; }
 
+ private:
+  AlignedFloats(const AlignedFloats&) = delete;
+  AlignedFloats& operator=(const AlignedFloats&) = delete;
+
+  static const std::size_t stackSize = 32;
+  static const std::size_t alignment = 32;
+
+  alignas(alignment) float stackData[stackSize];
+  std::vector<float> heapData;
+  float* data;
+};
+
+/**
+ * \brief The vertices of two polygons and the axes on which they are
+ * projected, stored as arrays of coordinates.
+ */
+struct SeparatingAxesData {
+  const float* x1;
+  const float* y1;
+  std::size_t count1;
+  const float* x2;
+  const float* y2;
+  std::size_t count2;
+  const float* axesX;  ///< The axes of the first polygon, then the axes of the
+                       ///< second one, each padded to a multiple of lanesCount.
+  const float* axesY;
+  float* distances;  ///< The distance between the projections of the polygons
+                     ///< on each axis. Negative if the projections overlap.
+  std::size_t axesCount;  ///< The number of axes, including padding.
+};
+
+/**
+ * \brief The functions doing the computations on arrays of axes.
+ *
+ * All implementations must do the same floating point operations, in the
+ * same order, so that they give exactly the same results.
+ */
+struct SeparatingAxesImplementation {
+  void (*normalizeAxes)(float* axesX, float* axesY, std::size_t count);
+  void (*computeDistances)(SeparatingAxesData& data);
+};
+
+void NormalizeAxesScalar(float* axesX, float* axesY, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    float length = std::sqrt(axesX[i] * axesX[i] + axesY[i] * axesY[i]);
+    if (length != 0.0f) {
+      axesX[i] /= length;
+      axesY[i] /= length;
+    }
+  }
+}
+
+void ProjectScalar(float axisX,
+                   float axisY,
+                   const float* x,
+                   const float* y,
+                   std::size_t count,
+                   float& min,
+                   float& max) {
+  float dp = axisX * x[0] + axisY * y[0];
   min = dp;
   max = dp;
 
-  for (std::size_t i = 1; i < p.vertices.size(); i++) {
-    dp = dotProduct(axis, p.vertices[i]);
+  for (std::size_t i = 1; i < count; i++) {
+    dp = axisX * x[i] + axisY * y[i];
 
     if (dp < min)
       min = dp;
@@ -52,88 +154,401 @@ void project(const sf::Vector2f axis,
   }
 }
 
-float distance(float minA, float maxA, float minB, float maxB) {
-  if (minA < minB)
-    return minB - maxA;
-  else
-    return minA - maxB;
+void ComputeDistancesScalar(SeparatingAxesData& data) {
+  for (std::size_t i = 0; i < data.axesCount; ++i) {
+    float minA, maxA, minB, maxB;
+    ProjectScalar(data.axesX[i],
+                  data.axesY[i],
+                  data.x1,
+                  data.y1,
+                  data.count1,
+                  minA,
+                  maxA);
+    ProjectScalar(data.axesX[i],
+                  data.axesY[i],
+                  data.x2,
+                  data.y2,
+                  data.count2,
+                  minB,
+                  maxB);
+
+    data.distances[i] = minA < minB ? minB - maxA : minA - maxB;
+  }
 }
 
-}  // namespace
+#if defined(GD_POLYGON_COLLISION_SIMD)
+__m128 SelectSSE2(__m128 mask, __m128 a, __m128 b) {
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
 
-CollisionResult GD_API PolygonCollisionTest(Polygon2d& p1,
-                                            Polygon2d& p2,
-                                            bool ignoreTouchingEdges) {
-  if (p1.vertices.size() < 3 || p2.vertices.size() < 3) {
-    CollisionResult result;
-    result.collision = false;
-    result.move_axis.x = 0.0f;
-    result.move_axis.y = 0.0f;
-    return result;
+void NormalizeAxesSSE2(float* axesX, float* axesY, std::size_t count) {
+  const __m128 zero = _mm_setzero_ps();
+  for (std::size_t i = 0; i < count; i += 4) {
+    __m128 x = _mm_load_ps(axesX + i);
+    __m128 y = _mm_load_ps(axesY + i);
+    __m128 length =
+        _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)));
+    __m128 notZero = _mm_cmpneq_ps(length, zero);
+    _mm_store_ps(axesX + i, SelectSSE2(notZero, _mm_div_ps(x, length), x));
+    _mm_store_ps(axesY + i, SelectSSE2(notZero, _mm_div_ps(y, length), y));
   }
+}
 
-  p1.ComputeEdges();
-  p2.ComputeEdges();
+void ProjectSSE2(__m128 axisX,
+                 __m128 axisY,
+                 const float* x,
+                 const float* y,
+                 std::size_t count,
+                 __m128& min,
+                 __m128& max) {
+  __m128 dp = _mm_add_ps(_mm_mul_ps(axisX, _mm_set1_ps(x[0])),
+                         _mm_mul_ps(axisY, _mm_set1_ps(y[0])));
+  min = dp;
+  max = dp;
 
-  sf::Vector2f edge;
-  sf::Vector2f move_axis(0, 0);
-  sf::Vector2f mtd(0, 0);
+  for (std::size_t i = 1; i < count; i++) {
+    dp = _mm_add_ps(_mm_mul_ps(axisX, _mm_set1_ps(x[i])),
+                    _mm_mul_ps(axisY, _mm_set1_ps(y[i])));
+    min = _mm_min_ps(dp, min);
+    max = _mm_max_ps(dp, max);
+  }
+}
 
-  float min_dist = FLT_MAX;
+void ComputeDistancesSSE2(SeparatingAxesData& data) {
+  for (std::size_t i = 0; i < data.axesCount; i += 4) {
+    __m128 axisX = _mm_load_ps(data.axesX + i);
+    __m128 axisY = _mm_load_ps(data.axesY + i);
+    __m128 minA, maxA, minB, maxB;
+    ProjectSSE2(axisX, axisY, data.x1, data.y1, data.count1, minA, maxA);
+    ProjectSSE2(axisX, axisY, data.x2, data.y2, data.count2, minB, maxB);
+
+    _mm_store_ps(data.distances + i,
+                 SelectSSE2(_mm_cmplt_ps(minA, minB),
+                            _mm_sub_ps(minB, maxA),
+                            _mm_sub_ps(minA, maxB)));
+  }
+}
 
-  CollisionResult result;
+GD_TARGET_AVX void NormalizeAxesAVX(float* axesX,
+                                    float* axesY,
+                                    std::size_t count) {
+  const __m256 zero = _mm256_setzero_ps();
+  for (std::size_t i = 0; i < count; i += 8) {
+    __m256 x = _mm256_load_ps(axesX + i);
+    __m256 y = _mm256_load_ps(axesY + i);
+    __m256 length =
+        _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)));
+    __m256 notZero = _mm256_cmp_ps(length, zero, _CMP_NEQ_UQ);
+    _mm256_store_ps(axesX + i,
+                    _mm256_blendv_ps(x, _mm256_div_ps(x, length), notZero));
+    _mm256_store_ps(axesY + i,
+                    _mm256_blendv_ps(y, _mm256_div_ps(y, length), notZero));
+  }
+}
 
-  // Iterate over all the edges composing the polygons
-  for (std::size_t i = 0; i < p1.vertices.size() + p2.vertices.size(); i++) {
-    if (i < p1.vertices.size())  // or <=
-    {
-      edge = p1.edges[i];
-    } else {
-      edge = p2.edges[i - p1.vertices.size()];
-    }
+GD_TARGET_AVX void ProjectAVX(__m256 axisX,
+                              __m256 axisY,
+                              const float* x,
+                              const float* y,
+                              std::size_t count,
+                              __m256& min,
+                              __m256& max) {
+  __m256 dp = _mm256_add_ps(_mm256_mul_ps(axisX, _mm256_set1_ps(x[0])),
+                            _mm256_mul_ps(axisY, _mm256_set1_ps(y[0])));
+  min = dp;
+  max = dp;
 
-    sf::Vector2f axis(
-        -edge.y, edge.x);  // Get the axis to which polygons will be projected
-    normalise(axis);
+  for (std::size_t i = 1; i < count; i++) {
+    dp = _mm256_add_ps(_mm256_mul_ps(axisX, _mm256_set1_ps(x[i])),
+                       _mm256_mul_ps(axisY, _mm256_set1_ps(y[i])));
+    min = _mm256_min_ps(dp, min);
+    max = _mm256_max_ps(dp, max);
+  }
+}
 
-    float minA = 0;
-    float minB = 0;
-    float maxA = 0;
-    float maxB = 0;
+GD_TARGET_AVX void ComputeDistancesAVX(SeparatingAxesData& data) {
+  for (std::size_t i = 0; i < data.axesCount; i += 8) {
+    __m256 axisX = _mm256_load_ps(data.axesX + i);
+    __m256 axisY = _mm256_load_ps(data.axesY + i);
+    __m256 minA, maxA, minB, maxB;
+    ProjectAVX(axisX, axisY, data.x1, data.y1, data.count1, minA, maxA);
+    ProjectAVX(axisX, axisY, data.x2, data.y2, data.count2, minB, maxB);
+
+    _mm256_store_ps(
+        data.distances + i,
+        _mm256_blendv_ps(_mm256_sub_ps(minA, maxB),
+                         _mm256_sub_ps(minB, maxA),
+                         _mm256_cmp_ps(minA, minB, _CMP_LT_OQ)));
+  }
+}
 
-    project(axis, p1, minA, maxA);
-    project(axis, p2, minB, maxB);
+bool IsAVXSupported() {
+#if defined(_MSC_VER)
+  int cpuInfo[4];
+  __cpuid(cpuInfo, 1);
+  bool osUsesXSave = (cpuInfo[2] & (1 << 27)) != 0;
+  bool cpuHasAVX = (cpuInfo[2] & (1 << 28)) != 0;
+  return osUsesXSave && cpuHasAVX && (_xgetbv(0) & 6) == 6;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx");
+#endif
+}
+#endif
+
+const SeparatingAxesImplementation implementations[] = {
+    {NormalizeAxesScalar, ComputeDistancesScalar},
+#if defined(GD_POLYGON_COLLISION_SIMD)
+    {NormalizeAxesSSE2, ComputeDistancesSSE2},
+    {NormalizeAxesAVX, ComputeDistancesAVX},
+#endif
+};
+
+PolygonCollisionImplementation GetFastestImplementation() {
+  if (IsPolygonCollisionImplementationSupported(POLYGON_COLLISION_AVX))
+    return POLYGON_COLLISION_AVX;
+  if (IsPolygonCollisionImplementationSupported(POLYGON_COLLISION_SSE2))
+    return POLYGON_COLLISION_SSE2;
+
+  return POLYGON_COLLISION_SCALAR;
+}
 
-    float dist = distance(minA, maxA, minB, maxB);
-    if (dist > 0.0f || (dist == 0.0 && ignoreTouchingEdges)) {
-      // If the projections on the axis do not overlap, then
-      // there is no collision
-      result.collision = false;
-      result.move_axis.x = 0.0f;
-      result.move_axis.y = 0.0f;
+PolygonCollisionImplementation currentImplementation =
+    GetFastestImplementation();
 
+/**
+ * \brief Test the collision between a polygon and other polygons using the
+ * separating axis theorem.
+ *
+ * The vertices and the axes of the first polygon are only prepared once for
+ * all the tests.
+ */
+class SeparatingAxesTest {
+ public:
+  /**
+   * \param maxCount2 The maximum number of vertices of the polygons which
+   * will be tested against p1.
+   */
+  SeparatingAxesTest(const Polygon2d& p1,
+                     std::size_t maxCount2,
+                     bool ignoreTouchingEdges_)
+      : polygon1(p1),
+        count1(p1.vertices.size()),
+        paddedCount1(padToLanesCount(count1)),
+        x1(count1),
+        y1(count1),
+        x2(maxCount2),
+        y2(maxCount2),
+        axesX(paddedCount1 + padToLanesCount(maxCount2)),
+        axesY(paddedCount1 + padToLanesCount(maxCount2)),
+        distances(paddedCount1 + padToLanesCount(maxCount2)),
+        axes1Normalized(false),
+        ignoreTouchingEdges(ignoreTouchingEdges_),
+        implementation(implementations[currentImplementation]) {
+    GatherVertices(p1, x1.Get(), y1.Get(), aabb1);
+  }
+
+  CollisionResult Test(const Polygon2d& p2) {
+    CollisionResult result;
+    result.collision = false;
+    result.move_axis.x = 0.0f;
+    result.move_axis.y = 0.0f;
+
+    std::size_t count2 = p2.vertices.size();
+    if (count1 < 3 || count2 < 3) return result;
+
+    // Polygons with bounding boxes not touching can't be colliding.
+    AABB aabb2;
+    GatherVertices(p2, x2.Get(), y2.Get(), aabb2);
+    if (aabb1.minX > aabb2.maxX || aabb2.minX > aabb1.maxX ||
+        aabb1.minY > aabb2.maxY || aabb2.minY > aabb1.maxY)
+      return result;
+
+    if (!axes1Normalized) {
+      GatherAxes(polygon1, axesX.Get(), axesY.Get(), paddedCount1);
+      implementation.normalizeAxes(axesX.Get(), axesY.Get(), paddedCount1);
+      axes1Normalized = true;
+    }
+    std::size_t paddedCount2 = padToLanesCount(count2);
+    float* axes2X = axesX.Get() + paddedCount1;
+    float* axes2Y = axesY.Get() + paddedCount1;
+    GatherAxes(p2, axes2X, axes2Y, paddedCount2);
+    implementation.normalizeAxes(axes2X, axes2Y, paddedCount2);
+
+    SeparatingAxesData data;
+    data.x1 = x1.Get();
+    data.y1 = y1.Get();
+    data.count1 = count1;
+    data.x2 = x2.Get();
+    data.y2 = y2.Get();
+    data.count2 = count2;
+    data.axesX = axesX.Get();
+    data.axesY = axesY.Get();
+    data.distances = distances.Get();
+    data.axesCount = paddedCount1 + paddedCount2;
+    implementation.computeDistances(data);
+
+    // Iterate over the axes of all the edges composing the polygons, skipping
+    // the padding.
+    float minDist = FLT_MAX;
+    sf::Vector2f moveAxis(0, 0);
+    if (!FindSmallestOverlap(0, count1, minDist, moveAxis) ||
+        !FindSmallestOverlap(
+            paddedCount1, paddedCount1 + count2, minDist, moveAxis))
       return result;
+
+    result.collision = true;
+
+    sf::Vector2f d = polygon1.ComputeCenter() - p2.ComputeCenter();
+    if (dotProduct(d, moveAxis) < 0.0f) moveAxis = -moveAxis;
+    result.move_axis = moveAxis * minDist;
+
+    return result;
+  }
+
+ private:
+  struct AABB {
+    AABB() : minX(FLT_MAX), minY(FLT_MAX), maxX(-FLT_MAX), maxY(-FLT_MAX){};
+
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+  };
+
+  static void GatherVertices(const Polygon2d& p,
+                             float* x,
+                             float* y,
+                             AABB& aabb) {
+    for (std::size_t i = 0; i < p.vertices.size(); ++i) {
+      x[i] = p.vertices[i].x;
+      y[i] = p.vertices[i].y;
+      aabb.minX = std::min(aabb.minX, x[i]);
+      aabb.minY = std::min(aabb.minY, y[i]);
+      aabb.maxX = std::max(aabb.maxX, x[i]);
+      aabb.maxY = std::max(aabb.maxY, y[i]);
     }
+  }
 
-    float absDist = std::abs(dist);
+  /**
+   * \brief Store the axes to which polygons will be projected, perpendicular
+   * to the edges of \a p, padding them with null axes.
+   */
+  static void GatherAxes(const Polygon2d& p,
+                         float* axesX,
+                         float* axesY,
+                         std::size_t paddedCount) {
+    computeEdgesIfNeeded(p);
+    std::size_t count = p.vertices.size();
+    for (std::size_t i = 0; i < count; ++i) {
+      axesX[i] = -p.edges[i].y;
+      axesY[i] = p.edges[i].x;
+    }
+    std::fill(axesX + count, axesX + paddedCount, 0.0f);
+    std::fill(axesY + count, axesY + paddedCount, 0.0f);
+  }
 
-    if (absDist < min_dist) {
-      min_dist = absDist;
-      move_axis = axis;
+  /**
+   * \brief Update the axis with the smallest overlap of the projections, among
+   * the axes from \a begin to \a end.
+   *
+   * \return false if the projections do not overlap on one of the axes,
+   * meaning that there is no collision.
+   */
+  bool FindSmallestOverlap(std::size_t begin,
+                           std::size_t end,
+                           float& minDist,
+                           sf::Vector2f& moveAxis) {
+    const float* dist = distances.Get();
+    for (std::size_t i = begin; i < end; ++i) {
+      if (dist[i] > 0.0f || (dist[i] == 0.0 && ignoreTouchingEdges))
+        return false;
+
+      float absDist = std::abs(dist[i]);
+      if (absDist < minDist) {
+        minDist = absDist;
+        moveAxis.x = axesX.Get()[i];
+        moveAxis.y = axesY.Get()[i];
+      }
     }
+
+    return true;
   }
 
-  result.collision = true;
+  const Polygon2d& polygon1;
+  std::size_t count1;
+  std::size_t paddedCount1;
+  AABB aabb1;
+  AlignedFloats x1;
+  AlignedFloats y1;
+  AlignedFloats x2;
+  AlignedFloats y2;
+  AlignedFloats axesX;
+  AlignedFloats axesY;
+  AlignedFloats distances;
+  bool axes1Normalized;
+  bool ignoreTouchingEdges;
+  const SeparatingAxesImplementation& implementation;
+};
 
-  sf::Vector2f d = p1.ComputeCenter() - p2.ComputeCenter();
-  if (dotProduct(d, move_axis) < 0.0f) move_axis = -move_axis;
-  result.move_axis = move_axis * min_dist;
+}  // namespace
 
-  return result;
+bool GD_API IsPolygonCollisionImplementationSupported(
+    PolygonCollisionImplementation implementation) {
+  switch (implementation) {
+    case POLYGON_COLLISION_SCALAR:
+      return true;
+#if defined(GD_POLYGON_COLLISION_SIMD)
+    case POLYGON_COLLISION_SSE2:
+      return true;
+    case POLYGON_COLLISION_AVX:
+      return IsAVXSupported();
+#endif
+    default:
+      return false;
+  }
+}
+
+bool GD_API
+SetPolygonCollisionImplementation(PolygonCollisionImplementation implementation) {
+  if (!IsPolygonCollisionImplementationSupported(implementation)) return false;
+
+  currentImplementation = implementation;
+  return true;
+}
+
+PolygonCollisionImplementation GD_API GetPolygonCollisionImplementation() {
+  return currentImplementation;
+}
+
+CollisionResult GD_API PolygonCollisionTest(const Polygon2d& p1,
+                                            const Polygon2d& p2,
+                                            bool ignoreTouchingEdges) {
+  SeparatingAxesTest test(p1, p2.vertices.size(), ignoreTouchingEdges);
+  return test.Test(p2);
+}
+
+bool GD_API PolygonCollisionBatchTest(const Polygon2d& p1,
+                                      const std::vector<Polygon2d>& polygons,
+                                      std::vector<CollisionResult>& results,
+                                      bool ignoreTouchingEdges) {
+  std::size_t maxCount2 = 0;
+  for (const Polygon2d& p2 : polygons)
+    maxCount2 = std::max(maxCount2, p2.vertices.size());
+
+  SeparatingAxesTest test(p1, maxCount2, ignoreTouchingEdges);
+  results.resize(polygons.size());
+  bool collision = false;
+  for (std::size_t i = 0; i < polygons.size(); ++i) {
+    results[i] = test.Test(polygons[i]);
+    if (results[i].collision) collision = true;
+  }
+
+  return collision;
 }
 
 RaycastResult GD_API PolygonRaycastTest(
-    Polygon2d& poly, float startX, float startY, float endX, float endY) {
+    const Polygon2d& poly, float startX, float startY, float endX, float endY) {
   RaycastResult result;
   result.collision = false;
 
@@ -141,7 +556,7 @@ RaycastResult GD_API PolygonRaycastTest(
     return result;
   }
 
-  poly.ComputeEdges();
+  computeEdgesIfNeeded(poly);
   sf::Vector2f p, q, r, s;
   float minSqDist = FLT_MAX;
 
@@ -216,7 +631,7 @@ RaycastResult GD_API PolygonRaycastTest(
   return result;
 }
 
-bool GD_API IsPointInsidePolygon(Polygon2d& poly, float x, float y) {
+bool GD_API IsPointInsidePolygon(const Polygon2d& poly, float x, float y) {
   bool inside = false;
   sf::Vector2f vi, vj;
 
@@ -6,6 +6,7 @@
 #ifndef POLYGONCOLLISION_H
 #define POLYGONCOLLISION_H
 #include <SFML/System.hpp>
+#include <vector>
 class Polygon2d;
 
 /**
@@ -42,12 +43,85 @@ struct RaycastResult {
  *
  * \return true if polygons are overlapping
  *
+ * \note Edges of the polygons are only computed if they were not already
+ * computed (see Polygon2d::ComputeEdges).
+ * \note The projections of the polygons on the axes are computed using the
+ * implementation chosen with SetPolygonCollisionImplementation.
+ *
  * \ingroup GameEngine
  */
-CollisionResult GD_API PolygonCollisionTest(Polygon2d& p1,
-                                            Polygon2d& p2,
+CollisionResult GD_API PolygonCollisionTest(const Polygon2d& p1,
+                                            const Polygon2d& p2,
                                             bool ignoreTouchingEdges = false);
 
+/**
+ * Do a collision test between a polygon and each polygon of a list.
+ * \warning Polygons must convexes.
+ *
+ * Gives the same results as calling PolygonCollisionTest for each polygon, but
+ * the vertices and the axes of \a p1 are only prepared once.
+ *
+ * \param p1 The polygon tested against all the others
+ * \param polygons The other polygons
+ * \param results Filled with the result of the test of each polygon of \a
+ * polygons, in the same order.
+ * \param ignoreTouchingEdges See PolygonCollisionTest.
+ *
+ * \return true if p1 is overlapping at least one of the polygons
+ *
+ * \ingroup GameEngine
+ */
+bool GD_API PolygonCollisionBatchTest(const Polygon2d& p1,
+                                      const std::vector<Polygon2d>& polygons,
+                                      std::vector<CollisionResult>& results,
+                                      bool ignoreTouchingEdges = false);
+
+/**
+ * \brief The implementations of the computations done by PolygonCollisionTest.
+ *
+ * All the implementations give exactly the same results: SIMD implementations
+ * project the polygons on 4 (SSE2) or 8 (AVX) axes at once, doing the same
+ * floating point operations as the scalar implementation.
+ *
+ * \ingroup GameEngine
+ */
+enum PolygonCollisionImplementation {
+  POLYGON_COLLISION_SCALAR,
+  POLYGON_COLLISION_SSE2,
+  POLYGON_COLLISION_AVX
+};
+
+/**
+ * \brief Return true if the implementation is available on this platform and
+ * supported by the CPU.
+ *
+ * \ingroup GameEngine
+ */
+bool GD_API IsPolygonCollisionImplementationSupported(
+    PolygonCollisionImplementation implementation);
+
+/**
+ * \brief Change the implementation used by PolygonCollisionTest and
+ * PolygonCollisionBatchTest.
+ *
+ * The fastest implementation supported by the CPU is used by default.
+ *
+ * \return false if the implementation is not supported, in which case the
+ * implementation is not changed.
+ *
+ * \ingroup GameEngine
+ */
+bool GD_API
+SetPolygonCollisionImplementation(PolygonCollisionImplementation implementation);
+
+/**
+ * \brief Return the implementation used by PolygonCollisionTest and
+ * PolygonCollisionBatchTest.
+ *
+ * \ingroup GameEngine
+ */
+PolygonCollisionImplementation GD_API GetPolygonCollisionImplementation();
+
 /**
  * Do a raycast test.
  * \warning Polygon must be convex.
@@ -59,7 +133,7 @@ CollisionResult GD_API PolygonCollisionTest(Polygon2d& p1,
  * \ingroup GameEngine
  */
 RaycastResult GD_API PolygonRaycastTest(
-    Polygon2d& poly, float startX, float startY, float endX, float endY);
+    const Polygon2d& poly, float startX, float startY, float endX, float endY);
 
 /**
  * Check if a point is inside a polygon.
@@ -71,6 +145,6 @@ RaycastResult GD_API PolygonRaycastTest(
  *
  * \ingroup GameEngine
  */
-bool GD_API IsPointInsidePolygon(Polygon2d& poly, float x, float y);
+bool GD_API IsPointInsidePolygon(const Polygon2d& poly, float x, float y);
 
 #endif  // POLYGONCOLLISION_H
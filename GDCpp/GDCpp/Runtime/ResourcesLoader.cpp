@@ -36,12 +36,14 @@ bool ResourcesLoader::SetResourceFile(const gd::String& filename) {
 void ResourcesLoader::LoadSFMLImage(const gd::String& filename,
                                     sf::Image& image) {
   if (resFile.ContainsFile(filename)) {
-    char* buffer = resFile.GetFile(filename);
-    if (buffer == NULL)
+    // Images can be loaded from another thread (see SceneStack::Preload), so
+    // the buffer shared by the other files can't be used.
+    std::vector<char> buffer;
+    if (!resFile.ReadFile(filename, buffer))
       cout << "Failed to get the file of a SFML image from resource file: "
            << filename << endl;
 
-    if (!image.loadFromMemory(buffer, resFile.GetFileSize(filename)))
+    if (!image.loadFromMemory(buffer.data(), buffer.size()))
       cout << "Failed to load a SFML image from resource file: " << filename
            << endl;
   } else {
@@ -51,6 +51,9 @@ class GD_API ResourcesLoader {
    */
   bool SetResourceFile(const gd::String &filename);
 
+  /**
+   * \brief Load an image. Can be called from any thread.
+   */
   void LoadSFMLImage(const gd::String &filename, sf::Image &image);
 
   sf::Texture LoadSFMLTexture(const gd::String &filename);
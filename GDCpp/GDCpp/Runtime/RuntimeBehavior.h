@@ -59,6 +59,21 @@ class GD_CORE_API RuntimeBehavior {
     if (activated) DoStepPostEvents(scene);
   };
 
+  /**
+   * \brief Return true if the steps of the behavior can be run at the same
+   * time as the steps of other objects behaviors.
+   *
+   * Redefine this method to return true if DoStepPreEvents and
+   * DoStepPostEvents only change the behavior and the position, angle, size or
+   * variables of the object owning it, and only read the scene. They must not
+   * create or delete objects, change the layer or Z order of the object, or
+   * access to other objects.
+   *
+   * Thread-safe behaviors are stepped in parallel, after the other behaviors.
+   * \see BehaviorsStepper
+   */
+  virtual bool IsThreadSafe() const { return false; }
+
   /**
    * De/Activate the behavior
    */
@@ -25,6 +25,17 @@ std::vector<RuntimeObject *> RuntimeContext::GetObjectsRawPointers(
   return scene->objectsInstances.GetObjectsRawPointers(name);
 }
 
+std::vector<RuntimeObject *> RuntimeContext::GetObjectsRawPointers(
+    ObjectNameId &nameId) {
+  ObjInstancesHolder &objectsInstances = scene->objectsInstances;
+  return objectsInstances.GetObjectsRawPointers(
+      nameId.Get(objectsInstances.GetObjectNamesTable()));
+}
+
+PickedObjectsLists RuntimeContext::GetPickedObjectsLists() {
+  return PickedObjectsLists(scene->objectsInstances.GetObjectNamesTable());
+}
+
 RuntimeVariablesContainer &RuntimeContext::GetSceneVariables() {
   return scene->GetVariables();
 }
@@ -4,6 +4,8 @@
 #include <map>
 #include <string>
 #include <vector>
+#include "GDCpp/Runtime/ObjectNamesTable.h"
+#include "GDCpp/Runtime/PickedObjectsLists.h"
 #include "GDCpp/Runtime/String.h"
 class RuntimeObject;
 class RuntimeScene;
@@ -30,6 +32,15 @@ class GD_API RuntimeContext {
    */
   std::vector<RuntimeObject *> GetObjectsRawPointers(const gd::String &name);
 
+  /**
+   * \brief Get a "raw pointers" list to objects with a specific name, without
+   * hashing the name once its identifier is known.
+   *
+   * Used by events generated code, which declares an ObjectNameId for each
+   * name of object used by events.
+   */
+  std::vector<RuntimeObject *> GetObjectsRawPointers(ObjectNameId &nameId);
+
   /**
    * \brief Shortcut for scene->GetVariables();
    */
@@ -52,6 +63,20 @@ class GD_API RuntimeContext {
    */
   void StartNewFrame();
 
+  /**
+   * \brief Return empty lists of picked objects, to be filled by events
+   * generated code with the lists of the objects given to a function.
+   *
+   * Lists are identified by the identifiers of the names of the objects in
+   * the table of the scene, so that no name is hashed when the lists are
+   * built (see PickedObjectsLists::Add).
+   */
+  PickedObjectsLists GetPickedObjectsLists();
+
+  /**
+   * \deprecated Events generated code now uses GetPickedObjectsLists, which
+   * does not build a std::map each time objects are given to a function.
+   */
   RuntimeContext &ClearObjectListsMap();
   RuntimeContext &AddObjectListToMap(const gd::String &objectName,
                                      std::vector<RuntimeObject *> &list);
@@ -8,10 +8,12 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include "GDCore/Project/Object.h"
 #include "GDCpp/Runtime/Project/Project.h"
 #include "GDCpp/Runtime/RuntimeVariablesContainer.h"
 
-RuntimeGame::RuntimeGame() {
+RuntimeGame::RuntimeGame()
+    : objectNames(std::make_shared<ObjectNamesTable>()) {
   soundManager.SetResourcesManager(&GetResourcesManager());
 }
 
@@ -21,4 +23,7 @@ void RuntimeGame::LoadFromProject(const gd::Project& project) {
 
   variables.Merge(project.GetVariables());
   soundManager.SetResourcesManager(&GetResourcesManager());
+
+  for (std::size_t i = 0; i < project.GetObjectsCount(); ++i)
+    objectNames->GetId(project.GetObject(i).GetName());
 }
@@ -10,6 +10,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include "GDCpp/Runtime/ObjectNamesTable.h"
 #include "GDCpp/Runtime/Project/Project.h"
 #include "GDCpp/Runtime/RuntimeVariablesContainer.h"
 #include "GDCpp/Runtime/SoundManager.h"
@@ -55,6 +56,20 @@ class GD_API RuntimeGame : public gd::Project {
    */
   inline RuntimeVariablesContainer& GetVariables() { return variables; }
 
+  /**
+   * \brief Return the table giving an identifier to each name of object,
+   * shared by all the scenes of the game.
+   */
+  ObjectNamesTable& GetObjectNamesTable() { return *objectNames; }
+
+  /**
+   * \brief Return a shared pointer to the table giving an identifier to each
+   * name of object.
+   */
+  std::shared_ptr<ObjectNamesTable> GetSharedObjectNamesTable() {
+    return objectNames;
+  }
+
   /**
    * \brief Get the width of the window at the startup of the game.
    * \note This won't changed after the game startup, even if the window
@@ -72,6 +87,8 @@ class GD_API RuntimeGame : public gd::Project {
  private:
   RuntimeVariablesContainer variables;  ///< List of the global variables
   SoundManager soundManager;
+  std::shared_ptr<ObjectNamesTable>
+      objectNames;  ///< The identifiers of the names of objects.
 
   unsigned int
       windowOriginalWidth;  ///< Game window width at the start of the game
@@ -8,11 +8,13 @@
 #include <cmath>
 #include <cstring>
 #include <iostream>
+#include <typeinfo>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Tools/Localization.h"
 #include "GDCpp/Extensions/Builtin/MathematicalTools.h"
 #include "GDCpp/Extensions/CppPlatform.h"
 #include "GDCpp/Runtime/CommonTools.h"
+#include "GDCpp/Runtime/ObjInstancesHolder.h"
 #include "GDCpp/Runtime/Polygon2d.h"
 #include "GDCpp/Runtime/PolygonCollision.h"
 #include "GDCpp/Runtime/Project/Behavior.h"
@@ -25,11 +27,15 @@ using namespace std;
 RuntimeObject::RuntimeObject(RuntimeScene &scene, const gd::Object &object)
     : name(object.GetName()),
       type(object.GetType()),
-      X(0),
-      Y(0),
-      zOrder(0),
       hidden(false),
-      objectVariables(object.GetVariables()) {
+      objectVariables(object.GetVariables()),
+      transforms(nullptr),
+      transformIndex(0),
+      instancesHolder(nullptr),
+      renderingLayerIndex(0),
+      renderingIndex(0),
+      objectNameId(0),
+      objectIndex(0) {
   ClearForce();
 
   // Create the behaviors
@@ -51,24 +57,63 @@ void RuntimeObject::Init(const RuntimeObject &object) {
   type = object.type;
   objectVariables = object.objectVariables;
 
-  X = object.X;
-  Y = object.Y;
-  zOrder = object.zOrder;
   hidden = object.hidden;
   layer = object.layer;
   force5 = object.force5;
   forces = object.forces;
+  hitBoxes = object.hitBoxes;
+
+  ObjectsTransforms::Transform objectTransform =
+      object.transforms ? object.transforms->Get(object.transformIndex)
+                        : object.transform;
+  if (transforms)
+    transforms->Set(transformIndex, objectTransform);
+  else
+    transform = objectTransform;
+
+  // The object is not moved to the container of the other object,
+  // but its rendering list must be updated if it's already in a container.
+  if (instancesHolder) {
+    instancesHolder->ObjectLayerHasChanged(this);
+    instancesHolder->ObjectZOrderHasChanged(this);
+  }
 
   // Clone behaviors
   behaviors.clear();
   for (auto it = object.behaviors.cbegin(); it != object.behaviors.cend();
        ++it) {
     behaviors[it->first] =
-        gd::make_unique<RuntimeBehavior>(*it->second->Clone());
+        std::unique_ptr<RuntimeBehavior>(it->second->Clone());
     behaviors[it->first]->SetOwner(this);
   }
 }
 
+bool RuntimeObject::Reinitialize(const RuntimeObject &object) {
+  if (typeid(*this) != typeid(RuntimeObject) ||
+      typeid(object) != typeid(RuntimeObject))
+    return false;
+
+  Init(object);
+  return true;
+}
+
+void RuntimeObject::SetZOrder(int zOrder_) {
+  if (zOrder_ == GetZOrder()) return;
+
+  if (transforms)
+    transforms->SetZOrder(transformIndex, zOrder_);
+  else
+    transform.zOrder = zOrder_;
+  if (instancesHolder) instancesHolder->ObjectZOrderHasChanged(this);
+}
+
+void RuntimeObject::SetLayer(const gd::String &layer_) {
+  if (layer_ == layer) return;
+
+  layer = layer_;
+  if (instancesHolder) instancesHolder->ObjectLayerHasChanged(this);
+}
+
 /**
  * \brief Add the specified behavior to the object
  */
@@ -99,7 +144,7 @@ void RuntimeObject::GetPropertyForDebugger(std::size_t propertyNb,
     value = layer;
   } else if (propertyNb == 5) {
     name = _("Z order");
-    value = gd::String::From(zOrder);
+    value = gd::String::From(GetZOrder());
   } else if (propertyNb == 6) {
     name = _("Speed");
     value = gd::String::From(TotalForceLength());
@@ -137,7 +182,7 @@ bool RuntimeObject::ChangeProperty(std::size_t propertyNb,
     } else
       SetHidden(false);
   } else if (propertyNb == 4) {
-    layer = newValue;
+    SetLayer(newValue);
   } else if (propertyNb == 5) {
     SetZOrder(newValue.To<int>());
   } else if (propertyNb == 6) {
@@ -187,15 +232,50 @@ void RuntimeObject::PutAroundAPosition(float positionX,
        (GetDrawableY() + GetCenterY()));
 }
 
+void RuntimeObject::PushForce(const Force &force) {
+  if (force.GetClearing() == 0) {
+    // The force is only applied during this frame: only the sum of these
+    // forces is needed.
+    if (transforms)
+      transforms->AddInstantForce(transformIndex, force.GetX(), force.GetY());
+    else {
+      transform.instantForceX += force.GetX();
+      transform.instantForceY += force.GetY();
+    }
+    return;
+  }
+
+  forces.push_back(force);
+  UpdatePersistentForce();
+}
+
+void RuntimeObject::UpdatePersistentForce() {
+  float forceX = 0;
+  float forceY = 0;
+  for (std::size_t i = 0; i < forces.size(); i++) {
+    forceX += forces[i].GetX();
+    forceY += forces[i].GetY();
+  }
+  forceX += force5.GetX();
+  forceY += force5.GetY();
+
+  if (transforms)
+    transforms->SetPersistentForce(transformIndex, forceX, forceY);
+  else {
+    transform.persistentForceX = forceX;
+    transform.persistentForceY = forceY;
+  }
+}
+
 void RuntimeObject::AddForce(float x, float y, float clearing) {
-  forces.push_back(Force(x, y, clearing));
+  PushForce(Force(x, y, clearing));
 }
 
 void RuntimeObject::AddForceUsingPolarCoordinates(float angle,
                                                   float length,
                                                   float clearing) {
   angle *= 3.14159 / 180.0;
-  forces.push_back(Force(cos(angle) * length, sin(angle) * length, clearing));
+  PushForce(Force(cos(angle) * length, sin(angle) * length, clearing));
 }
 /**
  * Add a force toward a position
@@ -209,7 +289,7 @@ void RuntimeObject::AddForceTowardPosition(float positionX,
   double x = positionX - (GetDrawableX() + GetCenterX());
   float angle = atan2(y, x);
 
-  forces.push_back(Force(cos(angle) * length, sin(angle) * length, clearing));
+  PushForce(Force(cos(angle) * length, sin(angle) * length, clearing));
 }
 
 void RuntimeObject::AddForceToMoveAround(float positionX,
@@ -233,20 +313,19 @@ void RuntimeObject::AddForceToMoveAround(float positionX,
   int newX = cos(newangle / 180.f * 3.14159f) * distance;
   int newY = sin(newangle / 180.f * 3.14159f) * distance;
 
-  forces.push_back(Force(newX - oldX, newY - oldY, clearing));
+  PushForce(Force(newX - oldX, newY - oldY, clearing));
 }
 
-void RuntimeObject::Duplicate(
-    RuntimeScene &scene,
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists) {
+void RuntimeObject::Duplicate(RuntimeScene &scene,
+                              const PickedObjectsLists &pickedObjectLists) {
   RuntimeObject *newObject =
       scene.objectsInstances.AddObject(std::unique_ptr<RuntimeObject>(Clone()));
 
-  if (pickedObjectLists[name] != NULL &&
-      find(pickedObjectLists[name]->begin(),
-           pickedObjectLists[name]->end(),
-           newObject) == pickedObjectLists[name]->end())
-    pickedObjectLists[name]->push_back(newObject);
+  std::vector<RuntimeObject *> *pickedObjects = pickedObjectLists.Get(name);
+  if (pickedObjects != NULL &&
+      find(pickedObjects->begin(), pickedObjects->end(), newObject) ==
+          pickedObjects->end())
+    pickedObjects->push_back(newObject);
 }
 
 bool RuntimeObject::IsStopped() { return TotalForceLength() == 0; }
@@ -298,11 +377,9 @@ double RuntimeObject::GetDistanceWithObject(RuntimeObject *object) {
 }
 
 bool RuntimeObject::SeparateFromObjects(
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists,
-    bool ignoreTouchingEdges) {
+    const PickedObjectsLists &pickedObjectLists, bool ignoreTouchingEdges) {
   vector<RuntimeObject *> objects;
-  for (std::map<gd::String, std::vector<RuntimeObject *> *>::const_iterator it =
-           pickedObjectLists.begin();
+  for (PickedObjectsLists::const_iterator it = pickedObjectLists.begin();
        it != pickedObjectLists.end();
        ++it) {
     if (it->second != NULL) {
@@ -321,12 +398,14 @@ bool RuntimeObject::SeparateFromObjects(
   sf::Vector2f moveVector;
   for (std::size_t j = 0; j < objects.size(); ++j) {
     if (objects[j] != this) {
-      std::vector<Polygon2d> hitBoxes = GetHitBoxes(objects[j]->GetAABB());
-      vector<Polygon2d> otherHitBoxes = objects[j]->GetHitBoxes(GetAABB());
-      for (std::size_t k = 0; k < hitBoxes.size(); ++k) {
+      const std::vector<Polygon2d> &objHitBoxes =
+          GetHitBoxes(objects[j]->GetAABB());
+      const std::vector<Polygon2d> &otherHitBoxes =
+          objects[j]->GetHitBoxes(GetAABB());
+      for (std::size_t k = 0; k < objHitBoxes.size(); ++k) {
         for (std::size_t l = 0; l < otherHitBoxes.size(); ++l) {
           CollisionResult result = PolygonCollisionTest(
-              hitBoxes[k], otherHitBoxes[l], ignoreTouchingEdges);
+              objHitBoxes[k], otherHitBoxes[l], ignoreTouchingEdges);
           if (result.collision) {
             moveVector += result.move_axis;
             moved = true;
@@ -410,8 +489,8 @@ bool RuntimeObject::IsCollidingWith(RuntimeObject *obj2,
   sf::FloatRect objRect = obj1->GetAABB();
   sf::FloatRect obj2Rect = obj2->GetAABB();
 
-  vector<Polygon2d> objHitboxes = obj1->GetHitBoxes(obj2Rect);
-  vector<Polygon2d> obj2Hitboxes = obj2->GetHitBoxes(objRect);
+  const vector<Polygon2d> &objHitboxes = obj1->GetHitBoxes(obj2Rect);
+  const vector<Polygon2d> &obj2Hitboxes = obj2->GetHitBoxes(objRect);
   for (std::size_t k = 0; k < objHitboxes.size(); ++k) {
     for (std::size_t l = 0; l < obj2Hitboxes.size(); ++l) {
       if (PolygonCollisionTest(
@@ -425,9 +504,9 @@ bool RuntimeObject::IsCollidingWith(RuntimeObject *obj2,
 }
 
 bool RuntimeObject::IsCollidingWithPoint(float pointX, float pointY) {
-  vector<Polygon2d> hitBoxes = GetHitBoxes();
-  for (std::size_t i = 0; i < hitBoxes.size(); ++i) {
-    if (IsPointInsidePolygon(hitBoxes[i], pointX, pointY)) return true;
+  const vector<Polygon2d> &objHitBoxes = GetHitBoxes();
+  for (std::size_t i = 0; i < objHitBoxes.size(); ++i) {
+    if (IsPointInsidePolygon(objHitBoxes[i], pointX, pointY)) return true;
   }
 
   return false;
@@ -451,7 +530,7 @@ RaycastResult RuntimeObject::RaycastTest(
 
   float testSqDist = closest ? sqDist : 0.0f;
 
-  vector<Polygon2d> hitboxes = GetHitBoxes();
+  const vector<Polygon2d> &hitboxes = GetHitBoxes();
   for (std::size_t i = 0; i < hitboxes.size(); ++i) {
     RaycastResult res = PolygonRaycastTest(hitboxes[i], x, y, endX, endY);
 
@@ -471,10 +550,9 @@ RaycastResult RuntimeObject::RaycastTest(
 }
 
 void RuntimeObject::SeparateObjectsWithoutForces(
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists) {
+    const PickedObjectsLists &pickedObjectLists) {
   vector<RuntimeObject *> objects2;
-  for (std::map<gd::String, std::vector<RuntimeObject *> *>::const_iterator it =
-           pickedObjectLists.begin();
+  for (PickedObjectsLists::const_iterator it = pickedObjectLists.begin();
        it != pickedObjectLists.end();
        ++it) {
     if (it->second != NULL) {
@@ -511,10 +589,9 @@ void RuntimeObject::SeparateObjectsWithoutForces(
 }
 
 void RuntimeObject::SeparateObjectsWithForces(
-    std::map<gd::String, std::vector<RuntimeObject *> *> pickedObjectLists) {
+    const PickedObjectsLists &pickedObjectLists) {
   vector<RuntimeObject *> objects2;
-  for (std::map<gd::String, std::vector<RuntimeObject *> *>::const_iterator it =
-           pickedObjectLists.begin();
+  for (PickedObjectsLists::const_iterator it = pickedObjectLists.begin();
        it != pickedObjectLists.end();
        ++it) {
     if (it->second != NULL) {
@@ -542,6 +619,7 @@ void RuntimeObject::SeparateObjectsWithForces(
       } else {
         if (force5.GetY() == 0) force5.SetY(-(TotalForceY()) + 10);
       }
+      UpdatePersistentForce();
     }
   }
 }
@@ -626,17 +704,19 @@ sf::FloatRect RuntimeObject::GetAABB() const {
   return resultTransform.transformRect(notTransformedAABB);
 }
 
-std::vector<Polygon2d> RuntimeObject::GetHitBoxes() const {
-  std::vector<Polygon2d> mask;
-  Polygon2d rectangle = Polygon2d::CreateRectangle(GetWidth(), GetHeight());
-  rectangle.Rotate(GetAngle() / 180 * 3.14159);
-  rectangle.Move(GetX() + GetCenterX(), GetY() + GetCenterY());
+const std::vector<Polygon2d> &RuntimeObject::GetHitBoxes() const {
+  // The size or the angle of the object can be changed without the object
+  // being notified: the hitbox is computed again each time.
+  hitBoxes.resize(1);
+  hitBoxes[0] = Polygon2d::CreateRectangle(GetWidth(), GetHeight());
+  hitBoxes[0].Rotate(GetAngle() / 180 * 3.14159);
+  hitBoxes[0].Move(GetX() + GetCenterX(), GetY() + GetCenterY());
 
-  mask.push_back(rectangle);
-  return mask;
+  return hitBoxes;
 }
 
-std::vector<Polygon2d> RuntimeObject::GetHitBoxes(sf::FloatRect hint) const {
+const std::vector<Polygon2d> &RuntimeObject::GetHitBoxes(
+    sf::FloatRect hint) const {
   return GetHitBoxes();
 }
 
@@ -682,6 +762,14 @@ bool RuntimeObject::ClearForce() {
 
   forces.clear();
 
+  if (transforms)
+    transforms->ClearInstantForce(transformIndex);
+  else {
+    transform.instantForceX = 0;
+    transform.instantForceY = 0;
+  }
+  UpdatePersistentForce();
+
   return true;
 }
 
@@ -702,23 +790,25 @@ bool RuntimeObject::UpdateForce(float elapsedTime) {
     }
   }
 
+  if (transforms)
+    transforms->ClearInstantForce(transformIndex);
+  else {
+    transform.instantForceX = 0;
+    transform.instantForceY = 0;
+  }
+  UpdatePersistentForce();
+
   return true;
 }
 
 float RuntimeObject::TotalForceX() const {
-  float ForceXsimple = 0;
-  for (std::size_t i = 0; i < forces.size(); i++)
-    ForceXsimple += forces[i].GetX();
-
-  return ForceXsimple + force5.GetX();
+  return transforms ? transforms->GetTotalForceX(transformIndex)
+                    : transform.instantForceX + transform.persistentForceX;
 }
 
 float RuntimeObject::TotalForceY() const {
-  float ForceYsimple = 0;
-  for (std::size_t i = 0; i < forces.size(); i++)
-    ForceYsimple += forces[i].GetY();
-
-  return ForceYsimple + force5.GetY();
+  return transforms ? transforms->GetTotalForceY(transformIndex)
+                    : transform.instantForceY + transform.persistentForceY;
 }
 
 float RuntimeObject::TotalForceAngle() const {
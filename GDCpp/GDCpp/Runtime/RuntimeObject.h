@@ -13,6 +13,9 @@
 #include <vector>
 #include "GDCore/Tools/MakeUnique.h"
 #include "GDCpp/Runtime/Force.h"
+#include "GDCpp/Runtime/ObjectsTransforms.h"
+#include "GDCpp/Runtime/PickedObjectsLists.h"
+#include "GDCpp/Runtime/Polygon2d.h"
 #include "GDCpp/Runtime/RuntimeBehavior.h"
 #include "GDCpp/Runtime/RuntimeVariablesContainer.h"
 #include "GDCpp/Runtime/String.h"
@@ -23,9 +26,9 @@ class Object;
 namespace sf {
 class RenderTarget;
 }
-class Polygon2d;
 class RaycastResult;
 class RuntimeScene;
+class ObjInstancesHolder;
 
 /**
  * \brief A RuntimeObject is something displayed on the scene.
@@ -90,7 +93,10 @@ class GD_API RuntimeObject {
   /**
    * \brief Copy constructor. Calls Init().
    */
-  RuntimeObject(const RuntimeObject& object) { Init(object); };
+  RuntimeObject(const RuntimeObject& object)
+      : transforms(nullptr), transformIndex(0), instancesHolder(nullptr) {
+    Init(object);
+  };
 
   /**
    * \brief Assignment operator. Calls Init().
@@ -117,6 +123,25 @@ class GD_API RuntimeObject {
     return gd::make_unique<RuntimeObject>(*this);
   }
 
+  /**
+   * \brief Make the object a copy of \a object, reusing the memory already
+   * allocated by the object when possible. Used to recycle the objects deleted
+   * from a scene (see ObjectsPrototypes).
+   *
+   * The default implementation only supports objects which are exactly
+   * RuntimeObject. Redefine it in your derived object class like this:
+   * \code
+   * auto myObject = dynamic_cast<const MyRuntimeObject*>(&object);
+   * if (!myObject) return false;
+   *
+   * *this = *myObject;
+   * return true;
+   * \endcode
+   *
+   * \return false if the object can't be made a copy of \a object.
+   */
+  virtual bool Reinitialize(const RuntimeObject& object);
+
   /**
    * \brief Called by RuntimeScene when creating the RuntimeObject from an
    * initial instance.
@@ -206,12 +231,15 @@ class GD_API RuntimeObject {
   /**
    * \brief Query the Z order of the object
    */
-  inline int GetZOrder() const { return zOrder; }
+  inline int GetZOrder() const {
+    return transforms ? transforms->GetZOrder(transformIndex)
+                      : transform.zOrder;
+  }
 
   /**
    * \brief Change the Z order of the object
    */
-  inline void SetZOrder(int zOrder_) { zOrder = zOrder_; }
+  void SetZOrder(int zOrder_);
 
   /**
    * \brief Return if the object is hidden or not
@@ -231,7 +259,7 @@ class GD_API RuntimeObject {
   /**
    * \brief Change the layer of the object
    */
-  inline void SetLayer(const gd::String& layer_) { layer = layer_; }
+  void SetLayer(const gd::String& layer_);
 
   /**
    * \brief Get the layer of the object
@@ -248,21 +276,25 @@ class GD_API RuntimeObject {
   /**
    * \brief Get the object AABB
    */
-  sf::FloatRect GetAABB() const;
+  virtual sf::FloatRect GetAABB() const;
 
   /**
-   * \brief Get the object hitbox(es)
+   * \brief Get the object hitbox(es), in scene coordinates, with their edges
+   * computed (see Polygon2d::ComputeEdges).
+   *
    * \note Default implementation returns a basic bounding box, according to the
    * object width/height and angle.
+   * \note The returned hitboxes are owned by the object, and are only valid
+   * until the object is modified.
    */
-  virtual std::vector<Polygon2d> GetHitBoxes() const;
+  virtual const std::vector<Polygon2d>& GetHitBoxes() const;
 
   /**
    * \brief Get the object hitbox(es) preferably intersecting with hint
    * \note The default implementation returns all the hitbox given by
    * GetHitBoxes()
    */
-  virtual std::vector<Polygon2d> GetHitBoxes(sf::FloatRect hint) const;
+  virtual const std::vector<Polygon2d>& GetHitBoxes(sf::FloatRect hint) const;
 
   /**
    * \brief Check collision between two objects using their hitboxes.
@@ -380,12 +412,16 @@ class GD_API RuntimeObject {
   /**
    * \brief Get the X coordinate of the object in the layout.
    */
-  inline float GetX() const { return X; }
+  inline float GetX() const {
+    return transforms ? transforms->GetX(transformIndex) : transform.x;
+  }
 
   /**
    * \brief Get the Y coordinate of the object in the layout.
    */
-  inline float GetY() const { return Y; }
+  inline float GetY() const {
+    return transforms ? transforms->GetY(transformIndex) : transform.y;
+  }
 
   /**
    * \brief Change X position of the object.
@@ -393,7 +429,10 @@ class GD_API RuntimeObject {
    * extra work if needed.
    */
   void SetX(float x_) {
-    X = x_;
+    if (transforms)
+      transforms->SetX(transformIndex, x_);
+    else
+      transform.x = x_;
     OnPositionChanged();
   }
 
@@ -403,7 +442,10 @@ class GD_API RuntimeObject {
    * extra work if needed.
    */
   void SetY(float y_) {
-    Y = y_;
+    if (transforms)
+      transforms->SetY(transformIndex, y_);
+    else
+      transform.y = y_;
     OnPositionChanged();
   }
 
@@ -458,6 +500,8 @@ class GD_API RuntimeObject {
   ///@{
 
   Force force5;  ///< \deprecated Old custom force used to manage collisions.
+                 ///< Changes are taken into account by TotalForceX/Y after the
+                 ///< next call to UpdateForce.
 
   /**
    * Automatically called at each frame so as to update forces applied on the
@@ -576,9 +620,8 @@ class GD_API RuntimeObject {
              const char* yOperator,
              float yValue);
 
-  void Duplicate(
-      RuntimeScene& scene,
-      std::map<gd::String, std::vector<RuntimeObject*>*> pickedObjectLists);
+  void Duplicate(RuntimeScene& scene,
+                 const PickedObjectsLists& pickedObjectLists);
   void ActivateBehavior(const gd::String& behaviorName, bool activate = true);
   bool BehaviorActivated(const gd::String& behaviorName);
 
@@ -588,29 +631,24 @@ class GD_API RuntimeObject {
   double GetSqDistanceWithObject(RuntimeObject* other);
   double GetDistanceWithObject(RuntimeObject* other);
 
-  bool SeparateFromObjects(
-      std::map<gd::String, std::vector<RuntimeObject*>*> pickedObjectLists,
-      bool ignoreTouchingEdges = false);
+  bool SeparateFromObjects(const PickedObjectsLists& pickedObjectLists,
+                           bool ignoreTouchingEdges = false);
 
   /** \deprecated
    */
   void SeparateObjectsWithoutForces(
-      std::map<gd::String, std::vector<RuntimeObject*>*> pickedObjectLists);
+      const PickedObjectsLists& pickedObjectLists);
 
   /** \deprecated
    */
   void SeparateObjectsWithForces(
-      std::map<gd::String, std::vector<RuntimeObject*>*> pickedObjectLists);
+      const PickedObjectsLists& pickedObjectLists);
   ///@}
 
  protected:
   gd::String name;  ///< The full name of the object
   gd::String type;  ///< Which type is the object. ( To test if we can do
                     ///< something reserved to some objects with it )
-  float X;          ///< X position on the scene
-  float Y;          ///< Y position on the scene
-  int zOrder;   ///< Z order on the scene, to choose if an object is displayed
-                ///< before another object.
   bool hidden;  ///< True to prevent the object from being rendered.
   gd::String layer;  ///< Name of the layer on which the object is.
   std::map<gd::String, std::unique_ptr<RuntimeBehavior>>
@@ -618,13 +656,46 @@ class GD_API RuntimeObject {
                   ///< ownership of the object
   RuntimeVariablesContainer
       objectVariables;        ///< List of the variables of the object
-  std::vector<Force> forces;  ///< Forces applied to the object
+  mutable std::vector<Polygon2d>
+      hitBoxes;  ///< The hitboxes returned by GetHitBoxes. Objects can
+                 ///< update them only when needed.
+  std::vector<Force> forces;  ///< Forces applied to the object during more
+                              ///< than a frame. Their sum is kept in the
+                              ///< transform of the object.
 
   /**
    * \brief Initialize object using another object. Used by copy-ctor and
    * assign-op. \warning Don't forget to update me if members were changed!
    */
   void Init(const RuntimeObject& object);
+
+ private:
+  void PushForce(const Force& force);
+  void UpdatePersistentForce();
+
+  friend class ObjInstancesHolder;
+  friend class ObjectsTransforms;
+  friend class BehaviorsStepper;
+
+  ObjectsTransforms::Transform
+      transform;  ///< Position, Z order and forces of the object, used when
+                  ///< the object is not in an ObjectsTransforms. Use GetX,
+                  ///< GetY, GetZOrder or TotalForceX/Y to read them.
+  ObjectsTransforms* transforms;  ///< The store containing the position, Z
+                                  ///< order and forces of the object, if any.
+  std::size_t transformIndex;  ///< The index of the object in transforms.
+
+  ObjInstancesHolder* instancesHolder;  ///< The container owning the object,
+                                        ///< notified when the layer or the Z
+                                        ///< order is changed. Can be NULL.
+  std::size_t renderingLayerIndex;  ///< The rendering list of instancesHolder
+                                    ///< containing the object.
+  std::size_t renderingIndex;  ///< The position of the object in its
+                               ///< rendering list.
+  std::size_t objectNameId;  ///< The identifier of the list of instancesHolder
+                             ///< containing the object.
+  std::size_t objectIndex;  ///< The position of the object in its list of
+                            ///< instancesHolder.
 };
 
 #endif  // RUNTIMEOBJECT_H
@@ -20,3 +20,14 @@ void GD_API PickOnly(RuntimeObjectsLists& pickedObjectsLists,
   if (pickedObjectsLists[thisOne->GetName()] != NULL)
     pickedObjectsLists[thisOne->GetName()]->push_back(thisOne);
 }
+
+void GD_API PickOnly(const PickedObjectsLists& pickedObjectsLists,
+                     RuntimeObject* thisOne) {
+  for (const PickedObjectsLists::value_type& list : pickedObjectsLists) {
+    if (list.second != NULL) list.second->clear();
+  }
+
+  std::vector<RuntimeObject*>* list =
+      pickedObjectsLists.Get(thisOne->GetName());
+  if (list != NULL) list->push_back(thisOne);
+}
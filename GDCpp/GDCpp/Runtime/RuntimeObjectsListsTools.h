@@ -9,9 +9,21 @@
 #include <map>
 #include <string>
 #include <vector>
+#include "ObjectsBroadPhase.h"
+#include "ObjectsPickingMarks.h"
+#include "PickedObjectsLists.h"
 #include "RuntimeObject.h"
 #include "RuntimeScene.h"
 
+/**
+ * \brief Lists of objects indexed by the names of the objects.
+ *
+ * Events generated code gives PickedObjectsLists to the functions of
+ * conditions and actions, which are implicitly converted to this type for the
+ * functions (usually from extensions) still taking a RuntimeObjectsLists.
+ *
+ * The functions below are templates working with both types.
+ */
 typedef std::map<gd::String, std::vector<RuntimeObject *> *>
     RuntimeObjectsLists;
 
@@ -24,6 +36,66 @@ typedef std::map<gd::String, std::vector<RuntimeObject *> *>
 void GD_API PickOnly(RuntimeObjectsLists &pickedObjectsLists,
                      RuntimeObject *thisOne);
 
+/**
+ * \brief Keep only the specified object in the lists of picked objects.
+ * \param objectsLists The lists of objects to trim
+ * \param thisOne The object to keep in the lists
+ * \ingroup GameEngine
+ */
+void GD_API PickOnly(const PickedObjectsLists &pickedObjectsLists,
+                     RuntimeObject *thisOne);
+
+/**
+ * \brief Allocate a bitset in \a marks for each list of \a objectsLists, in
+ * the same order as the lists.
+ * \return The first bitset (the others are obtained with
+ * ObjectsPickingMarks::GetNext).
+ * \ingroup GameEngine
+ */
+template <typename ObjectsLists>
+std::size_t AllocatePickingMarks(ObjectsPickingMarks &marks,
+                                 const ObjectsLists &objectsLists) {
+  std::size_t firstBitset = marks.GetUsedWordsCount();
+  for (typename ObjectsLists::const_iterator it = objectsLists.begin();
+       it != objectsLists.end();
+       ++it)
+    marks.Allocate(it->second ? it->second->size() : 0);
+
+  return firstBitset;
+}
+
+/**
+ * \brief Remove from the lists the objects which are not marked in their
+ * bitset.
+ *
+ * Lists which size is not the size of their bitset are skipped, as they were
+ * already trimmed (see TwoObjectListsTest).
+ * \ingroup GameEngine
+ */
+template <typename ObjectsLists>
+void TrimNotPickedObjects(const ObjectsPickingMarks &marks,
+                          std::size_t firstBitset,
+                          const ObjectsLists &objectsLists) {
+  std::size_t bitset = firstBitset;
+  for (typename ObjectsLists::const_iterator it = objectsLists.begin();
+       it != objectsLists.end();
+       ++it, bitset = marks.GetNext(bitset)) {
+    if (!it->second) continue;
+    std::vector<RuntimeObject *> &arr = *it->second;
+    if (arr.size() != marks.GetSize(bitset)) continue;
+
+    size_t finalSize = 0;
+    for (std::size_t k = 0; k < arr.size(); ++k) {
+      RuntimeObject *obj = arr[k];
+      if (marks.IsMarked(bitset, k)) {
+        arr[finalSize] = obj;
+        finalSize++;
+      }
+    }
+    arr.resize(finalSize);
+  }
+}
+
 /**
  * \brief Filter objects to keep only the one that fullfil the predicate
  *
@@ -35,58 +107,40 @@ void GD_API PickOnly(RuntimeObjectsLists &pickedObjectsLists,
  * true if the object fulfill the predicate. \return true if at least one object
  * fulfill the predicate.
  *
+ * \note Picked objects are marked using ObjectsPickingMarks::Get(), so that no
+ * memory is allocated.
+ *
  * \ingroup GameEngine
  */
-template <typename Pred>
-bool PickObjectsIf(const RuntimeObjectsLists &pickedObjectsLists,
+template <typename ObjectsLists, typename Pred>
+bool PickObjectsIf(const ObjectsLists &pickedObjectsLists,
                    bool negatePredicate,
                    Pred predicate) {
   bool isTrue = false;
 
-  // Create a boolean for each object
-  std::vector<std::vector<bool> > pickedList;
-  for (RuntimeObjectsLists::const_iterator it = pickedObjectsLists.begin();
-       it != pickedObjectsLists.end();
-       ++it) {
-    std::vector<bool> arr;
-    arr.assign(it->second->size(), false);
-    pickedList.push_back(arr);
-  }
+  // Create a mark for each object
+  ObjectsPickingMarks &marks = ObjectsPickingMarks::Get();
+  ObjectsPickingMarks::Scope marksScope(marks);
+  std::size_t firstBitset = AllocatePickingMarks(marks, pickedObjectsLists);
 
   // Pick objects which are fulfulling the predicate.
-  std::size_t i = 0;
-  for (RuntimeObjectsLists::const_iterator it = pickedObjectsLists.begin();
+  std::size_t bitset = firstBitset;
+  for (typename ObjectsLists::const_iterator it = pickedObjectsLists.begin();
        it != pickedObjectsLists.end();
-       ++it, ++i) {
+       ++it, bitset = marks.GetNext(bitset)) {
     if (!it->second) continue;
     const std::vector<RuntimeObject *> &arr1 = *it->second;
 
     for (std::size_t k = 0; k < arr1.size(); ++k) {
       if (negatePredicate ^ predicate(arr1[k])) {
-        pickedList[i][k] = true;
+        marks.Mark(bitset, k);
         isTrue = true;
       }
     }
   }
 
   // Trim not picked objects from lists.
-  i = 0;
-  for (RuntimeObjectsLists::const_iterator it = pickedObjectsLists.begin();
-       it != pickedObjectsLists.end();
-       ++it, ++i) {
-    size_t finalSize = 0;
-    if (!it->second) continue;
-    std::vector<RuntimeObject *> &arr = *it->second;
-
-    for (std::size_t k = 0; k < arr.size(); ++k) {
-      RuntimeObject *obj = arr[k];
-      if (pickedList[i][k]) {
-        arr[finalSize] = obj;
-        finalSize++;
-      }
-    }
-    arr.resize(finalSize);
-  }
+  TrimNotPickedObjects(marks, firstBitset, pickedObjectsLists);
 
   return isTrue;
 }
@@ -107,65 +161,56 @@ bool PickObjectsIf(const RuntimeObjectsLists &pickedObjectsLists,
  * when trimming the list).
  *
  * Cost (Worst case, predicate being always false):
- *    Cost(Creating tables with a total of NbObjList1+NbObjList2 booleans)
+ *    Cost(Clearing NbObjList1+NbObjList2 marks)
  *  + Cost(predicate)*NbObjList1*NbObjList2
- *  + Cost(Testing NbObjList1+NbObjList2 booleans)
+ *  + Cost(Testing NbObjList1+NbObjList2 marks)
  *  + Cost(Removing NbObjList1+NbObjList2 objects from all the lists)
  *
  * Cost (Best case, predicate being always true):
- *    Cost(Creating tables with a total of NbObjList1+NbObjList2 booleans)
+ *    Cost(Clearing NbObjList1+NbObjList2 marks)
  *  + Cost(predicate)*(NbObjList1+NbObjList2)
- *  + Cost(Testing NbObjList1+NbObjList2 booleans)
+ *  + Cost(Testing NbObjList1+NbObjList2 marks)
+ *
+ * \note Picked objects are marked using ObjectsPickingMarks::Get(), so that no
+ * memory is allocated.
  *
  * \ingroup GameEngine
  */
-template <typename Pred>
-bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
-                        RuntimeObjectsLists objectsLists2,
+template <typename ObjectsLists1, typename ObjectsLists2, typename Pred>
+bool TwoObjectListsTest(const ObjectsLists1 &objectsLists1,
+                        const ObjectsLists2 &objectsLists2,
                         bool negatePredicate,
                         Pred predicate) {
   bool isTrue = false;
 
-  // Create a boolean for each object
-  std::vector<std::vector<bool> > pickedList1;
-  std::vector<std::vector<bool> > pickedList2;
-
-  for (RuntimeObjectsLists::const_iterator it = objectsLists1.begin();
-       it != objectsLists1.end();
-       ++it) {
-    std::vector<bool> arr;
-    arr.assign(it->second->size(), false);
-    pickedList1.push_back(arr);
-  }
-  for (RuntimeObjectsLists::const_iterator it = objectsLists2.begin();
-       it != objectsLists2.end();
-       ++it) {
-    std::vector<bool> arr;
-    arr.assign(it->second->size(), false);
-    pickedList2.push_back(arr);
-  }
+  // Create a mark for each object
+  ObjectsPickingMarks &marks = ObjectsPickingMarks::Get();
+  ObjectsPickingMarks::Scope marksScope(marks);
+  std::size_t firstBitset1 = AllocatePickingMarks(marks, objectsLists1);
+  std::size_t firstBitset2 = AllocatePickingMarks(marks, objectsLists2);
 
   // Launch the function each object of the first list with each object
   // of the second list.
-  std::size_t i = 0;
-  for (RuntimeObjectsLists::const_iterator it = objectsLists1.begin();
+  std::size_t bitset1 = firstBitset1;
+  for (typename ObjectsLists1::const_iterator it = objectsLists1.begin();
        it != objectsLists1.end();
-       ++it, ++i) {
+       ++it, bitset1 = marks.GetNext(bitset1)) {
     if (!it->second) continue;
     const std::vector<RuntimeObject *> &arr1 = *it->second;
 
     for (std::size_t k = 0; k < arr1.size(); ++k) {
       bool atLeastOneObject = false;
 
-      std::size_t j = 0;
-      for (RuntimeObjectsLists::const_iterator it2 = objectsLists2.begin();
+      std::size_t bitset2 = firstBitset2;
+      for (typename ObjectsLists2::const_iterator it2 =
+               objectsLists2.begin();
            it2 != objectsLists2.end();
-           ++it2, ++j) {
+           ++it2, bitset2 = marks.GetNext(bitset2)) {
         if (!it2->second) continue;
         const std::vector<RuntimeObject *> &arr2 = *it2->second;
 
         for (std::size_t l = 0; l < arr2.size(); ++l) {
-          if (pickedList1[i][k] && pickedList2[j][l])
+          if (marks.IsMarked(bitset1, k) && marks.IsMarked(bitset2, l))
             continue;  // Avoid unnecessary costly call to functor.
 
           if (std::addressof(arr1[k]) != std::addressof(arr2[l]) &&
@@ -174,8 +219,8 @@ bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
               isTrue = true;
 
               // Pick the objects
-              pickedList1[i][k] = true;
-              pickedList2[j][l] = true;
+              marks.Mark(bitset1, k);
+              marks.Mark(bitset2, l);
             }
 
             atLeastOneObject = true;
@@ -186,56 +231,116 @@ bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
       if (!atLeastOneObject &&
           negatePredicate) {  // The object is not overlapping any other object.
         isTrue = true;
-        pickedList1[i][k] = true;
+        marks.Mark(bitset1, k);
       }
     }
   }
 
   // Trim not picked objects from lists.
-  i = 0;
-  for (RuntimeObjectsLists::const_iterator it = objectsLists1.begin();
+  TrimNotPickedObjects(marks, firstBitset1, objectsLists1);
+
+  //*This is important*! We can have a list that has already been trimmed
+  // just before: TrimNotPickedObjects skips lists which size is not the size
+  // of their marks.
+  if (!negatePredicate)
+    TrimNotPickedObjects(marks, firstBitset2, objectsLists2);
+
+  return isTrue;
+}
+
+/**
+ * \brief Same as TwoObjectListsTest, but only calls the predicate on pairs of
+ * objects which bounding circles are overlapping.
+ *
+ * The objects of objectsLists2 are put in \a broadPhase (usually the one of the
+ * scene, see RuntimeScene::GetObjectsBroadPhase) and each object of
+ * objectsLists1 is only tested against the objects found in the cells it
+ * covers.
+ *
+ * \warning The predicate must be false for any pair of objects which bounding
+ * circles (as used by RuntimeObject::IsCollidingWith) are not overlapping,
+ * otherwise the result would be different from TwoObjectListsTest.
+ *
+ * Cost (Worst case, predicate being always false):
+ *    Cost(Clearing NbObjList1+NbObjList2 marks)
+ *  + Cost(Inserting NbObjList2 objects in the grid)
+ *  + Cost(predicate)*NbOverlappingPairs
+ *  + Cost(Removing NbObjList1+NbObjList2 objects from all the lists)
+ *
+ * \ingroup GameEngine
+ */
+template <typename ObjectsLists1, typename ObjectsLists2, typename Pred>
+bool TwoObjectListsTestWithBroadPhase(const ObjectsLists1 &objectsLists1,
+                                      const ObjectsLists2 &objectsLists2,
+                                      bool negatePredicate,
+                                      ObjectsBroadPhase &broadPhase,
+                                      Pred predicate) {
+  bool isTrue = false;
+
+  // Create a mark for each object
+  ObjectsPickingMarks &marks = ObjectsPickingMarks::Get();
+  ObjectsPickingMarks::Scope marksScope(marks);
+  std::size_t firstBitset1 = AllocatePickingMarks(marks, objectsLists1);
+  std::size_t firstBitset2 = AllocatePickingMarks(marks, objectsLists2);
+
+  // Put the objects of the second list in the grid, with the bitset of their
+  // list as the list index.
+  broadPhase.Clear();
+  std::size_t bitset2 = firstBitset2;
+  for (typename ObjectsLists2::const_iterator it2 = objectsLists2.begin();
+       it2 != objectsLists2.end();
+       ++it2, bitset2 = marks.GetNext(bitset2)) {
+    if (!it2->second) continue;
+    const std::vector<RuntimeObject *> &arr2 = *it2->second;
+    for (std::size_t l = 0; l < arr2.size(); ++l)
+      broadPhase.Insert(arr2[l], std::addressof(arr2[l]), bitset2, l);
+  }
+  broadPhase.Build();
+
+  // Launch the function on each object of the first list with each object
+  // of the second list that is near enough.
+  std::size_t bitset1 = firstBitset1;
+  for (typename ObjectsLists1::const_iterator it = objectsLists1.begin();
        it != objectsLists1.end();
-       ++it, ++i) {
-    size_t finalSize = 0;
+       ++it, bitset1 = marks.GetNext(bitset1)) {
     if (!it->second) continue;
-    std::vector<RuntimeObject *> &arr = *it->second;
+    const std::vector<RuntimeObject *> &arr1 = *it->second;
 
-    for (std::size_t k = 0; k < arr.size(); ++k) {
-      RuntimeObject *obj = arr[k];
-      if (pickedList1[i][k]) {
-        arr[finalSize] = obj;
-        finalSize++;
-      }
-    }
-    arr.resize(finalSize);
-  }
+    for (std::size_t k = 0; k < arr1.size(); ++k) {
+      bool atLeastOneObject = false;
 
-  if (!negatePredicate) {
-    std::size_t i = 0;
-    for (RuntimeObjectsLists::const_iterator it = objectsLists2.begin();
-         it != objectsLists2.end();
-         ++it, ++i) {
-      size_t finalSize = 0;
-      if (!it->second) continue;
-      std::vector<RuntimeObject *> &arr = *it->second;
-
-      //*This is important*! We can have a list that has already been trimmed
-      // just before
-      if (arr.size() !=
-          pickedList2[i].size())  // If the size of the objects list != size of
-                                  // the boolean "picked" list...
-        continue;  //... then the object list was already trimmed, skip it.
-
-      for (std::size_t k = 0; k < arr.size(); ++k) {
-        RuntimeObject *obj = arr[k];
-        if (pickedList2[i][k]) {
-          arr[finalSize] = obj;
-          finalSize++;
-        }
+      broadPhase.ForEachCandidate(
+          arr1[k],
+          [&](RuntimeObject *const *slot, std::size_t bitset, std::size_t l) {
+            if (marks.IsMarked(bitset1, k) && marks.IsMarked(bitset, l))
+              return;  // Avoid unnecessary costly call to functor.
+
+            if (std::addressof(arr1[k]) != slot && predicate(arr1[k], *slot)) {
+              if (!negatePredicate) {
+                isTrue = true;
+
+                // Pick the objects
+                marks.Mark(bitset1, k);
+                marks.Mark(bitset, l);
+              }
+
+              atLeastOneObject = true;
+            }
+          });
+
+      if (!atLeastOneObject &&
+          negatePredicate) {  // The object is not overlapping any other object.
+        isTrue = true;
+        marks.Mark(bitset1, k);
       }
-      arr.resize(finalSize);
     }
   }
+  broadPhase.Clear();
+
+  // Trim not picked objects from lists (see TwoObjectListsTest).
+  TrimNotPickedObjects(marks, firstBitset1, objectsLists1);
+  if (!negatePredicate)
+    TrimNotPickedObjects(marks, firstBitset2, objectsLists2);
 
   return isTrue;
 }
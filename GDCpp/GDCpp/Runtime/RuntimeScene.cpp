@@ -13,6 +13,7 @@
 #include "GDCpp/Extensions/CppPlatform.h"
 #include "GDCpp/Runtime/BehaviorsRuntimeSharedData.h"
 #include "GDCpp/Runtime/FontManager.h"
+#include "GDCpp/Runtime/FrameProfiler.h"
 #include "GDCpp/Runtime/ImageManager.h"
 #include "GDCpp/Runtime/ManualTimer.h"
 #include "GDCpp/Runtime/Project/BehaviorsSharedData.h"
@@ -56,6 +57,8 @@ RuntimeScene::RuntimeScene(sf::RenderWindow* renderWindow_, RuntimeGame* game_)
       isFullScreen(false),
       inputManager(renderWindow_),
       codeExecutionEngine(new CodeExecutionEngine) {
+  if (game)
+    objectsInstances.SetObjectNamesTable(game->GetSharedObjectNamesTable());
   ChangeRenderWindow(renderWindow);
 }
 
@@ -72,6 +75,7 @@ RuntimeScene::~RuntimeScene() {
   objectsInstances.Clear();  // Force destroy objects NOW as they can have
                              // pointers to some RuntimeScene members which so
                              // need to be destroyed AFTER objects.
+  objectsPrototypes.Clear();
 }
 
 std::shared_ptr<gd::ImageManager> RuntimeScene::GetImageManager() const {
@@ -118,11 +122,23 @@ void RuntimeScene::RequestChange(SceneChange::Change change,
 }
 
 bool RuntimeScene::RenderAndStep() {
+  frameProfiler.BeginFrame();
   requestedChange.change = SceneChange::CONTINUE;
-  ManageRenderTargetEvents();
+  {
+    FrameProfiler::Scope scope(frameProfiler, FrameProfiler::INPUTS);
+    ManageRenderTargetEvents();
+  }
   timeManager.Update(clock.restart().asMicroseconds(), game->GetMinimumFPS());
-  ManageObjectsBeforeEvents();
-  if (game) game->GetSoundManager().ManageGarbage();
+  {
+    FrameProfiler::Scope scope(frameProfiler,
+                               FrameProfiler::BEHAVIORS_PRE_EVENTS);
+    ManageObjectsBeforeEvents();
+  }
+  if (game) {
+    FrameProfiler::Scope scope(frameProfiler,
+                               FrameProfiler::SOUNDS_GARBAGE_COLLECTION);
+    game->GetSoundManager().ManageGarbage();
+  }
 
 #if defined(GD_IDE_ONLY)
   if (GetProfiler()) {
@@ -131,7 +147,10 @@ bool RuntimeScene::RenderAndStep() {
   }
 #endif
 
-  GetCodeExecutionEngine()->Execute();
+  {
+    FrameProfiler::Scope scope(frameProfiler, FrameProfiler::EVENTS);
+    GetCodeExecutionEngine()->Execute();
+  }
 
 #if defined(GD_IDE_ONLY)
   if (GetProfiler() && GetProfiler()->profilingActivated) {
@@ -148,7 +167,10 @@ bool RuntimeScene::RenderAndStep() {
 #endif
 
   // Rendering
-  Render();
+  {
+    FrameProfiler::Scope scope(frameProfiler, FrameProfiler::RENDERING);
+    Render();
+  }
 
 #if defined(GD_IDE_ONLY)
   if (GetProfiler() && GetProfiler()->profilingActivated) {
@@ -161,6 +183,7 @@ bool RuntimeScene::RenderAndStep() {
   }
 #endif
 
+  frameProfiler.EndFrame();
   return requestedChange.change != SceneChange::CONTINUE;
 }
 
@@ -201,10 +224,6 @@ void RuntimeScene::Render() {
                                 GetBackgroundColorGreen(),
                                 GetBackgroundColorBlue()));
 
-  // Sort object by order to render them
-  RuntimeObjNonOwningPtrList allObjects = objectsInstances.GetAllObjects();
-  OrderObjectsByZOrder(allObjects);
-
 #if !defined(ANDROID)  // TODO: OpenGL
   // To allow using OpenGL to draw:
   glClear(GL_DEPTH_BUFFER_BIT);  // Clear the depth buffer
@@ -215,6 +234,11 @@ void RuntimeScene::Render() {
   // Draw layer by layer
   for (std::size_t layerIndex = 0; layerIndex < layers.size(); ++layerIndex) {
     if (layers[layerIndex].GetVisibility()) {
+      // Objects of the layer, sorted by Z order
+      const RuntimeObjNonOwningPtrList& layerObjects =
+          objectsInstances.GetObjectsToRender(layerIndex,
+                                              !StandardSortMethod());
+
       for (std::size_t cameraIndex = 0;
            cameraIndex < layers[layerIndex].GetCameraCount();
            ++cameraIndex) {
@@ -249,10 +273,7 @@ void RuntimeScene::Render() {
         renderWindow->setView(camera.GetSFMLView());
 
         // Rendering all objects
-        for (std::size_t id = 0; id < allObjects.size(); ++id) {
-          if (allObjects[id]->GetLayer() == layers[layerIndex].GetName())
-            allObjects[id]->Draw(*renderWindow);
-        }
+        for (RuntimeObject* object : layerObjects) object->Draw(*renderWindow);
       }
     }
   }
@@ -265,23 +286,6 @@ void RuntimeScene::Render() {
   renderWindow->display();
 }
 
-bool RuntimeScene::OrderObjectsByZOrder(RuntimeObjNonOwningPtrList& objList) {
-  if (StandardSortMethod())
-    std::sort(objList.begin(),
-              objList.end(),
-              [](const RuntimeObject* o1, const RuntimeObject* o2) {
-                return o1->GetZOrder() < o2->GetZOrder();
-              });
-  else
-    std::stable_sort(objList.begin(),
-                     objList.end(),
-                     [](const RuntimeObject* o1, const RuntimeObject* o2) {
-                       return o1->GetZOrder() < o2->GetZOrder();
-                     });
-
-  return true;
-}
-
 RuntimeLayer& RuntimeScene::GetRuntimeLayer(const gd::String& name) {
   for (RuntimeLayer& layer : layers) {
     if (layer.GetName() == name) return layer;
@@ -300,40 +304,68 @@ const RuntimeLayer& RuntimeScene::GetRuntimeLayer(
 }
 
 void RuntimeScene::ManageObjectsAfterEvents() {
-  // Delete objects that were removed.
-  RuntimeObjNonOwningPtrList allObjects = objectsInstances.GetAllObjects();
-  for (std::size_t id = 0; id < allObjects.size(); ++id) {
-    if (allObjects[id]->GetName().empty()) {
-      for (std::size_t i = 0; i < extensionsToBeNotifiedOnObjectDeletion.size();
-           ++i)
+  // Delete objects that were removed. Their name was emptied, so they are all
+  // in the same list.
+  {
+    FrameProfiler::Scope scope(frameProfiler, FrameProfiler::OBJECTS_DELETION);
+    RuntimeObjNonOwningPtrList removedObjects =
+        objectsInstances.GetObjectsRawPointers("");
+    for (RuntimeObject* object : removedObjects) {
+      for (std::size_t i = 0;
+           i < extensionsToBeNotifiedOnObjectDeletion.size();
+           ++i) {
+        FrameProfiler::Scope extensionScope(
+            frameProfiler, objectDeletionSectionsIds[i]);
         extensionsToBeNotifiedOnObjectDeletion[i]->ObjectDeletedFromScene(
-            *this, allObjects[id]);
+            *this, object);
+      }
 
-      objectsInstances.RemoveObject(
-          allObjects[id]);  // Remove from objects instances, not from the
-                            // temporary list!
+      objectsPrototypes.Recycle(objectsInstances.RemoveObject(object));
     }
   }
 
-  // Update objects positions, forces and behaviors
-  allObjects = objectsInstances.GetAllObjects();
+  // Move all objects according to their forces, using the elapsed time of
+  // their layer.
+  ObjectsTransforms& transforms = objectsInstances.GetTransforms();
+  {
+    FrameProfiler::Scope scope(frameProfiler, FrameProfiler::FORCES);
+    layersElapsedTimes.resize(layers.size());
+    for (std::size_t i = 0; i < layers.size(); ++i)
+      layersElapsedTimes[i] =
+          static_cast<double>(layers[i].GetElapsedTime(*this)) / 1000000.0;
+
+    transforms.ApplyForces(
+        layersElapsedTimes,
+        static_cast<double>(badRuntimeLayer.GetElapsedTime(*this)) /
+            1000000.0);
+  }
+
+  // Notify all the moved objects before any behavior is stepped, so that
+  // behaviors see the up-to-date hitboxes of the other objects.
+  RuntimeObjNonOwningPtrList allObjects = objectsInstances.GetAllObjects();
+  for (RuntimeObject* object : allObjects) {
+    if (object->TotalForceX() != 0 || object->TotalForceY() != 0)
+      object->OnPositionChanged();
+  }
+
+  // Update objects forces and behaviors
+  FrameProfiler::Scope scope(frameProfiler, FrameProfiler::OBJECTS_UPDATE);
   for (RuntimeObject* object : allObjects) {
-    double elapsedTimeInSeconds =
-        static_cast<double>(object->GetElapsedTime(*this)) / 1000000.0;
-    object->SetX(object->GetX() +
-                 (object->TotalForceX() * elapsedTimeInSeconds));
-    object->SetY(object->GetY() +
-                 (object->TotalForceY() * elapsedTimeInSeconds));
     object->Update(*this);
-    object->UpdateForce(elapsedTimeInSeconds);
-    object->DoBehaviorsPostEvents(*this);
+    object->UpdateForce(transforms.GetElapsedTime(object));
+    behaviorsStepper.StepObjectBehaviors(
+        *object, *this, BehaviorsStepper::POST_EVENTS);
   }
+  behaviorsStepper.StepThreadSafeBehaviors(*this,
+                                           BehaviorsStepper::POST_EVENTS);
 }
 
 void RuntimeScene::ManageObjectsBeforeEvents() {
   RuntimeObjNonOwningPtrList allObjects = objectsInstances.GetAllObjects();
   for (std::size_t id = 0; id < allObjects.size(); ++id)
-    allObjects[id]->DoBehaviorsPreEvents(*this);
+    behaviorsStepper.StepObjectBehaviors(
+        *allObjects[id], *this, BehaviorsStepper::PRE_EVENTS);
+  behaviorsStepper.StepThreadSafeBehaviors(*this, BehaviorsStepper::PRE_EVENTS);
 }
 
 /**
@@ -341,32 +373,14 @@ void RuntimeScene::ManageObjectsBeforeEvents() {
  */
 class ObjectsFromInitialInstanceCreator : public gd::InitialInstanceFunctor {
  public:
-  ObjectsFromInitialInstanceCreator(gd::Project& game_,
-                                    RuntimeScene& scene_,
+  ObjectsFromInitialInstanceCreator(RuntimeScene& scene_,
                                     float xOffset_,
                                     float yOffset_)
-      : game(game_), scene(scene_), xOffset(xOffset_), yOffset(yOffset_){};
+      : scene(scene_), xOffset(xOffset_), yOffset(yOffset_){};
   virtual ~ObjectsFromInitialInstanceCreator(){};
 
   virtual void operator()(gd::InitialInstance& instance) {
-    std::vector<ObjSPtr>::const_iterator sceneObject =
-        std::find_if(scene.GetObjects().begin(),
-                     scene.GetObjects().end(),
-                     std::bind2nd(ObjectHasName(), instance.GetObjectName()));
-    std::vector<ObjSPtr>::const_iterator globalObject =
-        std::find_if(game.GetObjects().begin(),
-                     game.GetObjects().end(),
-                     std::bind2nd(ObjectHasName(), instance.GetObjectName()));
-
-    RuntimeObjSPtr newObject;
-
-    if (sceneObject !=
-        scene.GetObjects().end())  // We check first scene's objects' list.
-      newObject = CppPlatform::Get().CreateRuntimeObject(scene, **sceneObject);
-    else if (globalObject !=
-             scene.game->GetObjects().end())  // Then the global object list
-      newObject = CppPlatform::Get().CreateRuntimeObject(scene, **globalObject);
-
+    RuntimeObjSPtr newObject = scene.CreateObject(instance.GetObjectName());
     if (newObject != std::unique_ptr<RuntimeObject>()) {
       newObject->SetX(instance.GetX() + xOffset);
       newObject->SetY(instance.GetY() + yOffset);
@@ -390,7 +404,6 @@ class ObjectsFromInitialInstanceCreator : public gd::InitialInstanceFunctor {
   }
 
  private:
-  gd::Project& game;
   RuntimeScene& scene;
   float xOffset;
   float yOffset;
@@ -400,7 +413,7 @@ void RuntimeScene::CreateObjectsFrom(
     const gd::InitialInstancesContainer& container,
     float xOffset,
     float yOffset) {
-  ObjectsFromInitialInstanceCreator func(*game, *this, xOffset, yOffset);
+  ObjectsFromInitialInstanceCreator func(*this, xOffset, yOffset);
   const_cast<gd::InitialInstancesContainer&>(container).IterateOverInstances(
       func);
 }
@@ -412,6 +425,12 @@ bool RuntimeScene::LoadFromScene(const gd::Layout& scene) {
 bool RuntimeScene::LoadFromSceneAndCustomInstances(
     const gd::Layout& scene, const gd::InitialInstancesContainer& instances) {
   std::cout << "Loading RuntimeScene from a scene.";
+  if (!CopyFromScene(scene)) return false;
+
+  return FinishLoading(instances);
+}
+
+bool RuntimeScene::CopyFromScene(const gd::Layout& scene) {
   if (!game) {
     std::cout << "..No valid gd::Project associated to the RuntimeScene. "
                  "Aborting loading."
@@ -422,17 +441,30 @@ bool RuntimeScene::LoadFromSceneAndCustomInstances(
   // Copy inherited scene
   Scene::operator=(scene);
 
+  // Initialize variables
+  variables = scene.GetVariables();
+
+  return true;
+}
+
+bool RuntimeScene::LoadFromCopiedScene() {
+  std::cout << "Loading RuntimeScene from a copied scene.";
+  return FinishLoading(GetInitialInstances());
+}
+
+bool RuntimeScene::FinishLoading(
+    const gd::InitialInstancesContainer& instances) {
+  if (!game) return false;
+
   // Clear RuntimeScene datas
   objectsInstances.Clear();
+  objectsPrototypes.Clear();
   timeManager.Reset();
 
   std::cout << ".";
   codeExecutionEngine->runtimeContext.scene = this;
   inputManager.DisableInputWhenFocusIsLost(IsInputDisabledWhenFocusIsLost());
 
-  // Initialize variables
-  variables = scene.GetVariables();
-
   // Initialize layers
   std::cout << ".";
   layers.clear();
@@ -440,9 +472,17 @@ bool RuntimeScene::LoadFromSceneAndCustomInstances(
                                      0.0f,
                                      game->GetGameResolutionWidth(),
                                      game->GetGameResolutionHeight()));
+  std::vector<gd::String> layersNames;
   for (std::size_t i = 0; i < GetLayersCount(); ++i) {
     layers.push_back(RuntimeLayer(GetLayer(i), defaultView));
+    layersNames.push_back(layers.back().GetName());
   }
+  objectsInstances.SetRenderingLayers(layersNames);
+
+  // Give an identifier to the names of the objects now, so that events only
+  // have to find them once.
+  for (std::size_t i = 0; i < GetObjectsCount(); ++i)
+    game->GetObjectNamesTable().GetId(GetObject(i).GetName());
 
   // Create object instances which are originally positioned on scene
   std::cout << ".";
@@ -450,7 +490,7 @@ bool RuntimeScene::LoadFromSceneAndCustomInstances(
 
   // Behaviors shared data
   std::cout << ".";
-  behaviorsSharedDatas.LoadFrom(scene.GetAllBehaviorSharedData());
+  behaviorsSharedDatas.LoadFrom(GetAllBehaviorSharedData());
 
   std::cout << ".";
   // Extensions specific initialization
@@ -461,8 +501,11 @@ bool RuntimeScene::LoadFromSceneAndCustomInstances(
         std::dynamic_pointer_cast<ExtensionBase>(gdExtension);
     if (extension != std::shared_ptr<ExtensionBase>()) {
       extension->SceneLoaded(*this);
-      if (extension->ToBeNotifiedOnObjectDeletion())
+      if (extension->ToBeNotifiedOnObjectDeletion()) {
         extensionsToBeNotifiedOnObjectDeletion.push_back(extension.get());
+        objectDeletionSectionsIds.push_back(FrameProfiler::GetSectionId(
+            "Objects deletion: " + game->GetUsedExtensions()[i]));
+      }
     }
   }
 
@@ -12,8 +12,12 @@
 #include <string>
 #include <vector>
 #include "GDCpp/Runtime/BehaviorsRuntimeSharedDataHolder.h"
+#include "GDCpp/Runtime/BehaviorsStepper.h"
+#include "GDCpp/Runtime/FrameProfiler.h"
 #include "GDCpp/Runtime/InputManager.h"
 #include "GDCpp/Runtime/ObjInstancesHolder.h"
+#include "GDCpp/Runtime/ObjectsBroadPhase.h"
+#include "GDCpp/Runtime/ObjectsPrototypes.h"
 #include "GDCpp/Runtime/Project/Layout.h"
 #include "GDCpp/Runtime/RuntimeLayer.h"
 #include "GDCpp/Runtime/RuntimeVariablesContainer.h"
@@ -102,6 +106,48 @@ class GD_API RuntimeScene : public Scene {
    */
   TimeManager& GetTimeManager() { return timeManager; }
 
+  /**
+   * \brief Get the grid used to find objects that could be colliding.
+   * \see TwoObjectListsTestWithBroadPhase
+   */
+  ObjectsBroadPhase& GetObjectsBroadPhase() { return objectsBroadPhase; }
+
+  /**
+   * \brief Get the prototypes used to create the objects, and the pools of
+   * objects deleted from the scene.
+   *
+   * Enable the pooling (see ObjectsPrototypes::EnablePooling) to recycle
+   * the objects deleted from the scene when new objects are created.
+   */
+  ObjectsPrototypes& GetObjectsPrototypes() { return objectsPrototypes; }
+
+  /**
+   * \brief Create a new instance of the object called \a name (searched in the
+   * objects of the scene then in the global objects).
+   *
+   * \note The object is not added to the scene: add it to objectsInstances.
+   * \return The new object, or nullptr if no object has this name.
+   */
+  RuntimeObjSPtr CreateObject(const gd::String& name) {
+    return objectsPrototypes.CreateObject(*this, name);
+  }
+
+  /**
+   * \brief Get the object running the steps of the objects behaviors.
+   *
+   * Use it to make the steps of the behaviors deterministic (see
+   * BehaviorsStepper::SetDeterministic).
+   */
+  BehaviorsStepper& GetBehaviorsStepper() { return behaviorsStepper; }
+
+  /**
+   * \brief Get the profiler measuring the phases of each frame of the scene.
+   *
+   * The profiler is disabled by default: enable it to measure frames, then
+   * export the trace or read the histograms of the phases.
+   */
+  FrameProfiler& GetFrameProfiler() { return frameProfiler; }
+
   /**
    * Get the layer with specified name.
    */
@@ -140,6 +186,22 @@ class GD_API RuntimeScene : public Scene {
   bool LoadFromSceneAndCustomInstances(
       const gd::Layout& scene, const gd::InitialInstancesContainer& instances);
 
+  /**
+   * \brief Copy a gd::Layout into the RuntimeScene, which is the first step of
+   * LoadFromScene.
+   *
+   * The game is only read, so this can be done in a thread other than the game
+   * loop thread (see SceneStack::Preload) as long as the game is not modified.
+   * LoadFromCopiedScene must then be called in the game loop thread.
+   */
+  bool CopyFromScene(const gd::Layout& scene);
+
+  /**
+   * \brief Finish loading a scene copied with CopyFromScene: create the initial
+   * instances and notify the extensions.
+   */
+  bool LoadFromCopiedScene();
+
   /**
    * Create the objects from an gd::InitialInstancesContainer object.
    *
@@ -222,11 +284,6 @@ class GD_API RuntimeScene : public Scene {
    */
   void ManageRenderTargetEvents();
 
-  /**
-   * \brief Order an object list according to object's Z coordinate.
-   */
-  bool OrderObjectsByZOrder(RuntimeObjNonOwningPtrList& objList);
-
   /**
    * \brief Render a frame in the window
    */
@@ -250,6 +307,12 @@ class GD_API RuntimeScene : public Scene {
    */
   void SetupOpenGLProjection();
 
+  /**
+   * \brief Create the initial instances and notify the extensions, once the
+   * scene is copied.
+   */
+  bool FinishLoading(const gd::InitialInstancesContainer& instances);
+
   bool isFullScreen;  ///< As sf::RenderWindow can't say if it is fullscreen or
                       ///< not
   InputManager inputManager;
@@ -261,10 +324,24 @@ class GD_API RuntimeScene : public Scene {
                                                ///< list of extensions which
                                                ///< must be notified when an
                                                ///< object is deleted.
+  std::vector<std::size_t>
+      objectDeletionSectionsIds;  ///< The profiler section of each extension
+                                  ///< of
+                                  ///< extensionsToBeNotifiedOnObjectDeletion.
   BehaviorsRuntimeSharedDataHolder
       behaviorsSharedDatas;  ///< Contains all behaviors shared datas.
+  ObjectsBroadPhase objectsBroadPhase;  ///< Grid used to speed up collision
+                                       ///< tests between objects lists.
+  ObjectsPrototypes objectsPrototypes;  ///< Prototypes of the objects, cloned
+                                        ///< to create new objects.
+  BehaviorsStepper behaviorsStepper;  ///< Steps the behaviors, in parallel
+                                      ///< when they are thread-safe.
+  FrameProfiler frameProfiler;
   std::vector<RuntimeLayer>
       layers;  ///< The layers used at runtime to display the scene.
+  std::vector<float> layersElapsedTimes;  ///< The elapsed time of each layer,
+                                          ///< in seconds, used to move the
+                                          ///< objects after the events.
   std::shared_ptr<CodeExecutionEngine> codeExecutionEngine;
   SceneChange
       requestedChange;  ///< What should be done at the end of the frame.
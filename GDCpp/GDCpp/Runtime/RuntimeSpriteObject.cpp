@@ -43,6 +43,7 @@ RuntimeSpriteObject::RuntimeSpriteObject(RuntimeScene& scene,
       animationSpeedScale(1.f),
       ptrToCurrentSprite(NULL),
       needUpdateCurrentSprite(true),
+      needUpdateHitBoxes(true),
       opacity(255),
       blendMode(0),
       isFlippedX(false),
@@ -74,6 +75,18 @@ RuntimeSpriteObject::RuntimeSpriteObject(RuntimeScene& scene,
 
 RuntimeSpriteObject::~RuntimeSpriteObject(){};
 
+bool RuntimeSpriteObject::Reinitialize(const RuntimeObject& object) {
+  auto spriteObject = dynamic_cast<const RuntimeSpriteObject*>(&object);
+  if (!spriteObject) return false;
+
+  // Animations are copied into the existing ones, reusing their memory.
+  *this = *spriteObject;
+  ptrToCurrentSprite = NULL;
+  needUpdateCurrentSprite = true;
+  needUpdateHitBoxes = true;
+  return true;
+}
+
 bool RuntimeSpriteObject::ExtraInitializationFromInitialInstance(
     const gd::InitialInstance& position) {
   if (position.floatInfos.find("animation") != position.floatInfos.end())
@@ -99,11 +112,11 @@ bool RuntimeSpriteObject::Draw(sf::RenderTarget& renderTarget) {
 }
 
 float RuntimeSpriteObject::GetDrawableX() const {
-  return X - GetCurrentSprite().GetOrigin().GetX() * fabs(scaleX);
+  return GetX() - GetCurrentSprite().GetOrigin().GetX() * fabs(scaleX);
 }
 
 float RuntimeSpriteObject::GetDrawableY() const {
-  return Y - GetCurrentSprite().GetOrigin().GetY() * fabs(scaleY);
+  return GetY() - GetCurrentSprite().GetOrigin().GetY() * fabs(scaleY);
 }
 
 float RuntimeSpriteObject::GetWidth() const {
@@ -121,6 +134,7 @@ void RuntimeSpriteObject::SetWidth(float newWidth) {
     scaleX = newWidth / GetCurrentSFMLSprite().getLocalBounds().width;
     if (isFlippedX) scaleX *= -1;
     needUpdateCurrentSprite = true;
+    needUpdateHitBoxes = true;
   }
 }
 
@@ -129,6 +143,7 @@ void RuntimeSpriteObject::SetHeight(float newHeight) {
     scaleY = newHeight / GetCurrentSFMLSprite().getLocalBounds().height;
     if (isFlippedY) scaleY *= -1;
     needUpdateCurrentSprite = true;
+    needUpdateHitBoxes = true;
   }
 }
 
@@ -179,6 +194,7 @@ void RuntimeSpriteObject::SetScaleX(float val) {
 
   scaleX = val * (isFlippedX ? -1.0 : 1.0);
   needUpdateCurrentSprite = true;
+  needUpdateHitBoxes = true;
 }
 
 void RuntimeSpriteObject::SetScaleY(float val) {
@@ -187,6 +203,7 @@ void RuntimeSpriteObject::SetScaleY(float val) {
 
   scaleY = val * (isFlippedY ? -1.0 : 1.0);
   needUpdateCurrentSprite = true;
+  needUpdateHitBoxes = true;
 }
 
 float RuntimeSpriteObject::GetScaleX() const { return fabs(scaleX); }
@@ -282,12 +299,12 @@ void RuntimeSpriteObject::UpdateCurrentSprite() const {
   ptrToCurrentSprite->GetSFMLSprite().setRotation(
       multipleDirections ? 0 : currentAngle);
   ptrToCurrentSprite->GetSFMLSprite().setPosition(
-      X + (ptrToCurrentSprite->GetCenter().GetX() -
-           ptrToCurrentSprite->GetOrigin().GetX()) *
-              fabs(scaleX),
-      Y + (ptrToCurrentSprite->GetCenter().GetY() -
-           ptrToCurrentSprite->GetOrigin().GetY()) *
-              fabs(scaleY));
+      GetX() + (ptrToCurrentSprite->GetCenter().GetX() -
+                ptrToCurrentSprite->GetOrigin().GetX()) *
+                   fabs(scaleX),
+      GetY() + (ptrToCurrentSprite->GetCenter().GetY() -
+                ptrToCurrentSprite->GetOrigin().GetY()) *
+                   fabs(scaleY));
   if (isFlippedX)
     ptrToCurrentSprite->GetSFMLSprite().move(
         (ptrToCurrentSprite->GetSFMLSprite().getLocalBounds().width / 2 -
@@ -318,6 +335,7 @@ void RuntimeSpriteObject::Update(const RuntimeScene& scene) {
       animations[currentAnimation].Get().GetDirection(currentDirection);
 
   float delay = direction.GetTimeBetweenFrames();
+  std::size_t previousSprite = currentSprite;
 
   if (timeElapsedOnCurrentSprite > delay) {
     if (delay != 0) {
@@ -337,6 +355,7 @@ void RuntimeSpriteObject::Update(const RuntimeScene& scene) {
   }
 
   needUpdateCurrentSprite = true;
+  if (currentSprite != previousSprite) needUpdateHitBoxes = true;
 }
 
 const sf::Sprite& RuntimeSpriteObject::GetCurrentSFMLSprite() const {
@@ -351,30 +370,39 @@ const gd::Sprite& RuntimeSpriteObject::GetCurrentSprite() const {
   return *ptrToCurrentSprite;
 }
 
-std::vector<Polygon2d> RuntimeSpriteObject::GetHitBoxes() const {
+sf::FloatRect RuntimeSpriteObject::GetAABB() const {
+  if (needUpdateHitBoxes) UpdateHitBoxes();
+
+  return aabb;
+}
+
+const std::vector<Polygon2d>& RuntimeSpriteObject::GetHitBoxes() const {
+  if (needUpdateHitBoxes) UpdateHitBoxes();
+
+  return hitBoxes;
+}
+
+void RuntimeSpriteObject::UpdateHitBoxes() const {
+  needUpdateHitBoxes = false;
+  aabb = RuntimeObject::GetAABB();
   if (currentAnimation >= animations.size()) {
-    std::vector<Polygon2d> hitboxes;  // Invalid animation, bail out.
-    return hitboxes;
+    hitBoxes.clear();  // Invalid animation, bail out.
+    return;
   }
   const sf::Sprite& currentSFMLSprite = GetCurrentSFMLSprite();
-
-  std::vector<Polygon2d> polygons = GetCurrentSprite().GetCollisionMask();
-  for (std::size_t i = 0; i < polygons.size(); ++i) {
-    for (std::size_t j = 0; j < polygons[i].vertices.size(); ++j) {
-      sf::Vector2f newVertice = currentSFMLSprite.getTransform().transformPoint(
-          !isFlippedX
-              ? polygons[i].vertices[j].x
-              : GetCurrentSprite().GetSFMLSprite().getLocalBounds().width -
-                    polygons[i].vertices[j].x,
-          !isFlippedY
-              ? polygons[i].vertices[j].y
-              : GetCurrentSprite().GetSFMLSprite().getLocalBounds().height -
-                    polygons[i].vertices[j].y);
-      polygons[i].vertices[j] = newVertice;
+  const sf::Transform& transform = currentSFMLSprite.getTransform();
+  const sf::FloatRect localBounds = currentSFMLSprite.getLocalBounds();
+
+  hitBoxes = GetCurrentSprite().GetCollisionMask();
+  for (std::size_t i = 0; i < hitBoxes.size(); ++i) {
+    std::vector<sf::Vector2f>& vertices = hitBoxes[i].vertices;
+    for (std::size_t j = 0; j < vertices.size(); ++j) {
+      vertices[j] = transform.transformPoint(
+          !isFlippedX ? vertices[j].x : localBounds.width - vertices[j].x,
+          !isFlippedY ? vertices[j].y : localBounds.height - vertices[j].y);
     }
+    hitBoxes[i].ComputeEdges();
   }
-
-  return polygons;
 }
 
 bool RuntimeSpriteObject::SetSprite(std::size_t nb) {
@@ -391,6 +419,7 @@ bool RuntimeSpriteObject::SetSprite(std::size_t nb) {
   timeElapsedOnCurrentSprite = 0;
 
   needUpdateCurrentSprite = true;
+  needUpdateHitBoxes = true;
   return true;
 }
 
@@ -403,6 +432,7 @@ bool RuntimeSpriteObject::SetCurrentAnimation(std::size_t nb) {
   timeElapsedOnCurrentSprite = 0;
 
   needUpdateCurrentSprite = true;
+  needUpdateHitBoxes = true;
   return true;
 }
 
@@ -433,6 +463,7 @@ bool RuntimeSpriteObject::SetDirection(float nb) {
     currentAngle = nb;
 
     needUpdateCurrentSprite = true;
+    needUpdateHitBoxes = true;
     return true;
   } else {
     if (nb >= animations[currentAnimation].Get().GetDirectionsCount() ||
@@ -446,6 +477,7 @@ bool RuntimeSpriteObject::SetDirection(float nb) {
     timeElapsedOnCurrentSprite = 0;
 
     needUpdateCurrentSprite = true;
+    needUpdateHitBoxes = true;
     return true;
   }
 }
@@ -457,6 +489,7 @@ bool RuntimeSpriteObject::SetAngle(float newAngle) {
     currentAngle = newAngle;
 
     needUpdateCurrentSprite = true;
+    needUpdateHitBoxes = true;
   } else {
     newAngle = static_cast<int>(newAngle) % 360;
     if (newAngle < 0) newAngle += 360;
@@ -517,6 +550,7 @@ void RuntimeSpriteObject::FlipX(bool flip) {
   if (flip != isFlippedX) {
     scaleX *= -1.0;
     needUpdateCurrentSprite = true;
+    needUpdateHitBoxes = true;
   }
   isFlippedX = flip;
 }
@@ -525,6 +559,7 @@ void RuntimeSpriteObject::FlipY(bool flip) {
   if (flip != isFlippedY) {
     scaleY *= -1.0;
     needUpdateCurrentSprite = true;
+    needUpdateHitBoxes = true;
   }
   isFlippedY = flip;
 }
@@ -653,7 +688,7 @@ AnimationProxy::AnimationProxy(const gd::Animation& animation_)
 AnimationProxy::AnimationProxy(const AnimationProxy& proxy)
     : animation(new gd::Animation(proxy.Get())) {}
 AnimationProxy& AnimationProxy::operator=(const AnimationProxy& rhs) {
-  *animation = gd::Animation(rhs.Get());
+  *animation = rhs.Get();
 
   return *this;
 }
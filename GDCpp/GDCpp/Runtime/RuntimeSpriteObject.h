@@ -54,6 +54,7 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
   virtual std::unique_ptr<RuntimeObject> Clone() const {
     return gd::make_unique<RuntimeSpriteObject>(*this);
   }
+  virtual bool Reinitialize(const RuntimeObject& object) override;
 
   virtual bool ExtraInitializationFromInitialInstance(
       const gd::InitialInstance& position);
@@ -70,7 +71,10 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
 
   virtual void Update(const RuntimeScene& scene);
 
-  virtual void OnPositionChanged() { needUpdateCurrentSprite = true; };
+  virtual void OnPositionChanged() {
+    needUpdateCurrentSprite = true;
+    needUpdateHitBoxes = true;
+  };
 
   virtual float GetWidth() const;
   virtual float GetHeight() const;
@@ -86,7 +90,8 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
   virtual bool SetAngle(float newAngle);
   virtual float GetAngle() const;
 
-  virtual std::vector<Polygon2d> GetHitBoxes() const;
+  virtual sf::FloatRect GetAABB() const;
+  virtual const std::vector<Polygon2d>& GetHitBoxes() const;
   virtual bool CursorOnObject(RuntimeScene& scene, bool accurate);
 
   /**
@@ -336,6 +341,16 @@ class GD_API RuntimeSpriteObject : public RuntimeObject {
   mutable gd::Sprite* ptrToCurrentSprite;  // Pointer to the current sprite
   mutable bool needUpdateCurrentSprite;
 
+  /**
+   * \brief Compute the hitboxes and the AABB of the current sprite.
+   */
+  void UpdateHitBoxes() const;
+
+  mutable bool needUpdateHitBoxes;  ///< True if the position, angle, scale,
+                                    ///< flipping or sprite were changed since
+                                    ///< the hitboxes were computed.
+  mutable sf::FloatRect aabb;       ///< The AABB, computed with the hitboxes.
+
   std::vector<AnimationProxy> animations;
 
   float opacity;
@@ -4,31 +4,142 @@
  * reserved. This project is released under the MIT License.
  */
 #include "SceneStack.h"
+#include <set>
 #include "CodeExecutionEngine.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/Animation.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/Direction.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/Sprite.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/SpriteObject.h"
+#include "GDCore/Project/ImageManager.h"
+#include "GDCore/Project/InitialInstance.h"
+#include "GDCore/Project/InitialInstancesContainer.h"
 #include "RuntimeGame.h"
 #include "RuntimeScene.h"
 #include "SceneNameMangler.h"
 
+#undef GetObject  // Disable an annoying macro
+
+namespace {
+
+/**
+ * \brief Internal Tool class used to find the objects having initial
+ * instances.
+ */
+class InstancesObjectNamesFinder : public gd::InitialInstanceFunctor {
+ public:
+  InstancesObjectNamesFinder(){};
+  virtual ~InstancesObjectNamesFinder(){};
+
+  virtual void operator()(gd::InitialInstance& instance) {
+    objectNames.insert(instance.GetObjectName());
+  }
+
+  std::set<gd::String> objectNames;
+};
+
+/**
+ * \brief Return the images, not already loaded, of the sprite objects having
+ * initial instances in the layout.
+ *
+ * Other objects load their images when the scene is loaded.
+ */
+std::vector<gd::String> GetImagesToPreload(RuntimeGame& game,
+                                           const gd::Layout& layout) {
+  InstancesObjectNamesFinder finder;
+  const_cast<gd::InitialInstancesContainer&>(layout.GetInitialInstances())
+      .IterateOverInstances(finder);
+
+  std::set<gd::String> imagesNames;
+  for (const gd::String& objectName : finder.objectNames) {
+    const gd::Object* object =
+        layout.HasObjectNamed(objectName)
+            ? &layout.GetObject(objectName)
+            : (game.HasObjectNamed(objectName) ? &game.GetObject(objectName)
+                                               : nullptr);
+    auto spriteObject = dynamic_cast<const gd::SpriteObject*>(object);
+    if (!spriteObject) continue;
+
+    for (const gd::Animation& animation : spriteObject->GetAllAnimations()) {
+      for (std::size_t i = 0; i < animation.GetDirectionsCount(); ++i) {
+        const gd::Direction& direction = animation.GetDirection(i);
+        for (std::size_t j = 0; j < direction.GetSpritesCount(); ++j) {
+          const gd::String& imageName = direction.GetSprite(j).GetImageName();
+          if (!game.GetImageManager()->HasLoadedSFMLTexture(imageName))
+            imagesNames.insert(imageName);
+        }
+      }
+    }
+  }
+
+  return std::vector<gd::String>(imagesNames.begin(), imagesNames.end());
+}
+
+}  // namespace
+
+SceneStack::~SceneStack() {
+  for (auto& it : preloadedScenes) it.second->thread.join();
+}
+
 bool SceneStack::Step() {
   if (stack.empty()) return false;
 
+  std::size_t uploadsCount = maxTexturesUploadsPerStep;
+  for (auto& it : preloadedScenes)
+    uploadsCount -= UploadTextures(*it.second, uploadsCount);
+
   auto& scene = stack.back();
+  if (hasPendingChange) {
+    auto preloadedScene = preloadedScenes.find(pendingChange.requestedScene);
+    if (preloadedScene != preloadedScenes.end() &&
+        !IsLoaded(*preloadedScene->second)) {
+      // Keep displaying the current scene until the new one is loaded.
+      scene->RenderWithoutStep();
+      return scene->GetRequestedChange().change !=
+             RuntimeScene::SceneChange::STOP_GAME;
+    }
+
+    hasPendingChange = false;
+    return ApplyChange(pendingChange);
+  }
+
   if (scene->RenderAndStep()) {
     auto request = scene->GetRequestedChange();
-    if (request.change == RuntimeScene::SceneChange::STOP_GAME) {
-      return false;
-    } else if (request.change == RuntimeScene::SceneChange::POP_SCENE) {
-      Pop();
-    } else if (request.change == RuntimeScene::SceneChange::PUSH_SCENE) {
-      Push(request.requestedScene);
-    } else if (request.change == RuntimeScene::SceneChange::REPLACE_SCENE) {
-      Replace(request.requestedScene);
-    } else if (request.change == RuntimeScene::SceneChange::CLEAR_SCENES) {
-      Replace(request.requestedScene, true);
-    } else {
-      if (errorCallback) errorCallback("Unrecognized change in scene stack.");
-      return false;
+    if (request.change == RuntimeScene::SceneChange::PUSH_SCENE ||
+        request.change == RuntimeScene::SceneChange::REPLACE_SCENE ||
+        request.change == RuntimeScene::SceneChange::CLEAR_SCENES) {
+      // Load the new scene in the background, unless it's already done.
+      if (game.HasLayoutNamed(request.requestedScene))
+        Preload(request.requestedScene);
+
+      auto preloadedScene = preloadedScenes.find(request.requestedScene);
+      if (preloadedScene != preloadedScenes.end() &&
+          !IsLoaded(*preloadedScene->second)) {
+        hasPendingChange = true;
+        pendingChange = request;
+        return true;
+      }
     }
+
+    return ApplyChange(request);
+  }
+
+  return true;
+}
+
+bool SceneStack::ApplyChange(const RuntimeScene::SceneChange& request) {
+  if (request.change == RuntimeScene::SceneChange::STOP_GAME) {
+    return false;
+  } else if (request.change == RuntimeScene::SceneChange::POP_SCENE) {
+    Pop();
+  } else if (request.change == RuntimeScene::SceneChange::PUSH_SCENE) {
+    Push(request.requestedScene);
+  } else if (request.change == RuntimeScene::SceneChange::REPLACE_SCENE) {
+    Replace(request.requestedScene);
+  } else if (request.change == RuntimeScene::SceneChange::CLEAR_SCENES) {
+    Replace(request.requestedScene, true);
+  } else {
+    if (errorCallback) errorCallback("Unrecognized change in scene stack.");
+    return false;
   }
 
   return true;
@@ -43,16 +154,50 @@ std::unique_ptr<RuntimeScene> SceneStack::Pop() {
 }
 
 RuntimeScene* SceneStack::Push(gd::String newSceneName) {
-  if (!game.HasLayoutNamed(newSceneName)) {
+  std::unique_ptr<RuntimeScene> newScene = LoadScene(newSceneName);
+  if (!newScene) return nullptr;
+
+  stack.push_back(std::move(newScene));
+  return stack.back().get();
+}
+
+RuntimeScene* SceneStack::Replace(gd::String newSceneName, bool clear) {
+  // Load the new scene before removing the others, so that the textures they
+  // share are not unloaded then loaded again.
+  std::unique_ptr<RuntimeScene> newScene = LoadScene(newSceneName);
+
+  if (clear) {
+    while (!stack.empty()) stack.pop_back();
+  } else {
+    if (!stack.empty()) stack.pop_back();
+  }
+  if (!newScene) return nullptr;
+
+  stack.push_back(std::move(newScene));
+  return stack.back().get();
+}
+
+std::unique_ptr<RuntimeScene> SceneStack::LoadScene(
+    const gd::String& sceneName) {
+  if (!game.HasLayoutNamed(sceneName)) {
     if (errorCallback)
-      errorCallback("Scene \"" + newSceneName + "\" does not exist.");
+      errorCallback("Scene \"" + sceneName + "\" does not exist.");
     return nullptr;
   }
 
-  std::unique_ptr<RuntimeScene> newScene(new RuntimeScene(window, &game));
-  if (!newScene->LoadFromScene(game.GetLayout(newSceneName))) {
+  std::unique_ptr<RuntimeScene> newScene;
+  std::unique_ptr<PreloadedScene> preloadedScene =
+      TakePreloadedScene(sceneName);
+  if (preloadedScene) {
+    newScene = std::move(preloadedScene->scene);
+    if (!newScene->LoadFromCopiedScene()) newScene = nullptr;
+  } else {
+    newScene.reset(new RuntimeScene(window, &game));
+    if (!newScene->LoadFromScene(game.GetLayout(sceneName))) newScene = nullptr;
+  }
+  if (!newScene) {
     if (errorCallback)
-      errorCallback("Unable to load scene \"" + newSceneName + "\".");
+      errorCallback("Unable to load scene \"" + sceneName + "\".");
     return nullptr;
   }
 
@@ -64,15 +209,88 @@ RuntimeScene* SceneStack::Push(gd::String newSceneName) {
   }
 
   newScene->ChangeRenderWindow(window);
-  stack.push_back(std::move(newScene));
-  return stack.back().get();
+  return newScene;
 }
 
-RuntimeScene* SceneStack::Replace(gd::String newSceneName, bool clear) {
-  if (clear) {
-    while (!stack.empty()) stack.pop_back();
-  } else {
-    if (!stack.empty()) stack.pop_back();
+bool SceneStack::Preload(gd::String sceneName) {
+  if (!game.HasLayoutNamed(sceneName)) {
+    if (errorCallback)
+      errorCallback("Scene \"" + sceneName + "\" does not exist.");
+    return false;
   }
-  return Push(newSceneName);
+  if (preloadedScenes.find(sceneName) != preloadedScenes.end()) return true;
+
+  const gd::Layout& layout = game.GetLayout(sceneName);
+  std::unique_ptr<PreloadedScene> preloadedScene(new PreloadedScene);
+  preloadedScene->scene.reset(new RuntimeScene(NULL, &game));
+  preloadedScene->imagesNames = GetImagesToPreload(game, layout);
+  preloadedScene->textures.resize(preloadedScene->imagesNames.size());
+
+  // The thread only decodes images and copies the layout: the textures are
+  // created by UploadTextures, and the objects by LoadFromCopiedScene, in the
+  // thread using the stack.
+  PreloadedScene& scene = *preloadedScene;
+  std::shared_ptr<gd::ImageManager> imageManager = game.GetImageManager();
+  scene.thread = std::thread([&scene, &layout, imageManager]() {
+    for (std::size_t i = 0; i < scene.imagesNames.size(); ++i) {
+      scene.textures[i] = imageManager->DecodeImage(scene.imagesNames[i]);
+      scene.decodedImagesCount++;
+    }
+
+    scene.scene->CopyFromScene(layout);
+    scene.copied = true;
+  });
+
+  preloadedScenes[sceneName] = std::move(preloadedScene);
+  return true;
+}
+
+float SceneStack::GetLoadingProgress(const gd::String& sceneName) const {
+  auto it = preloadedScenes.find(sceneName);
+  if (it == preloadedScenes.end()) return 0;
+
+  // Decoding an image, creating its texture and copying the layout each count
+  // as a step.
+  const PreloadedScene& preloadedScene = *it->second;
+  std::size_t stepsCount = preloadedScene.textures.size() * 2 + 1;
+  std::size_t doneStepsCount = preloadedScene.decodedImagesCount +
+                               preloadedScene.uploadedImagesCount +
+                               (preloadedScene.copied ? 1 : 0);
+  return static_cast<float>(doneStepsCount) / stepsCount;
+}
+
+std::size_t SceneStack::UploadTextures(PreloadedScene& preloadedScene,
+                                       std::size_t maxCount) {
+  std::size_t decodedImagesCount = preloadedScene.decodedImagesCount;
+  std::size_t count = 0;
+  while (count < maxCount &&
+         preloadedScene.uploadedImagesCount < decodedImagesCount) {
+    std::size_t i = preloadedScene.uploadedImagesCount;
+    if (preloadedScene.textures[i])
+      preloadedScene.textures[i] = game.GetImageManager()->LoadDecodedImage(
+          preloadedScene.imagesNames[i], preloadedScene.textures[i]);
+
+    preloadedScene.uploadedImagesCount++;
+    count++;
+  }
+
+  return count;
+}
+
+bool SceneStack::IsLoaded(const PreloadedScene& preloadedScene) const {
+  return preloadedScene.copied &&
+         preloadedScene.uploadedImagesCount == preloadedScene.textures.size();
+}
+
+std::unique_ptr<SceneStack::PreloadedScene> SceneStack::TakePreloadedScene(
+    const gd::String& sceneName) {
+  auto it = preloadedScenes.find(sceneName);
+  if (it == preloadedScenes.end()) return nullptr;
+
+  std::unique_ptr<PreloadedScene> preloadedScene = std::move(it->second);
+  preloadedScenes.erase(it);
+
+  preloadedScene->thread.join();
+  UploadTextures(*preloadedScene, preloadedScene->textures.size());
+  return preloadedScene;
 }
@@ -3,18 +3,26 @@
  * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
  * reserved. This project is released under the MIT License.
  */
+#include <GDCpp/Runtime/RuntimeScene.h>
 #include <GDCpp/Runtime/String.h>
+#include <atomic>
 #include <functional>
+#include <map>
 #include <memory>
+#include <thread>
 #include <vector>
 class RuntimeGame;
-class RuntimeScene;
+class SFMLTextureWrapper;
 namespace sf {
 class RenderWindow;
 }
 
 /**
  * A stack of RuntimeScene.
+ *
+ * Scenes can be loaded in the background (see SceneStack::Preload). Scene
+ * changes requested by the events of a scene are done once the new scene is
+ * loaded, the current scene being rendered (but not stepped) meanwhile.
  */
 class GD_API SceneStack {
  public:
@@ -26,13 +34,18 @@ class GD_API SceneStack {
    * execute for scenes.
    */
   SceneStack(RuntimeGame &game_, sf::RenderWindow *window_)
-      : game(game_), window(window_){};
+      : game(game_),
+        window(window_),
+        maxTexturesUploadsPerStep(4),
+        hasPendingChange(false){};
+  virtual ~SceneStack();
 
   /**
    * \brief Execute one step of the game.
    *
    * RuntimeScene::RenderAndStep is called on the current scene. If a scene
-   * change was requested, the stack is updated.
+   * change was requested, the new scene is preloaded and the stack is updated
+   * once it's loaded, the current scene being only rendered until then.
    *
    * This method is typically called in a loop until it returns false.
    * \return false if game must be stopped.
@@ -64,6 +77,35 @@ class GD_API SceneStack {
    */
   RuntimeScene *Replace(gd::String newSceneName, bool clear = false);
 
+  /**
+   * \brief Start loading a scene in a background thread, so that it's ready to
+   * be used when pushed or when replacing the current scene.
+   *
+   * The scene is copied and its images are decoded by the background thread.
+   * The textures are then created, a few at each call to Step, in the thread
+   * calling Step. Push and Replace use the preloaded scene, waiting for it to
+   * be loaded if necessary.
+   *
+   * \return false if the scene does not exist.
+   */
+  bool Preload(gd::String sceneName);
+
+  /**
+   * \brief Return the progress of the loading of a scene started by Preload,
+   * from 0 to 1 when the scene is ready to be used.
+   *
+   * \return The progress, or 0 if the scene is not being preloaded.
+   */
+  float GetLoadingProgress(const gd::String &sceneName) const;
+
+  /**
+   * \brief Set the maximum number of textures of preloaded scenes created at
+   * each Step.
+   */
+  void SetMaxTexturesUploadsPerStep(std::size_t count) {
+    maxTexturesUploadsPerStep = count;
+  }
+
   /**
    * \brief Set the callback called when an error occurs (loading failed...)
    */
@@ -77,9 +119,67 @@ class GD_API SceneStack {
   }
 
  private:
+  /**
+   * \brief A scene being loaded in the background.
+   */
+  struct PreloadedScene {
+    PreloadedScene()
+        : decodedImagesCount(0), uploadedImagesCount(0), copied(false){};
+
+    std::unique_ptr<RuntimeScene> scene;
+    std::vector<gd::String> imagesNames;  ///< The images to decode.
+    std::vector<std::shared_ptr<SFMLTextureWrapper>>
+        textures;  ///< The images decoded by the thread, then their textures,
+                   ///< kept alive until the scene is used.
+    std::atomic<std::size_t>
+        decodedImagesCount;  ///< The number of textures filled by the thread.
+    std::size_t uploadedImagesCount;
+    std::atomic<bool> copied;  ///< True once the thread is done.
+    std::thread thread;
+  };
+
+  /**
+   * \brief Create the textures of the images decoded for a preloaded scene, up
+   * to \a maxCount textures.
+   * \return The number of textures created.
+   */
+  std::size_t UploadTextures(PreloadedScene &preloadedScene,
+                             std::size_t maxCount);
+
+  /**
+   * \brief Return true if the preloaded scene can be used without waiting.
+   */
+  bool IsLoaded(const PreloadedScene &preloadedScene) const;
+
+  /**
+   * \brief Remove the preloaded scene called \a sceneName from the preloaded
+   * scenes, waiting for it to be loaded.
+   * \return The preloaded scene, or nullptr if it was not preloaded.
+   */
+  std::unique_ptr<PreloadedScene> TakePreloadedScene(
+      const gd::String &sceneName);
+
+  /**
+   * \brief Load a scene, using the preloaded scene if any, and set it up to be
+   * added to the stack.
+   * \return The new scene, or nullptr if loading failed.
+   */
+  std::unique_ptr<RuntimeScene> LoadScene(const gd::String &sceneName);
+
+  /**
+   * \brief Update the stack as requested by the current scene.
+   * \return false if game must be stopped.
+   */
+  bool ApplyChange(const RuntimeScene::SceneChange &request);
+
   RuntimeGame &game;
   sf::RenderWindow *window;
   std::vector<std::unique_ptr<RuntimeScene>> stack;
+  std::map<gd::String, std::unique_ptr<PreloadedScene>> preloadedScenes;
+  std::size_t maxTexturesUploadsPerStep;
+  bool hasPendingChange;  ///< True if a scene change is waiting for the new
+                          ///< scene to be preloaded.
+  RuntimeScene::SceneChange pendingChange;
   std::function<void(gd::String)> errorCallback;
   std::function<bool(RuntimeScene &)> loadCallback;
 };
@@ -0,0 +1,153 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(std::size_t workersCount)
+    : generation(0),
+      stopping(false),
+      running(false),
+      remainingChunksCount(0),
+      cancelled(false),
+      function(nullptr) {
+  for (std::size_t i = 0; i < workersCount + 1; ++i)
+    queues.emplace_back(new Queue);
+
+  // Queue 0 is the queue of the thread calling ParallelFor.
+  for (std::size_t i = 0; i < workersCount; ++i)
+    workers.emplace_back(&ThreadPool::WorkerLoop, this, i + 1);
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  workAvailable.notify_all();
+  for (std::thread& worker : workers) worker.join();
+}
+
+void ThreadPool::ParallelFor(std::size_t count,
+                             std::size_t chunkSize,
+                             const ChunkFunction& function_) {
+  if (count == 0) return;
+  chunkSize = std::max<std::size_t>(chunkSize, 1);
+
+  bool wasRunning = false;
+  if (workers.empty() || count <= chunkSize ||
+      !running.compare_exchange_strong(wasRunning, true)) {
+    for (std::size_t begin = 0; begin < count; begin += chunkSize)
+      function_(begin, std::min(begin + chunkSize, count));
+    return;
+  }
+
+  // Workers still looking for chunks of the previous loop can find the new
+  // chunks as soon as they are in the queues, so the loop is set up first.
+  std::size_t chunksCount = (count + chunkSize - 1) / chunkSize;
+  function = &function_;
+  cancelled = false;
+  remainingChunksCount = chunksCount;
+
+  // Spread the chunks between the queues. Consecutive chunks are given to the
+  // same queue, so that each thread works on a contiguous range of iterations.
+  std::size_t chunksPerQueue =
+      (chunksCount + queues.size() - 1) / queues.size();
+  for (std::size_t i = 0; i < chunksCount; ++i) {
+    Queue& queue = *queues[i / chunksPerQueue];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.chunks.push_back(
+        Chunk(i * chunkSize, std::min((i + 1) * chunkSize, count)));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    generation++;
+  }
+  workAvailable.notify_all();
+
+  RunChunks(0);
+
+  std::exception_ptr thrownException;
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    workDone.wait(lock, [this]() { return remainingChunksCount == 0; });
+    std::swap(thrownException, exception);
+  }
+  function = nullptr;
+  running = false;
+
+  if (thrownException) std::rethrow_exception(thrownException);
+}
+
+ThreadPool& ThreadPool::Get() {
+#if defined(EMSCRIPTEN)
+  static ThreadPool pool(0);
+#else
+  static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 1u) -
+                         1);
+#endif
+  return pool;
+}
+
+void ThreadPool::WorkerLoop(std::size_t queueIndex) {
+  std::size_t lastGeneration = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      workAvailable.wait(lock, [&]() {
+        return stopping || generation != lastGeneration;
+      });
+      if (stopping) return;
+      lastGeneration = generation;
+    }
+
+    RunChunks(queueIndex);
+  }
+}
+
+void ThreadPool::RunChunks(std::size_t queueIndex) {
+  Chunk chunk;
+  while (PopChunk(queueIndex, chunk) || StealChunk(queueIndex, chunk)) {
+    if (!cancelled) {
+      try {
+        (*function)(chunk.first, chunk.second);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!exception) exception = std::current_exception();
+        cancelled = true;
+      }
+    }
+
+    if (--remainingChunksCount == 0) {
+      std::lock_guard<std::mutex> lock(mutex);
+      workDone.notify_all();
+    }
+  }
+}
+
+bool ThreadPool::PopChunk(std::size_t queueIndex, Chunk& chunk) {
+  Queue& queue = *queues[queueIndex];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.chunks.empty()) return false;
+
+  chunk = queue.chunks.front();
+  queue.chunks.pop_front();
+  return true;
+}
+
+bool ThreadPool::StealChunk(std::size_t queueIndex, Chunk& chunk) {
+  for (std::size_t i = 1; i < queues.size(); ++i) {
+    Queue& queue = *queues[(queueIndex + i) % queues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.chunks.empty()) continue;
+
+    chunk = queue.chunks.back();
+    queue.chunks.pop_back();
+    return true;
+  }
+
+  return false;
+}
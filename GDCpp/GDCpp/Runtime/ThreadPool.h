@@ -0,0 +1,115 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * \brief A pool of threads used to run loops in parallel.
+ *
+ * The iterations of a loop are split into chunks, which are spread between one
+ * queue for each thread. Each thread runs the chunks of its own queue, then
+ * steals chunks from the other queues, so that threads stay busy even when
+ * chunks are not taking the same time.
+ *
+ * \see ThreadPool::ParallelFor
+ * \ingroup GameEngine
+ */
+class GD_API ThreadPool {
+ public:
+  /**
+   * \brief The function called for each chunk, with the first iteration of the
+   * chunk and the iteration after the last one.
+   */
+  typedef std::function<void(std::size_t begin, std::size_t end)> ChunkFunction;
+
+  /**
+   * \brief Create a pool with the specified number of threads, in addition to
+   * the thread calling ParallelFor.
+   */
+  ThreadPool(std::size_t workersCount);
+  virtual ~ThreadPool();
+
+  /**
+   * \brief Return the number of threads of the pool, not counting the thread
+   * calling ParallelFor.
+   */
+  std::size_t GetWorkersCount() const { return workers.size(); }
+
+  /**
+   * \brief Call \a function for chunks of at most \a chunkSize iterations,
+   * until the \a count iterations are done.
+   *
+   * The calling thread runs chunks too, and the method returns once all the
+   * chunks are done. If \a function throws an exception, the remaining chunks
+   * are skipped and the first exception is rethrown.
+   *
+   * \note If the pool is already running a loop (for example when called from
+   * \a function), or if there is only one chunk, the chunks are run, in order,
+   * by the calling thread.
+   */
+  void ParallelFor(std::size_t count,
+                   std::size_t chunkSize,
+                   const ChunkFunction& function);
+
+  /**
+   * \brief Return the pool shared by the game engine, having one thread less
+   * than the number of threads supported by the CPU.
+   */
+  static ThreadPool& Get();
+
+ private:
+  typedef std::pair<std::size_t, std::size_t> Chunk;
+
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Chunk> chunks;
+  };
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  void WorkerLoop(std::size_t queueIndex);
+
+  /**
+   * \brief Run the chunks of the queue, then the chunks stolen from other
+   * queues, until there are no chunks left.
+   */
+  void RunChunks(std::size_t queueIndex);
+
+  bool PopChunk(std::size_t queueIndex, Chunk& chunk);
+  bool StealChunk(std::size_t queueIndex, Chunk& chunk);
+
+  std::vector<std::thread> workers;
+  std::vector<std::unique_ptr<Queue>> queues;  ///< One queue for each worker,
+                                               ///< and one for the thread
+                                               ///< calling ParallelFor.
+
+  std::mutex mutex;  ///< Protects the members below.
+  std::condition_variable workAvailable;
+  std::condition_variable workDone;
+  std::size_t generation;  ///< Incremented for each loop, to wake up workers.
+  bool stopping;
+  std::exception_ptr exception;  ///< The first exception thrown by a chunk.
+
+  std::atomic<bool> running;
+  std::atomic<std::size_t> remainingChunksCount;
+  std::atomic<bool> cancelled;
+  const ChunkFunction* function;  ///< The function of the running loop.
+};
+
+#endif  // THREADPOOL_H
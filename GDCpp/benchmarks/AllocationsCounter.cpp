@@ -0,0 +1,24 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#include "AllocationsCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<std::size_t> allocationsCount(0);
+}
+
+std::size_t AllocationsCounter::GetCount() { return allocationsCount; }
+
+void* operator new(std::size_t size) {
+  allocationsCount++;
+  void* ptr = std::malloc(size != 0 ? size : 1);
+  if (!ptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
@@ -0,0 +1,25 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+#ifndef GDCPP_BENCHMARKS_ALLOCATIONSCOUNTER_H
+#define GDCPP_BENCHMARKS_ALLOCATIONSCOUNTER_H
+#include <cstddef>
+
+/**
+ * \brief Count the allocations done with operator new by the benchmarks.
+ *
+ * The global operator new is only replaced in the benchmarks executable, so
+ * that the tests and the games are not affected.
+ */
+class AllocationsCounter {
+ public:
+  /**
+   * \brief Return the number of allocations done since the start of the
+   * benchmarks.
+   */
+  static std::size_t GetCount();
+};
+
+#endif  // GDCPP_BENCHMARKS_ALLOCATIONSCOUNTER_H
@@ -0,0 +1,121 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Benchmarks of the functions used by conditions to pick objects.
+ */
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include "AllocationsCounter.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/ObjectsPickingMarks.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeObjectsListsTools.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+TEST_CASE("ObjectsListsTools - Benchmarks", "[game-engine][benchmarks]") {
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+  gd::Object object("MyObject");
+  gd::Object otherObject("MyOtherObject");
+
+  const std::size_t objectsCount = 10000;
+  std::vector<std::unique_ptr<RuntimeObject>> objects;
+  std::vector<RuntimeObject*> allObjects;
+  for (std::size_t i = 0; i < objectsCount; ++i) {
+    objects.emplace_back(new RuntimeObject(scene, object));
+    objects.back()->SetX(i);
+    allObjects.push_back(objects.back().get());
+  }
+  std::vector<std::unique_ptr<RuntimeObject>> otherObjects;
+  std::vector<RuntimeObject*> allOtherObjects;
+  for (std::size_t i = 0; i < 10; ++i) {
+    otherObjects.emplace_back(new RuntimeObject(scene, otherObject));
+    otherObjects.back()->SetX(i * 1000);
+    allOtherObjects.push_back(otherObjects.back().get());
+  }
+
+  std::vector<RuntimeObject*> pickedObjects;
+  std::vector<RuntimeObject*> otherPickedObjects;
+  pickedObjects.reserve(objectsCount);
+  otherPickedObjects.reserve(allOtherObjects.size());
+  RuntimeObjectsLists lists = {{"MyObject", &pickedObjects}};
+  RuntimeObjectsLists otherLists = {{"MyOtherObject", &otherPickedObjects}};
+
+  auto doBenchmark = [&](const gd::String& benchmarkName,
+                         std::function<void()> func) {
+    auto resetLists = [&]() {
+      pickedObjects.assign(allObjects.begin(), allObjects.end());
+      otherPickedObjects.assign(allOtherObjects.begin(), allOtherObjects.end());
+    };
+
+    // Let the picking marks grow to their final size before measuring.
+    resetLists();
+    func();
+
+    const std::size_t runsCount = 100;
+    long long totalTime = 0;
+    std::size_t totalAllocations = 0;
+    for (std::size_t i = 0; i < runsCount; ++i) {
+      resetLists();
+
+      std::size_t allocationsCountBefore = AllocationsCounter::GetCount();
+      auto start = std::chrono::steady_clock::now();
+      func();
+      auto end = std::chrono::steady_clock::now();
+      totalAllocations +=
+          AllocationsCounter::GetCount() - allocationsCountBefore;
+      totalTime +=
+          std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+              .count();
+    }
+
+    std::cout << benchmarkName << " benchmark (" << runsCount
+              << " runs): " << (float)totalTime / runsCount
+              << " microseconds, " << (float)totalAllocations / runsCount
+              << " allocations per call" << std::endl;
+    return totalAllocations;
+  };
+
+  // Picking objects does not allocate memory, and the picking marks are given
+  // back after each call.
+  REQUIRE(doBenchmark("PickObjectsIf with 10k objects", [&]() {
+            PickObjectsIf(lists, false, [](RuntimeObject* obj) {
+              return obj->GetX() >= 5000;
+            });
+          }) == 0);
+  REQUIRE(ObjectsPickingMarks::Get().GetUsedWordsCount() == 0);
+
+  REQUIRE(doBenchmark("TwoObjectListsTest with 10k and 10 objects", [&]() {
+            TwoObjectListsTest(
+                lists,
+                otherLists,
+                false,
+                [](RuntimeObject* obj1, RuntimeObject* obj2) {
+                  return obj1->GetX() == obj2->GetX();
+                });
+          }) == 0);
+  REQUIRE(ObjectsPickingMarks::Get().GetUsedWordsCount() == 0);
+
+  // Lists are built by events generated code for each condition, from the
+  // identifiers of the names of the objects: this does not allocate memory.
+  ObjectNamesTable& names = scene.objectsInstances.GetObjectNamesTable();
+  ObjectNameId nameId("MyObject");
+  ObjectNameId otherNameId("MyOtherObject");
+  REQUIRE(doBenchmark("TwoObjectListsTest with lists built by events", [&]() {
+            TwoObjectListsTest(
+                PickedObjectsLists(names).Add(nameId, pickedObjects),
+                PickedObjectsLists(names).Add(otherNameId, otherPickedObjects),
+                false,
+                [](RuntimeObject* obj1, RuntimeObject* obj2) {
+                  return obj1->GetX() == obj2->GetX();
+                });
+          }) == 0);
+  REQUIRE(ObjectsPickingMarks::Get().GetUsedWordsCount() == 0);
+}
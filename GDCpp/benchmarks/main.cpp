@@ -0,0 +1,13 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Main file for GDevelop C++ Platform benchmarks
+ *
+ * Benchmarks needing to count the allocations are run by this executable,
+ * separated from the tests, because operator new is replaced.
+ */
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
@@ -0,0 +1,133 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering BehaviorsStepper class.
+ */
+#include "GDCpp/Runtime/BehaviorsStepper.h"
+#include <atomic>
+#include <memory>
+#include <set>
+#include <vector>
+#include "GDCore/Project/Object.h"
+#include "GDCore/Serialization/SerializerElement.h"
+#include "GDCpp/Runtime/RuntimeBehavior.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+namespace {
+/**
+ * A behavior moving its object and recording the order in which behaviors are
+ * stepped.
+ */
+class StepRecordingBehavior : public RuntimeBehavior {
+ public:
+  StepRecordingBehavior(bool threadSafe_, std::atomic<std::size_t>& counter_)
+      : RuntimeBehavior(gd::SerializerElement()),
+        preEventsStep(0),
+        postEventsStep(0),
+        threadSafe(threadSafe_),
+        counter(counter_){};
+  virtual ~StepRecordingBehavior(){};
+  virtual RuntimeBehavior* Clone() const {
+    return new StepRecordingBehavior(*this);
+  }
+
+  virtual bool IsThreadSafe() const { return threadSafe; }
+
+  std::size_t preEventsStep;
+  std::size_t postEventsStep;
+
+ private:
+  virtual void DoStepPreEvents(RuntimeScene& scene) {
+    if (threadSafe) object->SetX(object->GetX() + 1);
+    preEventsStep = counter++;
+  }
+  virtual void DoStepPostEvents(RuntimeScene& scene) {
+    if (threadSafe) object->SetY(object->GetY() + 1);
+    postEventsStep = counter++;
+  }
+
+  bool threadSafe;
+  std::atomic<std::size_t>& counter;
+};
+}
+
+TEST_CASE("BehaviorsStepper", "[game-engine]") {
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+  gd::Object object("MyObject");
+
+  std::atomic<std::size_t> counter(0);
+  const std::size_t objectsCount = 1000;
+  std::vector<std::unique_ptr<RuntimeObject>> objects;
+  std::vector<StepRecordingBehavior*> behaviors;
+  std::vector<StepRecordingBehavior*> threadSafeBehaviors;
+  for (std::size_t i = 0; i < objectsCount; ++i) {
+    objects.emplace_back(new RuntimeObject(scene, object));
+
+    behaviors.push_back(new StepRecordingBehavior(false, counter));
+    objects.back()->AddBehavior(
+        "Behavior", std::unique_ptr<RuntimeBehavior>(behaviors.back()));
+    threadSafeBehaviors.push_back(new StepRecordingBehavior(true, counter));
+    objects.back()->AddBehavior(
+        "ThreadSafeBehavior",
+        std::unique_ptr<RuntimeBehavior>(threadSafeBehaviors.back()));
+  }
+
+  auto step = [&](BehaviorsStepper& stepper) {
+    counter = 0;
+    for (auto& object : objects)
+      stepper.StepObjectBehaviors(
+          *object, scene, BehaviorsStepper::PRE_EVENTS);
+    stepper.StepThreadSafeBehaviors(scene, BehaviorsStepper::PRE_EVENTS);
+
+    counter = 0;
+    for (auto& object : objects)
+      stepper.StepObjectBehaviors(
+          *object, scene, BehaviorsStepper::POST_EVENTS);
+    stepper.StepThreadSafeBehaviors(scene, BehaviorsStepper::POST_EVENTS);
+  };
+
+  SECTION("Deterministic") {
+    BehaviorsStepper stepper;
+    stepper.SetDeterministic();
+    REQUIRE(stepper.IsDeterministic());
+    step(stepper);
+    step(stepper);
+
+    // Behaviors are stepped in the order of the objects, and in the order of
+    // the behaviors of each object.
+    for (std::size_t i = 0; i < objectsCount; ++i) {
+      REQUIRE(behaviors[i]->preEventsStep == 2 * i);
+      REQUIRE(behaviors[i]->postEventsStep == 2 * i);
+      REQUIRE(threadSafeBehaviors[i]->preEventsStep == 2 * i + 1);
+      REQUIRE(threadSafeBehaviors[i]->postEventsStep == 2 * i + 1);
+      REQUIRE(objects[i]->GetX() == 2);
+      REQUIRE(objects[i]->GetY() == 2);
+    }
+  }
+
+  SECTION("Parallel") {
+    BehaviorsStepper stepper;
+    REQUIRE(!stepper.IsDeterministic());
+    step(stepper);
+    step(stepper);
+
+    // Thread-safe behaviors are stepped after all the others.
+    std::set<std::size_t> threadSafeSteps;
+    for (std::size_t i = 0; i < objectsCount; ++i) {
+      REQUIRE(behaviors[i]->preEventsStep == i);
+      REQUIRE(behaviors[i]->postEventsStep == i);
+      REQUIRE(threadSafeBehaviors[i]->preEventsStep >= objectsCount);
+      threadSafeSteps.insert(threadSafeBehaviors[i]->preEventsStep);
+      REQUIRE(objects[i]->GetX() == 2);
+      REQUIRE(objects[i]->GetY() == 2);
+    }
+    REQUIRE(threadSafeSteps.size() == objectsCount);
+  }
+}
@@ -0,0 +1,112 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering FrameProfiler class.
+ */
+#include "GDCpp/Runtime/FrameProfiler.h"
+#include <sstream>
+#include "catch.hpp"
+
+TEST_CASE("FrameProfiler", "[game-engine]") {
+  SECTION("Sections") {
+    REQUIRE(FrameProfiler::GetSectionName(FrameProfiler::FRAME) == "Frame");
+    REQUIRE(FrameProfiler::GetSectionName(FrameProfiler::RENDERING) ==
+            "Rendering");
+
+    std::size_t sectionId = FrameProfiler::GetSectionId("My section");
+    REQUIRE(sectionId > FrameProfiler::RENDERING);
+    REQUIRE(FrameProfiler::GetSectionId("My section") == sectionId);
+    REQUIRE(FrameProfiler::GetSectionName(sectionId) == "My section");
+    REQUIRE(FrameProfiler::GetSectionId("Events") == FrameProfiler::EVENTS);
+  }
+
+  SECTION("Disabled profiler") {
+    FrameProfiler profiler;
+    REQUIRE(profiler.IsEnabled() == false);
+
+    profiler.BeginFrame();
+    { FrameProfiler::Scope scope(profiler, FrameProfiler::EVENTS); }
+    profiler.EndFrame();
+
+    REQUIRE(profiler.GetTraceSamplesCount() == 0);
+    REQUIRE(profiler.GetHistogram(FrameProfiler::EVENTS).framesCount == 0);
+
+    // The trace is empty until the profiler is enabled.
+    std::ostringstream trace;
+    profiler.ExportChromeTrace(trace);
+    REQUIRE(trace.str().find("\"name\"") == std::string::npos);
+  }
+
+  SECTION("Histograms") {
+    FrameProfiler profiler;
+    profiler.Enable();
+    profiler.SetHistogramFramesCount(3);
+
+    for (std::size_t i = 0; i < 5; ++i) {
+      profiler.BeginFrame();
+      { FrameProfiler::Scope scope(profiler, FrameProfiler::EVENTS); }
+      { FrameProfiler::Scope scope(profiler, FrameProfiler::EVENTS); }
+      if (i == 0) {
+        FrameProfiler::Scope scope(profiler, FrameProfiler::RENDERING);
+      }
+      profiler.EndFrame();
+    }
+
+    // Only the latest frames are kept.
+    FrameProfiler::Histogram histogram =
+        profiler.GetHistogram(FrameProfiler::EVENTS);
+    REQUIRE(histogram.framesCount == 3);
+    REQUIRE(histogram.bucketsCounts.size() == FrameProfiler::GetBucketsCount());
+    std::size_t bucketsTotal = 0;
+    for (std::size_t count : histogram.bucketsCounts) bucketsTotal += count;
+    REQUIRE(bucketsTotal == 3);
+    REQUIRE(histogram.maxTime <= histogram.totalTime);
+
+    REQUIRE(profiler.GetHistogram(FrameProfiler::FRAME).framesCount == 3);
+    REQUIRE(profiler.GetHistogram(FrameProfiler::RENDERING).framesCount == 1);
+    REQUIRE(profiler.GetHistogram(FrameProfiler::FORCES).framesCount == 0);
+
+    profiler.Clear();
+    REQUIRE(profiler.GetHistogram(FrameProfiler::EVENTS).framesCount == 0);
+  }
+
+  SECTION("Buckets") {
+    REQUIRE(FrameProfiler::GetBucketMinTime(0) == 0);
+    REQUIRE(FrameProfiler::GetBucketMinTime(1) == 1);
+    REQUIRE(FrameProfiler::GetBucketMinTime(2) == 2);
+    REQUIRE(FrameProfiler::GetBucketMinTime(11) == 1024);
+  }
+
+  SECTION("Chrome trace") {
+    FrameProfiler profiler;
+    profiler.Enable();
+    profiler.SetTraceCapacity(3);
+
+    std::size_t sectionId = FrameProfiler::GetSectionId("Events: \"Enemies\"");
+    profiler.BeginFrame();
+    { FrameProfiler::Scope scope(profiler, FrameProfiler::EVENTS); }
+    { FrameProfiler::Scope scope(profiler, sectionId); }
+    profiler.EndFrame();
+    REQUIRE(profiler.GetTraceSamplesCount() == 3);
+
+    std::ostringstream trace;
+    profiler.ExportChromeTrace(trace);
+    REQUIRE(trace.str().find("{\"traceEvents\":[") == 0);
+    REQUIRE(trace.str().find("\"name\":\"Events\",\"ph\":\"X\"") !=
+            std::string::npos);
+    REQUIRE(trace.str().find("\"name\":\"Events: \\\"Enemies\\\"\"") !=
+            std::string::npos);
+    REQUIRE(trace.str().find("\"name\":\"Frame\"") != std::string::npos);
+
+    // The oldest samples are replaced when the trace is full.
+    profiler.BeginFrame();
+    profiler.EndFrame();
+    REQUIRE(profiler.GetTraceSamplesCount() == 3);
+    trace.str("");
+    profiler.ExportChromeTrace(trace);
+    REQUIRE(trace.str().find("\"name\":\"Events\",") == std::string::npos);
+  }
+}
@@ -62,4 +62,216 @@ TEST_CASE("ObjInstancesHolder", "[common]") {
     REQUIRE(container.GetObjects("2").size() == 3);
     REQUIRE(container.GetObjectsRawPointers("2").size() == 3);
   }
+  SECTION("Removing objects") {
+    gd::Object obj1("1");
+    gd::Object obj2("2");
+
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+
+    ObjInstancesHolder container;
+    std::vector<RuntimeObject*> objects1;
+    for (std::size_t i = 0; i < 5; ++i)
+      objects1.push_back(container.AddObject(
+          std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj1))));
+    RuntimeObject* obj2APtr = container.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj2)));
+
+    // The last object of the list takes the place of the removed one
+    container.RemoveObject(objects1[1]);
+    REQUIRE(container.GetObjectsRawPointers("1") ==
+            RuntimeObjNonOwningPtrList(
+                {objects1[0], objects1[4], objects1[2], objects1[3]}));
+    container.RemoveObject(objects1[3]);
+    container.RemoveObject(objects1[4]);
+    REQUIRE(container.GetObjectsRawPointers("1") ==
+            RuntimeObjNonOwningPtrList({objects1[0], objects1[2]}));
+    REQUIRE(container.GetObjects("1")[1].get() == objects1[2]);
+
+    // Removing with a predicate keeps the order of the other objects
+    for (std::size_t i = 0; i < 3; ++i)
+      objects1.push_back(container.AddObject(
+          std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj1))));
+    container.RemoveObjectsIf([&](RuntimeObject* object) {
+      return object == objects1[0] || object == objects1[6] ||
+             object == obj2APtr;
+    });
+    REQUIRE(container.GetObjectsRawPointers("1") ==
+            RuntimeObjNonOwningPtrList({objects1[2], objects1[5], objects1[7]}));
+    REQUIRE(container.GetObjects("2").empty());
+
+    // Objects can still be removed one by one after that
+    container.RemoveObject(objects1[2]);
+    REQUIRE(container.GetObjectsRawPointers("1") ==
+            RuntimeObjNonOwningPtrList({objects1[7], objects1[5]}));
+  }
+  SECTION("Rendering lists") {
+    gd::Object obj1("1");
+
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+
+    ObjInstancesHolder container;
+    container.SetRenderingLayers({"", "Layer 1"});
+
+    std::unique_ptr<RuntimeObject> obj1A(new RuntimeObject(scene, obj1));
+    std::unique_ptr<RuntimeObject> obj1B(new RuntimeObject(scene, obj1));
+    std::unique_ptr<RuntimeObject> obj1C(new RuntimeObject(scene, obj1));
+    obj1A->SetZOrder(3);
+    obj1B->SetZOrder(1);
+    obj1C->SetZOrder(2);
+    obj1C->SetLayer("Layer 1");
+    RuntimeObject* obj1APtr = container.AddObject(std::move(obj1A));
+    RuntimeObject* obj1BPtr = container.AddObject(std::move(obj1B));
+    RuntimeObject* obj1CPtr = container.AddObject(std::move(obj1C));
+
+    REQUIRE(container.GetObjectsToRender(0) ==
+            RuntimeObjNonOwningPtrList({obj1BPtr, obj1APtr}));
+    REQUIRE(container.GetObjectsToRender(1) ==
+            RuntimeObjNonOwningPtrList({obj1CPtr}));
+
+    // Changing the Z order or the layer updates the lists
+    obj1APtr->SetZOrder(0);
+    obj1CPtr->SetLayer("");
+    REQUIRE(container.GetObjectsToRender(0) ==
+            RuntimeObjNonOwningPtrList({obj1APtr, obj1BPtr, obj1CPtr}));
+    REQUIRE(container.GetObjectsToRender(1).empty());
+
+    // Objects on an unknown layer are not rendered
+    obj1BPtr->SetLayer("Unknown layer");
+    REQUIRE(container.GetObjectsToRender(0) ==
+            RuntimeObjNonOwningPtrList({obj1APtr, obj1CPtr}));
+
+    // Removed objects are removed from the lists
+    container.RemoveObject(obj1APtr);
+    REQUIRE(container.GetObjectsToRender(0) ==
+            RuntimeObjNonOwningPtrList({obj1CPtr}));
+
+    // Copies have their own lists
+    ObjInstancesHolder copy = container;
+    REQUIRE(copy.GetObjectsToRender(0).size() == 1);
+    REQUIRE(copy.GetObjectsToRender(0)[0] != obj1CPtr);
+  }
+  SECTION("Rendering lists of layers not rendered") {
+    gd::Object obj1("1");
+
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+
+    ObjInstancesHolder container;
+    container.SetRenderingLayers({""});
+
+    // Lists are compacted while objects are removed, even if they are never
+    // rendered.
+    std::vector<RuntimeObject*> objects;
+    for (std::size_t i = 0; i < 100; ++i) {
+      std::unique_ptr<RuntimeObject> object(new RuntimeObject(scene, obj1));
+      object->SetZOrder(i);
+      objects.push_back(container.AddObject(std::move(object)));
+    }
+    for (std::size_t i = 0; i < 1000; ++i) {
+      std::unique_ptr<RuntimeObject> object(new RuntimeObject(scene, obj1));
+      object->SetZOrder(200);
+      container.RemoveObject(container.AddObject(std::move(object)));
+    }
+    for (std::size_t i = 0; i < 100; i += 2) container.RemoveObject(objects[i]);
+
+    const RuntimeObjNonOwningPtrList& objectsToRender =
+        container.GetObjectsToRender(0);
+    REQUIRE(objectsToRender.size() == 50);
+    for (std::size_t i = 0; i < 50; ++i)
+      REQUIRE(objectsToRender[i] == objects[i * 2 + 1]);
+  }
+  SECTION("Object names identifiers") {
+    gd::Object obj1("1");
+    gd::Object obj2("2");
+
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+    ObjectNamesTable& objectNames = game.GetObjectNamesTable();
+    REQUIRE(&scene.objectsInstances.GetObjectNamesTable() == &objectNames);
+
+    ObjInstancesHolder& container = scene.objectsInstances;
+    RuntimeObject* obj1APtr = container.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj1)));
+    container.AddObject(
+        std::unique_ptr<RuntimeObject>(new RuntimeObject(scene, obj2)));
+
+    std::size_t id1 = objectNames.GetId("1");
+    std::size_t id2 = objectNames.GetId("2");
+    REQUIRE(id1 != id2);
+    REQUIRE(objectNames.GetName(id1) == "1");
+    REQUIRE(container.GetObjects(id1).size() == 1);
+    REQUIRE(container.GetObjectsRawPointers(id2).size() == 1);
+    REQUIRE(container.GetObjects(objectNames.GetId("Unknown")).empty());
+
+    // Names are cached by ObjectNameId, for the table they were resolved for
+    ObjectNameId nameId("2");
+    REQUIRE(nameId.Get(objectNames) == id2);
+    ObjectNamesTable otherObjectNames;
+    REQUIRE(nameId.Get(otherObjectNames) == 0);
+    REQUIRE(nameId.Get(objectNames) == id2);
+
+    // Changing the table keeps the objects
+    container.SetObjectNamesTable(std::make_shared<ObjectNamesTable>());
+    REQUIRE(container.GetObjects("2").size() == 1);
+    REQUIRE(container.GetObjectNamesTable().GetId("1") == 0);
+
+    // Deleted objects are moved to the list of objects without name
+    obj1APtr->DeleteFromScene(scene);
+    REQUIRE(container.GetObjects("1").empty());
+    REQUIRE(container.GetObjectsRawPointers("").size() == 1);
+  }
+  SECTION("Transforms") {
+    gd::Object obj1("1");
+
+    RuntimeGame game;
+    RuntimeScene scene(NULL, &game);
+
+    std::unique_ptr<RuntimeObject> obj1A(new RuntimeObject(scene, obj1));
+    obj1A->SetX(10);
+    obj1A->SetY(20);
+    obj1A->SetZOrder(3);
+    obj1A->AddForce(100, 0, 1);
+    obj1A->AddForce(0, 50, 0);
+    obj1A->SetLayer("Layer");
+    std::unique_ptr<RuntimeObject> obj1B(new RuntimeObject(scene, obj1));
+
+    // Components are kept when objects are moved to the store
+    ObjInstancesHolder container;
+    container.SetRenderingLayers({"", "Layer"});
+    RuntimeObject* obj1APtr = container.AddObject(std::move(obj1A));
+    RuntimeObject* obj1BPtr = container.AddObject(std::move(obj1B));
+    ObjectsTransforms& transforms = container.GetTransforms();
+    REQUIRE(transforms.GetCount() == 2);
+    REQUIRE(obj1APtr->GetX() == 10);
+    REQUIRE(obj1APtr->GetY() == 20);
+    REQUIRE(obj1APtr->GetZOrder() == 3);
+    REQUIRE(obj1APtr->TotalForceX() == 100);
+    REQUIRE(obj1APtr->TotalForceY() == 50);
+
+    // Objects are moved using the elapsed time of their layer
+    transforms.ApplyForces({0.5, 2}, 1);
+    REQUIRE(obj1APtr->GetX() == 210);
+    REQUIRE(obj1APtr->GetY() == 120);
+    REQUIRE(obj1BPtr->GetX() == 0);
+    REQUIRE(transforms.GetElapsedTime(obj1APtr) == 2);
+    REQUIRE(transforms.GetElapsedTime(obj1BPtr) == 0.5);
+
+    // Forces lasting only a frame are removed
+    obj1APtr->UpdateForce(transforms.GetElapsedTime(obj1APtr));
+    REQUIRE(obj1APtr->TotalForceX() == 100);
+    REQUIRE(obj1APtr->TotalForceY() == 0);
+
+    // Copies and removed objects don't use the store anymore
+    std::unique_ptr<RuntimeObject> obj1ACopy(obj1APtr->Clone());
+    REQUIRE(obj1ACopy->GetX() == 210);
+    obj1ACopy->SetX(0);
+    REQUIRE(obj1APtr->GetX() == 210);
+
+    container.RemoveObject(obj1BPtr);
+    REQUIRE(transforms.GetCount() == 1);
+    REQUIRE(obj1APtr->GetX() == 210);
+    REQUIRE(obj1APtr->GetZOrder() == 3);
+  }
 }
@@ -0,0 +1,207 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the broad-phase used for collisions between objects.
+ */
+#include "GDCpp/Runtime/ObjectsBroadPhase.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+#include "GDCore/CommonTools.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeObjectsListsTools.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+namespace {
+/**
+ * \brief An object having a fixed size, so that its default hitbox is not
+ * empty.
+ */
+class BoxRuntimeObject : public RuntimeObject {
+ public:
+  BoxRuntimeObject(RuntimeScene& scene,
+                   const gd::Object& object,
+                   float width_,
+                   float height_)
+      : RuntimeObject(scene, object), width(width_), height(height_){};
+
+  virtual float GetWidth() const { return width; }
+  virtual float GetHeight() const { return height; }
+
+ private:
+  float width;
+  float height;
+};
+
+std::vector<std::unique_ptr<BoxRuntimeObject>> CreateObjects(
+    RuntimeScene& scene,
+    const gd::Object& object,
+    std::size_t count,
+    float areaSize,
+    std::mt19937& generator) {
+  std::uniform_real_distribution<float> position(-areaSize / 2, areaSize / 2);
+  std::uniform_real_distribution<float> size(4, 48);
+
+  std::vector<std::unique_ptr<BoxRuntimeObject>> objects;
+  for (std::size_t i = 0; i < count; ++i) {
+    objects.emplace_back(
+        new BoxRuntimeObject(scene, object, size(generator), size(generator)));
+    objects.back()->SetX(position(generator));
+    objects.back()->SetY(position(generator));
+  }
+
+  return objects;
+}
+
+std::vector<RuntimeObject*> ToRawPointers(
+    const std::vector<std::unique_ptr<BoxRuntimeObject>>& objects) {
+  std::vector<RuntimeObject*> list;
+  for (auto& object : objects) list.push_back(object.get());
+  return list;
+}
+}
+
+TEST_CASE("ObjectsBroadPhase", "[game-engine]") {
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+  gd::Object bullet("Bullet");
+  gd::Object enemy("Enemy");
+  std::mt19937 generator(42);
+
+  auto collisionTest = [](RuntimeObject* obj1, RuntimeObject* obj2) {
+    return obj1->IsCollidingWith(obj2);
+  };
+
+  SECTION("Candidates") {
+    BoxRuntimeObject near1(scene, bullet, 10, 10);
+    BoxRuntimeObject near2(scene, bullet, 10, 10);
+    BoxRuntimeObject far(scene, bullet, 10, 10);
+    near1.SetX(0);
+    near2.SetX(12);
+    far.SetX(1000);
+    std::vector<RuntimeObject*> list = {&near1, &near2, &far};
+
+    ObjectsBroadPhase& broadPhase = scene.GetObjectsBroadPhase();
+    broadPhase.Clear();
+    for (std::size_t i = 0; i < list.size(); ++i)
+      broadPhase.Insert(list[i], &list[i], 0, i);
+    broadPhase.Build();
+    REQUIRE(broadPhase.GetObjectsCount() == 3);
+
+    std::vector<std::size_t> candidates;
+    broadPhase.ForEachCandidate(
+        &near1,
+        [&candidates](RuntimeObject* const*, std::size_t, std::size_t index) {
+          candidates.push_back(index);
+        });
+    std::sort(candidates.begin(), candidates.end());
+    REQUIRE(candidates == std::vector<std::size_t>({0, 1}));
+  }
+
+  SECTION("Same result as TwoObjectListsTest") {
+    for (bool inverted : {false, true}) {
+      for (float areaSize : {200.0f, 1000.0f, 5000.0f}) {
+        auto bullets = CreateObjects(scene, bullet, 150, areaSize, generator);
+        auto enemies = CreateObjects(scene, enemy, 100, areaSize, generator);
+
+        std::vector<RuntimeObject*> bullets1 = ToRawPointers(bullets);
+        std::vector<RuntimeObject*> enemies1 = ToRawPointers(enemies);
+        RuntimeObjectsLists lists1 = {{"Bullet", &bullets1}};
+        RuntimeObjectsLists lists2 = {{"Enemy", &enemies1}};
+        bool result1 =
+            TwoObjectListsTest(lists1, lists2, inverted, collisionTest);
+
+        std::vector<RuntimeObject*> bullets2 = ToRawPointers(bullets);
+        std::vector<RuntimeObject*> enemies2 = ToRawPointers(enemies);
+        RuntimeObjectsLists lists3 = {{"Bullet", &bullets2}};
+        RuntimeObjectsLists lists4 = {{"Enemy", &enemies2}};
+        bool result2 =
+            TwoObjectListsTestWithBroadPhase(lists3,
+                                             lists4,
+                                             inverted,
+                                             scene.GetObjectsBroadPhase(),
+                                             collisionTest);
+
+        REQUIRE(result1 == result2);
+        REQUIRE(bullets1 == bullets2);
+        REQUIRE(enemies1 == enemies2);
+      }
+    }
+  }
+
+  SECTION("Same list on both sides") {
+    auto bullets = CreateObjects(scene, bullet, 200, 1000, generator);
+
+    std::vector<RuntimeObject*> bullets1 = ToRawPointers(bullets);
+    RuntimeObjectsLists lists1 = {{"Bullet", &bullets1}};
+    bool result1 = TwoObjectListsTest(lists1, lists1, false, collisionTest);
+
+    std::vector<RuntimeObject*> bullets2 = ToRawPointers(bullets);
+    RuntimeObjectsLists lists2 = {{"Bullet", &bullets2}};
+    bool result2 = TwoObjectListsTestWithBroadPhase(
+        lists2, lists2, false, scene.GetObjectsBroadPhase(), collisionTest);
+
+    REQUIRE(result1 == result2);
+    REQUIRE(bullets1 == bullets2);
+  }
+}
+
+TEST_CASE("ObjectsBroadPhase - Benchmarks", "[game-engine][benchmarks]") {
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+  gd::Object bullet("Bullet");
+  gd::Object enemy("Enemy");
+  std::mt19937 generator(42);
+
+  auto collisionTest = [](RuntimeObject* obj1, RuntimeObject* obj2) {
+    return obj1->IsCollidingWith(obj2);
+  };
+
+  auto measure = [](std::function<void()> func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+        .count();
+  };
+
+  for (std::size_t count : {100, 200, 400, 800}) {
+    // Keep the density of objects constant while their number grows.
+    float areaSize = 60 * std::sqrt(static_cast<float>(count));
+    auto bullets = CreateObjects(scene, bullet, count, areaSize, generator);
+    auto enemies = CreateObjects(scene, enemy, count, areaSize, generator);
+
+    long long bruteForceTime = measure([&]() {
+      std::vector<RuntimeObject*> bulletsList = ToRawPointers(bullets);
+      std::vector<RuntimeObject*> enemiesList = ToRawPointers(enemies);
+      TwoObjectListsTest(RuntimeObjectsLists({{"Bullet", &bulletsList}}),
+                         RuntimeObjectsLists({{"Enemy", &enemiesList}}),
+                         false,
+                         collisionTest);
+    });
+    long long broadPhaseTime = measure([&]() {
+      std::vector<RuntimeObject*> bulletsList = ToRawPointers(bullets);
+      std::vector<RuntimeObject*> enemiesList = ToRawPointers(enemies);
+      TwoObjectListsTestWithBroadPhase(
+          RuntimeObjectsLists({{"Bullet", &bulletsList}}),
+          RuntimeObjectsLists({{"Enemy", &enemiesList}}),
+          false,
+          scene.GetObjectsBroadPhase(),
+          collisionTest);
+    });
+
+    std::cout << "Collisions between " << count << " and " << count
+              << " objects: " << bruteForceTime
+              << " microseconds (brute force), " << broadPhaseTime
+              << " microseconds (broad-phase)" << std::endl;
+  }
+}
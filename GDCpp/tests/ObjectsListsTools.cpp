@@ -6,6 +6,7 @@
 /**
  * @file Tests covering common features of GDevelop C++ Platform.
  */
+#include <thread>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Project/ObjectsContainer.h"
 #include "GDCore/Project/Layout.h"
@@ -101,10 +102,123 @@ TEST_CASE("ObjectsListsTools", "[game-engine]") {
     REQUIRE(list1[0] == &obj1A);
     REQUIRE(list2[0] == &obj2C);
   }
+  SECTION("Picking marks") {
+    ObjectsPickingMarks& marks = ObjectsPickingMarks::Get();
+    std::size_t usedWordsCount = marks.GetUsedWordsCount();
+
+    std::map<gd::String, std::vector<RuntimeObject*>*> map1;
+    std::map<gd::String, std::vector<RuntimeObject*>*> map2;
+    std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
+    std::vector<RuntimeObject*> list2 = {&obj2A, &obj2B, &obj2C};
+    map1["1"] = &list1;
+    map2["2"] = &list2;
+
+    // Conditions can be nested: each one has its own marks.
+    REQUIRE(PickObjectsIf(map1, false, [&](RuntimeObject* obj) {
+              std::vector<RuntimeObject*> otherList = list2;
+              std::map<gd::String, std::vector<RuntimeObject*>*> otherMap;
+              otherMap["2"] = &otherList;
+              return obj != &obj1B &&
+                     TwoObjectListsTest(
+                         otherMap,
+                         otherMap,
+                         false,
+                         [](RuntimeObject* obj1, RuntimeObject* obj2) {
+                           return obj1 == obj2;
+                         }) == false;
+            }) == true);
+    REQUIRE(list1 == std::vector<RuntimeObject*>({&obj1A, &obj1C}));
+
+    // Marks are released after each condition.
+    REQUIRE(marks.GetUsedWordsCount() == usedWordsCount);
+
+    // Lists can be missing from the maps
+    map2["Missing"] = nullptr;
+    REQUIRE(TwoObjectListsTest(
+                map1, map2, false, [&](RuntimeObject* obj1, RuntimeObject*) {
+                  return obj1 == &obj1C;
+                }) == true);
+    REQUIRE(list1 == std::vector<RuntimeObject*>({&obj1C}));
+    REQUIRE(list2.size() == 3);
+    REQUIRE(marks.GetUsedWordsCount() == usedWordsCount);
+
+    // Each thread has its own marks.
+    ObjectsPickingMarks* otherThreadMarks = nullptr;
+    std::thread([&otherThreadMarks]() {
+      otherThreadMarks = &ObjectsPickingMarks::Get();
+    }).join();
+    REQUIRE(otherThreadMarks != &marks);
+  }
+  SECTION("PickedObjectsLists") {
+    ObjectNamesTable names;
+    std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
+    std::vector<RuntimeObject*> list2 = {&obj2A, &obj2B, &obj2C};
+    std::vector<RuntimeObject*> otherList1;
+
+    PickedObjectsLists lists(names);
+    REQUIRE(lists.empty());
+
+    // Lists are kept in the order they were added. Adding the list of a name
+    // already added replaces it.
+    ObjectNameId nameId2("2");
+    lists.Add(names.GetId("1"), otherList1)
+        .Add(nameId2, list2)
+        .Add(names.GetId("1"), list1);
+    REQUIRE(lists.size() == 2);
+    REQUIRE(lists.begin()->second == &list1);
+    REQUIRE(lists.GetName(*lists.begin()) == "1");
+    REQUIRE(lists.Get(names.GetId("2")) == &list2);
+    REQUIRE(lists.Get("2") == &list2);
+    REQUIRE(lists.Get(names.GetId("3")) == nullptr);
+    REQUIRE(lists.Get("3") == nullptr);
+
+    // Lists are given as a map to the functions taking a RuntimeObjectsLists.
+    RuntimeObjectsLists map = lists;
+    REQUIRE(map.size() == 2);
+    REQUIRE(map["1"] == &list1);
+    REQUIRE(map["2"] == &list2);
+
+    REQUIRE(PickObjectsIf(lists, false, [&](RuntimeObject* obj) {
+              return obj != &obj1B && obj != &obj2B;
+            }) == true);
+    REQUIRE(list1 == std::vector<RuntimeObject*>({&obj1A, &obj1C}));
+    REQUIRE(list2 == std::vector<RuntimeObject*>({&obj2A, &obj2C}));
+
+    REQUIRE(TwoObjectListsTest(
+                PickedObjectsLists(names).Add(names.GetId("1"), list1),
+                map,
+                false,
+                [&](RuntimeObject* obj1, RuntimeObject* obj2) {
+                  return obj1 == &obj1C && obj2 == &obj2A;
+                }) == true);
+    REQUIRE(list1 == std::vector<RuntimeObject*>({&obj1C}));
+    REQUIRE(list2 == std::vector<RuntimeObject*>({&obj2A}));
+
+    PickOnly(lists, &obj2C);
+    REQUIRE(list1.empty());
+    REQUIRE(list2 == std::vector<RuntimeObject*>({&obj2C}));
+
+    SECTION("More lists than stored inline") {
+      std::vector<std::vector<RuntimeObject*>> moreLists(10);
+      PickedObjectsLists lists(names);
+      for (std::size_t i = 0; i < moreLists.size(); ++i)
+        lists.Add(names.GetId("Object" + gd::String::From(i)), moreLists[i]);
+      lists.Add(names.GetId("Object2"), list1);
+
+      REQUIRE(lists.size() == 10);
+      for (std::size_t i = 0; i < moreLists.size(); ++i) {
+        REQUIRE(lists.GetName(lists.begin()[i]) ==
+                "Object" + gd::String::From(i));
+        REQUIRE(lists.Get("Object" + gd::String::From(i)) ==
+                (i == 2 ? &list1 : &moreLists[i]));
+      }
+    }
+  }
   SECTION("PickNearestObject") {
-    std::map<gd::String, std::vector<RuntimeObject*>*> map;
+    ObjectNamesTable names;
     std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
-    map["1"] = &list1;
+    PickedObjectsLists lists(names);
+    lists.Add(names.GetId("1"), list1);
     obj1A.SetX(50);
     obj1A.SetY(50);
     obj1B.SetX(160);
@@ -112,16 +226,16 @@ TEST_CASE("ObjectsListsTools", "[game-engine]") {
     obj1C.SetX(100);
     obj1C.SetY(300);
 
-    REQUIRE(PickNearestObject(map, 100, 90, false) == true);
+    REQUIRE(PickNearestObject(lists, 100, 90, false) == true);
     REQUIRE(list1.size() == 1);
     REQUIRE(list1[0] == &obj1A);
 
     SECTION("Furthest") {
-      std::map<gd::String, std::vector<RuntimeObject*>*> map;
       std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
-      map["1"] = &list1;
+      PickedObjectsLists lists(names);
+      lists.Add(names.GetId("1"), list1);
 
-      REQUIRE(PickNearestObject(map, 100, 90, true) == true);
+      REQUIRE(PickNearestObject(lists, 100, 90, true) == true);
       REQUIRE(list1.size() == 1);
       REQUIRE(list1[0] == &obj1C);
     }
@@ -0,0 +1,103 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the creation of objects from prototypes, and the
+ * recycling of deleted objects.
+ */
+#include "GDCpp/Runtime/ObjectsPrototypes.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "catch.hpp"
+
+TEST_CASE("ObjectsPrototypes", "[game-engine]") {
+  RuntimeGame game;
+  RuntimeScene scene(NULL, &game);
+
+  gd::Object sceneObject("MyObject");
+  gd::Object sharedObject("SharedObject");
+  sharedObject.GetVariables().InsertNew("FromScene");
+  scene.InsertObject(sceneObject, 0);
+  scene.InsertObject(sharedObject, 1);
+
+  gd::Object globalObject("GlobalObject");
+  gd::Object globalSharedObject("SharedObject");
+  globalSharedObject.GetVariables().InsertNew("FromGlobalObjects");
+  game.InsertObject(globalObject, 0);
+  game.InsertObject(globalSharedObject, 1);
+
+  ObjectsPrototypes& prototypes = scene.GetObjectsPrototypes();
+
+  SECTION("Prototypes") {
+    const RuntimeObject* prototype =
+        prototypes.GetPrototype(scene, "MyObject");
+    REQUIRE(prototype != nullptr);
+    REQUIRE(prototype->GetName() == "MyObject");
+    REQUIRE(prototypes.GetPrototype(scene, "MyObject") == prototype);
+    REQUIRE(prototypes.GetPrototype(scene, "GlobalObject") != nullptr);
+    REQUIRE(prototypes.GetPrototype(scene, "UnknownObject") == nullptr);
+
+    // Objects of the scene hide the global objects with the same name.
+    REQUIRE(prototypes.GetPrototype(scene, "SharedObject")
+                ->GetVariables()
+                .Has("FromScene"));
+
+    prototypes.Clear();
+    REQUIRE(prototypes.GetPrototype(scene, "MyObject") != nullptr);
+  }
+
+  SECTION("Creating objects") {
+    RuntimeObjSPtr object = scene.CreateObject("MyObject");
+    REQUIRE(object != nullptr);
+    REQUIRE(object->GetName() == "MyObject");
+    REQUIRE(object.get() != prototypes.GetPrototype(scene, "MyObject"));
+
+    RuntimeObjSPtr globalObject = scene.CreateObject("GlobalObject");
+    REQUIRE(globalObject != nullptr);
+    REQUIRE(globalObject->GetName() == "GlobalObject");
+
+    REQUIRE(scene.CreateObject("UnknownObject") == nullptr);
+  }
+
+  SECTION("Recycling deleted objects") {
+    prototypes.EnablePooling();
+    RuntimeObject* object =
+        scene.objectsInstances.AddObject(scene.CreateObject("MyObject"));
+    object->SetX(42);
+    object->GetVariables().Get("MyVariable").SetValue(1);
+
+    object->DeleteFromScene(scene);
+    prototypes.Recycle(scene.objectsInstances.RemoveObject(object));
+    REQUIRE(prototypes.GetPooledObjectsCount("") == 1);
+
+    // The deleted object is reused, and made a copy of the prototype.
+    RuntimeObjSPtr newObject = scene.CreateObject("GlobalObject");
+    REQUIRE(newObject.get() == object);
+    REQUIRE(newObject->GetName() == "GlobalObject");
+    REQUIRE(newObject->GetX() == 0);
+    REQUIRE(!newObject->GetVariables().Has("MyVariable"));
+    REQUIRE(prototypes.GetPooledObjectsCount("") == 0);
+
+    scene.objectsInstances.AddObject(std::move(newObject));
+    REQUIRE(scene.objectsInstances.GetObjects("GlobalObject").size() == 1);
+  }
+
+  SECTION("Pool size") {
+    prototypes.EnablePooling();
+    prototypes.SetMaxPooledObjectsCount(2);
+    std::vector<RuntimeObjSPtr> objects;
+    for (std::size_t i = 0; i < 3; ++i)
+      objects.push_back(scene.CreateObject("MyObject"));
+    for (auto& object : objects) prototypes.Recycle(std::move(object));
+    REQUIRE(prototypes.GetPooledObjectsCount("") == 2);
+
+    prototypes.EnablePooling(false);
+    REQUIRE(prototypes.GetPooledObjectsCount("") == 0);
+    prototypes.Recycle(scene.CreateObject("MyObject"));
+    REQUIRE(prototypes.GetPooledObjectsCount("") == 0);
+  }
+}
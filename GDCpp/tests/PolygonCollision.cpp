@@ -0,0 +1,153 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the collision tests between polygons.
+ */
+#include "GDCpp/Runtime/PolygonCollision.h"
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "GDCpp/Runtime/Polygon2d.h"
+#include "catch.hpp"
+
+namespace {
+Polygon2d CreateConvexPolygon(std::mt19937& generator,
+                              std::size_t verticesCount,
+                              float centerX,
+                              float centerY) {
+  std::uniform_real_distribution<float> radiusDistribution(5, 50);
+  std::uniform_real_distribution<float> angleDistribution(0, 6.28318f);
+
+  Polygon2d polygon;
+  float radius = radiusDistribution(generator);
+  float startAngle = angleDistribution(generator);
+  for (std::size_t i = 0; i < verticesCount; ++i) {
+    float angle = startAngle + 6.28318f * i / verticesCount;
+    polygon.vertices.push_back(sf::Vector2f(centerX + radius * std::cos(angle),
+                                            centerY + radius * std::sin(angle)));
+  }
+
+  return polygon;
+}
+
+bool AreIdentical(const CollisionResult& a, const CollisionResult& b) {
+  return a.collision == b.collision &&
+         std::memcmp(&a.move_axis.x, &b.move_axis.x, sizeof(float)) == 0 &&
+         std::memcmp(&a.move_axis.y, &b.move_axis.y, sizeof(float)) == 0;
+}
+}
+
+TEST_CASE("PolygonCollision", "[game-engine]") {
+  PolygonCollisionImplementation defaultImplementation =
+      GetPolygonCollisionImplementation();
+  REQUIRE(IsPolygonCollisionImplementationSupported(POLYGON_COLLISION_SCALAR));
+  REQUIRE(IsPolygonCollisionImplementationSupported(defaultImplementation));
+
+  SECTION("Rectangles") {
+    Polygon2d rectangle1 = Polygon2d::CreateRectangle(10, 10);
+    Polygon2d rectangle2 = Polygon2d::CreateRectangle(10, 10);
+
+    rectangle2.Move(8, 0);
+    CollisionResult result = PolygonCollisionTest(rectangle1, rectangle2);
+    REQUIRE(result.collision == true);
+    REQUIRE(result.move_axis.x == -2);
+    REQUIRE(result.move_axis.y == 0);
+
+    rectangle2.Move(2, 0);
+    REQUIRE(PolygonCollisionTest(rectangle1, rectangle2).collision == true);
+    REQUIRE(PolygonCollisionTest(rectangle1, rectangle2, true).collision ==
+            false);
+
+    rectangle2.Move(0.5, 0);
+    REQUIRE(PolygonCollisionTest(rectangle1, rectangle2).collision == false);
+
+    Polygon2d segment;
+    segment.vertices.push_back(sf::Vector2f(0, 0));
+    segment.vertices.push_back(sf::Vector2f(1, 1));
+    REQUIRE(PolygonCollisionTest(rectangle1, segment).collision == false);
+  }
+
+  SECTION("Batch test") {
+    Polygon2d rectangle = Polygon2d::CreateRectangle(10, 10);
+    std::vector<Polygon2d> polygons;
+    polygons.push_back(Polygon2d::CreateRectangle(4, 4));
+    polygons.push_back(Polygon2d::CreateRectangle(4, 4));
+    polygons.back().Move(100, 0);
+
+    std::vector<CollisionResult> results;
+    REQUIRE(PolygonCollisionBatchTest(rectangle, polygons, results) == true);
+    REQUIRE(results.size() == 2);
+    REQUIRE(results[0].collision == true);
+    REQUIRE(results[1].collision == false);
+
+    polygons.erase(polygons.begin());
+    REQUIRE(PolygonCollisionBatchTest(rectangle, polygons, results) == false);
+    REQUIRE(results.size() == 1);
+  }
+
+  SECTION("Implementations give identical results") {
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<std::size_t> verticesCountDistribution(3, 12);
+    std::uniform_real_distribution<float> positionDistribution(-60, 60);
+
+    std::vector<Polygon2d> polygons;
+    for (std::size_t i = 0; i < 200; ++i) {
+      polygons.push_back(
+          CreateConvexPolygon(generator,
+                              verticesCountDistribution(generator),
+                              positionDistribution(generator),
+                              positionDistribution(generator)));
+    }
+    // Add rectangles on integer coordinates, to have touching edges.
+    for (std::size_t i = 0; i < 20; ++i) {
+      polygons.push_back(Polygon2d::CreateRectangle(10, 10));
+      polygons.back().Move((i % 5) * 10, (i / 5) * 10);
+    }
+
+    const PolygonCollisionImplementation implementations[] = {
+        POLYGON_COLLISION_SSE2, POLYGON_COLLISION_AVX};
+    for (bool ignoreTouchingEdges : {false, true}) {
+      std::vector<CollisionResult> expectedResults;
+      REQUIRE(SetPolygonCollisionImplementation(POLYGON_COLLISION_SCALAR));
+      for (const Polygon2d& p1 : polygons) {
+        for (const Polygon2d& p2 : polygons) {
+          expectedResults.push_back(
+              PolygonCollisionTest(p1, p2, ignoreTouchingEdges));
+        }
+      }
+
+      for (PolygonCollisionImplementation implementation : implementations) {
+        if (!IsPolygonCollisionImplementationSupported(implementation))
+          continue;
+
+        REQUIRE(SetPolygonCollisionImplementation(implementation));
+        std::size_t differencesCount = 0;
+        std::size_t batchDifferencesCount = 0;
+        std::vector<CollisionResult> results;
+        for (std::size_t i = 0; i < polygons.size(); ++i) {
+          PolygonCollisionBatchTest(
+              polygons[i], polygons, results, ignoreTouchingEdges);
+          for (std::size_t j = 0; j < polygons.size(); ++j) {
+            const CollisionResult& expectedResult =
+                expectedResults[i * polygons.size() + j];
+            if (!AreIdentical(PolygonCollisionTest(polygons[i],
+                                                   polygons[j],
+                                                   ignoreTouchingEdges),
+                              expectedResult))
+              differencesCount++;
+            if (!AreIdentical(results[j], expectedResult))
+              batchDifferencesCount++;
+          }
+        }
+        REQUIRE(differencesCount == 0);
+        REQUIRE(batchDifferencesCount == 0);
+      }
+    }
+
+    SetPolygonCollisionImplementation(defaultImplementation);
+  }
+}
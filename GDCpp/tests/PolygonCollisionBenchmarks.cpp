@@ -0,0 +1,81 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Benchmarks of the collision tests between polygons.
+ */
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "GDCpp/Runtime/Polygon2d.h"
+#include "GDCpp/Runtime/PolygonCollision.h"
+#include "catch.hpp"
+
+TEST_CASE("PolygonCollision - Benchmarks", "[game-engine][benchmarks]") {
+  // Hitboxes of 4 to 8 vertices, close enough to each other so that most of
+  // the tests are not stopped by their bounding boxes.
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<std::size_t> verticesCountDistribution(4, 8);
+  std::uniform_real_distribution<float> positionDistribution(-40, 40);
+  std::uniform_real_distribution<float> angleDistribution(0, 360);
+
+  std::vector<Polygon2d> hitboxes;
+  for (std::size_t i = 0; i < 500; ++i) {
+    std::size_t verticesCount = verticesCountDistribution(generator);
+    Polygon2d hitbox;
+    for (std::size_t j = 0; j < verticesCount; ++j) {
+      float angle = 6.28318f * j / verticesCount;
+      hitbox.vertices.push_back(
+          sf::Vector2f(20 * std::cos(angle), 10 * std::sin(angle)));
+    }
+    hitbox.Rotate(angleDistribution(generator));
+    hitbox.Move(positionDistribution(generator), positionDistribution(generator));
+    hitbox.ComputeEdges();
+    hitboxes.push_back(hitbox);
+  }
+
+  auto doBenchmark = [&](const std::string& benchmarkName, bool batch) {
+    std::size_t collisionsCount = 0;
+    std::vector<CollisionResult> results;
+    auto start = std::chrono::steady_clock::now();
+    for (const Polygon2d& p1 : hitboxes) {
+      if (batch) {
+        PolygonCollisionBatchTest(p1, hitboxes, results);
+        for (const CollisionResult& result : results)
+          if (result.collision) collisionsCount++;
+      } else {
+        for (const Polygon2d& p2 : hitboxes)
+          if (PolygonCollisionTest(p1, p2).collision) collisionsCount++;
+      }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << benchmarkName << " benchmark ("
+              << hitboxes.size() * hitboxes.size() << " tests, "
+              << collisionsCount << " collisions): "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end -
+                                                                        start)
+                     .count()
+              << " microseconds" << std::endl;
+  };
+
+  PolygonCollisionImplementation defaultImplementation =
+      GetPolygonCollisionImplementation();
+  const std::pair<PolygonCollisionImplementation, std::string>
+      implementations[] = {{POLYGON_COLLISION_SCALAR, "scalar"},
+                           {POLYGON_COLLISION_SSE2, "SSE2"},
+                           {POLYGON_COLLISION_AVX, "AVX"}};
+  for (const auto& implementation : implementations) {
+    if (!SetPolygonCollisionImplementation(implementation.first)) continue;
+
+    doBenchmark("PolygonCollisionTest (" + implementation.second + ")", false);
+    doBenchmark("PolygonCollisionBatchTest (" + implementation.second + ")",
+                true);
+  }
+  SetPolygonCollisionImplementation(defaultImplementation);
+}
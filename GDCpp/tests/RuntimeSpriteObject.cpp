@@ -29,6 +29,8 @@ TEST_CASE("RuntimeSpriteObject", "[game-engine]") {
     anim.SetName("First animation");
     gd::Sprite sprite;
     sprite.SetImageName("Image.png");
+    sprite.SetCollisionMaskAutomatic(false);
+    sprite.SetCustomCollisionMask({Polygon2d::CreateRectangle(10, 10)});
     anim.SetDirectionsCount(1);
     anim.GetDirection(0).AddSprite(sprite);
     obj1.AddAnimation(anim);
@@ -60,6 +62,21 @@ TEST_CASE("RuntimeSpriteObject", "[game-engine]") {
     object.SetAngle(42);
     REQUIRE(object.GetAngle() == 42);
   }
+  SECTION("Hitboxes") {
+    const std::vector<Polygon2d>& hitBoxes = object.GetHitBoxes();
+    REQUIRE(hitBoxes.size() == 1);
+    REQUIRE(hitBoxes[0].vertices.size() == 4);
+    REQUIRE(hitBoxes[0].edges.size() == 4);
+    float firstVertexX = hitBoxes[0].vertices[0].x;
+
+    // Hitboxes are kept by the object, and updated when it is moved/rotated
+    object.SetX(object.GetX() + 5);
+    REQUIRE(&object.GetHitBoxes() == &hitBoxes);
+    REQUIRE(hitBoxes[0].vertices[0].x == firstVertexX + 5);
+
+    object.SetAngle(90);
+    REQUIRE(object.GetHitBoxes()[0].vertices[0].x != firstVertexX + 5);
+  }
   SECTION("Animations") {
     REQUIRE(object.GetCurrentAnimation() == 0);
     REQUIRE(object.GetCurrentAnimationName() == "First animation");
@@ -7,15 +7,26 @@
  * @file Tests covering scene stacking of GDevelop C++ Platform.
  */
 #include "GDCpp/Runtime/SceneStack.h"
+#include <thread>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Project/ObjectsContainer.h"
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/CodeExecutionEngine.h"
+#include "GDCpp/Runtime/RuntimeContext.h"
 #include "GDCpp/Runtime/RuntimeGame.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeScene.h"
 #include "catch.hpp"
 
+namespace {
+int ReplaceByScene2(RuntimeContext* context) {
+  context->scene->RequestChange(RuntimeScene::SceneChange::REPLACE_SCENE,
+                                "Scene 2");
+  return 0;
+}
+}  // namespace
+
 TEST_CASE("SceneStack", "[game-engine]") {
   RuntimeGame game;
   game.InsertNewLayout("Scene 1", 0);
@@ -59,4 +70,39 @@ TEST_CASE("SceneStack", "[game-engine]") {
     });
     stack.Replace("Scene 1", true);
   }
+
+  SECTION("Preload") {
+    REQUIRE(stack.Preload("test") == false);
+    REQUIRE(stack.GetLoadingProgress("Scene 2") == 0);
+
+    REQUIRE(stack.Preload("Scene 2") == true);
+    while (stack.GetLoadingProgress("Scene 2") < 1) std::this_thread::yield();
+
+    RuntimeScene* scene = stack.Push("Scene 2");
+    REQUIRE(scene != nullptr);
+    REQUIRE(scene->GetName() == "Scene 2");
+    REQUIRE(stack.GetLoadingProgress("Scene 2") == 0);
+
+    // Preloaded scenes not used are destroyed with the stack.
+    REQUIRE(stack.Preload("Scene 1") == true);
+  }
+
+  SECTION("Scene changes requested by events") {
+    std::vector<gd::String> loadedScenes;
+    stack.OnLoadScene([&loadedScenes](RuntimeScene& scene) {
+      if (scene.GetName() == "Scene 1")
+        scene.GetCodeExecutionEngine()->LoadFunction(&ReplaceByScene2);
+
+      loadedScenes.push_back(scene.GetName());
+      return true;
+    });
+    stack.Push("Scene 1");
+
+    // The new scene is loaded in the background, then replaces the first one.
+    while (loadedScenes.size() < 2) REQUIRE(stack.Step() == true);
+    REQUIRE(loadedScenes[1] == "Scene 2");
+    REQUIRE(stack.GetLoadingProgress("Scene 2") == 0);
+    REQUIRE(stack.Pop() == nullptr);
+    REQUIRE(stack.Step() == true);
+  }
 }
@@ -0,0 +1,86 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-present Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Benchmarks of the duration of the frames during a scene change.
+ */
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include "GDCore/Project/InitialInstance.h"
+#include "GDCore/Project/InitialInstancesContainer.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCore/Project/Variable.h"
+#include "GDCpp/Runtime/CodeExecutionEngine.h"
+#include "GDCpp/Runtime/RuntimeContext.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/SceneStack.h"
+#include "catch.hpp"
+
+namespace {
+int ReplaceByBigScene(RuntimeContext* context) {
+  context->scene->RequestChange(RuntimeScene::SceneChange::REPLACE_SCENE,
+                                "Big scene");
+  return 0;
+}
+
+long long GetTimeMicroseconds() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
+TEST_CASE("SceneStack - Benchmarks", "[game-engine][benchmarks]") {
+  RuntimeGame game;
+  game.InsertNewLayout("Small scene", 0);
+  gd::Layout& bigScene = game.InsertNewLayout("Big scene", 1);
+  for (std::size_t i = 0; i < 50000; ++i)
+    bigScene.GetVariables().InsertNew("Variable" + gd::String::From(i));
+  bigScene.InsertObject(gd::Object("MyObject"), 0);
+  for (std::size_t i = 0; i < 1000; ++i) {
+    gd::InitialInstance& instance =
+        bigScene.GetInitialInstances().InsertNewInitialInstance();
+    instance.SetObjectName("MyObject");
+    instance.SetX(i);
+  }
+
+  std::size_t loadedBigScenesCount = 0;
+  SceneStack stack(game, NULL);
+  stack.OnLoadScene([&loadedBigScenesCount](RuntimeScene& scene) {
+    if (scene.GetName() == "Small scene")
+      scene.GetCodeExecutionEngine()->LoadFunction(&ReplaceByBigScene);
+    else
+      loadedBigScenesCount++;
+
+    return true;
+  });
+
+  // Load the big scene when asked, stopping the game loop.
+  stack.Push("Small scene");
+  long long start = GetTimeMicroseconds();
+  stack.Replace("Big scene");
+  long long synchronousLoadingTime = GetTimeMicroseconds() - start;
+  std::cout << "Synchronous loading: " << synchronousLoadingTime
+            << " microseconds." << std::endl;
+
+  // Let the scene stack load the big scene in the background while the small
+  // scene is displayed.
+  stack.Replace("Small scene");
+  long long longestFrameTime = 0;
+  std::size_t framesCount = 0;
+  while (loadedBigScenesCount < 2) {
+    long long frameStart = GetTimeMicroseconds();
+    REQUIRE(stack.Step() == true);
+    longestFrameTime =
+        std::max(longestFrameTime, GetTimeMicroseconds() - frameStart);
+    framesCount++;
+  }
+  std::cout << "Background loading: " << framesCount
+            << " frames, the longest one taking " << longestFrameTime
+            << " microseconds." << std::endl;
+}
@@ -0,0 +1,66 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights
+ * reserved. This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering ThreadPool class.
+ */
+#include "GDCpp/Runtime/ThreadPool.h"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "catch.hpp"
+
+TEST_CASE("ThreadPool", "[game-engine]") {
+  SECTION("ParallelFor") {
+    for (std::size_t workersCount : {0, 1, 3}) {
+      ThreadPool pool(workersCount);
+      REQUIRE(pool.GetWorkersCount() == workersCount);
+
+      for (std::size_t count : {0, 1, 10, 1000, 1001}) {
+        std::vector<std::atomic<int>> calls(count);
+        for (auto& call : calls) call = 0;
+
+        std::atomic<std::size_t> badChunksCount(0);
+        pool.ParallelFor(count, 7, [&](std::size_t begin, std::size_t end) {
+          if (begin >= end || end - begin > 7) badChunksCount++;
+          for (std::size_t i = begin; i < end; ++i) calls[i]++;
+        });
+        REQUIRE(badChunksCount == 0u);
+
+        std::size_t badCallsCount = 0;
+        for (auto& call : calls)
+          if (call != 1) badCallsCount++;
+        REQUIRE(badCallsCount == 0);
+      }
+    }
+  }
+
+  SECTION("Nested ParallelFor") {
+    ThreadPool pool(2);
+    std::atomic<std::size_t> iterationsCount(0);
+    pool.ParallelFor(10, 1, [&](std::size_t, std::size_t) {
+      pool.ParallelFor(
+          10, 1, [&](std::size_t, std::size_t) { iterationsCount++; });
+    });
+    REQUIRE(iterationsCount == 100u);
+  }
+
+  SECTION("Exceptions") {
+    ThreadPool pool(2);
+    REQUIRE_THROWS_AS(
+        pool.ParallelFor(100,
+                         1,
+                         [&](std::size_t begin, std::size_t) {
+                           if (begin == 50) throw std::runtime_error("Error");
+                         }),
+        std::runtime_error);
+
+    // The pool can still be used.
+    std::atomic<std::size_t> iterationsCount(0);
+    pool.ParallelFor(
+        100, 1, [&](std::size_t, std::size_t) { iterationsCount++; });
+    REQUIRE(iterationsCount == 100u);
+  }
+}
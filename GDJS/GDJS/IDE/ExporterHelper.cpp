@@ -6,23 +6,37 @@
 #include "GDJS/IDE/ExporterHelper.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
 #include <fstream>
+#include <functional>
+#include <mutex>
 #include <sstream>
 #include <streambuf>
 #include <string>
+#include <thread>
 
 #include "GDCore/CommonTools.h"
 #include "GDCore/Events/CodeGeneration/EffectsCodeGenerator.h"
+#include "GDCore/Events/Serialization.h"
+#include "GDCore/Events/Tools/EventsCodeNameMangler.h"
+#include "GDCore/Extensions/Metadata/BehaviorMetadata.h"
 #include "GDCore/Extensions/Metadata/DependencyMetadata.h"
+#include "GDCore/Extensions/Metadata/ExpressionMetadata.h"
+#include "GDCore/Extensions/Metadata/InstructionMetadata.h"
 #include "GDCore/Extensions/Metadata/MetadataProvider.h"
+#include "GDCore/Extensions/Metadata/ObjectMetadata.h"
 #include "GDCore/Extensions/Platform.h"
 #include "GDCore/Extensions/PlatformExtension.h"
 #include "GDCore/IDE/AbstractFileSystem.h"
+#include "GDCore/IDE/DependenciesAnalyzer.h"
 #include "GDCore/IDE/Project/ProjectResourcesCopier.h"
 #include "GDCore/IDE/ProjectStripper.h"
 #include "GDCore/IDE/SceneNameMangler.h"
 #include "GDCore/Project/ExternalEvents.h"
 #include "GDCore/Project/ExternalLayout.h"
+#include "GDCore/Project/EventsFunctionsExtension.h"
 #include "GDCore/Project/Layout.h"
 #include "GDCore/Project/Project.h"
 #include "GDCore/Project/PropertyDescriptor.h"
@@ -31,6 +45,7 @@
 #include "GDCore/TinyXml/tinyxml.h"
 #include "GDCore/Tools/Localization.h"
 #include "GDCore/Tools/Log.h"
+#include "GDCore/Tools/VersionWrapper.h"
 #include "GDJS/Events/CodeGeneration/LayoutCodeGenerator.h"
 #include "GDJS/Extensions/JsPlatform.h"
 #undef CopyFile  // Disable an annoying macro
@@ -70,6 +85,289 @@ bool AreMapKeysMissingElementOfSet(std::map<gd::String, gd::String> map,
   return missingKey;
 }
 
+/**
+ * \brief Return a FNV-1a hash of the JSON of the element.
+ */
+gd::String ComputeHash(const gd::SerializerElement &element) {
+  gd::String json = gd::Serializer::ToJSON(element);
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char byte : json.Raw()) {
+    hash ^= byte;
+    hash *= 1099511628211ULL;
+  }
+
+  std::ostringstream hashString;
+  hashString << std::hex << hash;
+  return gd::String::FromUTF8(hashString.str());
+}
+
+/**
+ * \brief Serialize the parameters of an instruction or an expression, as
+ * they change the generated calls to its function.
+ */
+void SerializeParametersCodeTo(
+    const std::vector<gd::ParameterMetadata> &parameters,
+    gd::SerializerElement &element) {
+  element.ConsiderAsArrayOf("parameter");
+  for (auto &parameter : parameters) {
+    gd::SerializerElement &parameterElement = element.AddChild("parameter");
+    parameterElement.SetAttribute("type", parameter.GetType());
+    parameterElement.SetAttribute("extraInfo", parameter.GetExtraInfo());
+    parameterElement.SetAttribute("codeOnly", parameter.IsCodeOnly());
+    parameterElement.SetAttribute("defaultValue", parameter.GetDefaultValue());
+  }
+}
+
+/**
+ * \brief Serialize what the code generated for the instructions depends on:
+ * the function called, the files to include and the parameters.
+ */
+void SerializeInstructionsCodeTo(
+    std::map<gd::String, gd::InstructionMetadata> &instructions,
+    gd::SerializerElement &element) {
+  element.ConsiderAsArrayOf("instruction");
+  for (auto &it : instructions) {
+    gd::InstructionMetadata::ExtraInformation &code =
+        it.second.GetCodeExtraInformation();
+    gd::SerializerElement &instructionElement =
+        element.AddChild("instruction");
+    instructionElement.SetAttribute("name", it.first);
+    instructionElement.SetAttribute("function", code.functionCallName);
+    instructionElement.SetAttribute("type", code.type);
+    instructionElement.SetAttribute("accessType",
+                                    static_cast<int>(code.accessType));
+    instructionElement.SetAttribute("associatedInstruction",
+                                    code.optionalAssociatedInstruction);
+    instructionElement.SetAttribute("customCodeGenerator",
+                                    code.HasCustomCodeGenerator());
+    gd::SerializerElement &includesElement =
+        instructionElement.AddChild("includes");
+    includesElement.ConsiderAsArrayOf("include");
+    for (auto &include : code.GetIncludeFiles())
+      includesElement.AddChild("include").SetStringValue(include);
+    SerializeParametersCodeTo(it.second.GetParameters(),
+                              instructionElement.AddChild("parameters"));
+  }
+}
+
+/**
+ * \brief Serialize what the code generated for the expressions depends on:
+ * the function called, the files to include and the parameters.
+ */
+void SerializeExpressionsCodeTo(
+    std::map<gd::String, gd::ExpressionMetadata> &expressions,
+    gd::SerializerElement &element) {
+  element.ConsiderAsArrayOf("expression");
+  for (auto &it : expressions) {
+    gd::ExpressionCodeGenerationInformation &code =
+        it.second.GetCodeExtraInformation();
+    gd::SerializerElement &expressionElement = element.AddChild("expression");
+    expressionElement.SetAttribute("name", it.first);
+    expressionElement.SetAttribute("function", code.functionCallName);
+    expressionElement.SetAttribute("static", code.staticFunction);
+    expressionElement.SetAttribute("customCodeGenerator",
+                                   code.HasCustomCodeGenerator());
+    gd::SerializerElement &includesElement =
+        expressionElement.AddChild("includes");
+    includesElement.ConsiderAsArrayOf("include");
+    for (auto &include : code.GetIncludeFiles())
+      includesElement.AddChild("include").SetStringValue(include);
+    SerializeParametersCodeTo(it.second.GetParameters(),
+                              expressionElement.AddChild("parameters"));
+  }
+}
+
+/**
+ * \brief Serialize what the code generated for the events depends on in the
+ * metadata of the extension: the instructions and expressions of the
+ * extension, of its objects and of its behaviors, and the files to include
+ * for its objects and behaviors.
+ *
+ * The generated code is shared by the previews and exports using the same
+ * code output directory, so it must be generated again when an extension is
+ * updated.
+ */
+void SerializeExtensionCodeTo(gd::PlatformExtension &extension,
+                              gd::SerializerElement &element) {
+  element.SetAttribute("name", extension.GetName());
+
+  SerializeInstructionsCodeTo(extension.GetAllActions(),
+                              element.AddChild("actions"));
+  SerializeInstructionsCodeTo(extension.GetAllConditions(),
+                              element.AddChild("conditions"));
+  SerializeExpressionsCodeTo(extension.GetAllExpressions(),
+                             element.AddChild("expressions"));
+  SerializeExpressionsCodeTo(extension.GetAllStrExpressions(),
+                             element.AddChild("strExpressions"));
+
+  gd::SerializerElement &objectsElement = element.AddChild("objects");
+  objectsElement.ConsiderAsArrayOf("object");
+  for (auto &type : extension.GetExtensionObjectsTypes()) {
+    gd::ObjectMetadata &metadata = extension.GetObjectMetadata(type);
+    gd::SerializerElement &objectElement = objectsElement.AddChild("object");
+    objectElement.SetAttribute("type", type);
+    objectElement.SetAttribute("className", metadata.className);
+    gd::SerializerElement &includesElement =
+        objectElement.AddChild("includes");
+    includesElement.ConsiderAsArrayOf("include");
+    for (auto &include : metadata.includeFiles)
+      includesElement.AddChild("include").SetStringValue(include);
+
+    SerializeInstructionsCodeTo(extension.GetAllActionsForObject(type),
+                                objectElement.AddChild("actions"));
+    SerializeInstructionsCodeTo(extension.GetAllConditionsForObject(type),
+                                objectElement.AddChild("conditions"));
+    SerializeExpressionsCodeTo(extension.GetAllExpressionsForObject(type),
+                               objectElement.AddChild("expressions"));
+    SerializeExpressionsCodeTo(extension.GetAllStrExpressionsForObject(type),
+                               objectElement.AddChild("strExpressions"));
+  }
+
+  gd::SerializerElement &behaviorsElement = element.AddChild("behaviors");
+  behaviorsElement.ConsiderAsArrayOf("behavior");
+  for (auto &type : extension.GetBehaviorsTypes()) {
+    gd::BehaviorMetadata &metadata = extension.GetBehaviorMetadata(type);
+    gd::SerializerElement &behaviorElement =
+        behaviorsElement.AddChild("behavior");
+    behaviorElement.SetAttribute("type", type);
+    behaviorElement.SetAttribute("className", metadata.className);
+    gd::SerializerElement &includesElement =
+        behaviorElement.AddChild("includes");
+    includesElement.ConsiderAsArrayOf("include");
+    for (auto &include : metadata.includeFiles)
+      includesElement.AddChild("include").SetStringValue(include);
+
+    SerializeInstructionsCodeTo(extension.GetAllActionsForBehavior(type),
+                                behaviorElement.AddChild("actions"));
+    SerializeInstructionsCodeTo(extension.GetAllConditionsForBehavior(type),
+                                behaviorElement.AddChild("conditions"));
+    SerializeExpressionsCodeTo(extension.GetAllExpressionsForBehavior(type),
+                               behaviorElement.AddChild("expressions"));
+    SerializeExpressionsCodeTo(extension.GetAllStrExpressionsForBehavior(type),
+                               behaviorElement.AddChild("strExpressions"));
+  }
+}
+
+/**
+ * \brief Return a hash of what the code generated for all the layouts depends
+ * on: the global objects and groups, the global variables, the events
+ * functions extensions and the metadata of the platform extensions (see
+ * SerializeExtensionCodeTo).
+ */
+gd::String ComputeProjectCodeHash(const gd::Project &project,
+                                  bool exportForPreview) {
+  gd::SerializerElement element;
+  element.SetAttribute("gdevelopVersion", gd::VersionWrapper::FullString());
+  element.SetAttribute("exportForPreview", exportForPreview);
+  project.SerializeObjectsTo(element.AddChild("globalObjects"));
+  project.GetObjectGroups().SerializeTo(
+      element.AddChild("globalObjectsGroups"));
+  project.GetVariables().SerializeTo(element.AddChild("globalVariables"));
+
+  gd::SerializerElement &extensionsElement =
+      element.AddChild("eventsFunctionsExtensions");
+  extensionsElement.ConsiderAsArrayOf("eventsFunctionsExtension");
+  for (std::size_t i = 0; i < project.GetEventsFunctionsExtensionsCount();
+       ++i) {
+    project.GetEventsFunctionsExtension(i).SerializeTo(
+        extensionsElement.AddChild("eventsFunctionsExtension"));
+  }
+
+  gd::SerializerElement &platformExtensionsElement =
+      element.AddChild("platformExtensions");
+  platformExtensionsElement.ConsiderAsArrayOf("platformExtension");
+  for (auto &extension :
+       project.GetCurrentPlatform().GetAllPlatformExtensions()) {
+    SerializeExtensionCodeTo(
+        *extension, platformExtensionsElement.AddChild("platformExtension"));
+  }
+
+  return ComputeHash(element);
+}
+
+/**
+ * \brief Return a hash of what the code generated for the layout depends on:
+ * the project (see ComputeProjectCodeHash), the events, objects and groups of
+ * the layout, and the events of the scenes and external events it links to
+ * (as found by gd::DependenciesAnalyzer).
+ */
+gd::String ComputeLayoutCodeHash(gd::Project &project,
+                                 const gd::String &projectCodeHash,
+                                 gd::Layout &layout) {
+  gd::SerializerElement element;
+  element.SetAttribute("projectHash", projectCodeHash);
+  element.SetAttribute("name", layout.GetName());
+  gd::EventsListSerialization::SerializeEventsTo(layout.GetEvents(),
+                                                 element.AddChild("events"));
+  layout.SerializeObjectsTo(element.AddChild("objects"));
+  layout.GetObjectGroups().SerializeTo(element.AddChild("objectsGroups"));
+  layout.GetVariables().SerializeTo(element.AddChild("variables"));
+
+  DependenciesAnalyzer analyzer(project, layout);
+  analyzer.Analyze();
+  gd::SerializerElement &dependenciesElement =
+      element.AddChild("dependencies");
+  for (auto &sceneName : analyzer.GetScenesDependencies()) {
+    if (!project.HasLayoutNamed(sceneName)) continue;
+
+    gd::SerializerElement &sceneElement = dependenciesElement.AddChild("scene");
+    sceneElement.SetAttribute("name", sceneName);
+    gd::EventsListSerialization::SerializeEventsTo(
+        project.GetLayout(sceneName).GetEvents(),
+        sceneElement.AddChild("events"));
+  }
+  for (auto &externalEventsName : analyzer.GetExternalEventsDependencies()) {
+    if (!project.HasExternalEventsNamed(externalEventsName)) continue;
+
+    gd::SerializerElement &externalEventsElement =
+        dependenciesElement.AddChild("externalEvents");
+    externalEventsElement.SetAttribute("name", externalEventsName);
+    gd::EventsListSerialization::SerializeEventsTo(
+        project.GetExternalEvents(externalEventsName).GetEvents(),
+        externalEventsElement.AddChild("events"));
+  }
+
+  return ComputeHash(element);
+}
+
+/**
+ * \brief Call \a function for each index from 0 to \a count (excluded), on as
+ * many threads as the CPU supports (unless threads are not available).
+ *
+ * If \a function throws an exception, the first one is rethrown once all
+ * the threads are done.
+ */
+void ParallelFor(std::size_t count,
+                 const std::function<void(std::size_t)> &function) {
+#if defined(EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
+  for (std::size_t i = 0; i < count; ++i) function(i);
+#else
+  std::atomic<std::size_t> nextIndex(0);
+  std::exception_ptr exception;
+  std::mutex exceptionMutex;
+  auto work = [&]() {
+    for (std::size_t i = nextIndex++; i < count; i = nextIndex++) {
+      try {
+        function(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(exceptionMutex);
+        if (!exception) exception = std::current_exception();
+      }
+    }
+  };
+
+  std::size_t threadsCount =
+      std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u),
+                            count);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < threadsCount; ++i) threads.emplace_back(work);
+  work();
+  for (auto &thread : threads) thread.join();
+
+  if (exception) std::rethrow_exception(exception);
+#endif
+}
+
 }  // namespace
 
 namespace gdjs {
@@ -86,8 +384,9 @@ ExporterHelper::ExporterHelper(gd::AbstractFileSystem &fileSystem,
 
 bool ExporterHelper::ExportProjectForPixiPreview(
     const PreviewExportOptions &options) {
+  // The export directory is not cleared: resources that are unchanged since
+  // the previous preview are not copied again.
   fs.MkDir(options.exportPath);
-  fs.ClearDir(options.exportPath);
   std::vector<gd::String> includesFiles;
 
   gd::Project exportedProject = options.project;
@@ -97,7 +396,7 @@ bool ExporterHelper::ExportProjectForPixiPreview(
 
   // Export resources (*before* generating events as some resources filenames
   // may be updated)
-  ExportResources(fs, exportedProject, options.exportPath);
+  ExportResources(fs, exportedProject, options.exportPath, true);
 
   // Compatibility with GD <= 5.0-beta56
   // Stay compatible with text objects declaring their font as just a filename
@@ -195,13 +494,20 @@ gd::String ExporterHelper::ExportProjectData(
     const gd::SerializerElement &runtimeGameOptions) {
   fs.MkDir(fs.DirNameFrom(filename));
 
-  // Save the project to JSON
+  // Save the project to JSON. The JSON is streamed into a single buffer to
+  // avoid copying the (possibly large) project data multiple times.
   gd::SerializerElement rootElement;
   project.SerializeTo(rootElement);
-  gd::String output =
-      "gdjs.projectData = " + gd::Serializer::ToJSON(rootElement) + ";\n" +
-      "gdjs.runtimeGameOptions = " +
-      gd::Serializer::ToJSON(runtimeGameOptions) + ";\n";
+  std::ostringstream stream;
+  stream << "gdjs.projectData = ";
+  gd::Serializer::ToJSON(rootElement, stream);
+  stream << ";\n"
+         << "gdjs.runtimeGameOptions = ";
+  gd::Serializer::ToJSON(runtimeGameOptions, stream);
+  stream << ";\n";
+
+  gd::String output;
+  output.RawMutable() = stream.str();
 
   if (!fs.WriteToFile(filename, output)) return "Unable to write " + filename;
 
@@ -728,24 +1034,114 @@ bool ExporterHelper::ExportEventsCode(gd::Project &project,
                                       bool exportForPreview) {
   fs.MkDir(outputDir);
 
+  struct LayoutCode {
+    gd::String filename;
+    gd::String hash;
+    bool upToDate = false;
+    gd::String code;
+    std::set<gd::String> includes;
+  };
+
+  // Find the layouts having their code already generated by a previous export
+  // in the same directory, and not changed since.
+  gd::String manifestFilename = outputDir + "/" + "codeManifest.json";
+  gd::SerializerElement previousManifest;
+  if (fs.FileExists(manifestFilename))
+    previousManifest = gd::Serializer::FromJSON(fs.ReadFile(manifestFilename));
+  previousManifest.ConsiderAsArrayOf("layout");
+
+  std::vector<LayoutCode> layoutsCode(project.GetLayoutsCount());
+  gd::String projectCodeHash =
+      ComputeProjectCodeHash(project, exportForPreview);
+  ParallelFor(layoutsCode.size(), [&](std::size_t i) {
+    layoutsCode[i].hash =
+        ComputeLayoutCodeHash(project, projectCodeHash, project.GetLayout(i));
+  });
+
+  std::vector<std::size_t> outdatedLayouts;
   for (std::size_t i = 0; i < project.GetLayoutsCount(); ++i) {
-    std::set<gd::String> eventsIncludes;
-    gd::Layout &layout = project.GetLayout(i);
-    LayoutCodeGenerator layoutCodeGenerator(project);
-    gd::String eventsOutput = layoutCodeGenerator.GenerateLayoutCompleteCode(
-        layout, eventsIncludes, !exportForPreview);
-    gd::String filename =
+    LayoutCode &layoutCode = layoutsCode[i];
+    layoutCode.filename =
         outputDir + "/" + "code" + gd::String::From(i) + ".js";
 
+    if (i < previousManifest.GetChildrenCount()) {
+      const gd::SerializerElement &previousElement =
+          previousManifest.GetChild(i);
+      if (previousElement.GetStringAttribute("filename") ==
+              layoutCode.filename &&
+          previousElement.GetStringAttribute("hash") == layoutCode.hash &&
+          previousElement.HasChild("includes") &&
+          fs.FileExists(layoutCode.filename)) {
+        layoutCode.upToDate = true;
+
+        const gd::SerializerElement &includesElement =
+            previousElement.GetChild("includes");
+        includesElement.ConsiderAsArrayOf("include");
+        for (std::size_t j = 0; j < includesElement.GetChildrenCount(); ++j)
+          layoutCode.includes.insert(
+              includesElement.GetChild(j).GetStringValue());
+      }
+    }
+
+    if (!layoutCode.upToDate) outdatedLayouts.push_back(i);
+  }
+
+  auto writeManifest = [&]() {
+    gd::SerializerElement manifest;
+    manifest.ConsiderAsArrayOf("layout");
+    for (auto &layoutCode : layoutsCode) {
+      gd::SerializerElement &layoutElement = manifest.AddChild("layout");
+      layoutElement.SetAttribute("filename", layoutCode.filename);
+      if (!layoutCode.upToDate) continue;
+
+      layoutElement.SetAttribute("hash", layoutCode.hash);
+      gd::SerializerElement &includesElement =
+          layoutElement.AddChild("includes");
+      includesElement.ConsiderAsArrayOf("include");
+      for (auto &include : layoutCode.includes)
+        includesElement.AddChild("include").SetStringValue(include);
+    }
+    fs.WriteToFile(manifestFilename, gd::Serializer::ToJSON(manifest));
+  };
+
+  if (!outdatedLayouts.empty()) {
+    // Forget the outdated layouts before overwriting their files, in case the
+    // export is interrupted.
+    writeManifest();
+
+    // Generate the code of the outdated layouts in parallel. The singletons
+    // used during code generation are created before starting the threads.
+    gd::SceneNameMangler::Get();
+    EventsCodeNameMangler::Get();
+    ParallelFor(outdatedLayouts.size(), [&](std::size_t i) {
+      std::size_t layoutIndex = outdatedLayouts[i];
+      LayoutCode &layoutCode = layoutsCode[layoutIndex];
+      LayoutCodeGenerator layoutCodeGenerator(project);
+      layoutCode.code = layoutCodeGenerator.GenerateLayoutCompleteCode(
+          project.GetLayout(layoutIndex),
+          layoutCode.includes,
+          !exportForPreview);
+    });
+
     // Export the code
-    if (fs.WriteToFile(filename, eventsOutput)) {
-      for (auto &include : eventsIncludes) InsertUnique(includesFiles, include);
+    for (std::size_t layoutIndex : outdatedLayouts) {
+      LayoutCode &layoutCode = layoutsCode[layoutIndex];
+      if (!fs.WriteToFile(layoutCode.filename, layoutCode.code)) {
+        lastError = _("Unable to write ") + layoutCode.filename;
+        return false;
+      }
 
-      InsertUnique(includesFiles, filename);
-    } else {
-      lastError = _("Unable to write ") + filename;
-      return false;
+      layoutCode.upToDate = true;
+      layoutCode.code.clear();
     }
+    writeManifest();
+  }
+
+  for (auto &layoutCode : layoutsCode) {
+    for (auto &include : layoutCode.includes)
+      InsertUnique(includesFiles, include);
+
+    InsertUnique(includesFiles, layoutCode.filename);
   }
 
   return true;
@@ -866,9 +1262,10 @@ void ExporterHelper::ExportObjectAndBehaviorsIncludes(
 
 void ExporterHelper::ExportResources(gd::AbstractFileSystem &fs,
                                      gd::Project &project,
-                                     gd::String exportDir) {
+                                     gd::String exportDir,
+                                     bool incrementalCopy) {
   gd::ProjectResourcesCopier::CopyAllResourcesTo(
-      project, fs, exportDir, true, false, false);
+      project, fs, exportDir, true, false, false, incrementalCopy);
 }
 
 void ExporterHelper::AddDeprecatedFontFilesToFontResources(
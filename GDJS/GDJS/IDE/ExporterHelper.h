@@ -130,12 +130,14 @@ class ExporterHelper {
    * \param fs The abstract file system to use
    * \param project The project with resources to be exported.
    * \param exportDir The directory where the preview must be created.
-   * \param progressDlg Optional wxProgressDialog which will be updated with the
-   * progress.
+   * \param incrementalCopy If true, only the resources changed since the
+   * previous export in the same directory are copied (see
+   * gd::ProjectResourcesCopier::CopyAllResourcesTo).
    */
   static void ExportResources(gd::AbstractFileSystem &fs,
                               gd::Project &project,
-                              gd::String exportDir);
+                              gd::String exportDir,
+                              bool incrementalCopy = false);
 
   /**
    * \brief Add libraries files from Pixi.js or Cocos2d to the list of includes.
@@ -170,6 +172,11 @@ class ExporterHelper {
    * outputDir The directory where the events code must be generated. \param
    * includesFiles A reference to a vector that will be filled with JS files to
    * be exported along with the project. ( including "codeX.js" files ).
+   *
+   * A hash of the events, objects and dependencies of each layout is stored
+   * in "codeManifest.json" in the output directory: the code of layouts that
+   * did not change since a previous export in the same directory is not
+   * generated again. The code of the other layouts is generated in parallel.
    */
   bool ExportEventsCode(gd::Project &project,
                         gd::String outputDir,
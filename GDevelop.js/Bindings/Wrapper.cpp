@@ -313,6 +313,54 @@ class AbstractFileSystemJS : public AbstractFileSystem {
     return directories;
   }
 
+  // The following methods are optional in the JS implementation: files are
+  // always copied, and never removed, if they are not implemented.
+  virtual bool GetFileStats(const gd::String &file,
+                            std::uint64_t &size,
+                            std::int64_t &modificationTime) {
+    double stats[2];
+    if (!EM_ASM_INT(
+            {
+              var self = Module['getCache'](Module['AbstractFileSystemJS'])[$0];
+              if (!self.hasOwnProperty('getFileStats')) return 0;
+              var stats = self.getFileStats(UTF8ToString($1));
+              if (!stats) return 0;
+              HEAPF64[$2 >> 3] = stats.size;
+              HEAPF64[($2 >> 3) + 1] = stats.modificationTime;
+              return 1;
+            },
+            (int)this,
+            file.c_str(),
+            stats))
+      return false;
+
+    size = stats[0];
+    modificationTime = stats[1];
+    return true;
+  }
+
+  virtual gd::String GetFileHash(const gd::String &file) {
+    return (const char *)EM_ASM_INT(
+        {
+          var self = Module['getCache'](Module['AbstractFileSystemJS'])[$0];
+          if (!self.hasOwnProperty('getFileHash')) return ensureString('');
+          return ensureString(self.getFileHash(UTF8ToString($1)));
+        },
+        (int)this,
+        file.c_str());
+  }
+
+  virtual bool RemoveFile(const gd::String &file) {
+    return (bool)EM_ASM_INT(
+        {
+          var self = Module['getCache'](Module['AbstractFileSystemJS'])[$0];
+          if (!self.hasOwnProperty('removeFile')) return 0;
+          return self.removeFile(UTF8ToString($1));
+        },
+        (int)this,
+        file.c_str());
+  }
+
   AbstractFileSystemJS(){};
   virtual ~AbstractFileSystemJS(){};
 };
@@ -2617,11 +2617,10 @@ describe('libGD.js', function() {
   });
 
   describe('gd.Exporter (and gd.AbstractFileSystemJS)', function() {
-    it('should export a layout for preview', function(done) {
-      var fs = new gd.AbstractFileSystemJS();
-      var project = new gd.ProjectHelper.createNewGDJSProject();
-      var layout = project.insertNewLayout('Scene', 0);
-
+    // A fake file system, keeping the written files in memory.
+    const createInMemoryFileSystem = function() {
+      const fs = new gd.AbstractFileSystemJS();
+      fs.files = {};
       fs.mkDir = fs.clearDir = function() {};
       fs.getTempDir = function(path) {
         return '/tmp/';
@@ -2632,22 +2631,131 @@ describe('libGD.js', function() {
       fs.dirNameFrom = function(fullpath) {
         return path.dirname(fullpath);
       };
+      fs.makeAbsolute = function(relativePath, baseDirectory) {
+        return path.posix.resolve(baseDirectory, relativePath);
+      };
+      fs.makeRelative = function(absolutePath, baseDirectory) {
+        return path.posix.relative(baseDirectory, absolutePath);
+      };
+      fs.isAbsolute = function(fullPath) {
+        return path.posix.isAbsolute(fullPath);
+      };
+      fs.dirExists = function(directoryPath) {
+        return true;
+      };
       fs.readDir = function() {
         return new gd.VectorString();
       };
-      fs.writeToFile = function(path, content) {
-        //Validate that some code have been generated:
-        expect(content).toMatch('runtimeScene.getOnceTriggers().startNewFrame');
-        done();
+      fs.copyFile = fs.removeFile = function() {
+        return true;
+      };
+      fs.fileExists = function(filePath) {
+        return fs.files.hasOwnProperty(filePath);
+      };
+      fs.readFile = function(filePath) {
+        return fs.files[filePath] || '';
       };
+      fs.writeToFile = jest.fn();
+      fs.writeToFile.mockImplementation(function(filePath, content) {
+        fs.files[filePath] = content;
+        return true;
+      });
+
+      return fs;
+    };
+
+    it('should export a layout for preview', function() {
+      const fs = createInMemoryFileSystem();
+      const project = new gd.ProjectHelper.createNewGDJSProject();
+      const layout = project.insertNewLayout('Scene', 0);
+
+      const exporter = new gd.Exporter(fs);
+      exporter.setCodeOutputDirectory('/code');
+      const previewExportOptions = new gd.PreviewExportOptions(
+        project,
+        '/path/for/export/'
+      );
+      previewExportOptions.setLayoutName('Scene');
+      exporter.exportProjectForPixiPreview(previewExportOptions);
+
+      //Validate that some code have been generated:
+      expect(fs.files['/code/code0.js']).toMatch(
+        'runtimeScene.getOnceTriggers().startNewFrame'
+      );
+
+      previewExportOptions.delete();
+      exporter.delete();
+      project.delete();
+    });
+
+    it('should only generate again the code of changed layouts', function() {
+      const fs = createInMemoryFileSystem();
+      const project = new gd.ProjectHelper.createNewGDJSProject();
+      project.insertNewLayout('Scene', 0);
+      project.insertNewLayout('Other scene', 1);
 
       const exporter = new gd.Exporter(fs);
-      const previewExportOptions =
-        new gd.PreviewExportOptions(project, '/path/for/export/');
+      exporter.setCodeOutputDirectory('/code');
+      const previewExportOptions = new gd.PreviewExportOptions(
+        project,
+        '/path/for/export/'
+      );
       previewExportOptions.setLayoutName('Scene');
+      const getCodeWritesCount = function() {
+        return fs.writeToFile.mock.calls.filter(function(call) {
+          return call[0] === '/code/code0.js' || call[0] === '/code/code1.js';
+        }).length;
+      };
+
+      exporter.exportProjectForPixiPreview(previewExportOptions);
+      expect(getCodeWritesCount()).toBe(2);
+      expect(fs.fileExists('/code/codeManifest.json')).toBe(true);
+
+      // The code of unchanged layouts is kept...
+      fs.writeToFile.mockClear();
+      exporter.exportProjectForPixiPreview(previewExportOptions);
+      expect(getCodeWritesCount()).toBe(0);
+
+      // ...but generated again for changed layouts...
+      fs.writeToFile.mockClear();
+      project
+        .getLayout('Other scene')
+        .getEvents()
+        .insertEvent(new gd.StandardEvent(), 0);
       exporter.exportProjectForPixiPreview(previewExportOptions);
+      expect(getCodeWritesCount()).toBe(1);
+      expect(fs.writeToFile).toHaveBeenCalledWith(
+        '/code/code1.js',
+        expect.any(String)
+      );
+
+      // ...and for all the layouts when an extension changed.
+      const extension = new gd.PlatformExtension();
+      extension.setExtensionInformation(
+        'MyCodeHashExtension',
+        'Full name of test extension',
+        'Description of test extension',
+        'Author of test extension',
+        'License of test extension'
+      );
+      extension
+        .addAction('MyAction', 'My action', '', '', '', '', '')
+        .getCodeExtraInformation()
+        .setFunctionName('myFunction');
+      gd.JsPlatform.get().addNewExtension(extension);
+      fs.writeToFile.mockClear();
+      exporter.exportProjectForPixiPreview(previewExportOptions);
+      expect(getCodeWritesCount()).toBe(2);
+
+      fs.writeToFile.mockClear();
+      exporter.exportProjectForPixiPreview(previewExportOptions);
+      expect(getCodeWritesCount()).toBe(0);
+
+      gd.JsPlatform.get().removeExtension('MyCodeHashExtension');
+      extension.delete();
       previewExportOptions.delete();
       exporter.delete();
+      project.delete();
     });
   });
 
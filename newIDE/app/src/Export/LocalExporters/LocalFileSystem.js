@@ -2,6 +2,7 @@ import optionalRequire from '../../Utils/OptionalRequire.js';
 var fs = optionalRequire('fs-extra');
 var path = optionalRequire('path');
 var os = optionalRequire('os');
+var crypto = optionalRequire('crypto');
 const gd /* TODO: add flow in this file */ = global.gd;
 
 export default {
@@ -88,13 +89,59 @@ export default {
 
     source = this._translateURL(source);
     try {
-      if (source !== dest) fs.copySync(source, dest);
+      if (source !== dest) {
+        if (fs.statSync(source).isFile()) {
+          // Remove the destination first, so that a file hard linked to it
+          // is never overwritten. When the file system supports it, the copy
+          // is a (copy-on-write) clone of the file.
+          fs.ensureDirSync(path.dirname(dest));
+          fs.removeSync(dest);
+          fs.copyFileSync(source, dest, fs.constants.COPYFILE_FICLONE);
+        } else {
+          fs.copySync(source, dest);
+        }
+      }
     } catch (e) {
       console.error('copyFile(' + source + ', ' + dest + ') failed: ' + e);
       return false;
     }
     return true;
   },
+  removeFile: function(file) {
+    try {
+      fs.removeSync(file);
+    } catch (e) {
+      console.error('removeFile(' + file + ') failed: ' + e);
+      return false;
+    }
+    return true;
+  },
+  getFileStats: function(file) {
+    if (this._isExternalURL(file)) return null;
+
+    file = this._translateURL(file);
+    try {
+      const stat = fs.statSync(file);
+      if (!stat.isFile()) return null;
+      return { size: stat.size, modificationTime: Math.floor(stat.mtimeMs) };
+    } catch (e) {
+      return null;
+    }
+  },
+  getFileHash: function(file) {
+    if (this._isExternalURL(file)) return '';
+
+    file = this._translateURL(file);
+    try {
+      return crypto
+        .createHash('md5')
+        .update(fs.readFileSync(file))
+        .digest('hex');
+    } catch (e) {
+      console.error('getFileHash(' + file + ') failed: ' + e);
+      return '';
+    }
+  },
   writeToFile: function(file, contents) {
     try {
       fs.outputFileSync(file, contents);